@@ -26,6 +26,9 @@ function(add_assets_target)
             ${_ASSETS_SOURCE_DIR}/country-codes.db
             ${_ASSETS_SOURCE_DIR}/Luts.bin
             ${_ASSETS_DEST_DIR}/current
+        COMMAND python3 ${CMAKE_SOURCE_DIR}/tools/generate_sounds_catalog.py
+            --root ${_ASSETS_DEST_DIR}/current
+            --dir assets/audio
         COMMAND rsync -qravu --delete ${EXCLUDED}
             ${_ASSETS_SOURCE_DIR}/user
             ${_ASSETS_DEST_DIR}
@@ -60,6 +60,14 @@ option(ENABLE_USB_MTP "Enables usage of USB MTP" ON)
 # add Mudita USB Vendor/Product IDs
 option(MUDITA_USB_ID "Enables using Mudita registered USB Vendor ID and Pure Phone USB Product ID" ON)
 
+# add TLSF heap allocator option
+option(USE_TLSF_HEAP "Use TLSF allocator with per task accounting for system and user heaps" OFF)
+if (${USE_TLSF_HEAP} STREQUAL "ON")
+    set (USE_TLSF_HEAP_ENABLED 1 CACHE INTERNAL "")
+else()
+    set (USE_TLSF_HEAP_ENABLED 0 CACHE INTERNAL "")
+endif()
+
 #Config options described in README.md
 set(PROJECT_CONFIG_DEFINITIONS
         LOG_USE_COLOR=${LOG_USE_COLOR}
@@ -68,6 +76,7 @@ set(PROJECT_CONFIG_DEFINITIONS
         SYSTEM_VIEW_ENABLED=${SYSTEM_VIEW_ENABLED}
         USBCDC_ECHO_ENABLED=${USBCDC_ECHO_ENABLED}
         LOG_LUART_ENABLED=${LOG_LUART_ENABLED}
+        USE_TLSF_HEAP=${USE_TLSF_HEAP_ENABLED}
         MAGIC_ENUM_RANGE_MAX=256
         CACHE INTERNAL ""
         )
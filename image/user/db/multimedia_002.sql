@@ -0,0 +1,86 @@
+-- Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+-- For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+-- Artists and albums are moved out of the files table. Existing files keep their ids and tags.
+
+BEGIN TRANSACTION;
+
+CREATE TABLE IF NOT EXISTS artists
+(
+    _id         INTEGER PRIMARY KEY,
+    artist      TEXT NOT NULL UNIQUE,   /* song artist */
+    song_count  INTEGER DEFAULT 0       /* maintained by triggers */
+);
+
+CREATE TABLE IF NOT EXISTS albums
+(
+    _id         INTEGER PRIMARY KEY,
+    artist_id   INTEGER NOT NULL REFERENCES artists(_id),
+    album       TEXT NOT NULL,          /* song album */
+    song_count  INTEGER DEFAULT 0,      /* maintained by triggers */
+    UNIQUE (album, artist_id)
+);
+
+CREATE TABLE IF NOT EXISTS library_count
+(
+    _id     INTEGER PRIMARY KEY,
+    files   INTEGER,
+    artists INTEGER,
+    albums  INTEGER
+);
+
+INSERT OR IGNORE INTO library_count (_id, files, artists, albums) VALUES (1, 0, 0, 0);
+
+ALTER TABLE files RENAME TO files_001;
+
+CREATE TABLE files
+(
+    _id         INTEGER PRIMARY KEY,
+    path        TEXT UNIQUE,    /* filepath */
+    media_type  TEXT,           /* mime type e.g. "audio/mp3" */
+    size        INTEGER,        /* file size in bytes */
+    title       TEXT,           /* song title */
+    artist_id   INTEGER NOT NULL REFERENCES artists(_id),
+    album_id    INTEGER NOT NULL REFERENCES albums(_id),
+    comment     TEXT,           /* comment */
+    genre       TEXT,           /* e.g. "blues, classic rock" */
+    year        INTEGER,        /* year of release */
+    track       INTEGER,        /* track number */
+    song_length INTEGER,        /* length of the song in seconds */
+    bitrate     INTEGER,        /* bitrate of the song in kb/s */
+    sample_rate INTEGER,        /* sample rate of the song in Hz */
+    channels    INTEGER         /* number of channels 1 - mono, 2 - stereo */
+);
+
+CREATE INDEX IF NOT EXISTS files_title ON files (title);
+CREATE INDEX IF NOT EXISTS files_artist_title ON files (artist_id, title);
+CREATE INDEX IF NOT EXISTS files_album_title ON files (album_id, title);
+
+CREATE TRIGGER IF NOT EXISTS on_file_insert AFTER INSERT ON files BEGIN UPDATE library_count SET files=files+1 WHERE _id=1; UPDATE albums SET song_count=song_count+1 WHERE _id=NEW.album_id; UPDATE artists SET song_count=song_count+1 WHERE _id=NEW.artist_id; END;
+CREATE TRIGGER IF NOT EXISTS on_file_remove AFTER DELETE ON files BEGIN UPDATE library_count SET files=files-1 WHERE _id=1; UPDATE albums SET song_count=song_count-1 WHERE _id=OLD.album_id; UPDATE artists SET song_count=song_count-1 WHERE _id=OLD.artist_id; END;
+CREATE TRIGGER IF NOT EXISTS on_file_album_update AFTER UPDATE OF album_id ON files WHEN OLD.album_id IS NOT NEW.album_id BEGIN UPDATE albums SET song_count=song_count+1 WHERE _id=NEW.album_id; UPDATE albums SET song_count=song_count-1 WHERE _id=OLD.album_id; END;
+CREATE TRIGGER IF NOT EXISTS on_file_artist_update AFTER UPDATE OF artist_id ON files WHEN OLD.artist_id IS NOT NEW.artist_id BEGIN UPDATE artists SET song_count=song_count+1 WHERE _id=NEW.artist_id; UPDATE artists SET song_count=song_count-1 WHERE _id=OLD.artist_id; END;
+CREATE TRIGGER IF NOT EXISTS on_album_insert AFTER INSERT ON albums BEGIN UPDATE library_count SET albums=albums+1 WHERE _id=1; END;
+CREATE TRIGGER IF NOT EXISTS on_album_remove AFTER DELETE ON albums BEGIN UPDATE library_count SET albums=albums-1 WHERE _id=1; END;
+CREATE TRIGGER IF NOT EXISTS on_album_empty AFTER UPDATE OF song_count ON albums WHEN NEW.song_count=0 BEGIN DELETE FROM albums WHERE _id=NEW._id; END;
+CREATE TRIGGER IF NOT EXISTS on_artist_insert AFTER INSERT ON artists BEGIN UPDATE library_count SET artists=artists+1 WHERE _id=1; END;
+CREATE TRIGGER IF NOT EXISTS on_artist_remove AFTER DELETE ON artists BEGIN UPDATE library_count SET artists=artists-1 WHERE _id=1; END;
+CREATE TRIGGER IF NOT EXISTS on_artist_empty AFTER UPDATE OF song_count ON artists WHEN NEW.song_count=0 BEGIN DELETE FROM artists WHERE _id=NEW._id; END;
+
+INSERT OR IGNORE INTO artists (artist) SELECT DISTINCT IFNULL(artist, '') FROM files_001;
+
+INSERT OR IGNORE INTO albums (artist_id, album)
+    SELECT DISTINCT artists._id, IFNULL(files_001.album, '')
+    FROM files_001 JOIN artists ON artists.artist = IFNULL(files_001.artist, '');
+
+INSERT INTO files (_id, path, media_type, size, title, artist_id, album_id, comment, genre, year, track, song_length,
+    bitrate, sample_rate, channels)
+    SELECT files_001._id, path, media_type, size, title, artists._id, albums._id, comment, genre, year, track,
+    song_length, bitrate, sample_rate, channels
+    FROM files_001
+    JOIN artists ON artists.artist = IFNULL(files_001.artist, '')
+    JOIN albums ON albums.artist_id = artists._id AND albums.album = IFNULL(files_001.album, '');
+
+DROP TABLE files_001;
+
+COMMIT;
@@ -5,6 +5,7 @@
 
 #include <service-audio/AudioServiceAPI.hpp>
 #include <purefs/filesystem_paths.hpp>
+#include <tags_fetcher/SoundsCatalog.hpp>
 
 namespace gui
 {
@@ -20,7 +21,7 @@ namespace gui
 
         alarmSoundList = getMusicFilesList();
         std::vector<UTF8> printOptions;
-        for (const auto &musicFile : getMusicFilesList()) {
+        for (const auto &musicFile : alarmSoundList) {
             printOptions.push_back(musicFile.title);
         }
         optionSpinner->setData({printOptions});
@@ -93,17 +94,8 @@ namespace gui
 
     std::vector<tags::fetcher::Tags> AlarmMusicOptionsItem::getMusicFilesList()
     {
-        const auto musicFolder = (purefs::dir::getCurrentOSPath() / "assets/audio/alarm").string();
-        std::vector<tags::fetcher::Tags> musicFiles;
-        LOG_INFO("Scanning music folder: %s", musicFolder.c_str());
-        for (const auto &ent : std::filesystem::directory_iterator(musicFolder)) {
-            if (!ent.is_directory()) {
-                const auto filePath = std::string(musicFolder) + "/" + ent.path().filename().c_str();
-                auto fileTags       = tags::fetcher::fetchTags(filePath);
-                musicFiles.push_back(fileTags);
-                LOG_DEBUG("file: %s found", ent.path().filename().c_str());
-            }
-        }
+        const auto musicFolder = purefs::dir::getCurrentOSPath() / "assets/audio/alarm";
+        auto musicFiles        = tags::SoundsCatalog::getInstance().getSounds(musicFolder);
         LOG_INFO("Total number of music files found: %u", static_cast<unsigned int>(musicFiles.size()));
         return musicFiles;
     }
@@ -112,9 +112,12 @@ namespace gui
         }
         grid.x = style::design::tile_w;
         grid.y = style::design::tile_h;
+        setDeferredLayout(true);
         for (auto &tile : tiles) {
             addWidget(tile);
         }
+        // single layout pass for all the tiles, later changes are laid out at once
+        setDeferredLayout(false);
     }
 
     void MenuPage::setFirstTimeSelection()
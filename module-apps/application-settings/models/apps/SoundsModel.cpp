@@ -9,7 +9,7 @@
 #include <ListView.hpp>
 #include <purefs/filesystem_paths.hpp>
 #include <service-audio/AudioServiceAPI.hpp>
-#include <tags_fetcher/TagsFetcher.hpp>
+#include <tags_fetcher/SoundsCatalog.hpp>
 
 SoundsModel::SoundsModel(std::shared_ptr<AbstractSoundsPlayer> soundsPlayer) : soundsPlayer{std::move(soundsPlayer)}
 {}
@@ -43,24 +43,8 @@ void SoundsModel::createData(app::ApplicationCommon *app, audio_settings::Abstra
     // configure according to type
     std::filesystem::path folder = getSoundPath(model);
 
-    // iterate through selected folder and collect all sounds names
-    std::vector<std::filesystem::path> sounds;
-    if (std::filesystem::is_directory(folder)) {
-        LOG_INFO("Scanning sound folder: %s", folder.c_str());
-        for (const auto &entry : std::filesystem::directory_iterator(folder)) {
-            if (std::filesystem::is_directory(entry)) {
-                continue;
-            }
-
-            const auto &filePath = entry.path();
-            if (filePath.extension() == ".mp3")
-                sounds.push_back(filePath);
-        }
-        LOG_INFO("Found %d sounds in folder %s", static_cast<int>(sounds.size()), folder.c_str());
-    }
-    else {
-        LOG_ERROR("Cannot find directory: %s", folder.c_str());
-    }
+    const auto sounds = tags::SoundsCatalog::getInstance().getSounds(folder);
+    LOG_INFO("Found %d sounds in folder %s", static_cast<int>(sounds.size()), folder.c_str());
 
     applyItems(sounds, app, model);
 }
@@ -89,7 +73,7 @@ std::filesystem::path SoundsModel::getSoundPath(audio_settings::AbstractAudioSet
     }
 }
 
-void SoundsModel::applyItems(const std::vector<std::filesystem::path> &sounds,
+void SoundsModel::applyItems(const std::vector<tags::fetcher::Tags> &sounds,
                              app::ApplicationCommon *app,
                              audio_settings::AbstractAudioSettingsModel *model)
 {
@@ -97,7 +81,8 @@ void SoundsModel::applyItems(const std::vector<std::filesystem::path> &sounds,
     auto selectedItemIndex = 0;
 
     std::string selectedSound = purefs::dir::getCurrentOSPath() / model->getSound();
-    for (const auto &sound : sounds) {
+    for (const auto &soundTags : sounds) {
+        const std::filesystem::path sound{soundTags.filePath};
 
         bool isSelected = false;
         if (sound == selectedSound) {
@@ -105,10 +90,7 @@ void SoundsModel::applyItems(const std::vector<std::filesystem::path> &sounds,
             selectedItemIndex = currentItemIndex;
         }
 
-        std::string itemTitle;
-        auto fileTags = tags::fetcher::fetchTags(sound);
-        itemTitle     = fileTags.title;
-
+        std::string itemTitle = soundTags.title;
         if (itemTitle.empty()) {
             itemTitle = sound.filename();
         }
@@ -10,6 +10,7 @@
 #include <Audio/decoder/Decoder.hpp>
 #include <InternalModel.hpp>
 #include <Application.hpp>
+#include <tags_fetcher/TagsFetcher.hpp>
 
 /// Simple SoundsModel
 class SoundsModel : public app::InternalModel<gui::ListItem *>, public AbstractSoundsModel
@@ -39,10 +40,10 @@ class SoundsModel : public app::InternalModel<gui::ListItem *>, public AbstractS
     [[nodiscard]] std::filesystem::path getSoundPath(audio_settings::AbstractAudioSettingsModel *model);
 
     /// Apply the items to internal model
-    /// @param sounds collection of sound paths
+    /// @param sounds collection of sounds from the sounds catalog
     /// @param app pointer to current application
     /// @param model audio settings model
-    void applyItems(const std::vector<std::filesystem::path> &sounds,
+    void applyItems(const std::vector<tags::fetcher::Tags> &sounds,
                     app::ApplicationCommon *app,
                     audio_settings::AbstractAudioSettingsModel *model);
 
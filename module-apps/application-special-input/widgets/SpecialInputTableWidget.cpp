@@ -28,10 +28,13 @@ namespace gui
                              specialCharacterTableWidget::window_grid_h,
                              {specialCharacterTableWidget::char_grid_w, specialCharacterTableWidget::char_grid_h});
 
+        box->setDeferredLayout(true);
         for (auto &carrier : carrier) {
             box->addWidget(carrier.item);
             decorateActionActivated(carrier.item, carrier.val);
         }
+        // single layout pass for all the characters, later changes are laid out at once
+        box->setDeferredLayout(false);
         addWidget(box);
         inputCallback = [&](gui::Item &item, const gui::InputEvent &event) {
             if (!event.isShortRelease()) {
@@ -114,11 +114,11 @@ namespace gui
         setMinimumHeight(rectAxisLengthFrom(numberOfRectangles));
         createRectangles();
 
+        setDeferredLayout(true);
         for (auto rect : rectangles) {
             addWidget(rect);
         }
-
-        resizeItems();
+        setDeferredLayout(false);
     }
 
     void VBarGraph::applyBarStyle(BarGraphStyle graphStyle)
@@ -160,11 +160,11 @@ namespace gui
         setMinimumWidth(rectAxisLengthFrom(numberOfRectangles));
         createRectangles();
 
+        setDeferredLayout(true);
         for (auto rect : rectangles) {
             addWidget(rect);
         }
-
-        resizeItems();
+        setDeferredLayout(false);
     }
 
     void HBarGraph::applyBarStyle(BarGraphStyle graphStyle)
@@ -0,0 +1,157 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "SoundsCatalog.hpp"
+
+#include <json11.hpp>
+#include <log/log.hpp>
+#include <Utils.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace tags
+{
+    namespace fs = std::filesystem;
+
+    namespace
+    {
+        constexpr auto allowedExtensions = {".wav", ".mp3", ".flac"};
+        constexpr auto catalogVersion    = 1;
+
+        std::string normalize(const fs::path &path)
+        {
+            auto normal = path.lexically_normal();
+            if (!normal.has_filename() && normal.has_parent_path()) {
+                normal = normal.parent_path();
+            }
+            return normal.string();
+        }
+
+        bool isSound(const fs::path &path)
+        {
+            return std::any_of(allowedExtensions.begin(), allowedExtensions.end(), [&path](const auto &ext) {
+                return path.extension() == ext;
+            });
+        }
+
+        fetcher::Tags createTags(const json11::Json &entry, const std::string &filePath)
+        {
+            const auto total_duration_s = static_cast<uint32_t>(entry["duration"].int_value());
+            const auto duration_min     = total_duration_s / utils::secondsInMinute;
+            return fetcher::Tags{total_duration_s,
+                                 duration_min / utils::secondsInMinute,
+                                 duration_min,
+                                 total_duration_s % utils::secondsInMinute,
+                                 static_cast<uint32_t>(entry["sample_rate"].int_value()),
+                                 static_cast<uint32_t>(entry["channels"].int_value()),
+                                 static_cast<uint32_t>(entry["bitrate"].int_value()),
+                                 entry["artist"].string_value(),
+                                 {},
+                                 entry["title"].string_value(),
+                                 entry["album"].string_value(),
+                                 0,
+                                 filePath,
+                                 {},
+                                 0};
+        }
+    } // namespace
+
+    SoundsCatalog &SoundsCatalog::getInstance()
+    {
+        static SoundsCatalog instance;
+        return instance;
+    }
+
+    bool SoundsCatalog::init(const fs::path &rootDirectory)
+    {
+        const auto catalogPath = rootDirectory / catalogFile;
+        std::ifstream file(catalogPath);
+        if (!file.is_open()) {
+            LOG_WARN("No sounds catalog: %s, sounds will be scanned on demand", catalogPath.c_str());
+            return false;
+        }
+        std::stringstream content;
+        content << file.rdbuf();
+
+        std::string err;
+        const auto catalog = json11::Json::parse(content.str(), err);
+        if (!err.empty() || catalog["version"].int_value() != catalogVersion) {
+            LOG_ERROR("Invalid sounds catalog: %s", catalogPath.c_str());
+            return false;
+        }
+
+        cpp_freertos::LockGuard lock(mutex);
+        for (const auto &entry : catalog["sounds"].array_items()) {
+            const auto filePath = normalize(rootDirectory / entry["path"].string_value());
+            sounds.insert_or_assign(filePath, createTags(entry, filePath));
+            directories.insert(fs::path(filePath).parent_path().string());
+        }
+        LOG_INFO("Sounds catalog loaded: %u sounds", static_cast<unsigned>(sounds.size()));
+        return true;
+    }
+
+    std::vector<fetcher::Tags> SoundsCatalog::getSounds(const fs::path &directory)
+    {
+        const auto dir = normalize(directory);
+        cpp_freertos::LockGuard lock(mutex);
+        if (directories.find(dir) == directories.end()) {
+            scanDirectory(dir);
+        }
+
+        std::vector<fetcher::Tags> ret;
+        const auto prefix = dir + "/";
+        for (auto it = sounds.lower_bound(prefix); it != sounds.end(); ++it) {
+            if (it->first.compare(0, prefix.size(), prefix) != 0) {
+                break;
+            }
+            // Skip sounds from subdirectories
+            if (it->first.find('/', prefix.size()) == std::string::npos) {
+                ret.push_back(it->second);
+            }
+        }
+        return ret;
+    }
+
+    std::optional<fetcher::Tags> SoundsCatalog::getSound(const fs::path &filePath)
+    {
+        const auto path = normalize(filePath);
+        cpp_freertos::LockGuard lock(mutex);
+        if (const auto it = sounds.find(path); it != sounds.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    void SoundsCatalog::update(const fetcher::Tags &tags)
+    {
+        const auto path = normalize(tags.filePath);
+        cpp_freertos::LockGuard lock(mutex);
+        sounds.insert_or_assign(path, tags);
+    }
+
+    void SoundsCatalog::remove(const fs::path &filePath)
+    {
+        const auto path = normalize(filePath);
+        cpp_freertos::LockGuard lock(mutex);
+        sounds.erase(path);
+    }
+
+    void SoundsCatalog::scanDirectory(const std::string &directory)
+    {
+        LOG_INFO("Sound directory not in the catalog, scanning: %s", directory.c_str());
+        std::error_code ec;
+        for (const auto &entry : fs::directory_iterator(directory, ec)) {
+            if (entry.is_regular_file(ec) && isSound(entry.path())) {
+                auto tags = fetcher::fetchTags(normalize(entry.path()));
+                sounds.insert_or_assign(tags.filePath, std::move(tags));
+            }
+        }
+        if (ec) {
+            LOG_ERROR("Unable to scan %s: %s", directory.c_str(), ec.message().c_str());
+            return;
+        }
+        directories.insert(directory);
+    }
+} // namespace tags
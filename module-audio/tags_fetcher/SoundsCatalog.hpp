@@ -0,0 +1,53 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "TagsFetcher.hpp"
+
+#include <mutex.hpp>
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace tags
+{
+    /// In-memory catalog of the sounds shown by the sound pickers.
+    /// System sounds are loaded from the catalog generated at build time (tools/generate_sounds_catalog.py),
+    /// user sounds are kept up to date by the file indexer. Directories missing from the catalog are scanned
+    /// with the tags fetcher once, on the first request.
+    class SoundsCatalog
+    {
+      public:
+        static constexpr auto catalogFile = "assets/audio/catalog.json";
+
+        SoundsCatalog(const SoundsCatalog &) = delete;
+        void operator=(const SoundsCatalog &) = delete;
+
+        static SoundsCatalog &getInstance();
+
+        /// Load the build time catalog, its paths are relative to the rootDirectory
+        bool init(const std::filesystem::path &rootDirectory);
+
+        /// Sounds placed directly in the directory, sorted by the file path
+        std::vector<fetcher::Tags> getSounds(const std::filesystem::path &directory);
+        std::optional<fetcher::Tags> getSound(const std::filesystem::path &filePath);
+
+        void update(const fetcher::Tags &tags);
+        void remove(const std::filesystem::path &filePath);
+
+      private:
+        SoundsCatalog() = default;
+
+        void scanDirectory(const std::string &directory);
+
+        std::map<std::string, fetcher::Tags> sounds;
+        /// Directories with the whole content present in the catalog
+        std::set<std::string> directories;
+        cpp_freertos::MutexStandard mutex;
+    };
+} // namespace tags
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+Output format of the sounds catalog read by tags::SoundsCatalog.
+
+e.g.: python3 -m unittest test_generate_sounds_catalog
+"""
+
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+
+TESTS_DIR = os.path.dirname(os.path.abspath(__file__))
+GENERATOR = os.path.join(TESTS_DIR, "../../../tools/generate_sounds_catalog.py")
+TEST_FILES = os.path.join(TESTS_DIR, "../../Audio/test/testfiles")
+ENTRY_KEYS = ["path", "title", "artist", "album", "duration", "sample_rate", "channels", "bitrate"]
+
+
+class TestGenerateSoundsCatalog(unittest.TestCase):
+    def setUp(self):
+        self.root = tempfile.mkdtemp()
+        self.sounds_dir = os.path.join(self.root, "assets", "audio")
+        for subdir in ("ringtone", os.path.join("ringtone", "classic")):
+            os.makedirs(os.path.join(self.sounds_dir, subdir))
+        for name in ("audio.wav", "audio.mp3", "audio.flac"):
+            shutil.copy(os.path.join(TEST_FILES, name), os.path.join(self.sounds_dir, "ringtone", name))
+        shutil.copy(os.path.join(TEST_FILES, "audio.wav"), os.path.join(self.sounds_dir, "ringtone", "classic"))
+        with open(os.path.join(self.sounds_dir, "ringtone", "readme.txt"), "w") as f:
+            f.write("not a sound")
+
+    def tearDown(self):
+        shutil.rmtree(self.root)
+
+    def generate(self, *args):
+        subprocess.run([sys.executable, GENERATOR, "--root", self.root] + list(args), check=True,
+                       stdout=subprocess.DEVNULL)
+
+    def read_catalog(self, path):
+        with open(path, encoding="utf-8") as f:
+            return json.load(f)
+
+    def test_catalog(self):
+        self.generate()
+        catalog = self.read_catalog(os.path.join(self.sounds_dir, "catalog.json"))
+
+        self.assertEqual(catalog["version"], 1)
+        self.assertEqual([sound["path"] for sound in catalog["sounds"]],
+                         ["assets/audio/ringtone/audio.flac",
+                          "assets/audio/ringtone/audio.mp3",
+                          "assets/audio/ringtone/audio.wav",
+                          "assets/audio/ringtone/classic/audio.wav"])
+        for sound in catalog["sounds"]:
+            self.assertEqual(list(sound.keys()), ENTRY_KEYS)
+            for key in ("duration", "sample_rate", "channels", "bitrate"):
+                self.assertIsInstance(sound[key], int)
+
+    def test_tags(self):
+        self.generate()
+        sounds = {sound["path"]: sound for sound in
+                  self.read_catalog(os.path.join(self.sounds_dir, "catalog.json"))["sounds"]}
+
+        mp3 = sounds["assets/audio/ringtone/audio.mp3"]
+        self.assertEqual(mp3["title"], "mp3 Test track title - łąki")
+        self.assertEqual(mp3["artist"], "mp3 Test artist name - łąki")
+        self.assertEqual(mp3["album"], "mp3 Test album title - łąki")
+        self.assertEqual((mp3["sample_rate"], mp3["channels"], mp3["bitrate"]), (44100, 1, 128))
+
+        flac = sounds["assets/audio/ringtone/audio.flac"]
+        self.assertEqual(flac["title"], "flac Test track title - łąki")
+        self.assertEqual((flac["sample_rate"], flac["channels"]), (44100, 1))
+
+        # no tags, the title falls back to the file name like on the device
+        wav = sounds["assets/audio/ringtone/audio.wav"]
+        self.assertEqual((wav["title"], wav["artist"], wav["album"]), ("audio.wav", "", ""))
+        self.assertEqual((wav["sample_rate"], wav["channels"], wav["bitrate"]), (44100, 1, 705))
+
+    def test_output(self):
+        output = os.path.join(self.root, "catalog.json")
+        self.generate("--dir", "assets/audio/ringtone/classic", "--output", output)
+        catalog = self.read_catalog(output)
+        self.assertEqual([sound["path"] for sound in catalog["sounds"]], ["assets/audio/ringtone/classic/audio.wav"])
+        self.assertFalse(os.path.exists(os.path.join(self.sounds_dir, "catalog.json")))
+
+    def test_no_sounds_directory(self):
+        self.generate("--dir", "assets/missing")
+        self.assertFalse(os.path.exists(os.path.join(self.root, "assets", "missing", "catalog.json")))
+
+
+if __name__ == "__main__":
+    unittest.main()
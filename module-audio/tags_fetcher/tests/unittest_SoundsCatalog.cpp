@@ -0,0 +1,203 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <SoundsCatalog.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // the same format as written by tools/generate_sounds_catalog.py
+    constexpr auto generatedCatalog = R"({
+ "version": 1,
+ "sounds": [
+  {
+   "path": "assets/audio/ringtone/ringtone_b.wav",
+   "title": "ringtone_b.wav",
+   "artist": "",
+   "album": "",
+   "duration": 3,
+   "sample_rate": 44100,
+   "channels": 1,
+   "bitrate": 705
+  },
+  {
+   "path": "assets/audio/ringtone/ringtone_a.mp3",
+   "title": "Ringtone A",
+   "artist": "Mudita",
+   "album": "Sounds",
+   "duration": 3725,
+   "sample_rate": 48000,
+   "channels": 2,
+   "bitrate": 128
+  },
+  {
+   "path": "assets/audio/ringtone/classic/ringtone_c.flac",
+   "title": "Ringtone C",
+   "artist": "",
+   "album": "",
+   "duration": 10,
+   "sample_rate": 44100,
+   "channels": 2,
+   "bitrate": 900
+  }
+ ]
+})";
+
+    /// Every run gets its own root, the catalog is a singleton and keeps the sounds of the previous runs
+    fs::path createRoot()
+    {
+        static auto run = 0;
+        const auto root = fs::temp_directory_path() / ("sounds_catalog_test_" + std::to_string(run++));
+        fs::remove_all(root);
+        fs::create_directories(root / "assets/audio");
+        return root;
+    }
+
+    void writeFile(const fs::path &path, const std::string &content)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path);
+        file << content;
+    }
+
+    std::vector<std::string> filePaths(const std::vector<tags::fetcher::Tags> &sounds)
+    {
+        std::vector<std::string> paths;
+        std::transform(sounds.begin(), sounds.end(), std::back_inserter(paths), [](const auto &tags) {
+            return tags.filePath;
+        });
+        return paths;
+    }
+} // namespace
+
+TEST_CASE("Sounds catalog")
+{
+    auto &catalog    = tags::SoundsCatalog::getInstance();
+    const auto root  = createRoot();
+    const auto sound = [&root](const std::string &path) { return (root / path).string(); };
+
+    SECTION("No catalog")
+    {
+        REQUIRE_FALSE(catalog.init(root));
+    }
+
+    SECTION("Unsupported catalog version")
+    {
+        writeFile(root / tags::SoundsCatalog::catalogFile, R"({"version": 2, "sounds": []})");
+        REQUIRE_FALSE(catalog.init(root));
+    }
+
+    SECTION("Invalid catalog")
+    {
+        writeFile(root / tags::SoundsCatalog::catalogFile, "{\"version\": 1, \"sounds\": [");
+        REQUIRE_FALSE(catalog.init(root));
+    }
+
+    SECTION("Generated catalog")
+    {
+        writeFile(root / tags::SoundsCatalog::catalogFile, generatedCatalog);
+        REQUIRE(catalog.init(root));
+
+        SECTION("Sounds of the directory")
+        {
+            const auto sounds = catalog.getSounds(root / "assets/audio/ringtone");
+            REQUIRE(filePaths(sounds) == std::vector<std::string>{sound("assets/audio/ringtone/ringtone_a.mp3"),
+                                                                  sound("assets/audio/ringtone/ringtone_b.wav")});
+            REQUIRE(filePaths(catalog.getSounds(root / "assets/audio/ringtone/")) == filePaths(sounds));
+
+            const auto &tags = sounds.front();
+            REQUIRE(tags.title == "Ringtone A");
+            REQUIRE(tags.artist == "Mudita");
+            REQUIRE(tags.album == "Sounds");
+            REQUIRE(tags.total_duration_s == 3725);
+            REQUIRE(tags.duration_hour == 1);
+            REQUIRE(tags.duration_min == 62);
+            REQUIRE(tags.duration_sec == 5);
+            REQUIRE(tags.sample_rate == 48000);
+            REQUIRE(tags.num_channel == 2);
+            REQUIRE(tags.bitrate == 128);
+        }
+
+        SECTION("Sounds of the subdirectory")
+        {
+            const auto sounds = catalog.getSounds(root / "assets/audio/ringtone/classic");
+            REQUIRE(filePaths(sounds) ==
+                    std::vector<std::string>{sound("assets/audio/ringtone/classic/ringtone_c.flac")});
+        }
+
+        SECTION("Single sound")
+        {
+            const auto tags = catalog.getSound(root / "assets/audio/ringtone/../ringtone/ringtone_b.wav");
+            REQUIRE(tags.has_value());
+            REQUIRE(tags->filePath == sound("assets/audio/ringtone/ringtone_b.wav"));
+            REQUIRE(tags->title == "ringtone_b.wav");
+            REQUIRE(tags->bitrate == 705);
+            REQUIRE_FALSE(catalog.getSound(root / "assets/audio/ringtone/missing.wav").has_value());
+        }
+
+        SECTION("Update")
+        {
+            auto tags  = *catalog.getSound(root / "assets/audio/ringtone/ringtone_b.wav");
+            tags.title = "Ringtone B";
+            catalog.update(tags);
+            catalog.update(tags::fetcher::Tags{sound("assets/audio/ringtone/ringtone_0.wav")});
+
+            const auto sounds = catalog.getSounds(root / "assets/audio/ringtone");
+            REQUIRE(filePaths(sounds) == std::vector<std::string>{sound("assets/audio/ringtone/ringtone_0.wav"),
+                                                                  sound("assets/audio/ringtone/ringtone_a.mp3"),
+                                                                  sound("assets/audio/ringtone/ringtone_b.wav")});
+            REQUIRE(sounds.back().title == "Ringtone B");
+        }
+
+        SECTION("Remove")
+        {
+            catalog.remove(root / "assets/audio/ringtone/ringtone_a.mp3");
+            catalog.remove(root / "assets/audio/ringtone/missing.wav");
+
+            REQUIRE(filePaths(catalog.getSounds(root / "assets/audio/ringtone")) ==
+                    std::vector<std::string>{sound("assets/audio/ringtone/ringtone_b.wav")});
+            REQUIRE_FALSE(catalog.getSound(root / "assets/audio/ringtone/ringtone_a.mp3").has_value());
+        }
+    }
+
+    SECTION("Directory missing from the catalog")
+    {
+        writeFile(root / tags::SoundsCatalog::catalogFile, generatedCatalog);
+        writeFile(root / "assets/audio/alarm/alarm_a.wav", "not really a sound");
+        writeFile(root / "assets/audio/alarm/alarm_b.mp3", "not really a sound");
+        writeFile(root / "assets/audio/alarm/readme.txt", "not a sound");
+        REQUIRE(catalog.init(root));
+
+        const auto alarms = std::vector<std::string>{sound("assets/audio/alarm/alarm_a.wav"),
+                                                     sound("assets/audio/alarm/alarm_b.mp3")};
+        REQUIRE(filePaths(catalog.getSounds(root / "assets/audio/alarm")) == alarms);
+
+        SECTION("Scanned once")
+        {
+            // later changes come from the file indexer only
+            writeFile(root / "assets/audio/alarm/alarm_c.flac", "not really a sound");
+            REQUIRE(filePaths(catalog.getSounds(root / "assets/audio/alarm")) == alarms);
+        }
+
+        SECTION("Changes of the scanned directory")
+        {
+            catalog.remove(root / "assets/audio/alarm/alarm_a.wav");
+            catalog.update(tags::fetcher::Tags{sound("assets/audio/alarm/alarm_c.flac")});
+            REQUIRE(filePaths(catalog.getSounds(root / "assets/audio/alarm")) ==
+                    std::vector<std::string>{sound("assets/audio/alarm/alarm_b.mp3"),
+                                             sound("assets/audio/alarm/alarm_c.flac")});
+        }
+    }
+
+    fs::remove_all(root);
+}
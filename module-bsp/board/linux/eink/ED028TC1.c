@@ -146,10 +146,22 @@ EinkStatus_e EinkDitherDisplay()
 EinkStatus_e EinkUpdateFrame(
     uint16_t X, uint16_t Y, uint16_t W, uint16_t H, uint8_t *buffer, EinkBpp_e bpp, EinkDisplayColorMode_e invertColors)
 {
+    // Levels the display ends up with when the frame is transferred with 1 or 2 bits per pixel
+    static const uint8_t levelLut_1Bpp[16] = {0, 0, 0, 0, 0, 0, 0, 0, 15, 15, 15, 15, 15, 15, 15, 15};
+    static const uint8_t levelLut_2Bpp[16] = {0, 0, 0, 0, 5, 5, 5, 5, 10, 10, 10, 10, 15, 15, 15, 15};
+    const uint8_t *levelLut                = bpp == Eink1Bpp ? levelLut_1Bpp : levelLut_2Bpp;
+
     uint32_t offset_eink   = Y * BOARD_EINK_DISPLAY_RES_X + X;
     uint32_t offset_buffer = 0;
     for (uint32_t h = 0; h < H; ++h) {
-        memcpy(shared_buffer + offset_eink, buffer + offset_buffer, W);
+        if (bpp == Eink1Bpp || bpp == Eink2Bpp) {
+            for (uint32_t w = 0; w < W; ++w) {
+                shared_buffer[offset_eink + w] = levelLut[buffer[offset_buffer + w] & 0x0F];
+            }
+        }
+        else {
+            memcpy(shared_buffer + offset_eink, buffer + offset_buffer, W);
+        }
         offset_eink += BOARD_EINK_DISPLAY_RES_X;
         offset_buffer += W;
     }
@@ -108,6 +108,11 @@ static uint8_t s_einkMaskLut_1Bpp[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1,
  */
 static uint8_t s_einkMaskLut_2Bpp[16] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3};
 
+/**
+ * @brief This lut is used for convertion of the 4bp input grayscale pixel to the black or white 2bpp output pixel
+ */
+static uint8_t s_einkBinarizationLut_2Bpp[16] = {0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 3, 3, 3, 3, 3, 3};
+
 /* External variable definitions */
 
 /* Internal function prototypes */
@@ -510,6 +515,24 @@ static uint8_t *s_EinkTransformFrameCoordinateSystemNoRotation_4Bpp(uint8_t *dat
                                                                     uint8_t *dataOut,
                                                                     EinkDisplayColorMode_e invertColors);
 
+/*
+ * Not rotating versions of s_EinkTransformFrameCoordinateSystem_1Bpp and s_EinkTransformFrameCoordinateSystem_2Bpp.
+ * They keep the pixel order of s_EinkTransformFrameCoordinateSystemNoRotation_4Bpp.
+ * The 2Bpp one converts the pixels with the given LUT, so it can also binarize the image.
+ */
+static uint8_t *s_EinkTransformFrameCoordinateSystemNoRotation_1Bpp(uint8_t *dataIn,
+                                                                    uint16_t windowWidthPx,
+                                                                    uint16_t windowHeightPx,
+                                                                    uint8_t *dataOut,
+                                                                    EinkDisplayColorMode_e invertColors);
+
+static uint8_t *s_EinkTransformFrameCoordinateSystemNoRotation_2Bpp(uint8_t *dataIn,
+                                                                    uint16_t windowWidthPx,
+                                                                    uint16_t windowHeightPx,
+                                                                    uint8_t *dataOut,
+                                                                    EinkDisplayColorMode_e invertColors,
+                                                                    const uint8_t *lut);
+
 /* Function bodies */
 
 void EinkChangeDisplayUpdateTimings(EinkDisplayTimingsMode_e timingsMode)
@@ -825,13 +848,24 @@ EinkStatus_e EinkUpdateFrame(
     s_einkServiceRotatedBuf[0] = EinkDataStartTransmission1;
     s_einkServiceRotatedBuf[1] = bpp - 1; //  0 - 1Bpp, 1 - 2Bpp, 2 - 3Bpp, 3 - 4Bpp
 
-    if ((s_einkConfiguredWaveform == EinkWaveformA2) || (s_einkConfiguredWaveform == EinkWaveformDU2)) {
+    // A2 can't drive the halftones, so the image is binarized for it. DU2 keeps them if the bit depth allows
+    if (s_einkConfiguredWaveform == EinkWaveformA2) {
         switch (bpp) {
         case Eink1Bpp: {
+#if defined(EINK_ROTATE_90_CLOCKWISE)
             s_EinkTransformAnimationFrameCoordinateSystem_1Bpp(buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors);
+#else
+            s_EinkTransformFrameCoordinateSystemNoRotation_1Bpp(
+                buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors);
+#endif
         } break;
         case Eink2Bpp: {
+#if defined(EINK_ROTATE_90_CLOCKWISE)
             s_EinkTransformAnimationFrameCoordinateSystem_2Bpp(buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors);
+#else
+            s_EinkTransformFrameCoordinateSystemNoRotation_2Bpp(
+                buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors, s_einkBinarizationLut_2Bpp);
+#endif
         } break;
         case Eink3Bpp: {
             s_EinkTransformAnimationFrameCoordinateSystem_3Bpp(buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors);
@@ -849,10 +883,20 @@ EinkStatus_e EinkUpdateFrame(
     else {
         switch (bpp) {
         case Eink1Bpp: {
+#if defined(EINK_ROTATE_90_CLOCKWISE)
             s_EinkTransformFrameCoordinateSystem_1Bpp(buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors);
+#else
+            s_EinkTransformFrameCoordinateSystemNoRotation_1Bpp(
+                buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors);
+#endif
         } break;
         case Eink2Bpp: {
+#if defined(EINK_ROTATE_90_CLOCKWISE)
             s_EinkTransformFrameCoordinateSystem_2Bpp(buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors);
+#else
+            s_EinkTransformFrameCoordinateSystemNoRotation_2Bpp(
+                buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors, s_einkMaskLut_2Bpp);
+#endif
         } break;
         case Eink3Bpp: {
             s_EinkTransformFrameCoordinateSystem_3Bpp(buffer, W, H, s_einkServiceRotatedBuf + 2, invertColors);
@@ -1338,3 +1382,81 @@ __attribute__((optimize("O1"))) static uint8_t *s_EinkTransformFrameCoordinateSy
 
     return dataOut;
 }
+
+__attribute__((optimize("O1"))) static uint8_t *s_EinkTransformFrameCoordinateSystemNoRotation_1Bpp(
+    uint8_t *dataIn,
+    uint16_t windowWidthPx,
+    uint16_t windowHeightPx,
+    uint8_t *dataOut,
+    EinkDisplayColorMode_e invertColors)
+{
+    // In 1bpp mode there are 8 pixels in the byte
+    const uint8_t pixelsInByte = 8;
+
+    uint8_t pixels    = 0;
+    uint8_t *outArray = dataOut;
+    int32_t inputRow  = 0;
+    int32_t inputCol  = 0;
+
+    for (inputRow = 0; inputRow < windowHeightPx - 1; ++inputRow) {
+        for (inputCol = windowWidthPx - 7; inputCol >= 0; inputCol -= pixelsInByte) {
+            uint32_t index = inputRow * BOARD_EINK_DISPLAY_RES_X + inputCol;
+
+            // Use the LUT to convert the input pixel from 4bpp to 1bpp. Pixel order the same as in the 4bpp version
+            pixels = (s_einkMaskLut_1Bpp[dataIn[index + 7]] << 7) | (s_einkMaskLut_1Bpp[dataIn[index + 6]] << 6) |
+                     (s_einkMaskLut_1Bpp[dataIn[index + 5]] << 5) | (s_einkMaskLut_1Bpp[dataIn[index + 4]] << 4) |
+                     (s_einkMaskLut_1Bpp[dataIn[index + 3]] << 3) | (s_einkMaskLut_1Bpp[dataIn[index + 2]] << 2) |
+                     (s_einkMaskLut_1Bpp[dataIn[index + 1]] << 1) | (s_einkMaskLut_1Bpp[dataIn[index + 0]] << 0);
+
+            if (invertColors) {
+                pixels = ~pixels;
+            }
+
+            *outArray = pixels;
+            ++outArray;
+        }
+    }
+
+    return dataOut;
+}
+
+__attribute__((optimize("O1"))) static uint8_t *s_EinkTransformFrameCoordinateSystemNoRotation_2Bpp(
+    uint8_t *dataIn,
+    uint16_t windowWidthPx,
+    uint16_t windowHeightPx,
+    uint8_t *dataOut,
+    EinkDisplayColorMode_e invertColors,
+    const uint8_t *lut)
+{
+    // In 2bpp mode there are 4 pixels in the byte. Using 8 pixels at a time for better performance
+    const uint8_t pixelsInByte = 8;
+
+    uint16_t pixels    = 0;
+    uint16_t *outArray = (uint16_t *)dataOut;
+    int32_t inputRow   = 0;
+    int32_t inputCol   = 0;
+
+    for (inputRow = 0; inputRow < windowHeightPx - 1; ++inputRow) {
+        for (inputCol = windowWidthPx - 7; inputCol >= 0; inputCol -= pixelsInByte) {
+            uint32_t index = inputRow * BOARD_EINK_DISPLAY_RES_X + inputCol;
+
+            // Use the LUT to convert the input pixel from 4bpp to 2bpp. Pixel order the same as in the 4bpp version
+            uint8_t firstPixels = (lut[dataIn[index + 7]] << 6) | (lut[dataIn[index + 6]] << 4) |
+                                  (lut[dataIn[index + 5]] << 2) | (lut[dataIn[index + 4]] << 0);
+            uint8_t secondPixels = (lut[dataIn[index + 3]] << 6) | (lut[dataIn[index + 2]] << 4) |
+                                   (lut[dataIn[index + 1]] << 2) | (lut[dataIn[index + 0]] << 0);
+
+            // Push the 8 pixels into the proper place in the uint16_t
+            pixels = firstPixels | (secondPixels << 8);
+
+            if (invertColors) {
+                pixels = ~pixels;
+            }
+
+            *outArray = pixels;
+            ++outArray;
+        }
+    }
+
+    return dataOut;
+}
@@ -93,6 +93,7 @@ namespace at
         DISABLE_TIME_ZONE_REPORTING,
         ENABLE_NETWORK_REGISTRATION_URC,
         SET_SMS_TEXT_MODE_UCS2,
+        SET_SMS_TEXT_MODE_GSM,
         CFUN_RESET,
         CFUN_MIN_FUNCTIONALITY,    /// Set minimum functionality
         CFUN_FULL_FUNCTIONALITY,   /// Full functionality
@@ -30,6 +30,7 @@ namespace at
             RECEIVING_NOT_STARTED,    /// at dma not starting requested receiving
             DATA_NOT_USED,            /// at received data not being used
             CMUX_FRAME_ERROR,         /// at cmux deserialize error
+            CANCELLED,                /// at command removed from the queue before it was sent
         } code = Code::UNDEFINED;
 
         Result() = default;
@@ -812,5 +812,33 @@ namespace at
             }
 
         } // namespace ccwa
+
+        namespace cmgl
+        {
+            auto parseIndexes(const std::vector<std::string> &data, std::vector<std::string> &indexes) -> bool
+            {
+                constexpr std::string_view header = "+CMGL: ";
+                indexes.clear();
+
+                for (auto line = data.begin(); line != data.end(); ++line) {
+                    const std::string_view view{*line};
+                    if (view.substr(0, header.size()) != header) {
+                        continue;
+                    }
+                    const auto index = view.substr(header.size(), view.find(',') - header.size());
+                    if (index.empty() || index.find_first_not_of("0123456789") != std::string_view::npos) {
+                        indexes.clear();
+                        return false;
+                    }
+                    indexes.emplace_back(index);
+
+                    // message text follows the header
+                    if (std::next(line) != data.end()) {
+                        ++line;
+                    }
+                }
+                return true;
+            }
+        } // namespace cmgl
     }     // namespace response
 } // namespace at
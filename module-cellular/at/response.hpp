@@ -454,5 +454,14 @@ namespace at
             auto getClass(const ServiceClass &serviceClass) noexcept
                 -> app::manager::actions::IMMICustomResultParams::MMIResultMessage;
         } // namespace ccwa
+
+        namespace cmgl
+        {
+            /// Takes message storage indexes from the text mode listing:
+            ///     +CMGL: <index>,<stat>,<oa>,[<alpha>],[<scts>]
+            ///     <data>
+            /// Message texts are skipped without copying, even if they look like a header
+            auto parseIndexes(const std::vector<std::string> &data, std::vector<std::string> &indexes) -> bool;
+        } // namespace cmgl
     }     // namespace response
 } // namespace at
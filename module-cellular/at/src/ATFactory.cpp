@@ -84,6 +84,7 @@ namespace at
         {AT::DISABLE_TIME_ZONE_REPORTING, {"AT+CTZR=0"}},
         {AT::ENABLE_NETWORK_REGISTRATION_URC, {"AT+CREG=2"}},
         {AT::SET_SMS_TEXT_MODE_UCS2, {"AT+CSMP=17,167,0,8"}},
+        {AT::SET_SMS_TEXT_MODE_GSM, {"AT+CSMP=17,167,0,0"}},
         {AT::LIST_MESSAGES, {"AT+CMGL=\"ALL\""}},
         {AT::GET_IMEI, {"AT+GSN"}},
         {AT::CCFC, {"AT+CCFC="}},
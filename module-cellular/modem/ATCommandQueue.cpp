@@ -0,0 +1,80 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "ATCommandQueue.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace at
+{
+    auto CommandQueue::push(Cmd cmd, Callback callback, Priority priority) -> Id
+    {
+        cpp_freertos::LockGuard lock(mutex);
+        const auto id = nextId++;
+        entries[static_cast<std::size_t>(priority)].push_back(Entry{id, std::move(cmd), std::move(callback), nullptr});
+        return id;
+    }
+
+    auto CommandQueue::push(Sequence sequence, Callback callback, Priority priority) -> Id
+    {
+        cpp_freertos::LockGuard lock(mutex);
+        const auto id = nextId++;
+        entries[static_cast<std::size_t>(priority)].push_back(
+            Entry{id, Cmd{""}, std::move(callback), std::move(sequence)});
+        return id;
+    }
+
+    auto CommandQueue::pop() -> std::optional<Entry>
+    {
+        cpp_freertos::LockGuard lock(mutex);
+        for (auto &queue : entries) {
+            if (!queue.empty()) {
+                auto entry = std::move(queue.front());
+                queue.pop_front();
+                return entry;
+            }
+        }
+        return std::nullopt;
+    }
+
+    auto CommandQueue::cancel(Id id) -> std::optional<Entry>
+    {
+        cpp_freertos::LockGuard lock(mutex);
+        for (auto &queue : entries) {
+            auto it = std::find_if(queue.begin(), queue.end(), [id](const auto &entry) { return entry.id == id; });
+            if (it != queue.end()) {
+                auto entry = std::move(*it);
+                queue.erase(it);
+                return entry;
+            }
+        }
+        return std::nullopt;
+    }
+
+    auto CommandQueue::clear() -> std::vector<Entry>
+    {
+        cpp_freertos::LockGuard lock(mutex);
+        std::vector<Entry> removed;
+        for (auto &queue : entries) {
+            std::move(queue.begin(), queue.end(), std::back_inserter(removed));
+            queue.clear();
+        }
+        return removed;
+    }
+
+    auto CommandQueue::size() const -> std::size_t
+    {
+        cpp_freertos::LockGuard lock(mutex);
+        std::size_t count = 0;
+        for (const auto &queue : entries) {
+            count += queue.size();
+        }
+        return count;
+    }
+
+    auto CommandQueue::empty() const -> bool
+    {
+        return size() == 0;
+    }
+} // namespace at
@@ -0,0 +1,65 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <at/Cmd.hpp>
+#include <at/Result.hpp>
+#include <mutex.hpp>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace at
+{
+    class BaseChannel;
+
+    /// Commands waiting to be sent on a single channel.
+    /// Commands are taken in priority order, commands of the same priority in the order they were queued.
+    class CommandQueue
+    {
+      public:
+        enum class Priority
+        {
+            CallControl, /// dial, answer, hang up - must not wait for anything else
+            Normal,
+            Housekeeping, /// periodic status polling, scans, bulk reads
+        };
+
+        using Id       = std::uint32_t;
+        using Callback = std::function<void(const Result &)>;
+        /// Commands depending on each other's responses, sent one after another without other commands in between
+        using Sequence = std::function<Result(BaseChannel &)>;
+
+        struct Entry
+        {
+            Id id;
+            Cmd cmd;
+            Callback callback;
+            Sequence sequence; ///< sent instead of the cmd when set
+        };
+
+        Id push(Cmd cmd, Callback callback, Priority priority = Priority::Normal);
+        Id push(Sequence sequence, Callback callback, Priority priority = Priority::Normal);
+        std::optional<Entry> pop();
+
+        /// Removes the command which wasn't sent yet
+        std::optional<Entry> cancel(Id id);
+        /// Removes all commands which weren't sent yet
+        std::vector<Entry> clear();
+
+        [[nodiscard]] auto size() const -> std::size_t;
+        [[nodiscard]] auto empty() const -> bool;
+
+      private:
+        static constexpr auto priorities = static_cast<std::size_t>(Priority::Housekeeping) + 1;
+
+        mutable cpp_freertos::MutexStandard mutex;
+        std::array<std::deque<Entry>, priorities> entries;
+        Id nextId = 0;
+    };
+} // namespace at
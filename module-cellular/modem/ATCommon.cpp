@@ -72,6 +72,7 @@ Result Channel::cmd(const std::string &cmd, std::chrono::milliseconds timeout, s
     }
     ATStream atStream(rxCount);
 
+    cpp_freertos::LockGuard lock(commandMutex);
     awaitingResponseFlag.set();
 
     cmdInit();
@@ -83,12 +84,15 @@ Result Channel::cmd(const std::string &cmd, std::chrono::milliseconds timeout, s
     auto endTime   = startTime + timeout;
 
     while (true) {
-        if (std::chrono::steady_clock::now() > endTime) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now > endTime) {
             result.code = Result::Code::TIMEOUT;
             break;
         }
 
-        if (size_t bytesRead = cmdReceive(receiveBuffer.get(), 0ms); bytesRead > 0) {
+        // block until the response arrives instead of polling, let other tasks run in the meantime
+        const auto timeLeft = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - now);
+        if (size_t bytesRead = cmdReceive(receiveBuffer.get(), timeLeft); bytesRead > 0) {
             auto cellularResult = bsp::cellular::CellularResult{receiveBuffer.get(), bytesRead};
 
             if (result = checkResult(cellularResult.getResultCode()); result.code != at::Result::Code::OK) {
@@ -57,6 +57,7 @@ namespace at
         std::unique_ptr<uint8_t[]> receiveBuffer;
         AwaitingResponseFlag awaitingResponseFlag;
         cpp_freertos::MutexStandard mutex;
+        cpp_freertos::MutexRecursive commandMutex;
 
       public:
         static const std::string OK;
@@ -85,5 +86,12 @@ namespace at
         virtual void cmdLog(std::string cmd, const Result &result, std::chrono::milliseconds timeout) final;
 
         Result checkResult(bsp::cellular::CellularResultCode cellularResult);
+
+        /// Commands can be sent from more than one task, lock it to send a sequence which can't be interleaved
+        /// (i.e. prompt and data of +CMGS)
+        auto getCommandMutex() -> cpp_freertos::MutexRecursive &
+        {
+            return commandMutex;
+        }
     };
 } // namespace at
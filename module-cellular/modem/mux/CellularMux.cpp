@@ -17,8 +17,6 @@
 #include <system/messages/DeviceRegistrationMessage.hpp>
 #include <time/time_constants.hpp>
 
-#include <gsl/util>
-
 #include <memory>
 #include <sstream>
 
@@ -148,8 +146,8 @@ bool baudDetectTestAT(ATParser *parser, BaudTestStep &step, BaudTestStep nextSte
 void closeCMux(std::unique_ptr<bsp::Cellular> &pv_cellular)
 {
     LOG_INFO("Closing mux mode");
-    CellularMuxFrame::frame_t frame = createCMUXExitFrame();
-    pv_cellular->write(static_cast<void *>(frame.serialize().data()), frame.serialize().size());
+    auto frame = createCMUXExitFrame().serialize();
+    pv_cellular->write(static_cast<void *>(frame.data()), frame.size());
     vTaskDelay(1000); // GSM module needs some time to close multiplexer
 }
 
@@ -448,25 +446,21 @@ CellularMux::ConfState CellularMux::startMultiplexer()
     return ConfState::Success;
 }
 
-void CellularMux::sendFrameToChannel(bsp::cellular::CellularResult &resultStruct)
+void CellularMux::sendFrameToChannel(const CellularMuxFrameView &frame, bsp::cellular::CellularResultCode resultCode)
 {
-    auto frame = CellularMuxFrame{resultStruct.getData()};
-
     for (const auto &chan : channels) {
-        if (frame.getFrameDLCI() == chan->getDLCI()) {
-            if (frame.getData().empty()) {
+        if (frame.getDLCI() == chan->getDLCI()) {
+            if (frame.status != CellularMuxFrame::OK) {
+                resultCode = bsp::cellular::CellularResultCode::CMUXFrameError;
+            }
+
+            if (frame.dataSize == 0) {
                 // Control frame contains no data
-                resultStruct.setData(frame.getSerData());
+                chan->parseInputData(resultCode, frame.frame, frame.frameSize);
             }
             else {
-                resultStruct.setData(frame.getData());
-            }
-
-            if (frame.getFrameStatus() != CellularMuxFrame::OK) {
-                resultStruct.setResultCode(bsp::cellular::CellularResultCode::CMUXFrameError);
+                chan->parseInputData(resultCode, frame.data, frame.dataSize);
             }
-
-            chan->parseInputData(&resultStruct);
             return;
         }
     }
@@ -474,30 +468,9 @@ void CellularMux::sendFrameToChannel(bsp::cellular::CellularResult &resultStruct
 
 void CellularMux::parseCellularResultCMUX(bsp::cellular::CellularDMAResultStruct &result)
 {
-    static std::vector<uint8_t> currentFrame;
-    static bool frameStartDetected = false;
-
-    for (auto i = 0U; i < result.dataSize; ++i) {
-        uint8_t character = gsl::at(result.data, i);
-        if (frameStartDetected || character == TS0710_FLAG) {
-            currentFrame.push_back(character);
-
-            // Check if frame is complete only in case of TS0710_FLAG
-            if (frameStartDetected && character == TS0710_FLAG) {
-                if (currentFrame.size() == 2) {
-                    currentFrame.erase(currentFrame.begin());
-                }
-                if (CellularMuxFrame::isComplete(currentFrame)) {
-                    frameStartDetected = false;
-                    bsp::cellular::CellularResult cellularResult{{result.resultCode, currentFrame}};
-                    sendFrameToChannel(cellularResult);
-                    currentFrame.clear();
-                    continue;
-                }
-            }
-
-            frameStartDetected = true;
-        }
+    muxParser.feed(result.data, result.dataSize);
+    while (const auto frame = muxParser.next()) {
+        sendFrameToChannel(*frame, result.resultCode);
     }
 }
 
@@ -514,13 +487,14 @@ size_t CellularMux::flushReceiveData()
 
 void CellularMux::processError(bsp::cellular::CellularDMAResultStruct &result)
 {
-    bsp::cellular::CellularResult cellularResult{{result.resultCode, {}}};
-
     if (mode == CellularMux::Mode::AT) {
+        bsp::cellular::CellularResult cellularResult{{result.resultCode, {}}};
         parser->processNewData(parentService, cellularResult);
     }
     else if (mode == CellularMux::Mode::CMUX || mode == CellularMux::Mode::CMUX_SETUP) {
-        sendFrameToChannel(cellularResult);
+        CellularMuxFrameView frame;
+        frame.status = CellularMuxFrame::EmptyFrame;
+        sendFrameToChannel(frame, result.resultCode);
     }
 }
 
@@ -196,6 +196,7 @@ repeated until a response is obtained or action is taken by a higher layer.
 
 #include "CellularMuxTypes.h"
 #include "CellularMuxFrame.h"
+#include "CellularMuxParser.h"
 #include "MuxParameters.hpp"
 
 #include "DLCChannel.h"
@@ -266,6 +267,7 @@ class CellularMux
 
     std::vector<std::unique_ptr<DLCChannel>> channels;
     DLCChannel::Callback_t controlCallback = nullptr;
+    CellularMuxParser muxParser;
 
     friend void workerTaskFunction(void *ptr);
 
@@ -284,7 +286,7 @@ class CellularMux
     size_t flushReceiveData();
     void processData(bsp::cellular::CellularDMAResultStruct &result);
     void processError(bsp::cellular::CellularDMAResultStruct &result);
-    void sendFrameToChannel(bsp::cellular::CellularResult &resultStruct);
+    void sendFrameToChannel(const CellularMuxFrameView &frame, bsp::cellular::CellularResultCode resultCode);
 
   public:
     CellularMux(PortSpeed_e portSpeed, sys::Service *parent);
@@ -3,6 +3,8 @@
 
 #include "CellularMuxData.h"
 #include "CellularMuxFrame.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
 
 CellularMuxData::CellularMuxData(DLCI_t DLCI,
@@ -38,33 +40,26 @@ void CellularMuxData::request(DLCI_t DLCI,
                 31 30 2E 30 2E 38 5F 42 55 49
                 4C 44 30 33 0D 0A 0D 0A 47 F9   UIH Frame
 */
-    auto constexpr maximumFrameLength = 127;
-    CellularMuxFrame::frame_t frame;
-    frame.Address = static_cast<uint8_t>(DLCI << 2) /*| (1 << 1)*/; // set C/R = 1 - command
-    frame.Control = static_cast<uint8_t>(TypeOfFrame_e::UIH);
+    auto constexpr maximumFrameLength = CellularMuxFrame::maxShortLength;
+    const auto address                = static_cast<uint8_t>(DLCI << 2) /*| (1 << 1)*/; // set C/R = 1 - command
+    const auto control                = static_cast<uint8_t>(TypeOfFrame_e::UIH);
 
-    if (userData.size() <= static_cast<size_t>(maximumFrameLength)) {
-        frame.data = userData;
-        CellularMuxFrame frame_c(frame);
-        // UartSend(frame_c.getSerData().data(), frame_c.getSerData().size());
-        pvCellular->write(static_cast<void *>(frame_c.getSerData().data()), frame_c.getSerData().size());
+    // every part is serialized in place, straight from the user data
+    std::array<uint8_t, CellularMuxFrame::serializedSize(maximumFrameLength)> frame;
+    auto dataLeft = userData.size();
+    auto part     = userData.data();
+    if (dataLeft > maximumFrameLength) {
+        LOG_DEBUG("SENDING %zu parts", (dataLeft + maximumFrameLength - 1) / maximumFrameLength);
     }
-    else { // if data size > max frame size
-        int dataLeft   = userData.size();
-        auto i         = userData.begin();
-        uint32_t parts = userData.size() / maximumFrameLength + 1; // add reminder
-        LOG_DEBUG("SENDING %" PRIu32 " parts", parts);
 
-        while ((parts--) != 0u) {
-            auto last  = i + (dataLeft <= maximumFrameLength ? dataLeft : maximumFrameLength); // distinguish reminder
-            frame.data = std::vector<uint8_t>(i, last);
-            i          = last;
-
-            CellularMuxFrame frame_c(frame);
-            pvCellular->write(static_cast<void *>(frame_c.getSerData().data()), frame_c.getSerData().size());
-            dataLeft -= (dataLeft <= maximumFrameLength ? dataLeft : maximumFrameLength);
-        }
-    }
+    do {
+        const auto partSize = std::min(dataLeft, maximumFrameLength);
+        const auto frameSize =
+            CellularMuxFrame::serialize(address, control, part, partSize, frame.data(), frame.size());
+        pvCellular->write(static_cast<void *>(frame.data()), frameSize);
+        part += partSize;
+        dataLeft -= partSize;
+    } while (dataLeft > 0);
 }
 
 /**
@@ -5,6 +5,7 @@
 
 #include "CellularMuxTypes.h"
 #include <inttypes.h>
+#include <cstring>
 #include <vector>
 #include <iostream>
 #include <log/log.hpp>
@@ -55,42 +56,8 @@ class CellularMuxFrame
 
         std::vector<uint8_t> serialize()
         {
-            std::vector<uint8_t> ret;
-            ret.push_back(TS0710_FLAG);
-            ret.push_back(Address | 0x01); // add EA = 1
-            ret.push_back(Control);
-            uint16_t Length = static_cast<uint16_t>(data.size());
-            if (Length > 127) {
-                Length <<= 1;      // shift data to extend for E/A bit
-                Length &= ~0x0001; // add E/A bit = 0 indicating long length
-                ret.push_back(static_cast<uint8_t>(Length & 0x00FF));
-                ret.push_back(static_cast<uint8_t>((Length >> 8) & 0x00FF));
-            }
-            else {
-                Length <<= 1;     // shift data to extend for E/A bit
-                Length |= 0x0001; // add E/A bit = 1 indicating short length
-                ret.push_back(static_cast<uint8_t>(Length & 0x00FF));
-            }
-            ret.insert(ret.end(), data.begin(), data.end()); // add data
-            /*Calculate FCS*/
-            unsigned char FCS = 0xFF;
-            unsigned char len = ret.size() - 1;
-            unsigned char i   = 1;
-            if (Control == static_cast<uint8_t>(TypeOfFrame_e::UIH)) {
-                len = 3; // par. 5.3.6 of GSM0710 document states that for UIH frames, the FCS shall be calculated over
-                // only the address, control and length fields TODO: include 2-byte address
-                // if (Length > 127)
-                //     len += 1;
-            }
-            /*len is the number of bytes in the message, p points to message*/
-
-            while (len--) {
-                FCS = crctable[FCS ^ ret[i++]];
-            }
-            /*Ones complement*/
-            FCS = 0xFF - FCS;
-            ret.push_back(FCS);
-            ret.push_back(TS0710_FLAG);
+            std::vector<uint8_t> ret(serializedSize(data.size()));
+            ret.resize(CellularMuxFrame::serialize(Address, Control, data.data(), data.size(), ret.data(), ret.size()));
             return ret;
         }
 
@@ -180,6 +147,66 @@ class CellularMuxFrame
         }
     };
 
+    static constexpr std::size_t maxShortLength = 127;
+    static constexpr std::uint8_t pollFinalBit  = 1 << 4;
+    static constexpr std::uint8_t fcsGoodValue  = 0xCF;
+
+    /// Size of the serialized frame carrying dataSize bytes of payload
+    static constexpr std::size_t serializedSize(std::size_t dataSize) noexcept
+    {
+        return TS0710_FRAME_HDR_LEN + dataSize + (dataSize > maxShortLength ? 1 : 0);
+    }
+
+    /// Feeds the bytes to the frame check sequence, start with 0xFF
+    static std::uint8_t updateFCS(std::uint8_t fcs, const std::uint8_t *data, std::size_t size) noexcept
+    {
+        while (size-- != 0) {
+            fcs = crctable[fcs ^ *data++];
+        }
+        return fcs;
+    }
+
+    /// Builds the frame in place, without intermediate buffers
+    /// @return number of bytes written to out, 0 if the frame does not fit
+    static std::size_t serialize(std::uint8_t address,
+                                 std::uint8_t control,
+                                 const std::uint8_t *data,
+                                 std::size_t dataSize,
+                                 std::uint8_t *out,
+                                 std::size_t outSize) noexcept
+    {
+        const auto frameSize = serializedSize(dataSize);
+        if (outSize < frameSize || dataSize > 0x7FFF) {
+            return 0;
+        }
+
+        std::size_t pos = 0;
+        out[pos++]      = TS0710_FLAG;
+        out[pos++]      = address | 0x01; // add EA = 1
+        out[pos++]      = control;
+        if (dataSize > maxShortLength) {
+            // E/A bit = 0 indicating long length
+            out[pos++] = static_cast<std::uint8_t>((dataSize << 1) & 0x00FE);
+            out[pos++] = static_cast<std::uint8_t>((dataSize >> 7) & 0x00FF);
+        }
+        else {
+            // E/A bit = 1 indicating short length
+            out[pos++] = static_cast<std::uint8_t>((dataSize << 1) | 0x0001);
+        }
+        const auto headerSize = pos;
+        if (dataSize > 0) {
+            std::memcpy(&out[pos], data, dataSize);
+            pos += dataSize;
+        }
+
+        // par. 5.3.6 of GSM0710 document states that for UIH frames, the FCS shall be calculated over
+        // only the address, control and length fields
+        const auto fcsSize = (control == static_cast<std::uint8_t>(TypeOfFrame_e::UIH)) ? headerSize - 1 : pos - 1;
+        out[pos++]         = 0xFF - updateFCS(0xFF, &out[1], fcsSize);
+        out[pos++]         = TS0710_FLAG;
+        return pos;
+    }
+
   private:
     frame_t pv_frame;
     std::vector<uint8_t> pv_serData;
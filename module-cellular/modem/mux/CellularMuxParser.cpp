@@ -0,0 +1,188 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "CellularMuxParser.h"
+
+#include <log/log.hpp>
+
+#include <cstring>
+
+namespace
+{
+    constexpr std::size_t minimumHeaderSize = 4; // flag, address, control, length
+    constexpr std::uint8_t quectelLength    = 0xFF;
+} // namespace
+
+void CellularMuxParser::feed(const std::uint8_t *data, std::size_t size)
+{
+    position = 0;
+
+    // closing flag of the previous frame is kept only for the frames sharing the flag, it is not needed when the new
+    // data starts with its own flag
+    if (pending == 1 && buffer[0] == TS0710_FLAG && size > 0 && data[0] == TS0710_FLAG) {
+        pending = 0;
+    }
+
+    if (pending == 0) {
+        source     = data;
+        sourceSize = size;
+        return;
+    }
+
+    if (pending + size > buffer.size()) {
+        LOG_ERROR("CMUX reassembly buffer overflow, dropping %zu bytes", pending);
+        pending    = 0;
+        source     = data;
+        sourceSize = size;
+        return;
+    }
+
+    std::memcpy(&buffer[pending], data, size);
+    pending += size;
+    source     = buffer.data();
+    sourceSize = pending;
+}
+
+std::optional<CellularMuxFrameView> CellularMuxParser::next()
+{
+    if (source == nullptr) {
+        return std::nullopt;
+    }
+
+    while (position < sourceSize) {
+        const auto flag = static_cast<const std::uint8_t *>(
+            std::memchr(&source[position], TS0710_FLAG, sourceSize - position));
+        if (flag == nullptr) {
+            position = sourceSize;
+            break;
+        }
+        position = flag - source;
+
+        // closing flag of the previous frame may be followed by the opening flag of the next one
+        while (position + 1 < sourceSize && source[position + 1] == TS0710_FLAG) {
+            ++position;
+        }
+
+        CellularMuxFrameView view;
+        switch (decode(&source[position], sourceSize - position, view)) {
+        case Result::Frame:
+            // leave the closing flag, it can start the next frame as well
+            position += view.frameSize - 1;
+            return view;
+        case Result::NeedMoreData:
+            stashRemainder();
+            return std::nullopt;
+        case Result::Invalid:
+            ++position;
+            break;
+        }
+    }
+
+    stashRemainder();
+    return std::nullopt;
+}
+
+void CellularMuxParser::reset() noexcept
+{
+    pending    = 0;
+    source     = nullptr;
+    sourceSize = 0;
+    position   = 0;
+}
+
+auto CellularMuxParser::decode(const std::uint8_t *frame, std::size_t available, CellularMuxFrameView &view) const
+    -> Result
+{
+    if (available < minimumHeaderSize) {
+        return Result::NeedMoreData;
+    }
+
+    const auto lengthByte = frame[3];
+    std::size_t headerSize;
+    std::size_t length;
+    if ((lengthByte & 0x01) != 0) { // short length
+        headerSize = minimumHeaderSize;
+        length     = lengthByte >> 1;
+    }
+    else { // long length
+        if (available < minimumHeaderSize + 1) {
+            return Result::NeedMoreData;
+        }
+        headerSize = minimumHeaderSize + 1;
+        length     = (lengthByte >> 1) | (static_cast<std::size_t>(frame[4]) << 7);
+    }
+
+    std::size_t frameSize;
+    if (lengthByte == quectelLength) {
+        // Quectel misimplementation of the standard - length field can't be trusted, frame ends on the next flag
+        const auto end = static_cast<const std::uint8_t *>(
+            std::memchr(&frame[headerSize], TS0710_FLAG, available - headerSize));
+        if (end == nullptr) {
+            return (available >= maxFrameSize) ? Result::Invalid : Result::NeedMoreData;
+        }
+        frameSize = end - frame + 1;
+        if (frameSize < headerSize + 2) {
+            return Result::Invalid;
+        }
+        length = frameSize - headerSize - 2;
+    }
+    else {
+        frameSize = headerSize + length + 2;
+        if (frameSize > maxFrameSize) {
+            LOG_ERROR("CMUX frame too long (%zu bytes). Dropping.", frameSize);
+            return Result::Invalid;
+        }
+        if (available < frameSize) {
+            return Result::NeedMoreData;
+        }
+        if (frame[frameSize - 1] != TS0710_FLAG) {
+            LOG_ERROR("Received frame has incorrect trailing flag. Dropping.");
+            return Result::Invalid;
+        }
+    }
+
+    view.address   = frame[1];
+    view.control   = frame[2] & ~CellularMuxFrame::pollFinalBit;
+    view.frame     = frame;
+    view.frameSize = frameSize;
+    view.data      = &frame[headerSize];
+    view.dataSize  = length;
+    view.status    = CellularMuxFrame::OK;
+
+    // par. 5.3.6 of GSM0710 document states that for UIH frames, the FCS shall be calculated over
+    // only the address, control and length fields
+    const auto isUIH   = view.control == static_cast<std::uint8_t>(TypeOfFrame_e::UIH);
+    const auto fcsSize = isUIH ? headerSize - 1 : headerSize - 1 + length;
+    auto fcs           = CellularMuxFrame::updateFCS(0xFF, &frame[1], fcsSize);
+    fcs                = CellularMuxFrame::updateFCS(fcs, &frame[frameSize - 2], 1);
+
+    // ignore FCS check if it's faulty Quectel UIH frame or UA frame
+    const auto isUA = view.control == (static_cast<std::uint8_t>(TypeOfFrame_e::UA) & ~CellularMuxFrame::pollFinalBit);
+    if (fcs != CellularMuxFrame::fcsGoodValue && lengthByte != quectelLength && !isUA) {
+        LOG_ERROR("Received frame FCS [0x%02X] != 0xCF error. Dropping.", fcs);
+        view.status   = CellularMuxFrame::CRCError;
+        view.dataSize = 0;
+    }
+
+    return Result::Frame;
+}
+
+void CellularMuxParser::stashRemainder()
+{
+    const auto remaining = sourceSize - position;
+
+    if (remaining > buffer.size()) {
+        LOG_ERROR("CMUX reassembly buffer overflow, dropping %zu bytes", remaining);
+        pending = 0;
+    }
+    else {
+        if (remaining > 0) {
+            std::memmove(buffer.data(), &source[position], remaining);
+        }
+        pending = remaining;
+    }
+
+    source     = nullptr;
+    sourceSize = 0;
+    position   = 0;
+}
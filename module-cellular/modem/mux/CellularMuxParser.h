@@ -0,0 +1,66 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "CellularMuxFrame.h"
+#include "CellularMuxTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+/// Frame decoded in place, pointers refer to the parser input or its reassembly buffer and stay valid until the
+/// following CellularMuxParser::next call
+struct CellularMuxFrameView
+{
+    std::uint8_t address                       = 0;
+    std::uint8_t control                       = 0;       ///< without the P/F bit
+    const std::uint8_t *frame                  = nullptr; ///< whole frame including both flags
+    std::size_t frameSize                      = 0;
+    const std::uint8_t *data                   = nullptr; ///< payload
+    std::size_t dataSize                       = 0;
+    CellularMuxFrame::TS0710FrameStatus status = CellularMuxFrame::OK;
+
+    DLCI_t getDLCI() const noexcept
+    {
+        return address >> 2;
+    }
+};
+
+/// Splits the byte stream received from the modem into TS 07.10 basic mode frames.
+///
+/// Frames which are contained in a single chunk are decoded directly from the caller's buffer, only the trailing,
+/// incomplete frame is kept in a fixed size reassembly buffer until the rest of it arrives.
+///
+/// Usage:
+///     parser.feed(data, size);
+///     while (auto frame = parser.next()) { ... }
+class CellularMuxParser
+{
+  public:
+    /// Frames longer than this are dropped
+    static constexpr std::size_t maxFrameSize = 2 * CellularMuxFrame::serializedSize(CellularMuxFrame::maxShortLength);
+
+    void feed(const std::uint8_t *data, std::size_t size);
+    std::optional<CellularMuxFrameView> next();
+    void reset() noexcept;
+
+  private:
+    enum class Result
+    {
+        Frame,
+        NeedMoreData,
+        Invalid
+    };
+
+    Result decode(const std::uint8_t *frame, std::size_t available, CellularMuxFrameView &view) const;
+    void stashRemainder();
+
+    std::array<std::uint8_t, maxFrameSize> buffer{};
+    std::size_t pending = 0; ///< bytes kept in buffer between feed calls
+
+    const std::uint8_t *source = nullptr;
+    std::size_t sourceSize     = 0;
+    std::size_t position       = 0;
+};
@@ -5,12 +5,16 @@
 
 #include "CellularMuxData.h"
 #include "CellularMuxFrame.h"
+#include "CellularMuxParser.h"
 
 #include <log/log.hpp>
 #include <ticks.hpp>
 #include <Utils.hpp>
 #include <magic_enum.hpp>
 
+#include <array>
+#include <cstring>
+
 DLCChannel::DLCChannel(DLCI_t DLCI, const std::string &name, bsp::Cellular *cellular, const Callback_t &callback)
     : Channel{new uint8_t[at::defaultReceiveBufferSize]}, name{name}, DLCI{DLCI}, pvCellular{cellular}
 {
@@ -48,15 +52,20 @@ bool DLCChannel::establish()
 {
     LOG_SENSITIVE(LOGDEBUG, "Sending %s frame to DLCI %i", TypeOfFrame_text[chanParams.TypeOfFrame].c_str(), DLCI);
 
-    CellularMuxFrame frame_c(CellularMuxFrame::frame_t(static_cast<uint8_t>(DLCI << 2) | (1 << 1),
-                                                       static_cast<uint8_t>(chanParams.TypeOfFrame)));
+    std::array<std::uint8_t, CellularMuxFrame::serializedSize(0)> frame;
+    const auto frameSize = CellularMuxFrame::serialize(static_cast<uint8_t>(DLCI << 2) | (1 << 1),
+                                                       static_cast<uint8_t>(chanParams.TypeOfFrame),
+                                                       nullptr,
+                                                       0,
+                                                       frame.data(),
+                                                       frame.size());
 
     awaitingResponseFlag.set();
 
     bool result = false;
 
     for (int retries = 0; retries < chanParams.MaxNumOfRetransmissions; ++retries) {
-        pvCellular->write(static_cast<void *>(frame_c.getSerData().data()), frame_c.getSerData().size());
+        pvCellular->write(static_cast<void *>(frame.data()), frameSize);
 
         auto startTime = std::chrono::steady_clock::now();
         auto endTime   = startTime + std::chrono::milliseconds{300};
@@ -105,6 +114,7 @@ std::vector<std::string> DLCChannel::sendCommandPrompt(const char *cmd,
 {
     std::vector<std::string> tokens;
 
+    cpp_freertos::LockGuard lock(commandMutex);
     awaitingResponseFlag.set();
 
     at::Result result;
@@ -154,21 +164,34 @@ std::vector<std::string> DLCChannel::sendCommandPrompt(const char *cmd,
     return tokens;
 }
 
-at::Result DLCChannel::parseInputData(bsp::cellular::CellularResult *cellularResult) const
+at::Result DLCChannel::parseInputData(bsp::cellular::CellularResultCode resultCode,
+                                      const std::uint8_t *data,
+                                      std::size_t size) const
 {
     at::Result result;
 
     if (awaitingResponseFlag.state()) {
+        // same layout as bsp::cellular::CellularResultStruct::serialize but without heap allocation
+        std::array<std::uint8_t, at::defaultMessageBufferSize> message;
+        if (size + sizeof(resultCode) > message.size()) {
+            LOG_ERROR("[DLC] Frame too long for message buffer (%zu bytes)", size);
+            size = message.size() - sizeof(resultCode);
+        }
+        message[0] = static_cast<std::uint8_t>(resultCode);
+        if (size > 0) {
+            std::memcpy(&message[sizeof(resultCode)], data, size);
+        }
+
         if (!xMessageBufferSend(responseBuffer,
-                                (void *)cellularResult->getSerialized().get(),
-                                cellularResult->getSerializedSize(),
+                                message.data(),
+                                size + sizeof(resultCode),
                                 pdMS_TO_TICKS(at::defaultBufferTimeoutMs.count()))) {
             LOG_DEBUG("[DLC] Message buffer full!");
             result.code = at::Result::Code::FULL_MSG_BUFFER;
         }
     }
     else if (pvCallback != nullptr) {
-        std::string receivedData = cellularResult->getDataAsString();
+        std::string receivedData(reinterpret_cast<const char *>(data), size);
         pvCallback(receivedData);
     }
     else {
@@ -180,7 +203,10 @@ at::Result DLCChannel::parseInputData(bsp::cellular::CellularResult *cellularRes
 
 bool DLCChannel::evaluateEstablishResponse(bsp::cellular::CellularResult &response) const
 {
-    auto frame = CellularMuxFrame{response.getData()};
-    return (frame.getFrameDLCI() == DLCI &&
-            (frame.getFrame().Control == (static_cast<uint8_t>(TypeOfFrame_e::UA) & ~(1 << 4))));
+    CellularMuxParser parser;
+    const auto &data = response.getData();
+    parser.feed(data.data(), data.size());
+    const auto frame = parser.next();
+    return (frame.has_value() && frame->getDLCI() == DLCI &&
+            (frame->control == (static_cast<uint8_t>(TypeOfFrame_e::UA) & ~CellularMuxFrame::pollFinalBit)));
 }
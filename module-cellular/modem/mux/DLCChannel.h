@@ -46,7 +46,10 @@ class DLCChannel : public at::Channel
                                                size_t rxCount,
                                                std::chrono::milliseconds timeout = std::chrono::milliseconds{300});
 
-    at::Result parseInputData(bsp::cellular::CellularResult *cellularResult) const;
+    /// Passes the frame payload to the waiting command or to the callback, data is copied only once
+    at::Result parseInputData(bsp::cellular::CellularResultCode resultCode,
+                              const std::uint8_t *data,
+                              std::size_t size) const;
 
     bool evaluateEstablishResponse(bsp::cellular::CellularResult &response) const;
 
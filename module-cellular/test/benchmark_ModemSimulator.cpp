@@ -0,0 +1,157 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <ModemSimulator.hpp>
+#include <PtyTransport.hpp>
+#include <modem/ATStream.hpp>
+#include <modem/ATURCStream.hpp>
+#include <modem/mux/CellularMuxFrame.h>
+#include <modem/mux/CellularMuxParser.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+// Benchmarks are hidden from default run, use: catch2-cellular-modem-simulator "[benchmark]"
+using cellular::simulator::ModemSimulator;
+
+namespace
+{
+    constexpr auto farFuture = ModemSimulator::Clock::time_point::max();
+
+    ModemSimulator::Config quietConfig()
+    {
+        ModemSimulator::Config config;
+        config.echo = false;
+        return config;
+    }
+
+    std::vector<std::uint8_t> makeFrame(DLCI_t dlci, TypeOfFrame_e type, const std::string &data)
+    {
+        std::vector<std::uint8_t> frame(CellularMuxFrame::serializedSize(data.size()));
+        CellularMuxFrame::serialize(static_cast<std::uint8_t>((dlci << 2) | 0x02),
+                                    static_cast<std::uint8_t>(type),
+                                    reinterpret_cast<const std::uint8_t *>(data.data()),
+                                    data.size(),
+                                    frame.data(),
+                                    frame.size());
+        return frame;
+    }
+
+    void startMux(ModemSimulator &modem)
+    {
+        const std::string cmux = "AT+CMUX=0\r";
+        modem.receive(reinterpret_cast<const std::uint8_t *>(cmux.data()), cmux.size());
+        for (DLCI_t dlci = 0; dlci <= ModemSimulator::notificationsDLCI; ++dlci) {
+            const auto sabm = makeFrame(dlci, TypeOfFrame_e::SABM, {});
+            modem.receive(sabm.data(), sabm.size());
+        }
+        modem.transmit(farFuture);
+    }
+} // namespace
+
+TEST_CASE("Modem simulator: CMUX URC storm throughput", "[.][benchmark]")
+{
+    constexpr auto urcCount = 1000;
+    ModemSimulator modem{quietConfig()};
+    startMux(modem);
+    modem.urcStorm("+QIND: \"csq\",20,99", urcCount);
+    const auto stream = modem.transmit(farFuture);
+
+    BENCHMARK("parse " + std::to_string(stream.size()) + " bytes in 512 byte chunks")
+    {
+        CellularMuxParser parser;
+        auto frames = 0;
+        for (std::size_t offset = 0; offset < stream.size(); offset += 512) {
+            parser.feed(&stream[offset], std::min<std::size_t>(512, stream.size() - offset));
+            while (parser.next()) {
+                ++frames;
+            }
+        }
+        return frames;
+    };
+
+    BENCHMARK("parse and split into URCs")
+    {
+        CellularMuxParser parser;
+        parser.feed(stream.data(), stream.size());
+        auto urcs = 0U;
+        at::ATURCStream urcStream;
+        while (auto frame = parser.next()) {
+            urcStream.write(std::string(reinterpret_cast<const char *>(frame->data), frame->dataSize));
+            urcs += urcStream.getURCList().size();
+        }
+        return urcs;
+    };
+}
+
+TEST_CASE("Modem simulator: command round trip", "[.][benchmark]")
+{
+    ModemSimulator modem{quietConfig()};
+    startMux(modem);
+    const auto command = makeFrame(ModemSimulator::commandsDLCI, TypeOfFrame_e::UIH, "AT+CSQ\r");
+
+    BENCHMARK("AT+CSQ over CMUX")
+    {
+        modem.receive(command.data(), command.size());
+        const auto response = modem.transmit(farFuture);
+
+        CellularMuxParser parser;
+        parser.feed(response.data(), response.size());
+        at::ATStream atStream;
+        while (auto frame = parser.next()) {
+            atStream.write(std::string(reinterpret_cast<const char *>(frame->data), frame->dataSize));
+        }
+        return atStream.getResult().code;
+    };
+
+    for (auto i = 0; i < 50; ++i) {
+        modem.receiveSms("+48123456789", "Message number " + std::to_string(i));
+    }
+    modem.transmit(farFuture);
+    const auto list = makeFrame(ModemSimulator::commandsDLCI, TypeOfFrame_e::UIH, "AT+CMGL=\"ALL\"\r");
+
+    BENCHMARK("AT+CMGL with 50 messages over CMUX")
+    {
+        modem.receive(list.data(), list.size());
+        const auto response = modem.transmit(farFuture);
+
+        CellularMuxParser parser;
+        parser.feed(response.data(), response.size());
+        at::ATStream atStream;
+        while (auto frame = parser.next()) {
+            atStream.write(std::string(reinterpret_cast<const char *>(frame->data), frame->dataSize));
+        }
+        return atStream.getResult().response.size();
+    };
+}
+
+TEST_CASE("Modem simulator: pty round trip latency", "[.][benchmark]")
+{
+    ModemSimulator modem{quietConfig()};
+    cellular::simulator::PtyTransport transport{modem};
+    REQUIRE(transport.start());
+    const auto fd = ::open(transport.getPath().c_str(), O_RDWR | O_NOCTTY);
+    REQUIRE(fd >= 0);
+
+    BENCHMARK("AT")
+    {
+        [[maybe_unused]] const auto written = ::write(fd, "AT\r", 3);
+        std::string response;
+        pollfd readable{fd, POLLIN, 0};
+        while (response.find("OK\r\n") == std::string::npos && ::poll(&readable, 1, 1000) > 0) {
+            char buffer[16];
+            if (const auto size = ::read(fd, buffer, sizeof(buffer)); size > 0) {
+                response.append(buffer, size);
+            }
+        }
+        return response.size();
+    };
+
+    ::close(fd);
+    transport.stop();
+}
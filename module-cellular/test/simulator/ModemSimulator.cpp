@@ -0,0 +1,611 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "ModemSimulator.hpp"
+
+#include <modem/mux/CellularMuxFrame.h>
+#include <modem/mux/CellularMuxTypes.h>
+
+#include <algorithm>
+
+namespace cellular::simulator
+{
+    namespace
+    {
+        constexpr char ctrlZ  = 0x1A;
+        constexpr char escape = 0x1B;
+
+        constexpr auto smsTimestamp = "\"21/01/01,12:00:00+04\"";
+
+        constexpr std::uint8_t typeOf(MuxDefines type) noexcept
+        {
+            return static_cast<std::uint8_t>(type);
+        }
+
+        bool startsWith(const std::string &text, const std::string &prefix)
+        {
+            return text.compare(0, prefix.size(), prefix) == 0;
+        }
+
+        std::string unquote(std::string text)
+        {
+            text.erase(std::remove(text.begin(), text.end(), '"'), text.end());
+            return text;
+        }
+
+        unsigned toNumber(const std::string &text, unsigned fallback = 0)
+        {
+            try {
+                return static_cast<unsigned>(std::stoul(text));
+            }
+            catch (const std::exception &) {
+                return fallback;
+            }
+        }
+
+        std::string numberType(const std::string &number)
+        {
+            return (!number.empty() && number.front() == '+') ? "145" : "129";
+        }
+    } // namespace
+
+    const std::vector<std::pair<std::string, ModemSimulator::Builtin>> ModemSimulator::builtins = {
+        {"AT+CMUX=", &ModemSimulator::cmux},
+        {"ATE", &ModemSimulator::echoMode},
+        {"AT+CREG?", &ModemSimulator::registrationStatus},
+        {"AT+CREG=", &ModemSimulator::registrationMode},
+        {"AT+CSQ", &ModemSimulator::signalQuality},
+        {"AT+COPS?", &ModemSimulator::currentOperator},
+        {"AT+QNWINFO", &ModemSimulator::networkInfo},
+        {"ATD", &ModemSimulator::dial},
+        {"ATA", &ModemSimulator::answer},
+        {"ATH", &ModemSimulator::hangup},
+        {"AT+CHUP", &ModemSimulator::hangup},
+        {"AT+CLCC", &ModemSimulator::listCalls},
+        {"AT+CMGF=", &ModemSimulator::smsFormat},
+        {"AT+CMGS=", &ModemSimulator::sendSms},
+        {"AT+QCMGS=", &ModemSimulator::quectelSendSms},
+        {"AT+CMGL", &ModemSimulator::listSms},
+        {"AT+CMGR=", &ModemSimulator::readSms},
+        {"AT+CMGD=", &ModemSimulator::deleteSms},
+    };
+
+    ModemSimulator::ModemSimulator() : ModemSimulator(Config{})
+    {}
+
+    ModemSimulator::ModemSimulator(Config config) : config{std::move(config)}, random{this->config.seed}
+    {
+        echo = this->config.echo;
+    }
+
+    void ModemSimulator::addRule(const std::string &prefix, Lines response)
+    {
+        addRule(prefix, [response = std::move(response)](const std::string &) { return response; });
+    }
+
+    void ModemSimulator::addRule(const std::string &prefix, Handler handler)
+    {
+        std::lock_guard lock(mutex);
+        rules.emplace_back(prefix, std::move(handler));
+    }
+
+    void ModemSimulator::receive(const std::uint8_t *data, std::size_t size)
+    {
+        std::lock_guard lock(mutex);
+
+        std::size_t position = 0;
+        // byte by byte, the frames may follow the AT+CMUX command in the same chunk
+        while (!muxActive && position < size) {
+            handleChannelData(noMux, &data[position++], 1);
+        }
+        if (position == size) {
+            return;
+        }
+
+        parser.feed(&data[position], size - position);
+        while (auto frame = parser.next()) {
+            handleFrame(*frame);
+            if (!muxActive) {
+                parser.reset();
+                break;
+            }
+        }
+    }
+
+    std::vector<std::uint8_t> ModemSimulator::transmit(Clock::time_point now)
+    {
+        std::lock_guard lock(mutex);
+        std::vector<std::uint8_t> bytes;
+        while (!output.empty() && output.front().due <= now) {
+            const auto &chunk = output.front().bytes;
+            bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+            output.pop_front();
+        }
+        return bytes;
+    }
+
+    std::optional<ModemSimulator::Clock::time_point> ModemSimulator::nextTransmission() const
+    {
+        std::lock_guard lock(mutex);
+        if (output.empty()) {
+            return std::nullopt;
+        }
+        return output.front().due;
+    }
+
+    void ModemSimulator::setTransmitNotifier(std::function<void()> notifier)
+    {
+        std::lock_guard lock(mutex);
+        transmitNotifier = std::move(notifier);
+    }
+
+    void ModemSimulator::setRegistered(bool value)
+    {
+        std::lock_guard lock(mutex);
+        registered = value;
+        if (registrationUrc > 0) {
+            queueUrc("+CREG: " + std::to_string(registered ? 1 : 0));
+        }
+    }
+
+    void ModemSimulator::setSignalQuality(unsigned value)
+    {
+        std::lock_guard lock(mutex);
+        rssi = value;
+    }
+
+    void ModemSimulator::incomingCall(const std::string &number)
+    {
+        std::lock_guard lock(mutex);
+        calls.push_back(Call{number, true, Call::State::Incoming});
+        queueUrc("RING");
+        queueUrc("+CLIP: \"" + number + "\"," + numberType(number) + ",,,,0");
+    }
+
+    void ModemSimulator::remoteAnswer()
+    {
+        std::lock_guard lock(mutex);
+        for (auto &call : calls) {
+            if (!call.incoming) {
+                call.state = Call::State::Active;
+            }
+        }
+    }
+
+    void ModemSimulator::remoteHangup()
+    {
+        std::lock_guard lock(mutex);
+        calls.clear();
+        queueUrc("NO CARRIER");
+    }
+
+    void ModemSimulator::receiveSms(const std::string &number, const std::string &text)
+    {
+        std::lock_guard lock(mutex);
+        unsigned index = 0;
+        while (storedMessages.count(index) != 0) {
+            ++index;
+        }
+        storedMessages[index] = Sms{number, text};
+        queueUrc("+CMTI: \"ME\"," + std::to_string(index));
+    }
+
+    void ModemSimulator::sendUrc(const std::string &urc)
+    {
+        std::lock_guard lock(mutex);
+        queueUrc(urc);
+    }
+
+    void ModemSimulator::urcStorm(const std::string &urc, std::size_t count)
+    {
+        std::lock_guard lock(mutex);
+        while (count-- != 0) {
+            queueUrc(urc);
+        }
+    }
+
+    bool ModemSimulator::isMuxActive() const
+    {
+        std::lock_guard lock(mutex);
+        return muxActive;
+    }
+
+    std::vector<ModemSimulator::Call> ModemSimulator::getCalls() const
+    {
+        std::lock_guard lock(mutex);
+        return calls;
+    }
+
+    std::map<unsigned, ModemSimulator::Sms> ModemSimulator::getStoredMessages() const
+    {
+        std::lock_guard lock(mutex);
+        return storedMessages;
+    }
+
+    std::vector<ModemSimulator::Sms> ModemSimulator::getSentMessages() const
+    {
+        std::lock_guard lock(mutex);
+        return sentMessages;
+    }
+
+    ModemSimulator::Lines ModemSimulator::getCommandLog() const
+    {
+        std::lock_guard lock(mutex);
+        return commandLog;
+    }
+
+    void ModemSimulator::handleFrame(const CellularMuxFrameView &frame)
+    {
+        if (frame.status != CellularMuxFrame::OK) {
+            return;
+        }
+
+        const auto dlci = frame.getDLCI();
+        const auto ua   = typeOf(MuxDefines::GSM0710_TYPE_UA) | CellularMuxFrame::pollFinalBit;
+        switch (frame.control) {
+        case typeOf(MuxDefines::GSM0710_TYPE_SABM):
+            openChannels.insert(dlci);
+            queueFrame(dlci, ua, nullptr, 0);
+            break;
+        case typeOf(MuxDefines::GSM0710_TYPE_DISC):
+            queueFrame(dlci, ua, nullptr, 0);
+            openChannels.erase(dlci);
+            if (dlci == 0) {
+                muxActive = false;
+            }
+            break;
+        case typeOf(MuxDefines::GSM0710_TYPE_UIH):
+            if (dlci == 0) {
+                handleControlMessage(frame.data, frame.dataSize);
+            }
+            else {
+                handleChannelData(dlci, frame.data, frame.dataSize);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void ModemSimulator::handleControlMessage(const std::uint8_t *data, std::size_t size)
+    {
+        if (size == 0) {
+            return;
+        }
+
+        // acknowledge with the same message marked as a response
+        std::vector<std::uint8_t> response(data, data + size);
+        response[0] &= ~typeOf(MuxDefines::GSM0710_CR);
+        queueFrame(0, typeOf(MuxDefines::GSM0710_TYPE_UIH), response.data(), response.size());
+
+        if ((data[0] & ~typeOf(MuxDefines::GSM0710_CR)) == typeOf(MuxDefines::GSM0710_CONTROL_CLD)) {
+            muxActive = false;
+        }
+    }
+
+    void ModemSimulator::handleChannelData(DLCI_t dlci, const std::uint8_t *data, std::size_t size)
+    {
+        auto &channel = channels[dlci];
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto c = static_cast<char>(data[i]);
+            if (channel.prompt) {
+                handlePromptData(dlci, channel, c);
+            }
+            else if (c == '\r') {
+                const auto line = std::move(channel.line);
+                channel.line.clear();
+                handleLine(dlci, line);
+            }
+            else if (c != '\n') {
+                channel.line.push_back(c);
+            }
+        }
+    }
+
+    void ModemSimulator::handlePromptData(DLCI_t dlci, Channel &channel, char c)
+    {
+        if (c == escape) {
+            channel = Channel{};
+            queueLines(dlci, {"OK"});
+        }
+        else if (c == ctrlZ) {
+            auto command = std::move(channel.promptCommand);
+            sentMessages.push_back(Sms{std::move(channel.promptNumber), std::move(channel.line)});
+            channel = Channel{};
+            if (roll(config.errorPercent)) {
+                queueLines(dlci, {"+CMS ERROR: 500"});
+                return;
+            }
+            queueLines(dlci, {command + ": " + std::to_string(messageReference++ % 256), "OK"});
+        }
+        else {
+            channel.line.push_back(c);
+        }
+    }
+
+    void ModemSimulator::handleLine(DLCI_t dlci, const std::string &line)
+    {
+        if (line.empty()) {
+            return;
+        }
+        commandLog.push_back(line);
+        if (echo) {
+            queueText(dlci, line + "\r");
+        }
+
+        const auto response = runCommand(dlci, line);
+        if (!response.empty()) {
+            queueLines(dlci, response);
+        }
+
+        if (muxRequested) {
+            muxRequested = false;
+            muxActive    = true;
+            channels.clear();
+            openChannels.clear();
+        }
+    }
+
+    ModemSimulator::Lines ModemSimulator::runCommand(DLCI_t dlci, const std::string &command)
+    {
+        if (roll(config.errorPercent)) {
+            return {"ERROR"};
+        }
+
+        for (auto rule = rules.rbegin(); rule != rules.rend(); ++rule) {
+            if (startsWith(command, rule->first)) {
+                return rule->second(command.substr(rule->first.size()));
+            }
+        }
+        for (const auto &[prefix, builtin] : builtins) {
+            if (startsWith(command, prefix)) {
+                return (this->*builtin)(dlci, command.substr(prefix.size()));
+            }
+        }
+
+        if (command == "AT") {
+            return {"OK"};
+        }
+        return {config.unknownCommandResult};
+    }
+
+    ModemSimulator::Lines ModemSimulator::cmux(DLCI_t dlci, const std::string &)
+    {
+        if (dlci != noMux) {
+            return {"ERROR"};
+        }
+        muxRequested = true;
+        return {"OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::echoMode(DLCI_t, const std::string &arguments)
+    {
+        echo = toNumber(arguments) != 0;
+        return {"OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::registrationMode(DLCI_t, const std::string &arguments)
+    {
+        registrationUrc = toNumber(arguments);
+        return {"OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::registrationStatus(DLCI_t, const std::string &)
+    {
+        return {"+CREG: " + std::to_string(registrationUrc) + "," + std::to_string(registered ? 1 : 0), "OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::signalQuality(DLCI_t, const std::string &)
+    {
+        return {"+CSQ: " + std::to_string(registered ? rssi : 99) + ",99", "OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::currentOperator(DLCI_t, const std::string &)
+    {
+        if (!registered) {
+            return {"+COPS: 0", "OK"};
+        }
+        return {"+COPS: 0,0,\"Simulator\",7", "OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::networkInfo(DLCI_t, const std::string &)
+    {
+        if (!registered) {
+            return {"+QNWINFO: No Service", "OK"};
+        }
+        return {"+QNWINFO: \"FDD LTE\",\"26001\",\"LTE BAND 3\",1300", "OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::dial(DLCI_t, const std::string &arguments)
+    {
+        if (!registered) {
+            return {"NO CARRIER"};
+        }
+        auto number = arguments.substr(0, arguments.find(';'));
+        calls.push_back(Call{std::move(number), false, Call::State::Alerting});
+        return {"OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::answer(DLCI_t, const std::string &)
+    {
+        auto call = std::find_if(
+            calls.begin(), calls.end(), [](const auto &call) { return call.state == Call::State::Incoming; });
+        if (call == calls.end()) {
+            return {"NO CARRIER"};
+        }
+        call->state = Call::State::Active;
+        return {"OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::hangup(DLCI_t, const std::string &)
+    {
+        calls.clear();
+        return {"OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::listCalls(DLCI_t, const std::string &)
+    {
+        Lines response;
+        for (std::size_t i = 0; i < calls.size(); ++i) {
+            const auto &call = calls[i];
+            response.push_back("+CLCC: " + std::to_string(i + 1) + "," + (call.incoming ? "1" : "0") + "," +
+                               std::to_string(static_cast<int>(call.state)) + ",0,0,\"" + call.number + "\"," +
+                               numberType(call.number));
+        }
+        response.emplace_back("OK");
+        return response;
+    }
+
+    ModemSimulator::Lines ModemSimulator::smsFormat(DLCI_t, const std::string &arguments)
+    {
+        textMode = toNumber(arguments) != 0;
+        return {"OK"};
+    }
+
+    ModemSimulator::Lines ModemSimulator::sendSms(DLCI_t dlci, const std::string &arguments)
+    {
+        return startPrompt(dlci, "+CMGS", arguments);
+    }
+
+    ModemSimulator::Lines ModemSimulator::quectelSendSms(DLCI_t dlci, const std::string &arguments)
+    {
+        return startPrompt(dlci, "+QCMGS", arguments);
+    }
+
+    ModemSimulator::Lines ModemSimulator::startPrompt(DLCI_t dlci,
+                                                      const std::string &command,
+                                                      const std::string &arguments)
+    {
+        auto &channel         = channels[dlci];
+        channel.prompt        = true;
+        channel.promptCommand = command;
+        // in the PDU mode the argument is the PDU length, the number is a part of the PDU
+        channel.promptNumber = textMode ? unquote(arguments.substr(0, arguments.find(','))) : std::string{};
+        queueText(dlci, "\r\n> ");
+        return {};
+    }
+
+    ModemSimulator::Lines ModemSimulator::listSms(DLCI_t, const std::string &arguments)
+    {
+        const auto filter = unquote(arguments);
+        const bool unread = filter == "=REC UNREAD" || filter == "=0";
+        const bool read   = filter == "=REC READ" || filter == "=1";
+
+        Lines response;
+        for (auto &[index, sms] : storedMessages) {
+            if ((unread && sms.read) || (read && !sms.read)) {
+                continue;
+            }
+            response.push_back("+CMGL: " + std::to_string(index) + "," + smsHeader(sms));
+            response.push_back(sms.text);
+            sms.read = true;
+        }
+        response.emplace_back("OK");
+        return response;
+    }
+
+    ModemSimulator::Lines ModemSimulator::readSms(DLCI_t, const std::string &arguments)
+    {
+        const auto sms = storedMessages.find(toNumber(arguments, storedMessages.size()));
+        if (sms == storedMessages.end()) {
+            return {"+CMS ERROR: 321"};
+        }
+        Lines response{"+CMGR: " + smsHeader(sms->second), sms->second.text, "OK"};
+        sms->second.read = true;
+        return response;
+    }
+
+    ModemSimulator::Lines ModemSimulator::deleteSms(DLCI_t, const std::string &arguments)
+    {
+        const auto separator = arguments.find(',');
+        const auto flag      = separator == std::string::npos ? 0 : toNumber(arguments.substr(separator + 1));
+        switch (flag) {
+        case 0:
+            storedMessages.erase(toNumber(arguments.substr(0, separator)));
+            break;
+        case 1:
+            for (auto sms = storedMessages.begin(); sms != storedMessages.end();) {
+                sms = sms->second.read ? storedMessages.erase(sms) : std::next(sms);
+            }
+            break;
+        default:
+            storedMessages.clear();
+            break;
+        }
+        return {"OK"};
+    }
+
+    void ModemSimulator::queueUrc(const std::string &urc)
+    {
+        queueText(urcChannel(), "\r\n" + urc + "\r\n");
+    }
+
+    void ModemSimulator::queueLines(DLCI_t dlci, const Lines &lines)
+    {
+        // "\r\n<line>\r\n<line>\r\n\r\n<result>\r\n" - the final result is separated with an empty line
+        std::string text = "\r\n";
+        for (std::size_t i = 0; i + 1 < lines.size(); ++i) {
+            text += lines[i] + "\r\n";
+        }
+        if (lines.size() > 1) {
+            text += "\r\n";
+        }
+        text += lines.back() + "\r\n";
+        queueText(dlci, text);
+    }
+
+    void ModemSimulator::queueText(DLCI_t dlci, const std::string &text)
+    {
+        const auto data = reinterpret_cast<const std::uint8_t *>(text.data());
+        if (dlci == noMux) {
+            queueBytes(std::vector<std::uint8_t>(data, data + text.size()));
+            return;
+        }
+
+        for (std::size_t offset = 0; offset < text.size(); offset += CellularMuxFrame::maxShortLength) {
+            const auto size = std::min(text.size() - offset, CellularMuxFrame::maxShortLength);
+            queueFrame(dlci, typeOf(MuxDefines::GSM0710_TYPE_UIH), &data[offset], size);
+        }
+    }
+
+    void ModemSimulator::queueFrame(DLCI_t dlci, std::uint8_t control, const std::uint8_t *data, std::size_t size)
+    {
+        if (roll(config.dropFramePercent)) {
+            return;
+        }
+
+        std::vector<std::uint8_t> frame(CellularMuxFrame::serializedSize(size));
+        const auto address = static_cast<std::uint8_t>(dlci << 2);
+        CellularMuxFrame::serialize(address, control, data, size, frame.data(), frame.size());
+        if (roll(config.corruptFramePercent)) {
+            frame[frame.size() - 2] ^= 0xFF;
+        }
+        queueBytes(std::move(frame));
+    }
+
+    void ModemSimulator::queueBytes(std::vector<std::uint8_t> bytes)
+    {
+        output.push_back(Chunk{Clock::now() + config.latency, std::move(bytes)});
+        if (transmitNotifier) {
+            transmitNotifier();
+        }
+    }
+
+    DLCI_t ModemSimulator::urcChannel() const
+    {
+        if (!muxActive) {
+            return noMux;
+        }
+        return openChannels.count(notificationsDLCI) != 0 ? notificationsDLCI : commandsDLCI;
+    }
+
+    bool ModemSimulator::roll(unsigned percent)
+    {
+        return percent != 0 && std::uniform_int_distribution<unsigned>{0, 99}(random) < percent;
+    }
+
+    std::string ModemSimulator::smsHeader(const Sms &sms) const
+    {
+        return std::string{sms.read ? "\"REC READ\"" : "\"REC UNREAD\""} + ",\"" + sms.number + "\",," + smsTimestamp;
+    }
+} // namespace cellular::simulator
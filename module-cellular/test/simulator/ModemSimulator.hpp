@@ -0,0 +1,184 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <modem/mux/CellularMuxParser.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace cellular::simulator
+{
+    /// Host side stand-in for the Quectel modem.
+    ///
+    /// Speaks plain AT until AT+CMUX and TS 07.10 basic mode afterwards. Registration, calls and SMS commands are
+    /// simulated, any command can be overridden with a scripted response. The simulator doesn't depend on the
+    /// transport: bytes written by the host are passed to receive() and bytes for the host are taken with transmit().
+    class ModemSimulator
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+        using Lines = std::vector<std::string>;
+        /// Gets the command text following the matched prefix, returns response lines including the final result
+        using Handler = std::function<Lines(const std::string &arguments)>;
+
+        struct Config
+        {
+            std::chrono::milliseconds latency = std::chrono::milliseconds::zero(); ///< delay of every response
+            unsigned errorPercent             = 0; ///< commands answered with ERROR
+            unsigned dropFramePercent         = 0; ///< CMUX frames which are never sent
+            unsigned corruptFramePercent      = 0; ///< CMUX frames sent with a broken FCS
+            std::uint32_t seed                = 0;
+            bool echo                         = true;
+            /// modem initialisation sends a lot of configuration commands which don't need to be simulated
+            std::string unknownCommandResult = "OK";
+        };
+
+        struct Call
+        {
+            enum class State
+            {
+                Active   = 0,
+                Held     = 1,
+                Dialing  = 2,
+                Alerting = 3,
+                Incoming = 4,
+                Waiting  = 5
+            };
+
+            std::string number;
+            bool incoming;
+            State state;
+        };
+
+        struct Sms
+        {
+            std::string number;
+            std::string text;
+            bool read = false;
+        };
+
+        static constexpr DLCI_t commandsDLCI      = 1;
+        static constexpr DLCI_t notificationsDLCI = 2;
+
+        ModemSimulator();
+        explicit ModemSimulator(Config config);
+
+        /// Scripted responses take precedence over the simulated commands, the most recently added rule wins
+        void addRule(const std::string &prefix, Lines response);
+        void addRule(const std::string &prefix, Handler handler);
+
+        /// Bytes written by the host
+        void receive(const std::uint8_t *data, std::size_t size);
+        /// Bytes for the host which are due at the given time
+        std::vector<std::uint8_t> transmit(Clock::time_point now = Clock::now());
+        std::optional<Clock::time_point> nextTransmission() const;
+        /// Called whenever new bytes for the host are queued, e.g. to wake up the transport
+        void setTransmitNotifier(std::function<void()> notifier);
+
+        void setRegistered(bool registered);
+        void setSignalQuality(unsigned rssi);
+        void incomingCall(const std::string &number);
+        void remoteAnswer();
+        void remoteHangup();
+        void receiveSms(const std::string &number, const std::string &text);
+        void sendUrc(const std::string &urc);
+        void urcStorm(const std::string &urc, std::size_t count);
+
+        bool isMuxActive() const;
+        std::vector<Call> getCalls() const;
+        std::map<unsigned, Sms> getStoredMessages() const;
+        std::vector<Sms> getSentMessages() const;
+        Lines getCommandLog() const;
+
+      private:
+        static constexpr DLCI_t noMux = -1;
+
+        struct Channel
+        {
+            std::string line;
+            bool prompt = false; ///< collecting the SMS text until Ctrl+Z
+            std::string promptCommand;
+            std::string promptNumber;
+        };
+
+        struct Chunk
+        {
+            Clock::time_point due;
+            std::vector<std::uint8_t> bytes;
+        };
+
+        using Builtin = Lines (ModemSimulator::*)(DLCI_t dlci, const std::string &arguments);
+
+        void handleFrame(const CellularMuxFrameView &frame);
+        void handleControlMessage(const std::uint8_t *data, std::size_t size);
+        void handleChannelData(DLCI_t dlci, const std::uint8_t *data, std::size_t size);
+        void handlePromptData(DLCI_t dlci, Channel &channel, char c);
+        void handleLine(DLCI_t dlci, const std::string &line);
+        Lines runCommand(DLCI_t dlci, const std::string &command);
+
+        Lines cmux(DLCI_t dlci, const std::string &arguments);
+        Lines echoMode(DLCI_t dlci, const std::string &arguments);
+        Lines registrationMode(DLCI_t dlci, const std::string &arguments);
+        Lines registrationStatus(DLCI_t dlci, const std::string &arguments);
+        Lines signalQuality(DLCI_t dlci, const std::string &arguments);
+        Lines currentOperator(DLCI_t dlci, const std::string &arguments);
+        Lines networkInfo(DLCI_t dlci, const std::string &arguments);
+        Lines dial(DLCI_t dlci, const std::string &arguments);
+        Lines answer(DLCI_t dlci, const std::string &arguments);
+        Lines hangup(DLCI_t dlci, const std::string &arguments);
+        Lines listCalls(DLCI_t dlci, const std::string &arguments);
+        Lines smsFormat(DLCI_t dlci, const std::string &arguments);
+        Lines sendSms(DLCI_t dlci, const std::string &arguments);
+        Lines quectelSendSms(DLCI_t dlci, const std::string &arguments);
+        Lines listSms(DLCI_t dlci, const std::string &arguments);
+        Lines readSms(DLCI_t dlci, const std::string &arguments);
+        Lines deleteSms(DLCI_t dlci, const std::string &arguments);
+        Lines startPrompt(DLCI_t dlci, const std::string &command, const std::string &arguments);
+
+        void queueUrc(const std::string &urc);
+        void queueLines(DLCI_t dlci, const Lines &lines);
+        void queueText(DLCI_t dlci, const std::string &text);
+        void queueFrame(DLCI_t dlci, std::uint8_t control, const std::uint8_t *data, std::size_t size);
+        void queueBytes(std::vector<std::uint8_t> bytes);
+        DLCI_t urcChannel() const;
+        bool roll(unsigned percent);
+        std::string smsHeader(const Sms &sms) const;
+
+        const Config config;
+        mutable std::mutex mutex;
+        std::mt19937 random;
+        std::function<void()> transmitNotifier;
+
+        std::vector<std::pair<std::string, Handler>> rules;
+        static const std::vector<std::pair<std::string, Builtin>> builtins;
+
+        CellularMuxParser parser;
+        bool muxActive    = false;
+        bool muxRequested = false; ///< switch to CMUX after the response to AT+CMUX is sent
+        bool echo;
+        std::map<DLCI_t, Channel> channels;
+        std::set<DLCI_t> openChannels;
+        std::deque<Chunk> output;
+
+        bool registered           = true;
+        unsigned registrationUrc  = 0;
+        unsigned rssi             = 20;
+        bool textMode             = false;
+        unsigned messageReference = 0;
+        std::vector<Call> calls;
+        std::map<unsigned, Sms> storedMessages;
+        std::vector<Sms> sentMessages;
+        Lines commandLog;
+    };
+} // namespace cellular::simulator
@@ -0,0 +1,142 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "PtyTransport.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace cellular::simulator
+{
+    namespace
+    {
+        constexpr std::size_t readChunkSize = 1024;
+
+        void closeFd(int &fd)
+        {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        bool writeAll(int fd, const std::uint8_t *data, std::size_t size)
+        {
+            while (size > 0) {
+                const auto written = ::write(fd, data, size);
+                if (written < 0) {
+                    if (errno == EINTR || errno == EAGAIN) {
+                        continue;
+                    }
+                    return false;
+                }
+                data += written;
+                size -= static_cast<std::size_t>(written);
+            }
+            return true;
+        }
+    } // namespace
+
+    PtyTransport::PtyTransport(ModemSimulator &modem) : modem{modem}
+    {}
+
+    PtyTransport::~PtyTransport()
+    {
+        stop();
+    }
+
+    bool PtyTransport::start()
+    {
+        master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) {
+            stop();
+            return false;
+        }
+        path = ::ptsname(master);
+
+        slave = ::open(path.c_str(), O_RDWR | O_NOCTTY);
+        if (slave < 0) {
+            stop();
+            return false;
+        }
+        termios settings{};
+        ::tcgetattr(slave, &settings);
+        ::cfmakeraw(&settings);
+        ::tcsetattr(slave, TCSANOW, &settings);
+
+        wakeFd = ::eventfd(0, EFD_NONBLOCK);
+        if (wakeFd < 0) {
+            stop();
+            return false;
+        }
+
+        modem.setTransmitNotifier([this]() { wakeUp(); });
+        running = true;
+        thread  = std::thread([this]() { run(); });
+        return true;
+    }
+
+    void PtyTransport::stop()
+    {
+        if (running.exchange(false)) {
+            wakeUp();
+            thread.join();
+            modem.setTransmitNotifier(nullptr);
+        }
+        closeFd(wakeFd);
+        closeFd(slave);
+        closeFd(master);
+    }
+
+    std::string PtyTransport::getPath() const
+    {
+        return path;
+    }
+
+    void PtyTransport::run()
+    {
+        std::array<std::uint8_t, readChunkSize> buffer{};
+        std::array<pollfd, 2> fds{pollfd{master, POLLIN, 0}, pollfd{wakeFd, POLLIN, 0}};
+
+        while (running) {
+            auto timeout = -1;
+            if (const auto due = modem.nextTransmission(); due.has_value()) {
+                const auto remaining =
+                    std::chrono::ceil<std::chrono::milliseconds>(*due - ModemSimulator::Clock::now()).count();
+                timeout = static_cast<int>(std::max<decltype(remaining)>(remaining, 0));
+            }
+
+            if (::poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR) {
+                break;
+            }
+
+            if ((fds[1].revents & POLLIN) != 0) {
+                std::uint64_t events;
+                [[maybe_unused]] const auto ret = ::read(wakeFd, &events, sizeof(events));
+            }
+            if ((fds[0].revents & POLLIN) != 0) {
+                if (const auto size = ::read(master, buffer.data(), buffer.size()); size > 0) {
+                    modem.receive(buffer.data(), static_cast<std::size_t>(size));
+                }
+            }
+
+            if (const auto bytes = modem.transmit(); !bytes.empty() && !writeAll(master, bytes.data(), bytes.size())) {
+                break;
+            }
+        }
+    }
+
+    void PtyTransport::wakeUp()
+    {
+        const std::uint64_t event       = 1;
+        [[maybe_unused]] const auto ret = ::write(wakeFd, &event, sizeof(event));
+    }
+} // namespace cellular::simulator
@@ -0,0 +1,43 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "ModemSimulator.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace cellular::simulator
+{
+    /// Attaches the simulator to a pseudo terminal, the linux build opens its slave side as the modem serial port
+    /// (-DSERIAL_PORT=<path>). Bytes are moved by a separate thread.
+    class PtyTransport
+    {
+      public:
+        explicit PtyTransport(ModemSimulator &modem);
+        ~PtyTransport();
+
+        PtyTransport(const PtyTransport &) = delete;
+        PtyTransport &operator=(const PtyTransport &) = delete;
+
+        bool start();
+        void stop();
+
+        /// Path of the slave side, e.g. /dev/pts/3
+        std::string getPath() const;
+
+      private:
+        void run();
+        void wakeUp();
+
+        ModemSimulator &modem;
+        std::thread thread;
+        std::atomic_bool running{false};
+        int master = -1;
+        int slave  = -1; ///< kept open so reads from the master don't fail while nobody uses the port
+        int wakeFd = -1;
+        std::string path;
+    };
+} // namespace cellular::simulator
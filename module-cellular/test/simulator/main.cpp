@@ -0,0 +1,124 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "ModemSimulator.hpp"
+#include "PtyTransport.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+// Usage: modem-simulator [--latency <ms>] [--error <%>] [--drop <%>] [--corrupt <%>] [--seed <n>]
+// Prints the pty path to pass as -DSERIAL_PORT and reads events from the standard input:
+//     call <number> | answer | hangup | sms <number> <text> | urc <text> | storm <count> <text> | register <0|1> |
+//     csq <rssi> | quit
+namespace
+{
+    using cellular::simulator::ModemSimulator;
+
+    bool parseArguments(int argc, char *argv[], ModemSimulator::Config &config)
+    {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            unsigned value = 0;
+            try {
+                value = static_cast<unsigned>(std::stoul(argv[i + 1]));
+            }
+            catch (const std::exception &) {
+                return false;
+            }
+            if (std::strcmp(argv[i], "--latency") == 0) {
+                config.latency = std::chrono::milliseconds{value};
+            }
+            else if (std::strcmp(argv[i], "--error") == 0) {
+                config.errorPercent = value;
+            }
+            else if (std::strcmp(argv[i], "--drop") == 0) {
+                config.dropFramePercent = value;
+            }
+            else if (std::strcmp(argv[i], "--corrupt") == 0) {
+                config.corruptFramePercent = value;
+            }
+            else if (std::strcmp(argv[i], "--seed") == 0) {
+                config.seed = value;
+            }
+            else {
+                return false;
+            }
+        }
+        return argc % 2 == 1;
+    }
+
+    std::string rest(std::istringstream &stream)
+    {
+        std::string text;
+        std::getline(stream >> std::ws, text);
+        return text;
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    ModemSimulator::Config config;
+    if (!parseArguments(argc, argv, config)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--latency <ms>] [--error <%>] [--drop <%>] [--corrupt <%>] [--seed <n>]" << std::endl;
+        return 1;
+    }
+
+    ModemSimulator modem{config};
+    cellular::simulator::PtyTransport transport{modem};
+    if (!transport.start()) {
+        std::cerr << "Unable to open the pseudo terminal" << std::endl;
+        return 1;
+    }
+    std::cout << transport.getPath() << std::endl;
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream stream{line};
+        std::string event;
+        stream >> event;
+
+        if (event == "call") {
+            modem.incomingCall(rest(stream));
+        }
+        else if (event == "answer") {
+            modem.remoteAnswer();
+        }
+        else if (event == "hangup") {
+            modem.remoteHangup();
+        }
+        else if (event == "sms") {
+            std::string number;
+            stream >> number;
+            modem.receiveSms(number, rest(stream));
+        }
+        else if (event == "urc") {
+            modem.sendUrc(rest(stream));
+        }
+        else if (event == "storm") {
+            std::size_t count = 0;
+            stream >> count;
+            modem.urcStorm(rest(stream), count);
+        }
+        else if (event == "register") {
+            unsigned registered = 0;
+            stream >> registered;
+            modem.setRegistered(registered != 0);
+        }
+        else if (event == "csq") {
+            unsigned rssi = 0;
+            stream >> rssi;
+            modem.setSignalQuality(rssi);
+        }
+        else if (event == "quit") {
+            break;
+        }
+        else if (!event.empty()) {
+            std::cerr << "Unknown event: " << event << std::endl;
+        }
+    }
+
+    transport.stop();
+    return 0;
+}
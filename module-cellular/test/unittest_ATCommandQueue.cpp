@@ -0,0 +1,95 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+#include <modem/ATCommandQueue.hpp>
+
+using Priority = at::CommandQueue::Priority;
+
+TEST_CASE("AT command queue")
+{
+    at::CommandQueue queue;
+    REQUIRE(queue.empty());
+    REQUIRE_FALSE(queue.pop().has_value());
+
+    SECTION("Same priority in order of arrival")
+    {
+        queue.push(at::Cmd{"AT+CSQ"}, nullptr);
+        queue.push(at::Cmd{"AT+CREG?"}, nullptr);
+        REQUIRE(queue.size() == 2);
+
+        REQUIRE(queue.pop()->cmd.getCmd() == "AT+CSQ");
+        REQUIRE(queue.pop()->cmd.getCmd() == "AT+CREG?");
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("Call control ahead of housekeeping")
+    {
+        queue.push(at::Cmd{"AT+COPS=?"}, nullptr, Priority::Housekeeping);
+        queue.push(at::Cmd{"AT+CMGL"}, nullptr, Priority::Normal);
+        queue.push(at::Cmd{"ATA"}, nullptr, Priority::CallControl);
+
+        REQUIRE(queue.pop()->cmd.getCmd() == "ATA");
+        REQUIRE(queue.pop()->cmd.getCmd() == "AT+CMGL");
+        REQUIRE(queue.pop()->cmd.getCmd() == "AT+COPS=?");
+    }
+
+    SECTION("Timeout and callback are kept")
+    {
+        at::Result received;
+        queue.push(at::Cmd{"AT+COPS=?", std::chrono::seconds{180}},
+                   [&received](const at::Result &result) { received = result; });
+
+        auto entry = queue.pop();
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->cmd.getTimeout() == std::chrono::seconds{180});
+        entry->callback(at::Result{at::Result::Code::OK, {"+COPS: 1"}});
+        REQUIRE(received.code == at::Result::Code::OK);
+        REQUIRE(received.response.front() == "+COPS: 1");
+    }
+
+    SECTION("Cancel")
+    {
+        const auto first  = queue.push(at::Cmd{"AT+CSQ"}, nullptr);
+        const auto second = queue.push(at::Cmd{"AT+CREG?"}, nullptr, Priority::Housekeeping);
+        REQUIRE(first != second);
+
+        auto cancelled = queue.cancel(second);
+        REQUIRE(cancelled.has_value());
+        REQUIRE(cancelled->cmd.getCmd() == "AT+CREG?");
+        REQUIRE_FALSE(queue.cancel(second).has_value());
+
+        REQUIRE(queue.pop()->id == first);
+        REQUIRE_FALSE(queue.cancel(first).has_value());
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("Clear")
+    {
+        queue.push(at::Cmd{"AT+CSQ"}, nullptr, Priority::Housekeeping);
+        queue.push(at::Cmd{"ATH"}, nullptr, Priority::CallControl);
+
+        const auto removed = queue.clear();
+        REQUIRE(removed.size() == 2);
+        REQUIRE(removed.front().cmd.getCmd() == "ATH");
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("Sequence keeps its place in the queue")
+    {
+        queue.push(at::Cmd{"AT+CSQ"}, nullptr, Priority::Housekeeping);
+        queue.push([](at::BaseChannel &) { return at::Result{at::Result::Code::OK, {"+CMGR: 1"}}; },
+                   nullptr,
+                   Priority::Normal);
+        queue.push(at::Cmd{"AT+CREG?"}, nullptr, Priority::Normal);
+
+        auto sequence = queue.pop();
+        REQUIRE(sequence.has_value());
+        REQUIRE(sequence->sequence);
+        REQUIRE(queue.pop()->cmd.getCmd() == "AT+CREG?");
+        REQUIRE_FALSE(queue.pop()->sequence);
+        REQUIRE(queue.empty());
+    }
+}
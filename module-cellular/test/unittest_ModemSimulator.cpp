@@ -0,0 +1,322 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+#include <ModemSimulator.hpp>
+#include <PtyTransport.hpp>
+#include <modem/mux/CellularMuxFrame.h>
+#include <modem/mux/CellularMuxParser.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <map>
+#include <string>
+
+using cellular::simulator::ModemSimulator;
+
+namespace
+{
+    constexpr auto farFuture = ModemSimulator::Clock::time_point::max();
+
+    std::string send(ModemSimulator &modem, const std::string &text)
+    {
+        modem.receive(reinterpret_cast<const std::uint8_t *>(text.data()), text.size());
+        const auto bytes = modem.transmit(farFuture);
+        return std::string(bytes.begin(), bytes.end());
+    }
+
+    /// Host side of the multiplexer, collects the received payloads per DLCI
+    class MuxHost
+    {
+      public:
+        explicit MuxHost(ModemSimulator &modem) : modem{modem}
+        {}
+
+        void start()
+        {
+            send(modem, "AT+CMUX=0\r");
+            for (DLCI_t dlci = 0; dlci <= ModemSimulator::notificationsDLCI; ++dlci) {
+                frame(dlci, static_cast<std::uint8_t>(TypeOfFrame_e::SABM), "");
+            }
+        }
+
+        void frame(DLCI_t dlci, std::uint8_t control, const std::string &data)
+        {
+            std::vector<std::uint8_t> out(CellularMuxFrame::serializedSize(data.size()));
+            CellularMuxFrame::serialize(static_cast<std::uint8_t>((dlci << 2) | 0x02),
+                                        control,
+                                        reinterpret_cast<const std::uint8_t *>(data.data()),
+                                        data.size(),
+                                        out.data(),
+                                        out.size());
+            modem.receive(out.data(), out.size());
+            collect();
+        }
+
+        void command(const std::string &cmd)
+        {
+            frame(ModemSimulator::commandsDLCI, static_cast<std::uint8_t>(TypeOfFrame_e::UIH), cmd + "\r");
+        }
+
+        void collect()
+        {
+            const auto bytes = modem.transmit(farFuture);
+            parser.feed(bytes.data(), bytes.size());
+            while (auto frame = parser.next()) {
+                if (frame->status != CellularMuxFrame::OK) {
+                    ++badFrames;
+                    continue;
+                }
+                frames[frame->getDLCI()].push_back(frame->control);
+                received[frame->getDLCI()].append(reinterpret_cast<const char *>(frame->data), frame->dataSize);
+            }
+        }
+
+        std::string take(DLCI_t dlci)
+        {
+            auto text = std::move(received[dlci]);
+            received[dlci].clear();
+            return text;
+        }
+
+        ModemSimulator &modem;
+        CellularMuxParser parser;
+        std::map<DLCI_t, std::string> received;
+        std::map<DLCI_t, std::vector<std::uint8_t>> frames;
+        unsigned badFrames = 0;
+    };
+
+    ModemSimulator::Config quietConfig()
+    {
+        ModemSimulator::Config config;
+        config.echo = false;
+        return config;
+    }
+} // namespace
+
+TEST_CASE("Modem simulator AT mode")
+{
+    ModemSimulator modem;
+
+    SECTION("Echo and final result")
+    {
+        REQUIRE(send(modem, "AT\r") == "AT\r\r\nOK\r\n");
+        REQUIRE(send(modem, "ATE0\r") == "ATE0\r\r\nOK\r\n");
+        REQUIRE(send(modem, "AT\r") == "\r\nOK\r\n");
+    }
+
+    SECTION("Command split into chunks")
+    {
+        REQUIRE(send(modem, "ATE0\r\nAT+C").find("OK") != std::string::npos);
+        REQUIRE(send(modem, "SQ\r") == "\r\n+CSQ: 20,99\r\n\r\nOK\r\n");
+    }
+
+    SECTION("Scripted rule overrides simulated command")
+    {
+        modem.addRule("AT+CSQ", ModemSimulator::Lines{"+CSQ: 5,99", "OK"});
+        modem.addRule("AT+QSIMSTAT?", [](const std::string &) { return ModemSimulator::Lines{"+CME ERROR: 10"}; });
+        send(modem, "ATE0\r");
+
+        REQUIRE(send(modem, "AT+CSQ\r") == "\r\n+CSQ: 5,99\r\n\r\nOK\r\n");
+        REQUIRE(send(modem, "AT+QSIMSTAT?\r") == "\r\n+CME ERROR: 10\r\n");
+        REQUIRE(modem.getCommandLog().back() == "AT+QSIMSTAT?");
+    }
+
+    SECTION("Unknown command")
+    {
+        send(modem, "ATE0\r");
+        REQUIRE(send(modem, "AT+QCFG=\"urc/ri/ring\"\r") == "\r\nOK\r\n");
+    }
+
+    SECTION("Registration")
+    {
+        send(modem, "ATE0\r");
+        send(modem, "AT+CREG=1\r");
+        REQUIRE(send(modem, "AT+CREG?\r") == "\r\n+CREG: 1,1\r\n\r\nOK\r\n");
+
+        modem.setRegistered(false);
+        REQUIRE(send(modem, "") == "\r\n+CREG: 0\r\n");
+        REQUIRE(send(modem, "AT+COPS?\r") == "\r\n+COPS: 0\r\n\r\nOK\r\n");
+        REQUIRE(send(modem, "ATD123;\r") == "\r\nNO CARRIER\r\n");
+    }
+}
+
+TEST_CASE("Modem simulator CMUX")
+{
+    ModemSimulator modem{quietConfig()};
+    MuxHost host{modem};
+    host.start();
+
+    REQUIRE(modem.isMuxActive());
+    REQUIRE(host.frames[0] == std::vector<std::uint8_t>{static_cast<std::uint8_t>(MuxDefines::GSM0710_TYPE_UA)});
+    REQUIRE(host.frames[1].size() == 1);
+
+    SECTION("Commands on the commands channel")
+    {
+        host.command("AT+CSQ");
+        REQUIRE(host.take(ModemSimulator::commandsDLCI) == "\r\n+CSQ: 20,99\r\n\r\nOK\r\n");
+    }
+
+    SECTION("Long response is split into frames")
+    {
+        const std::string longLine(300, 'x');
+        modem.addRule("AT+QLONG", ModemSimulator::Lines{longLine, "OK"});
+        host.frames.clear();
+
+        host.command("AT+QLONG");
+        REQUIRE(host.frames[ModemSimulator::commandsDLCI].size() == 3);
+        REQUIRE(host.take(ModemSimulator::commandsDLCI) == "\r\n" + longLine + "\r\n\r\nOK\r\n");
+    }
+
+    SECTION("URCs on the notifications channel")
+    {
+        modem.urcStorm("+QIND: \"csq\",20,99", 10);
+        host.collect();
+        REQUIRE(host.frames[ModemSimulator::notificationsDLCI].size() == 1 + 10);
+        REQUIRE(host.take(ModemSimulator::commandsDLCI).empty());
+    }
+
+    SECTION("Incoming call")
+    {
+        modem.incomingCall("+48123456789");
+        host.collect();
+        REQUIRE(host.take(ModemSimulator::notificationsDLCI) ==
+                "\r\nRING\r\n\r\n+CLIP: \"+48123456789\",145,,,,0\r\n");
+
+        host.command("AT+CLCC");
+        REQUIRE(host.take(ModemSimulator::commandsDLCI) == "\r\n+CLCC: 1,1,4,0,0,\"+48123456789\",145\r\n\r\nOK\r\n");
+        host.command("ATA");
+        REQUIRE(modem.getCalls().front().state == ModemSimulator::Call::State::Active);
+
+        modem.remoteHangup();
+        host.collect();
+        REQUIRE(host.take(ModemSimulator::notificationsDLCI) == "\r\nNO CARRIER\r\n");
+        REQUIRE(modem.getCalls().empty());
+    }
+
+    SECTION("Outgoing call")
+    {
+        host.command("ATD+48123456789;");
+        REQUIRE(host.take(ModemSimulator::commandsDLCI) == "\r\nOK\r\n");
+        REQUIRE(modem.getCalls().front().state == ModemSimulator::Call::State::Alerting);
+        modem.remoteAnswer();
+        REQUIRE(modem.getCalls().front().state == ModemSimulator::Call::State::Active);
+        host.command("ATH");
+        REQUIRE(modem.getCalls().empty());
+    }
+
+    SECTION("Send SMS")
+    {
+        host.command("AT+CMGF=1");
+        host.command("AT+CMGS=\"+48123456789\"");
+        REQUIRE(host.take(ModemSimulator::commandsDLCI) == "\r\nOK\r\n\r\n> ");
+
+        host.frame(ModemSimulator::commandsDLCI, static_cast<std::uint8_t>(TypeOfFrame_e::UIH), "Hello\x1A");
+        REQUIRE(host.take(ModemSimulator::commandsDLCI) == "\r\n+CMGS: 0\r\n\r\nOK\r\n");
+        const auto sent = modem.getSentMessages();
+        REQUIRE(sent.size() == 1);
+        REQUIRE(sent.front().number == "+48123456789");
+        REQUIRE(sent.front().text == "Hello");
+    }
+
+    SECTION("Receive and list SMS")
+    {
+        modem.receiveSms("+48111", "first");
+        modem.receiveSms("+48222", "second");
+        host.collect();
+        REQUIRE(host.take(ModemSimulator::notificationsDLCI) == "\r\n+CMTI: \"ME\",0\r\n\r\n+CMTI: \"ME\",1\r\n");
+
+        host.command("AT+CMGR=1");
+        REQUIRE(host.take(ModemSimulator::commandsDLCI) ==
+                "\r\n+CMGR: \"REC UNREAD\",\"+48222\",,\"21/01/01,12:00:00+04\"\r\nsecond\r\n\r\nOK\r\n");
+
+        host.command("AT+CMGL=\"REC UNREAD\"");
+        REQUIRE(host.take(ModemSimulator::commandsDLCI) ==
+                "\r\n+CMGL: 0,\"REC UNREAD\",\"+48111\",,\"21/01/01,12:00:00+04\"\r\nfirst\r\n\r\nOK\r\n");
+
+        host.command("AT+CMGD=0,1");
+        REQUIRE(modem.getStoredMessages().empty());
+    }
+
+    SECTION("Multiplexer close down")
+    {
+        host.frame(0, static_cast<std::uint8_t>(TypeOfFrame_e::UIH), std::string{"\xC3\x01", 2});
+        REQUIRE_FALSE(modem.isMuxActive());
+        REQUIRE(send(modem, "AT\r") == "\r\nOK\r\n");
+    }
+}
+
+TEST_CASE("Modem simulator error injection")
+{
+    auto config = quietConfig();
+
+    SECTION("Latency")
+    {
+        config.latency = std::chrono::milliseconds{100};
+        ModemSimulator modem{config};
+        const auto start = ModemSimulator::Clock::now();
+        modem.receive(reinterpret_cast<const std::uint8_t *>("AT\r"), 3);
+
+        REQUIRE(modem.transmit(start).empty());
+        REQUIRE(modem.nextTransmission() >= start + config.latency);
+        REQUIRE_FALSE(modem.transmit(start + config.latency + std::chrono::seconds{1}).empty());
+    }
+
+    SECTION("Command errors")
+    {
+        config.errorPercent = 100;
+        ModemSimulator modem{config};
+        REQUIRE(send(modem, "AT+CSQ\r") == "\r\nERROR\r\n");
+    }
+
+    SECTION("Dropped frames")
+    {
+        config.dropFramePercent = 100;
+        ModemSimulator modem{config};
+        MuxHost host{modem};
+        host.start();
+        host.command("AT");
+        REQUIRE(host.frames.empty());
+        REQUIRE(host.take(ModemSimulator::commandsDLCI).empty());
+    }
+
+    SECTION("Corrupted frames")
+    {
+        config.corruptFramePercent = 100;
+        ModemSimulator modem{config};
+        MuxHost host{modem};
+        host.start();
+        host.command("AT");
+        // FCS of UA frames is not checked
+        REQUIRE(host.badFrames == 1);
+        REQUIRE(host.take(ModemSimulator::commandsDLCI).empty());
+    }
+}
+
+TEST_CASE("Modem simulator over pty")
+{
+    ModemSimulator modem{quietConfig()};
+    cellular::simulator::PtyTransport transport{modem};
+    REQUIRE(transport.start());
+
+    const auto fd = ::open(transport.getPath().c_str(), O_RDWR | O_NOCTTY);
+    REQUIRE(fd >= 0);
+    REQUIRE(::write(fd, "AT+CSQ\r", 7) == 7);
+
+    std::string response;
+    pollfd readable{fd, POLLIN, 0};
+    while (response.find("OK\r\n") == std::string::npos && ::poll(&readable, 1, 1000) > 0) {
+        char buffer[64];
+        const auto size = ::read(fd, buffer, sizeof(buffer));
+        REQUIRE(size > 0);
+        response.append(buffer, size);
+    }
+    ::close(fd);
+    transport.stop();
+
+    REQUIRE(response == "\r\n+CSQ: 20,99\r\n\r\nOK\r\n");
+}
@@ -5,6 +5,7 @@
 
 #include <catch2/catch.hpp>
 #include <modem/mux/CellularMuxFrame.h>
+#include <modem/mux/CellularMuxParser.h>
 #include <modem/mux/CellularMuxTypes.h>
 #include <bsp/cellular/bsp_cellular.hpp>
 
@@ -81,3 +82,235 @@ TEST_CASE("TS0170 frame")
         REQUIRE(frame.isComplete(frame.getSerData()) == false);
     }
 }
+
+namespace
+{
+    std::vector<uint8_t> makeFrame(DLCI_t DLCI, const std::vector<uint8_t> &data)
+    {
+        std::vector<uint8_t> frame(CellularMuxFrame::serializedSize(data.size()));
+        frame.resize(CellularMuxFrame::serialize(static_cast<uint8_t>(DLCI << 2),
+                                                 static_cast<uint8_t>(TypeOfFrame_e::UIH),
+                                                 data.data(),
+                                                 data.size(),
+                                                 frame.data(),
+                                                 frame.size()));
+        return frame;
+    }
+
+    std::vector<uint8_t> toVector(const CellularMuxFrameView &frame)
+    {
+        return {frame.data, frame.data + frame.dataSize};
+    }
+} // namespace
+
+TEST_CASE("CMUX frame serialization in place")
+{
+    const std::vector<uint8_t> command{'A', 'T', '\r'};
+
+    SECTION("Short frame")
+    {
+        const std::vector<uint8_t> expected{0xf9, 0x09, 0xef, 0x07, 0x41, 0x54, 0x0d, 0x35, 0xf9};
+        REQUIRE(makeFrame(2, command) == expected);
+
+        CellularMuxFrame::frame_t tempFrame;
+        tempFrame.Address = static_cast<uint8_t>(2 << 2);
+        tempFrame.Control = static_cast<uint8_t>(TypeOfFrame_e::UIH);
+        tempFrame.data    = command;
+        REQUIRE(tempFrame.serialize() == expected);
+    }
+
+    SECTION("Frame without data")
+    {
+        std::array<uint8_t, CellularMuxFrame::serializedSize(0)> frame;
+        const auto size = CellularMuxFrame::serialize(
+            0x03, static_cast<uint8_t>(TypeOfFrame_e::SABM), nullptr, 0, frame.data(), frame.size());
+        REQUIRE(size == frame.size());
+        REQUIRE(frame == std::array<uint8_t, 6>{0xf9, 0x03, 0x3f, 0x01, 0x1c, 0xf9});
+    }
+
+    SECTION("Output buffer too small")
+    {
+        std::array<uint8_t, 8> frame;
+        REQUIRE(CellularMuxFrame::serialize(
+                    0x09, static_cast<uint8_t>(TypeOfFrame_e::UIH), command.data(), 3, frame.data(), frame.size()) ==
+                0);
+    }
+}
+
+TEST_CASE("CMUX parser")
+{
+    CellularMuxParser parser;
+    const std::vector<uint8_t> command{'A', 'T', '\r'};
+    const std::vector<uint8_t> response{'\r', '\n', 'O', 'K', '\r', '\n'};
+
+    SECTION("Frames in single chunk")
+    {
+        auto stream       = makeFrame(2, command);
+        const auto second = makeFrame(3, response);
+        stream.insert(stream.end(), second.begin(), second.end());
+
+        parser.feed(stream.data(), stream.size());
+        auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(frame->status == CellularMuxFrame::OK);
+        REQUIRE(frame->getDLCI() == 2);
+        REQUIRE(frame->control == static_cast<uint8_t>(TypeOfFrame_e::UIH));
+        REQUIRE(toVector(*frame) == command);
+        // frame is decoded in place
+        REQUIRE(frame->frame == stream.data());
+
+        frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(frame->getDLCI() == 3);
+        REQUIRE(toVector(*frame) == response);
+
+        REQUIRE_FALSE(parser.next().has_value());
+    }
+
+    SECTION("Frames sharing the flag")
+    {
+        auto stream       = makeFrame(2, command);
+        const auto second = makeFrame(3, response);
+        stream.insert(stream.end(), second.begin() + 1, second.end());
+
+        parser.feed(stream.data(), stream.size());
+        REQUIRE(parser.next().has_value());
+        const auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(toVector(*frame) == response);
+    }
+
+    SECTION("Frames in consecutive chunks are decoded in place")
+    {
+        const auto first  = makeFrame(2, command);
+        const auto second = makeFrame(3, response);
+        const auto third  = makeFrame(2, command);
+
+        for (const auto &chunk : {first, second, third}) {
+            parser.feed(chunk.data(), chunk.size());
+            const auto frame = parser.next();
+            REQUIRE(frame.has_value());
+            REQUIRE(frame->frame == chunk.data());
+            REQUIRE_FALSE(parser.next().has_value());
+        }
+    }
+
+    SECTION("Frames sharing the flag in consecutive chunks")
+    {
+        const auto first  = makeFrame(2, command);
+        const auto second = makeFrame(3, response);
+
+        parser.feed(first.data(), first.size());
+        REQUIRE(parser.next().has_value());
+        REQUIRE_FALSE(parser.next().has_value());
+        parser.feed(second.data() + 1, second.size() - 1);
+        const auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(frame->getDLCI() == 3);
+        REQUIRE(toVector(*frame) == response);
+    }
+
+    SECTION("Frame split into single bytes")
+    {
+        const auto stream = makeFrame(2, response);
+        for (auto i = 0U; i < stream.size() - 1; ++i) {
+            parser.feed(&stream[i], 1);
+            REQUIRE_FALSE(parser.next().has_value());
+        }
+        parser.feed(&stream.back(), 1);
+        const auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(frame->status == CellularMuxFrame::OK);
+        REQUIRE(toVector(*frame) == response);
+    }
+
+    SECTION("Flag inside data")
+    {
+        const std::vector<uint8_t> data{0x01, TS0710_FLAG, TS0710_FLAG, 0x02};
+        const auto stream = makeFrame(1, data);
+
+        parser.feed(stream.data(), 3);
+        REQUIRE_FALSE(parser.next().has_value());
+        parser.feed(stream.data() + 3, stream.size() - 3);
+        const auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(toVector(*frame) == data);
+    }
+
+    SECTION("Garbage before frame")
+    {
+        std::vector<uint8_t> stream{0x00, 0x41, 0x54};
+        const auto frame = makeFrame(2, command);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+
+        parser.feed(stream.data(), stream.size());
+        const auto decoded = parser.next();
+        REQUIRE(decoded.has_value());
+        REQUIRE(toVector(*decoded) == command);
+    }
+
+    SECTION("Incorrect trailing flag")
+    {
+        auto stream     = makeFrame(2, command);
+        stream.back()   = 0x00;
+        const auto next = makeFrame(3, response);
+        stream.insert(stream.end(), next.begin(), next.end());
+
+        parser.feed(stream.data(), stream.size());
+        const auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(frame->getDLCI() == 3);
+        REQUIRE(toVector(*frame) == response);
+    }
+
+    SECTION("FCS error")
+    {
+        auto stream               = makeFrame(2, command);
+        stream[stream.size() - 2] = 0x00;
+
+        parser.feed(stream.data(), stream.size());
+        const auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(frame->status == CellularMuxFrame::CRCError);
+        REQUIRE(frame->dataSize == 0);
+    }
+
+    SECTION("Long length")
+    {
+        std::vector<uint8_t> data(200);
+        for (auto i = 0U; i < data.size(); ++i) {
+            data[i] = static_cast<uint8_t>(i);
+        }
+        const auto stream = makeFrame(2, data);
+        REQUIRE(stream.size() == data.size() + 7);
+
+        parser.feed(stream.data(), stream.size() / 2);
+        REQUIRE_FALSE(parser.next().has_value());
+        parser.feed(stream.data() + stream.size() / 2, stream.size() - stream.size() / 2);
+        const auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(frame->status == CellularMuxFrame::OK);
+        REQUIRE(toVector(*frame) == data);
+    }
+
+    SECTION("Quectel length")
+    {
+        const std::vector<uint8_t> stream{0xf9, 0x09, 0xef, 0xff, 0x41, 0x54, 0x0d, 0x00, 0xf9};
+
+        parser.feed(stream.data(), stream.size());
+        const auto frame = parser.next();
+        REQUIRE(frame.has_value());
+        REQUIRE(frame->status == CellularMuxFrame::OK);
+        REQUIRE(toVector(*frame) == command);
+    }
+
+    SECTION("Reset drops pending data")
+    {
+        const auto stream = makeFrame(2, command);
+        parser.feed(stream.data(), 4);
+        REQUIRE_FALSE(parser.next().has_value());
+        parser.reset();
+        parser.feed(stream.data() + 4, stream.size() - 4);
+        REQUIRE_FALSE(parser.next().has_value());
+    }
+}
@@ -723,3 +723,51 @@ TEST_CASE("Response QCFG IMS")
         REQUIRE(at::response::parseQCFG_IMS(resp, ret) == false);
     }
 }
+
+TEST_CASE("Response CMGL")
+{
+    std::vector<std::string> ret;
+
+    SECTION("Messages listed")
+    {
+        at::Result resp;
+        resp.response.push_back("+CMGL: 0,\"REC READ\",\"+48600123456\",,\"21/01/01,12:00:00+04\"");
+        resp.response.push_back("Hello");
+        resp.response.push_back("+CMGL: 12,\"REC UNREAD\",\"+48600123456\",,\"21/01/01,12:00:01+04\"");
+        resp.response.push_back("World");
+        resp.response.push_back("OK");
+
+        REQUIRE(at::response::cmgl::parseIndexes(resp.response, ret) == true);
+        REQUIRE(ret == std::vector<std::string>{"0", "12"});
+    }
+
+    SECTION("Message text looking like a header")
+    {
+        at::Result resp;
+        resp.response.push_back("+CMGL: 3,\"REC UNREAD\",\"+48600123456\",,\"21/01/01,12:00:00+04\"");
+        resp.response.push_back("+CMGL: 7,\"REC UNREAD\"");
+        resp.response.push_back("OK");
+
+        REQUIRE(at::response::cmgl::parseIndexes(resp.response, ret) == true);
+        REQUIRE(ret == std::vector<std::string>{"3"});
+    }
+
+    SECTION("No messages")
+    {
+        at::Result resp;
+        resp.response.push_back("OK");
+
+        REQUIRE(at::response::cmgl::parseIndexes(resp.response, ret) == true);
+        REQUIRE(ret.empty());
+    }
+
+    SECTION("Invalid index")
+    {
+        at::Result resp;
+        resp.response.push_back("+CMGL: x,\"REC UNREAD\",\"+48600123456\",,\"21/01/01,12:00:00+04\"");
+        resp.response.push_back("Hello");
+
+        REQUIRE(at::response::cmgl::parseIndexes(resp.response, ret) == false);
+        REQUIRE(ret.empty());
+    }
+}
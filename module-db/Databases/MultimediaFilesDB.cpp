@@ -3,8 +3,41 @@
 
 #include "MultimediaFilesDB.hpp"
 
+#include <Database/DatabaseInitializer.hpp>
+#include <log/log.hpp>
+#include <purefs/filesystem_paths.hpp>
+
 namespace db::multimedia_files
 {
+    namespace
+    {
+        constexpr auto artistsAndAlbumsScript = "multimedia_002.sql";
+    } // namespace
+
     MultimediaFilesDB::MultimediaFilesDB(const char *name) : Database(name), files(this)
-    {}
+    {
+        if (isInitialized_ && isMigrationNeeded()) {
+            isInitialized_ = migrate();
+        }
+    }
+
+    bool MultimediaFilesDB::isMigrationNeeded()
+    {
+        const auto retQuery = query("SELECT name FROM sqlite_master WHERE type = 'table' AND name = 'artists';");
+        return (retQuery != nullptr) && (retQuery->getRowCount() == 0);
+    }
+
+    bool MultimediaFilesDB::migrate()
+    {
+        const auto script = purefs::dir::getUserDiskPath() / "db" / artistsAndAlbumsScript;
+        LOG_INFO("Migrating %s with %s", getName().c_str(), script.c_str());
+
+        const auto statements = initializer->readCommands(script);
+        if (statements.empty() || !initializer->executeOnDb(statements)) {
+            LOG_ERROR("Can't migrate %s", getName().c_str());
+            execute("ROLLBACK;");
+            return false;
+        }
+        return true;
+    }
 } // namespace db::multimedia_files
@@ -14,5 +14,11 @@ namespace db::multimedia_files
         explicit MultimediaFilesDB(const char *name);
 
         MultimediaFilesTable files;
+
+      private:
+        /// Init scripts run only when the database is created, databases created with the artist and album columns
+        /// in the files table are migrated when opened
+        bool isMigrationNeeded();
+        bool migrate();
     };
 } // namespace db::multimedia_files
@@ -6,6 +6,7 @@
 #include "ContactRecord.hpp"
 #include "ThreadRecord.hpp"
 #include "queries/messages/sms/QuerySMSAdd.hpp"
+#include "queries/messages/sms/QuerySMSAddMultiple.hpp"
 #include "queries/messages/sms/QuerySMSGet.hpp"
 #include "queries/messages/sms/QuerySMSGetByID.hpp"
 #include "queries/messages/sms/QuerySMSGetByText.hpp"
@@ -91,6 +92,46 @@ bool SMSRecordInterface::Add(const SMSRecord &rec)
 
     return true;
 }
+std::size_t SMSRecordInterface::AddMultiple(std::vector<SMSRecord> &records)
+{
+    // temporary contacts and threads are created on the way, a single commit saves a journal sync per record
+    if (!smsDB->execute("BEGIN TRANSACTION;")) {
+        LOG_ERROR("Cannot begin transaction");
+        return 0;
+    }
+    if (!contactsDB->execute("BEGIN TRANSACTION;")) {
+        LOG_ERROR("Cannot begin transaction");
+        smsDB->execute("ROLLBACK;");
+        return 0;
+    }
+
+    std::size_t added = 0;
+    for (auto &record : records) {
+        if (Add(record)) {
+            record.ID = GetLastID();
+            ++added;
+        }
+        else {
+            record.ID = DB_ID_NONE;
+        }
+    }
+
+    // the connection mustn't be left inside the transaction, nothing of the batch is stored then
+    auto committed = contactsDB->execute("COMMIT;");
+    if (!committed) {
+        contactsDB->execute("ROLLBACK;");
+    }
+    if (!committed || !smsDB->execute("COMMIT;")) {
+        LOG_ERROR("Cannot commit transaction");
+        smsDB->execute("ROLLBACK;");
+        for (auto &record : records) {
+            record.ID = DB_ID_NONE;
+        }
+        return 0;
+    }
+    return added;
+}
+
 uint32_t SMSRecordInterface::GetCount()
 {
     return smsDB->sms.count();
@@ -310,6 +351,9 @@ std::unique_ptr<db::QueryResult> SMSRecordInterface::runQuery(std::shared_ptr<db
     else if (typeid(*query) == typeid(db::query::SMSAdd)) {
         return addQuery(query);
     }
+    else if (typeid(*query) == typeid(db::query::SMSAddMultiple)) {
+        return addMultipleQuery(query);
+    }
     else if (typeid(*query) == typeid(db::query::SMSRemove)) {
         return removeQuery(query);
     }
@@ -415,6 +459,16 @@ std::unique_ptr<db::QueryResult> SMSRecordInterface::addQuery(const std::shared_
     response->setRequestQuery(query);
     return response;
 }
+std::unique_ptr<db::QueryResult> SMSRecordInterface::addMultipleQuery(const std::shared_ptr<db::Query> &query)
+{
+    const auto localQuery = static_cast<const db::query::SMSAddMultiple *>(query.get());
+    auto records          = localQuery->records;
+    const auto added      = AddMultiple(records);
+    auto response         = std::make_unique<db::query::SMSAddMultipleResult>(std::move(records), added);
+    response->setRequestQuery(query);
+    return response;
+}
+
 std::unique_ptr<db::QueryResult> SMSRecordInterface::removeQuery(const std::shared_ptr<db::Query> &query)
 {
     const auto localQuery = static_cast<const db::query::SMSRemove *>(query.get());
@@ -54,6 +54,9 @@ class SMSRecordInterface : public RecordInterface<SMSRecord, SMSRecordField>
     ~SMSRecordInterface() = default;
 
     bool Add(const SMSRecord &rec) override final;
+    /// Adds the records in a single transaction, IDs of the added records are updated
+    /// @return number of added records
+    std::size_t AddMultiple(std::vector<SMSRecord> &records);
     bool RemoveByID(uint32_t id) override final;
     bool RemoveByField(SMSRecordField field, const char *str) override final;
     bool Update(const SMSRecord &recUpdated) override final;
@@ -86,6 +89,7 @@ class SMSRecordInterface : public RecordInterface<SMSRecord, SMSRecordField>
     std::unique_ptr<db::QueryResult> getByTextQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> getCountQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> addQuery(const std::shared_ptr<db::Query> &query);
+    std::unique_ptr<db::QueryResult> addMultipleQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> removeQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> updateQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> getQuery(const std::shared_ptr<db::Query> &query);
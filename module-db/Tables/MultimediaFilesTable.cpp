@@ -9,6 +9,34 @@
 
 namespace db::multimedia_files
 {
+    namespace
+    {
+        constexpr auto filesJoin =
+            "files JOIN artists ON files.artist_id = artists._id JOIN albums ON files.album_id = albums._id";
+
+        /// Row layout matches the TableRow unpacked by CreateTableRow
+        std::string selectFiles(const char *clause)
+        {
+            return std::string("SELECT files._id, path, media_type, size, title, artist, album, comment, genre, year, "
+                               "track, song_length, bitrate, sample_rate, channels FROM ") +
+                   filesJoin + clause;
+        }
+
+        /// First string greater than all strings starting with the prefix, empty if there is no such string
+        std::string prefixUpperBound(std::string prefix)
+        {
+            while (!prefix.empty()) {
+                auto &last = reinterpret_cast<unsigned char &>(prefix.back());
+                if (last != 0xFF) {
+                    ++last;
+                    return prefix;
+                }
+                prefix.pop_back();
+            }
+            return prefix;
+        }
+    } // namespace
+
     TableRow CreateTableRow(const QueryResult &result)
     {
         if (result.getFieldCount() != magic_enum::enum_count<TableFields>() + 1) {
@@ -44,6 +72,7 @@ namespace db::multimedia_files
         createTableRow = CreateTableRow;
     }
 
+
     bool MultimediaFilesTable::create()
     {
         return true;
@@ -51,38 +80,44 @@ namespace db::multimedia_files
 
     bool MultimediaFilesTable::add(TableRow entry)
     {
-        return db->execute("INSERT INTO files (path, media_type, size, title, artist, album, "
-                           "comment, genre, year, track, song_length, bitrate, sample_rate, channels) "
-                           "VALUES('%q', '%q', %lu, '%q', '%q', '%q', '%q', '%q', %lu, %lu, %lu, %lu, %lu, %lu) "
-                           "ON CONFLICT(path) DO UPDATE SET "
-                           "path = excluded.path, "
-                           "media_type = excluded.media_type, "
-                           "size = excluded.size, "
-                           "title = excluded.title, "
-                           "artist = excluded.artist, "
-                           "album = excluded.album, "
-                           "comment = excluded.comment, "
-                           "genre = excluded.genre, "
-                           "year = excluded.year, "
-                           "track = excluded.track, "
-                           "song_length = excluded.song_length, "
-                           "bitrate = excluded.bitrate, "
-                           "sample_rate = excluded.sample_rate, "
-                           "channels = excluded.channels;",
-                           entry.fileInfo.path.c_str(),
-                           entry.fileInfo.mediaType.c_str(),
-                           entry.fileInfo.size,
-                           entry.tags.title.c_str(),
-                           entry.tags.album.artist.c_str(),
-                           entry.tags.album.title.c_str(),
-                           entry.tags.comment.c_str(),
-                           entry.tags.genre.c_str(),
-                           entry.tags.year,
-                           entry.tags.track,
-                           entry.audioProperties.songLength,
-                           entry.audioProperties.bitrate,
-                           entry.audioProperties.sampleRate,
-                           entry.audioProperties.channels);
+        return executeInTransaction([&] {
+            const auto ids = getOrAddAlbum(entry.tags.album);
+            if (!ids) {
+                return false;
+            }
+            return db->execute("INSERT INTO files (path, media_type, size, title, artist_id, album_id, "
+                               "comment, genre, year, track, song_length, bitrate, sample_rate, channels) "
+                               "VALUES('%q', '%q', %lu, '%q', %lu, %lu, '%q', '%q', %lu, %lu, %lu, %lu, %lu, %lu) "
+                               "ON CONFLICT(path) DO UPDATE SET "
+                               "path = excluded.path, "
+                               "media_type = excluded.media_type, "
+                               "size = excluded.size, "
+                               "title = excluded.title, "
+                               "artist_id = excluded.artist_id, "
+                               "album_id = excluded.album_id, "
+                               "comment = excluded.comment, "
+                               "genre = excluded.genre, "
+                               "year = excluded.year, "
+                               "track = excluded.track, "
+                               "song_length = excluded.song_length, "
+                               "bitrate = excluded.bitrate, "
+                               "sample_rate = excluded.sample_rate, "
+                               "channels = excluded.channels;",
+                               entry.fileInfo.path.c_str(),
+                               entry.fileInfo.mediaType.c_str(),
+                               entry.fileInfo.size,
+                               entry.tags.title.c_str(),
+                               ids->artist,
+                               ids->album,
+                               entry.tags.comment.c_str(),
+                               entry.tags.genre.c_str(),
+                               entry.tags.year,
+                               entry.tags.track,
+                               entry.audioProperties.songLength,
+                               entry.audioProperties.bitrate,
+                               entry.audioProperties.sampleRate,
+                               entry.audioProperties.channels);
+        });
     }
 
     bool MultimediaFilesTable::removeById(uint32_t id)
@@ -98,7 +133,9 @@ namespace db::multimedia_files
             return false;
         }
 
-        return db->execute("DELETE FROM files WHERE %q = '%q';", fieldName.c_str(), str);
+        const auto query = std::string("DELETE FROM files WHERE _id IN (SELECT files._id FROM ") + filesJoin +
+                           " WHERE %q = '%q');";
+        return db->execute(query.c_str(), fieldName.c_str(), str);
     }
 
     bool MultimediaFilesTable::removeAll()
@@ -108,57 +145,71 @@ namespace db::multimedia_files
 
     bool MultimediaFilesTable::update(TableRow entry)
     {
-        return db->execute("UPDATE files SET path = '%q', media_type = '%q', size = %lu, title = '%q', artist = '%q',"
-                           "album = '%q', comment = '%q', genre = '%q', year = %lu, track = %lu, song_length = %lu,"
-                           "bitrate = %lu, sample_rate = %lu, channels = %lu WHERE _id = %lu;",
-                           entry.fileInfo.path.c_str(),
-                           entry.fileInfo.mediaType.c_str(),
-                           entry.fileInfo.size,
-                           entry.tags.title.c_str(),
-                           entry.tags.album.artist.c_str(),
-                           entry.tags.album.title.c_str(),
-                           entry.tags.comment.c_str(),
-                           entry.tags.genre.c_str(),
-                           entry.tags.year,
-                           entry.tags.track,
-                           entry.audioProperties.songLength,
-                           entry.audioProperties.bitrate,
-                           entry.audioProperties.sampleRate,
-                           entry.audioProperties.channels,
-                           entry.ID);
+        return executeInTransaction([&] {
+            const auto ids = getOrAddAlbum(entry.tags.album);
+            if (!ids) {
+                return false;
+            }
+            return db->execute(
+                "UPDATE files SET path = '%q', media_type = '%q', size = %lu, title = '%q', artist_id = %lu,"
+                "album_id = %lu, comment = '%q', genre = '%q', year = %lu, track = %lu, song_length = %lu,"
+                "bitrate = %lu, sample_rate = %lu, channels = %lu WHERE _id = %lu;",
+                entry.fileInfo.path.c_str(),
+                entry.fileInfo.mediaType.c_str(),
+                entry.fileInfo.size,
+                entry.tags.title.c_str(),
+                ids->artist,
+                ids->album,
+                entry.tags.comment.c_str(),
+                entry.tags.genre.c_str(),
+                entry.tags.year,
+                entry.tags.track,
+                entry.audioProperties.songLength,
+                entry.audioProperties.bitrate,
+                entry.audioProperties.sampleRate,
+                entry.audioProperties.channels,
+                entry.ID);
+        });
     }
 
     bool MultimediaFilesTable::addOrUpdate(TableRow entry, std::string oldPath)
     {
         auto path = oldPath.empty() ? entry.fileInfo.path : oldPath;
 
-        return db->execute("BEGIN TRANSACTION; "
-                           "INSERT OR IGNORE INTO files (path) VALUES ('%q'); "
-                           "UPDATE files SET path = '%q', media_type = '%q', size = %lu, title = '%q', artist = '%q', "
-                           "album = '%q', comment = '%q', genre = '%q', year = %lu, track = %lu, song_length = %lu, "
-                           "bitrate = %lu, sample_rate = %lu, channels = %lu WHERE path = '%q'; "
-                           "COMMIT;",
-                           path.c_str(),
-                           entry.fileInfo.path.c_str(),
-                           entry.fileInfo.mediaType.c_str(),
-                           entry.fileInfo.size,
-                           entry.tags.title.c_str(),
-                           entry.tags.album.artist.c_str(),
-                           entry.tags.album.title.c_str(),
-                           entry.tags.comment.c_str(),
-                           entry.tags.genre.c_str(),
-                           entry.tags.year,
-                           entry.tags.track,
-                           entry.audioProperties.songLength,
-                           entry.audioProperties.bitrate,
-                           entry.audioProperties.sampleRate,
-                           entry.audioProperties.channels,
-                           path.c_str());
+        return executeInTransaction([&] {
+            const auto ids = getOrAddAlbum(entry.tags.album);
+            if (!ids) {
+                return false;
+            }
+            return db->execute(
+                "INSERT OR IGNORE INTO files (path, artist_id, album_id) VALUES ('%q', %lu, %lu); "
+                "UPDATE files SET path = '%q', media_type = '%q', size = %lu, title = '%q', artist_id = %lu, "
+                "album_id = %lu, comment = '%q', genre = '%q', year = %lu, track = %lu, song_length = %lu, "
+                "bitrate = %lu, sample_rate = %lu, channels = %lu WHERE path = '%q';",
+                path.c_str(),
+                ids->artist,
+                ids->album,
+                entry.fileInfo.path.c_str(),
+                entry.fileInfo.mediaType.c_str(),
+                entry.fileInfo.size,
+                entry.tags.title.c_str(),
+                ids->artist,
+                ids->album,
+                entry.tags.comment.c_str(),
+                entry.tags.genre.c_str(),
+                entry.tags.year,
+                entry.tags.track,
+                entry.audioProperties.songLength,
+                entry.audioProperties.bitrate,
+                entry.audioProperties.sampleRate,
+                entry.audioProperties.channels,
+                path.c_str());
+        });
     }
 
     TableRow MultimediaFilesTable::getById(uint32_t id)
     {
-        auto retQuery = db->query("SELECT * FROM files WHERE _id = %lu;", id);
+        auto retQuery = db->query(selectFiles(" WHERE files._id = %lu;").c_str(), id);
 
         if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
             return TableRow();
@@ -169,7 +220,7 @@ namespace db::multimedia_files
 
     TableRow MultimediaFilesTable::getByPath(std::string path)
     {
-        auto retQuery = db->query("SELECT * FROM files WHERE path = '%q';", path.c_str());
+        auto retQuery = db->query(selectFiles(" WHERE path = '%q';").c_str(), path.c_str());
 
         if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
             return TableRow();
@@ -180,7 +231,8 @@ namespace db::multimedia_files
 
     std::vector<TableRow> MultimediaFilesTable::getLimitOffset(uint32_t offset, uint32_t limit)
     {
-        auto retQuery = db->query("SELECT * from files ORDER BY title ASC LIMIT %lu OFFSET %lu;", limit, offset);
+        const auto query = selectFiles(" ORDER BY title ASC LIMIT %lu OFFSET %lu;");
+        auto retQuery    = db->query(query.c_str(), limit, offset);
 
         return retQueryUnpack(std::move(retQuery));
     }
@@ -188,7 +240,7 @@ namespace db::multimedia_files
     auto MultimediaFilesTable::getArtistsLimitOffset(uint32_t offset, uint32_t limit) -> std::vector<Artist>
     {
         auto retQuery =
-            db->query("SELECT DISTINCT artist from files ORDER BY artist ASC LIMIT %lu OFFSET %lu;", limit, offset);
+            db->query("SELECT artist FROM artists ORDER BY artist ASC LIMIT %lu OFFSET %lu;", limit, offset);
 
         if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
             return {};
@@ -214,41 +266,30 @@ namespace db::multimedia_files
             return {};
         }
 
-        retQuery = db->query("SELECT * FROM files WHERE %q = '%q' ORDER BY title ASC LIMIT %lu OFFSET %lu;",
-                             fieldName.c_str(),
-                             str,
-                             limit,
-                             offset);
+        const auto query = selectFiles(" WHERE %q = '%q' ORDER BY title ASC LIMIT %lu OFFSET %lu;");
+        retQuery         = db->query(query.c_str(), fieldName.c_str(), str, limit, offset);
 
         return retQueryUnpack(std::move(retQuery));
     }
 
     uint32_t MultimediaFilesTable::count()
     {
-        auto queryRet = db->query("SELECT COUNT(*) FROM files;");
-        if (!queryRet || queryRet->getRowCount() == 0) {
-            return 0;
-        }
-
-        return (*queryRet)[0].getUInt32();
+        return getCountFromQuery(db->query("SELECT files FROM library_count WHERE _id = 1;"));
     }
 
     uint32_t MultimediaFilesTable::countArtists()
     {
-        auto queryRet = db->query("SELECT COUNT (DISTINCT artist) FROM files;");
-        if (!queryRet || queryRet->getRowCount() == 0) {
-            return 0;
-        }
-
-        return (*queryRet)[0].getUInt32();
+        return getCountFromQuery(db->query("SELECT artists FROM library_count WHERE _id = 1;"));
     }
 
     auto MultimediaFilesTable::getAlbumsLimitOffset(uint32_t offset, uint32_t limit) -> std::vector<Album>
     {
-        auto retQuery = db->query(
-            "SELECT DISTINCT artist,album from files ORDER BY album ASC LIMIT %lu OFFSET %lu;", limit, offset);
+        auto retQuery = db->query("SELECT artist, album FROM albums JOIN artists ON albums.artist_id = artists._id "
+                                  "ORDER BY album ASC LIMIT %lu OFFSET %lu;",
+                                  limit,
+                                  offset);
 
-        if ((retQuery == nullptr) || (retQuery->getRowCount() < 2)) {
+        if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
             return {};
         }
 
@@ -262,13 +303,7 @@ namespace db::multimedia_files
 
     uint32_t MultimediaFilesTable::countAlbums()
     {
-        auto queryRet = db->query("SELECT COUNT(*) FROM"
-                                  "(SELECT DISTINCT artist,album from files);");
-        if (!queryRet || queryRet->getRowCount() == 0) {
-            return 0;
-        }
-
-        return (*queryRet)[0].getUInt32();
+        return getCountFromQuery(db->query("SELECT albums FROM library_count WHERE _id = 1;"));
     }
 
     uint32_t MultimediaFilesTable::countByFieldId(const char *field, uint32_t id)
@@ -277,12 +312,7 @@ namespace db::multimedia_files
             return 0;
         }
 
-        auto queryRet = db->query("SELECT COUNT(*) FROM files WHERE %q=%lu;", field, id);
-        if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
-            return 0;
-        }
-
-        return (*queryRet)[0].getUInt32();
+        return getCountFromQuery(db->query("SELECT COUNT(*) FROM files WHERE %q=%lu;", field, id));
     }
 
     std::string MultimediaFilesTable::getFieldName(TableFields field)
@@ -298,45 +328,84 @@ namespace db::multimedia_files
 
     auto MultimediaFilesTable::count(const Artist &artist) -> uint32_t
     {
-        auto queryRet = db->query("SELECT COUNT(*) FROM files WHERE artist='%q';", artist.c_str());
-        if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
-            return 0;
-        }
-
-        return (*queryRet)[0].getUInt32();
+        return getCountFromQuery(db->query("SELECT song_count FROM artists WHERE artist = '%q';", artist.c_str()));
     }
 
     auto MultimediaFilesTable::getLimitOffset(const Album &album, uint32_t offset, uint32_t limit)
         -> std::vector<TableRow>
     {
-        std::unique_ptr<QueryResult> retQuery = db->query(
-            "SELECT * FROM files WHERE artist = '%q' AND album = '%q' ORDER BY title ASC LIMIT %lu OFFSET %lu;",
-            album.artist.c_str(),
-            album.title.c_str(),
-            limit,
-            offset);
+        const auto query = selectFiles(" WHERE files.album_id = (SELECT albums._id FROM albums JOIN artists ON "
+                                       "albums.artist_id = artists._id WHERE artist = '%q' AND album = '%q') "
+                                       "ORDER BY title ASC LIMIT %lu OFFSET %lu;");
+        std::unique_ptr<QueryResult> retQuery =
+            db->query(query.c_str(), album.artist.c_str(), album.title.c_str(), limit, offset);
 
         return retQueryUnpack(std::move(retQuery));
     }
 
     auto MultimediaFilesTable::count(const Album &album) -> uint32_t
     {
-        auto queryRet = db->query("SELECT COUNT(*) FROM files WHERE artist='%q' AND album = '%q';",
+        return getCountFromQuery(
+            db->query("SELECT albums.song_count FROM albums JOIN artists ON albums.artist_id = artists._id "
+                      "WHERE artist = '%q' AND album = '%q';",
+                      album.artist.c_str(),
+                      album.title.c_str()));
+    }
+
+    auto MultimediaFilesTable::getLimitOffsetByPath(const std::string &path, uint32_t offset, uint32_t limit)
+        -> std::vector<TableRow>
+    {
+        // Prefix match as the range scan of the path index, LIKE can't use the index
+        const auto upperBound = prefixUpperBound(path);
+        if (upperBound.empty()) {
+            const auto query = selectFiles(" WHERE path >= '%q' ORDER BY title ASC LIMIT %lu OFFSET %lu;");
+            return retQueryUnpack(db->query(query.c_str(), path.c_str(), limit, offset));
+        }
+        const auto query =
+            selectFiles(" WHERE path >= '%q' AND path < '%q' ORDER BY title ASC LIMIT %lu OFFSET %lu;");
+        return retQueryUnpack(db->query(query.c_str(), path.c_str(), upperBound.c_str(), limit, offset));
+    }
+
+    auto MultimediaFilesTable::getOrAddAlbum(const Album &album) -> std::optional<AlbumIds>
+    {
+        if (!db->execute("INSERT OR IGNORE INTO artists (artist) VALUES ('%q'); "
+                         "INSERT OR IGNORE INTO albums (artist_id, album) "
+                         "SELECT _id, '%q' FROM artists WHERE artist = '%q';",
+                         album.artist.c_str(),
+                         album.title.c_str(),
+                         album.artist.c_str())) {
+            return std::nullopt;
+        }
+
+        auto retQuery = db->query("SELECT artists._id, albums._id FROM albums JOIN artists ON albums.artist_id = "
+                                  "artists._id WHERE artist = '%q' AND album = '%q';",
                                   album.artist.c_str(),
                                   album.title.c_str());
-        if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
-            return 0;
+        if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+            return std::nullopt;
         }
 
-        return (*queryRet)[0].getUInt32();
+        return AlbumIds{.artist = (*retQuery)[0].getUInt32(), .album = (*retQuery)[1].getUInt32()};
     }
 
-    auto MultimediaFilesTable::getLimitOffsetByPath(const std::string &path, uint32_t offset, uint32_t limit)
-        -> std::vector<TableRow>
+    auto MultimediaFilesTable::executeInTransaction(const std::function<bool()> &statements) -> bool
     {
-        std::string query = "SELECT * FROM files WHERE path LIKE '" + path + "%%' ORDER BY title ASC LIMIT " +
-                            std::to_string(limit) + " OFFSET " + std::to_string(offset) + ";";
-        std::unique_ptr<QueryResult> retQuery = db->query(query.c_str());
-        return retQueryUnpack(std::move(retQuery));
+        if (!db->execute("BEGIN TRANSACTION;")) {
+            return false;
+        }
+        if (!statements()) {
+            db->execute("ROLLBACK;");
+            return false;
+        }
+        return db->execute("COMMIT;");
+    }
+
+    auto MultimediaFilesTable::getCountFromQuery(std::unique_ptr<QueryResult> queryRet) -> uint32_t
+    {
+        if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
+            return 0;
+        }
+
+        return (*queryRet)[0].getUInt32();
     }
 } // namespace db::multimedia_files
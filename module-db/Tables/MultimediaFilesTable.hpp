@@ -7,6 +7,8 @@
 #include "Table.hpp"
 #include <Database/Database.hpp>
 
+#include <functional>
+#include <optional>
 #include <string>
 
 namespace db::multimedia_files
@@ -108,6 +110,16 @@ namespace db::multimedia_files
         bool addOrUpdate(TableRow entry, std::string oldPath = "");
 
       private:
+        struct AlbumIds
+        {
+            uint32_t artist{};
+            uint32_t album{};
+        };
+
         auto getFieldName(TableFields field) -> std::string;
+        /// Insert the artist and the album when missing, must be called inside the transaction
+        auto getOrAddAlbum(const Album &album) -> std::optional<AlbumIds>;
+        auto executeInTransaction(const std::function<bool()> &statements) -> bool;
+        auto getCountFromQuery(std::unique_ptr<QueryResult> queryRet) -> uint32_t;
     };
 } // namespace db::multimedia_files
@@ -0,0 +1,27 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "QuerySMSAddMultiple.hpp"
+
+using namespace std::literals::string_literals;
+
+namespace db::query
+{
+    SMSAddMultiple::SMSAddMultiple(std::vector<SMSRecord> records)
+        : Query(Query::Type::Create), records{std::move(records)}
+    {}
+
+    std::string SMSAddMultiple::debugInfo() const
+    {
+        return "SMSAddMultiple"s;
+    }
+
+    SMSAddMultipleResult::SMSAddMultipleResult(std::vector<SMSRecord> records, std::size_t added)
+        : records{std::move(records)}, added{added}
+    {}
+
+    std::string SMSAddMultipleResult::debugInfo() const
+    {
+        return "SMSAddMultipleResult"s;
+    }
+} // namespace db::query
@@ -0,0 +1,34 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <Common/Query.hpp>
+#include <module-db/Interface/SMSRecord.hpp>
+
+#include <vector>
+
+namespace db::query
+{
+    /// Adds all records in a single transaction
+    class SMSAddMultiple : public Query
+    {
+      public:
+        explicit SMSAddMultiple(std::vector<SMSRecord> records);
+
+        [[nodiscard]] std::string debugInfo() const override;
+        std::vector<SMSRecord> records;
+    };
+
+    class SMSAddMultipleResult : public QueryResult
+    {
+      public:
+        SMSAddMultipleResult(std::vector<SMSRecord> records, std::size_t added);
+
+        [[nodiscard]] std::string debugInfo() const override;
+
+        /// Records which were not added have ID set to DB_ID_NONE
+        std::vector<SMSRecord> records;
+        std::size_t added;
+    };
+} // namespace db::query
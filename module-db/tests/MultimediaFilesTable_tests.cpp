@@ -13,6 +13,7 @@
 #include <queries/multimedia_files/QueryMultimediaFilesCount.hpp>
 
 #include <algorithm>
+#include <set>
 using namespace db::multimedia_files;
 
 const std::vector<std::string> artists = {{""}, {"Just an artist"}, {"Mega artist"}, {"Super artist"}};
@@ -300,6 +301,41 @@ TEST_CASE("Multimedia DB tests")
                 }
             }
         }
+
+        SECTION("Counts after removal")
+        {
+            REQUIRE(db.files.removeByField(TableFields::path, records[5].fileInfo.path.c_str()));
+            REQUIRE(db.files.count() == records.size() - 1);
+            REQUIRE(db.files.countArtists() == artists.size() - 1);
+            REQUIRE(db.files.countAlbums() == numberOfAlbums - 1);
+            REQUIRE(db.files.count(artists[3]) == 0);
+            REQUIRE(db.files.count(albums[7]) == 0);
+            REQUIRE(db.files.getArtistsLimitOffset(0, artists.size()).size() == artists.size() - 1);
+        }
+
+        SECTION("Counts after album change")
+        {
+            auto record       = db.files.getByPath(records[4].fileInfo.path);
+            record.tags.album = albums[1];
+            REQUIRE(db.files.update(record));
+            REQUIRE(db.files.count() == records.size());
+            REQUIRE(db.files.countArtists() == artists.size());
+            REQUIRE(db.files.countAlbums() == numberOfAlbums - 1);
+            REQUIRE(db.files.count(albums[0]) == 0);
+            REQUIRE(db.files.count(albums[1]) == 2);
+            REQUIRE(db.files.getLimitOffset(albums[1], 0, records.size()).size() == 2);
+        }
+
+        SECTION("getLimitOffsetByPath")
+        {
+            const auto size = records.size();
+            REQUIRE(db.files.getLimitOffsetByPath("", 0, size).size() == size);
+            REQUIRE(db.files.getLimitOffsetByPath("user/", 0, size).size() == size);
+            REQUIRE(db.files.getLimitOffsetByPath("user/music/", 0, size).size() == size - 3);
+            REQUIRE(db.files.getLimitOffsetByPath("user/music/file1.mp3", 0, size).size() == 1);
+            REQUIRE(db.files.getLimitOffsetByPath("user_", 0, size).empty());
+            REQUIRE(db.files.getLimitOffsetByPath("USER/", 0, size).empty());
+        }
     }
 
     SECTION("Queries")
@@ -664,3 +700,66 @@ TEST_CASE("Multimedia DB tests")
 
     REQUIRE(Database::deinitialize());
 }
+
+TEST_CASE("Multimedia DB migration")
+{
+    REQUIRE(Database::initialize());
+
+    const auto path = (std::filesystem::path{"sys/user"} / "multimedia.db");
+    if (std::filesystem::exists(path)) {
+        REQUIRE(std::filesystem::remove(path));
+    }
+
+    {
+        // bring back the files table with the artist and album columns, as created by multimedia_001.sql only
+        MultimediaFilesDB db(path.c_str());
+        REQUIRE(db.isInitialized());
+        REQUIRE(db.execute("DROP TABLE files; DROP TABLE albums; DROP TABLE artists; DROP TABLE library_count;"));
+        REQUIRE(db.execute("CREATE TABLE files (_id INTEGER PRIMARY KEY, path TEXT UNIQUE, media_type TEXT, "
+                           "size INTEGER, title TEXT, artist TEXT, album TEXT, comment TEXT, genre TEXT, "
+                           "year INTEGER, track INTEGER, song_length INTEGER, bitrate INTEGER, "
+                           "sample_rate INTEGER, channels INTEGER);"));
+        for (const auto &record : records) {
+            REQUIRE(db.execute("INSERT INTO files (path, media_type, size, title, artist, album, year) "
+                               "VALUES ('%q', '%q', %lu, '%q', '%q', '%q', %lu);",
+                               record.fileInfo.path.c_str(),
+                               record.fileInfo.mediaType.c_str(),
+                               record.fileInfo.size,
+                               record.tags.title.c_str(),
+                               record.tags.album.artist.c_str(),
+                               record.tags.album.title.c_str(),
+                               record.tags.year));
+        }
+        REQUIRE(db.execute("INSERT INTO files (path, title) VALUES ('user/music/untagged.mp3', 'Untagged');"));
+    }
+
+    MultimediaFilesDB db(path.c_str());
+    REQUIRE(db.isInitialized());
+
+    REQUIRE(db.files.count() == records.size() + 1);
+    REQUIRE(db.files.countArtists() == artists.size());
+    std::set<std::pair<std::string, std::string>> migratedAlbums{{"", ""}};
+    for (const auto &record : records) {
+        migratedAlbums.emplace(record.tags.album.artist, record.tags.album.title);
+    }
+    REQUIRE(db.files.countAlbums() == migratedAlbums.size());
+
+    for (const auto &record : records) {
+        const auto migrated = db.files.getByPath(record.fileInfo.path);
+        REQUIRE(migrated.isValid());
+        REQUIRE(migrated.tags.title == record.tags.title);
+        REQUIRE(migrated.tags.album.artist == record.tags.album.artist);
+        REQUIRE(migrated.tags.album.title == record.tags.album.title);
+        REQUIRE(migrated.tags.year == record.tags.year);
+    }
+
+    const auto untagged = db.files.getByPath("user/music/untagged.mp3");
+    REQUIRE(untagged.isValid());
+    REQUIRE(untagged.tags.album.artist.empty());
+    REQUIRE(untagged.tags.album.title.empty());
+
+    REQUIRE(db.files.add(records[0]));
+    REQUIRE(db.files.count() == records.size() + 1);
+
+    REQUIRE(Database::deinitialize());
+}
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <module-db/queries/messages/sms/QuerySMSAddMultiple.hpp>
 #include <module-db/queries/messages/sms/QuerySMSGetForList.hpp>
 
 struct test
@@ -226,5 +227,29 @@ TEST_CASE("SMS Record tests")
         REQUIRE(result != nullptr);
     }
 
+    SECTION("SMS Record add multiple")
+    {
+        recordIN.type = SMSType::INBOX;
+        std::vector<SMSRecord> records{recordIN, recordIN};
+        recordIN.number = numberTest2;
+        records.push_back(recordIN);
+
+        auto query  = std::make_shared<db::query::SMSAddMultiple>(records);
+        auto ret    = smsRecInterface.runQuery(query);
+        auto result = dynamic_cast<db::query::SMSAddMultipleResult *>(ret.get());
+        REQUIRE(result != nullptr);
+        REQUIRE(result->added == 3);
+        REQUIRE(result->records.size() == 3);
+        for (const auto &record : result->records) {
+            REQUIRE(smsRecInterface.GetByID(record.ID).number == record.number);
+        }
+        REQUIRE(smsRecInterface.GetCount() == 3);
+
+        // both threads got their messages
+        ThreadRecordInterface threadInterface(&smsDB, &contactsDB);
+        REQUIRE(threadInterface.GetByNumber(numberTest).msgCount == 2);
+        REQUIRE(threadInterface.GetByNumber(numberTest2).unreadMsgCount == 1);
+    }
+
     Database::deinitialize();
 }
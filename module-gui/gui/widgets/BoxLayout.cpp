@@ -22,6 +22,7 @@ namespace gui
 
     bool BoxLayout::onInput(const InputEvent &inputEvent)
     {
+        updateLayout();
         if (inputCallback && inputCallback(*this, inputEvent)) {
             return true;
         }
@@ -55,24 +56,62 @@ namespace gui
     void BoxLayout::resizeItems()
     {}
 
+    void BoxLayout::invalidateLayout(bool withNavigation)
+    {
+        layoutDirty     = true;
+        navigationDirty = navigationDirty || withNavigation;
+
+        if (deferredLayout) {
+            requestLayout();
+        }
+        else {
+            applyLayout();
+        }
+    }
+
+    void BoxLayout::applyLayout()
+    {
+        if (layoutDirty) {
+            layoutDirty = false;
+            resizeItems();
+        }
+        if (navigationDirty) {
+            navigationDirty = false;
+            setNavigation();
+        }
+    }
+
+    void BoxLayout::setDeferredLayout(bool value)
+    {
+        deferredLayout = value;
+        if (!deferredLayout) {
+            applyLayout();
+        }
+    }
+
+    bool BoxLayout::isLayoutDeferred() const noexcept
+    {
+        return deferredLayout;
+    }
+
     void BoxLayout::setAlignment(const Alignment &value)
     {
         if (alignment != value) {
             alignment = value;
-            resizeItems();
+            invalidateLayout();
         }
     }
 
     void BoxLayout::addWidget(Item *item)
     {
         Rect::addWidget(item);
-        resizeItems();
+        invalidateLayout();
     }
 
     template <Axis axis> void BoxLayout::addWidget(Item *item)
     {
         Rect::addWidget(item);
-        resizeItems<axis>();
+        invalidateLayout();
     }
 
     bool BoxLayout::removeWidget(Item *item)
@@ -80,7 +119,7 @@ namespace gui
         bool ret = Rect::removeWidget(item);
 
         outOfDrawAreaItems.remove(item);
-        resizeItems();
+        invalidateLayout();
 
         return ret;
     }
@@ -90,7 +129,7 @@ namespace gui
         auto ret = Item::erase(item);
 
         outOfDrawAreaItems.remove(item);
-        resizeItems();
+        invalidateLayout();
 
         return ret;
     }
@@ -109,8 +148,11 @@ namespace gui
     {
         visible = value; // maybe use parent setVisible(...)? would be better but which one?
         if (value == true) {
-            resizeItems();         // move items in box in proper places
-            setNavigation();       // set navigation through kids -> TODO handle out of last/first to parent
+            // move items in box in proper places and set navigation through kids
+            // TODO handle out of last/first to parent
+            invalidateLayout(true);
+            // focus is chosen among the visible kids, deferred layout has to be done first
+            updateLayout();
             if (children.size()) { // set first visible kid as focused item - TODO should check for actionItems too...
                 /// this if back / front is crappy :|
                 if (previous) {
@@ -140,6 +182,7 @@ namespace gui
 
     unsigned int BoxLayout::getVisibleChildrenCount()
     {
+        updateLayout();
         assert(children.size() >= outOfDrawAreaItems.size());
         return children.size() - outOfDrawAreaItems.size();
     }
@@ -168,6 +211,7 @@ namespace gui
 
     Length BoxLayout::getPrimarySizeLeft()
     {
+        updateLayout();
         if (type == ItemType::HBOX) {
             return sizeLeft<Axis::X>(this, Area::Normal);
         }
@@ -196,7 +240,7 @@ namespace gui
         }
 
         outOfDrawAreaItems.clear();
-        resizeItems();
+        invalidateLayout();
     }
 
     // space left distposition `first is better` tactics
@@ -488,8 +532,7 @@ namespace gui
         }
 
         sizeStore->store(*el, granted);
-        resizeItems(); // vs mark dirty
-        setNavigation();
+        invalidateLayout(true);
 
         if (parentOnRequestedResizeCallback != nullptr) {
             parentOnRequestedResizeCallback();
@@ -581,7 +624,7 @@ namespace gui
             Item::informContentChanged();
         }
         else {
-            resizeItems();
+            invalidateLayout();
         }
     }
 
@@ -81,6 +81,16 @@ namespace gui
 
         Item *getLastVisibleElement();
 
+        /// layout of children has to be recalculated
+        bool layoutDirty = false;
+        /// navigation between children has to be recalculated
+        bool navigationDirty = false;
+        /// when set, invalidateLayout() only marks the box dirty and the layout is done by updateLayout()
+        bool deferredLayout = false;
+        /// mark layout (and optionally navigation) as outdated, recalculated at once unless layout is deferred
+        void invalidateLayout(bool withNavigation = false);
+        void applyLayout() override;
+
         /// get next navigation item including `from` item, ecludes not visible items and not acvite items
         std::list<Item *>::iterator nextNavigationItem(std::list<Item *>::iterator from);
 
@@ -122,6 +132,11 @@ namespace gui
         template <Axis axis> auto handleRequestResize(const Item *, Length request_w, Length request_h) -> Size;
         auto onDimensionChanged(const BoundingBox &oldDim, const BoundingBox &newDim) -> bool override;
         void handleContentChanged() override;
+        /// Defer layout and navigation updates caused by adding, removing or showing children until the draw list is
+        /// built (or updateLayout() is called), so building a box with N children needs one layout pass instead of N.
+        /// @note geometry of children is not up to date right after the change when enabled
+        void setDeferredLayout(bool value);
+        [[nodiscard]] bool isLayoutDeferred() const noexcept;
         /// Get primary sizes used in axis dominant layouts
         Length getPrimarySizeLeft();
         Length getPrimarySize();
@@ -81,6 +81,9 @@ namespace gui
         children.push_back(item);
 
         item->updateDrawArea();
+        if (item->layoutPending) {
+            requestLayout();
+        }
     }
 
     bool Item::removeWidget(Item *item)
@@ -110,6 +113,7 @@ namespace gui
         if (not visible) {
             return {};
         }
+        updateLayout();
         auto commands = std::list<Command>();
         if (preBuildDrawListHook != nullptr) {
             preBuildDrawListHook(commands);
@@ -122,6 +126,25 @@ namespace gui
         return commands;
     }
 
+    void Item::requestLayout()
+    {
+        for (auto item = this; item != nullptr && !item->layoutPending; item = item->parent) {
+            item->layoutPending = true;
+        }
+    }
+
+    void Item::updateLayout()
+    {
+        if (!layoutPending) {
+            return;
+        }
+        layoutPending = false;
+        applyLayout();
+        for (auto child : children) {
+            child->updateLayout();
+        }
+    }
+
     void Item::buildChildrenDrawList(std::list<Command> &commands)
     {
         for (auto widget : children) {
@@ -284,6 +284,14 @@ namespace gui
         /// @return bool requested size granted {w,h}
         virtual auto handleRequestResize(const Item *, Length request_w, Length request_h) -> Size;
 
+        /// flag informing that deferred layout of the item or of one of its children is pending
+        bool layoutPending = false;
+        /// mark the item and all its parents as having deferred layout pending
+        void requestLayout();
+        /// run pending deferred layouts in the item subtree, parents are laid out before their children
+        /// @note called before the draw list is built, can be called earlier if up to date geometry is needed
+        void updateLayout();
+
         /// flag informing that content has changed
         bool contentChanged = false;
         /// inform parent that child content has changed.
@@ -305,6 +313,10 @@ namespace gui
         virtual void buildDrawListImplementation(std::list<Command> &commands)
         {}
 
+        /// Applies deferred layout of the item itself, called from updateLayout()
+        virtual void applyLayout()
+        {}
+
         /// pre hook function, if set it is executed before building draw command
         /// at Item::buildDrawListImplementation()
         /// @param `commandlist` : commands list of commands for renderer to draw elements on screen
@@ -333,9 +333,10 @@ namespace gui::status_bar
 
     void StatusBar::showSignalStrength(bool enabled)
     {
-        const auto signalStrength = Store::GSM::get()->getSignalStrength();
-        const auto networkStatus  = Store::GSM::get()->getNetwork().status;
-        signal->update(signalStrength, networkStatus);
+        const auto gsm           = Store::GSM::get();
+        signalStrengthGeneration = gsm->getGeneration();
+        const auto snapshot      = gsm->getSnapshot();
+        signal->update(snapshot.signalStrength, snapshot.network.status);
         enabled ? signal->show() : signal->hide();
     }
 
@@ -344,7 +345,11 @@ namespace gui::status_bar
         if (signal == nullptr) {
             return false;
         }
-        showSignalStrength(configuration.isEnabled(Indicator::Signal));
+        const auto enabled = configuration.isEnabled(Indicator::Signal);
+        if (signalStrengthGeneration == Store::GSM::get()->getGeneration() && signal->visible == enabled) {
+            return false;
+        }
+        showSignalStrength(enabled);
         return true;
     }
 
@@ -367,13 +372,20 @@ namespace gui::status_bar
         if (networkAccessTechnology == nullptr) {
             return false;
         }
-        showNetworkAccessTechnology(configuration.isEnabled(Indicator::NetworkAccessTechnology));
+        const auto enabled = configuration.isEnabled(Indicator::NetworkAccessTechnology);
+        if (networkAccessTechnologyGeneration == Store::GSM::get()->getGeneration() &&
+            networkAccessTechnology->visible == enabled) {
+            return false;
+        }
+        showNetworkAccessTechnology(enabled);
         return true;
     }
 
     void StatusBar::showNetworkAccessTechnology(bool enabled)
     {
-        networkAccessTechnology->update(Store::GSM::get()->getNetwork().accessTechnology);
+        const auto gsm                    = Store::GSM::get();
+        networkAccessTechnologyGeneration = gsm->getGeneration();
+        networkAccessTechnology->update(gsm->getNetwork().accessTechnology);
         enabled ? networkAccessTechnology->show() : networkAccessTechnology->hide();
     }
 
@@ -9,6 +9,8 @@
 #include <service-bluetooth/Constants.hpp>
 #include "status-bar/AlarmClock.hpp"
 
+#include <cstdint>
+#include <optional>
 #include <vector>
 #include <map>
 
@@ -283,6 +285,12 @@ namespace gui::status_bar
 
         /// Current configuration of the Statusbar
         Configuration configuration;
+
+        /// Generation of the cellular state shown by the signal strength widget
+        std::optional<std::uint32_t> signalStrengthGeneration;
+
+        /// Generation of the cellular state shown by the NAT widget
+        std::optional<std::uint32_t> networkAccessTechnologyGeneration;
     };
 
 } // namespace gui::status_bar
@@ -8,6 +8,7 @@
 #include <log/log.hpp>
 #include <module-gui/test/mock/TestListViewProvider.hpp>
 #include <gui/input/InputEvent.hpp>
+#include <gui/core/DrawCommand.hpp>
 
 namespace testStyle
 {
@@ -605,3 +606,66 @@ TEST_F(BoxLayoutTesting, Box_Content_Change_Test)
 
     delete thirdBox;
 }
+
+TEST_F(BoxLayoutTesting, Box_Deferred_Layout_Test)
+{
+    auto parent = new gui::Item();
+    parent->addWidget(testVBoxLayout);
+    testVBoxLayout->setDeferredLayout(true);
+
+    // Add more elements than box can fit
+    addNItems(testVBoxLayout, fillVBoxPage + 2, testStyle::VBox_item_w, testStyle::VBox_item_h);
+
+    // Layout is only marked as pending - elements are neither placed nor pushed out of the box
+    ASSERT_TRUE(testVBoxLayout->layoutPending) << "Box layout should be pending";
+    ASSERT_TRUE(parent->layoutPending) << "Pending layout should be propagated to parent";
+    ASSERT_EQ(0, getNItem(testVBoxLayout, 1)->widgetArea.y) << "Second element should not be placed yet";
+    ASSERT_TRUE(testVBoxLayout->children.back()->visible) << "Last element should not be pushed out yet";
+
+    // Single layout pass is done before draw list is built
+    parent->buildDrawList();
+    ASSERT_FALSE(testVBoxLayout->layoutPending) << "Box layout should be done";
+    ASSERT_FALSE(parent->layoutPending) << "Parent layout should be done";
+    ASSERT_EQ(testStyle::VBox_item_h, getNItem(testVBoxLayout, 1)->widgetArea.y) << "Second element should be placed";
+    ASSERT_EQ(fillVBoxPage, testVBoxLayout->getVisibleChildrenCount()) << "Box should contain 6 visible elements";
+    ASSERT_FALSE(testVBoxLayout->children.back()->visible) << "Last element should be pushed out";
+
+    parent->removeWidget(testVBoxLayout);
+    delete parent;
+}
+
+TEST_F(BoxLayoutTesting, Box_Deferred_Navigation_Test)
+{
+    testHBoxLayout->setDeferredLayout(true);
+    addNItems(testHBoxLayout, fillHBoxPage, testStyle::HBox_item_w, testStyle::HBox_item_h);
+
+    // Navigation is set up on the first input
+    testHBoxLayout->setFocus(true);
+    ASSERT_EQ(1, dynamic_cast<TestItem *>(testHBoxLayout->getFocusItem())->ID) << "first element should have focus";
+
+    moveNTimes(testHBoxLayout, 2, gui::KeyCode::KEY_RIGHT);
+    ASSERT_EQ(3, dynamic_cast<TestItem *>(testHBoxLayout->getFocusItem())->ID)
+        << "move right by 2 - third element should have focus";
+
+    // Disabling deferred layout applies pending changes at once
+    auto item    = new TestItem(nullptr, 0, 0, testStyle::HBox_item_w, testStyle::HBox_item_h);
+    auto removed = getNItem(testHBoxLayout, 0);
+    testHBoxLayout->removeWidget(removed);
+    delete removed;
+    testHBoxLayout->addWidget(item);
+    testHBoxLayout->setDeferredLayout(false);
+    ASSERT_EQ(0, getNItem(testHBoxLayout, 0)->widgetArea.x) << "Second element should be moved to the front";
+}
+
+TEST_F(BoxLayoutTesting, Box_Deferred_Focus_Test)
+{
+    testVBoxLayout->setDeferredLayout(true);
+    addNItems(testVBoxLayout, fillVBoxPage + 2, testStyle::VBox_item_w, testStyle::VBox_item_h);
+
+    // Focus is set on the last element which fits in the box, not on the ones pushed out by the pending layout
+    testVBoxLayout->setVisible(true, true);
+    ASSERT_FALSE(testVBoxLayout->layoutPending) << "Box layout should be done";
+    ASSERT_TRUE(testVBoxLayout->getFocusItem()->visible) << "Focused element should be visible";
+    ASSERT_EQ(fillVBoxPage, dynamic_cast<TestItem *>(testVBoxLayout->getFocusItem())->ID)
+        << "Last visible element should have focus";
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+/*
+ * Implementation of pvPortMalloc() and vPortFree() on top of the TLSF allocator (memory/tlsf.h).
+ * Used instead of heap_4.c when USE_TLSF_HEAP is enabled: allocation and release take constant time regardless of
+ * heap fragmentation and every block is accounted to the allocating task (see memory/heapstats.h).
+ */
+
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "memory/heapstats.h"
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+static tlsf_t xHeap;
+static BaseType_t xHeapInitialised = pdFALSE;
+
+static void prvHeapInit( void )
+{
+	const int result = tlsf_init( &xHeap, ucHeap, configTOTAL_HEAP_SIZE, portBYTE_ALIGNMENT );
+	configASSERT( result == 0 );
+	( void ) result;
+	xHeapInitialised = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+void *pvReturn;
+
+	vTaskSuspendAll();
+	{
+		if( xHeapInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+
+		pvReturn = tlsf_malloc( &xHeap, xWantedSize, heap_current_owner() );
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+	if( pv != NULL )
+	{
+		vTaskSuspendAll();
+		{
+			traceFREE( pv, tlsf_block_size( &xHeap, pv ) );
+			tlsf_free( &xHeap, pv );
+		}
+		( void ) xTaskResumeAll();
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xHeapInitialised == pdTRUE ? xHeap.totalBytes - xHeap.usedBytes : configTOTAL_HEAP_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xHeapInitialised == pdTRUE ? xHeap.totalBytes - xHeap.peakUsedBytes : configTOTAL_HEAP_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+tlsf_t *heap_system_tlsf( void )
+{
+	return xHeapInitialised == pdTRUE ? &xHeap : NULL;
+}
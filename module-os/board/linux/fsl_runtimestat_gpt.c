@@ -2,6 +2,11 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include <stdint.h>
+#include <time.h>
+
+/* Same resolution as the GPT based counter on the target - 10 kHz */
+#define RUN_TIME_STATS_TICKS_PER_SECOND 10000ULL
+#define NANOSECONDS_PER_SECOND          1000000000ULL
 
 void vConfigureTimerForRunTimeStats(void)
 {
@@ -9,5 +14,8 @@ void vConfigureTimerForRunTimeStats(void)
 
 uint32_t ulHighFrequencyTimerTicks(void)
 {
-	return 0;
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)((uint64_t)now.tv_sec * RUN_TIME_STATS_TICKS_PER_SECOND +
+	                  (uint64_t)now.tv_nsec / (NANOSECONDS_PER_SECOND / RUN_TIME_STATS_TICKS_PER_SECOND));
 }
@@ -0,0 +1,89 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "heapstats.h"
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Thread local storage index 3 is taken by purefs current working directory */
+#define HEAP_OWNER_THREAD_LOCAL_INDEX 4
+
+#if (configNUM_THREAD_LOCAL_STORAGE_POINTERS <= HEAP_OWNER_THREAD_LOCAL_INDEX)
+#error "Heap owners require a thread local storage pointer"
+#endif
+
+static char ownerNames[TLSF_MAX_OWNERS][HEAP_OWNER_NAME_LENGTH] = {"unknown"};
+static tlsf_owner_t ownersCount = 1;
+
+static tlsf_owner_t registerOwner(const char *name)
+{
+    for (tlsf_owner_t owner = 1; owner < ownersCount; ++owner) {
+        /* restarted services (i.e. applications) get their previous slot back */
+        if (strncmp(ownerNames[owner], name, HEAP_OWNER_NAME_LENGTH - 1) == 0) {
+            return owner;
+        }
+    }
+    if (ownersCount == TLSF_MAX_OWNERS) {
+        return 0;
+    }
+    strncpy(ownerNames[ownersCount], name, HEAP_OWNER_NAME_LENGTH - 1);
+    return ownersCount++;
+}
+
+tlsf_owner_t heap_current_owner(void)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return 0;
+    }
+
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    /* owner is kept incremented by one, so NULL means the task is not registered yet */
+    uintptr_t cached = (uintptr_t)pvTaskGetThreadLocalStoragePointer(task, HEAP_OWNER_THREAD_LOCAL_INDEX);
+    if (cached == 0) {
+        cached = (uintptr_t)registerOwner(pcTaskGetName(task)) + 1;
+        vTaskSetThreadLocalStoragePointer(task, HEAP_OWNER_THREAD_LOCAL_INDEX, (void *)cached);
+    }
+    return (tlsf_owner_t)(cached - 1);
+}
+
+static tlsf_t *getHeap(heap_id_t heap)
+{
+    return heap == HeapSystem ? heap_system_tlsf() : heap_user_tlsf();
+}
+
+int heap_get_stats(heap_id_t heap, tlsf_stats_t *stats)
+{
+    int result = -1;
+    vTaskSuspendAll();
+    {
+        tlsf_t *tlsf = getHeap(heap);
+        if (tlsf != NULL) {
+            tlsf_get_stats(tlsf, stats);
+            result = 0;
+        }
+    }
+    (void)xTaskResumeAll();
+    return result;
+}
+
+size_t heap_get_owners_stats(heap_id_t heap, heap_owner_info_t *owners, size_t maxCount)
+{
+    size_t count = 0;
+    vTaskSuspendAll();
+    {
+        tlsf_t *tlsf = getHeap(heap);
+        for (tlsf_owner_t owner = 0; tlsf != NULL && owner < ownersCount && count < maxCount; ++owner) {
+            if (tlsf->owners[owner].peakUsedBytes == 0) {
+                continue;
+            }
+            owners[count].name  = ownerNames[owner];
+            owners[count].stats = tlsf->owners[owner];
+            ++count;
+        }
+    }
+    (void)xTaskResumeAll();
+    return count;
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+/*
+ * Statistics of the TLSF based heaps (USE_TLSF_HEAP). Memory is accounted per owner, where an owner is the name of
+ * the task which allocated the block - every service runs in its own task, so it gives per-service usage.
+ */
+
+#ifndef HEAPSTATS_H_
+#define HEAPSTATS_H_
+
+#include "tlsf.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HEAP_OWNER_NAME_LENGTH 24
+
+typedef enum
+{
+    HeapSystem, /*<< FreeRTOS heap - pvPortMalloc */
+    HeapUser    /*<< user heap - usermalloc */
+} heap_id_t;
+
+typedef struct
+{
+    const char *name;
+    tlsf_owner_stats_t stats;
+} heap_owner_info_t;
+
+/* Returns 0 and fills stats of the heap, or non zero if the heap is not available */
+int heap_get_stats(heap_id_t heap, tlsf_stats_t *stats);
+
+/* Fills up to maxCount entries for owners which ever allocated from the heap, returns number of entries filled */
+size_t heap_get_owners_stats(heap_id_t heap, heap_owner_info_t *owners, size_t maxCount);
+
+/* Returns owner of the calling task, registering the task on first use. Has to be called with scheduler suspended */
+tlsf_owner_t heap_current_owner(void);
+
+/* Allocator instances, NULL if the heap is not initialized */
+tlsf_t *heap_system_tlsf(void);
+tlsf_t *heap_user_tlsf(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAPSTATS_H_ */
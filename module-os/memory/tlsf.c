@@ -0,0 +1,437 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "tlsf.h"
+
+#include <string.h>
+
+#define TLSF_BLOCK_FREE     ((size_t)1)
+#define TLSF_MARKER_USED    ((uint16_t)0xa110)
+#define TLSF_MARKER_FREE    ((uint16_t)0xf4ee)
+#define TLSF_SMALL_BLOCK    ((size_t)1 << TLSF_FL_INDEX_SHIFT)
+#define TLSF_MAX_BLOCK_SIZE (((size_t)1 << TLSF_FL_INDEX_MAX) - 1)
+
+/* Header placed in front of every block. Free list links of a free block are kept in its payload. */
+typedef struct tlsf_block
+{
+    struct tlsf_block *prevPhys; /*<< physically previous block, NULL for the first one */
+    size_t size;                 /*<< payload size, lowest bit marks free block */
+    tlsf_owner_t owner;
+    uint16_t marker;
+} tlsf_block_t;
+
+typedef struct
+{
+    tlsf_block_t *next;
+    tlsf_block_t *prev;
+} tlsf_links_t;
+
+static inline size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static inline int flsSize(size_t value)
+{
+    return (int)(sizeof(unsigned long) * 8) - 1 - __builtin_clzl((unsigned long)value);
+}
+
+static inline size_t blockSize(const tlsf_block_t *block)
+{
+    return block->size & ~TLSF_BLOCK_FREE;
+}
+
+static inline int blockIsFree(const tlsf_block_t *block)
+{
+    return (block->size & TLSF_BLOCK_FREE) != 0;
+}
+
+static inline void *blockPayload(const tlsf_t *tlsf, const tlsf_block_t *block)
+{
+    return (uint8_t *)block + tlsf->headerSize;
+}
+
+static inline tlsf_block_t *blockFromPayload(const tlsf_t *tlsf, const void *ptr)
+{
+    return (tlsf_block_t *)((uint8_t *)ptr - tlsf->headerSize);
+}
+
+static inline tlsf_block_t *blockNext(const tlsf_t *tlsf, const tlsf_block_t *block)
+{
+    return (tlsf_block_t *)((uint8_t *)blockPayload(tlsf, block) + blockSize(block));
+}
+
+static inline tlsf_links_t *blockLinks(const tlsf_t *tlsf, const tlsf_block_t *block)
+{
+    return (tlsf_links_t *)blockPayload(tlsf, block);
+}
+
+/* Maps size to the list which keeps blocks of that size */
+static void mappingInsert(size_t size, int *fl, int *sl)
+{
+    if (size < TLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = (int)(size / (TLSF_SMALL_BLOCK / TLSF_SL_INDEX_COUNT));
+    }
+    else {
+        const int bit = flsSize(size);
+        *sl           = (int)((size >> (bit - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT);
+        *fl           = bit - (TLSF_FL_INDEX_SHIFT - 1);
+    }
+}
+
+/* Maps size to the first list whose every block is big enough */
+static void mappingSearch(size_t size, int *fl, int *sl)
+{
+    if (size >= TLSF_SMALL_BLOCK) {
+        size += ((size_t)1 << (flsSize(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    mappingInsert(size, fl, sl);
+}
+
+static void insertFreeBlock(tlsf_t *tlsf, tlsf_block_t *block)
+{
+    int fl, sl;
+    mappingInsert(blockSize(block), &fl, &sl);
+
+    tlsf_links_t *links = blockLinks(tlsf, block);
+    tlsf_block_t *head  = tlsf->freeLists[fl][sl];
+    links->next         = head;
+    links->prev         = NULL;
+    if (head != NULL) {
+        blockLinks(tlsf, head)->prev = block;
+    }
+    tlsf->freeLists[fl][sl] = block;
+    tlsf->flBitmap |= 1U << fl;
+    tlsf->slBitmap[fl] |= 1U << sl;
+
+    block->size |= TLSF_BLOCK_FREE;
+    block->marker = TLSF_MARKER_FREE;
+    tlsf->freeBytes += blockSize(block);
+    tlsf->freeBlocks++;
+}
+
+static void removeFreeBlock(tlsf_t *tlsf, tlsf_block_t *block)
+{
+    int fl, sl;
+    mappingInsert(blockSize(block), &fl, &sl);
+
+    tlsf_links_t *links = blockLinks(tlsf, block);
+    if (links->next != NULL) {
+        blockLinks(tlsf, links->next)->prev = links->prev;
+    }
+    if (links->prev != NULL) {
+        blockLinks(tlsf, links->prev)->next = links->next;
+    }
+    else {
+        tlsf->freeLists[fl][sl] = links->next;
+        if (links->next == NULL) {
+            tlsf->slBitmap[fl] &= ~(1U << sl);
+            if (tlsf->slBitmap[fl] == 0) {
+                tlsf->flBitmap &= ~(1U << fl);
+            }
+        }
+    }
+
+    block->size &= ~TLSF_BLOCK_FREE;
+    tlsf->freeBytes -= blockSize(block);
+    tlsf->freeBlocks--;
+}
+
+static tlsf_block_t *findSuitableBlock(const tlsf_t *tlsf, int fl, int sl)
+{
+    uint32_t slMap = tlsf->slBitmap[fl] & (~0U << sl);
+    if (slMap == 0) {
+        const uint32_t flMap = (fl + 1 < 32) ? tlsf->flBitmap & (~0U << (fl + 1)) : 0;
+        if (flMap == 0) {
+            return NULL;
+        }
+        fl    = __builtin_ctz(flMap);
+        slMap = tlsf->slBitmap[fl];
+    }
+    return tlsf->freeLists[fl][__builtin_ctz(slMap)];
+}
+
+/* Splits the tail of the block off if it's big enough to form another block and returns it (not inserted) */
+static tlsf_block_t *splitBlock(tlsf_t *tlsf, tlsf_block_t *block, size_t size)
+{
+    const size_t currentSize = blockSize(block);
+    if (currentSize < size + tlsf->headerSize + tlsf->minPayload) {
+        return NULL;
+    }
+
+    tlsf_block_t *rest = (tlsf_block_t *)((uint8_t *)blockPayload(tlsf, block) + size);
+    rest->prevPhys     = block;
+    rest->size         = currentSize - size - tlsf->headerSize;
+    rest->owner        = 0;
+    block->size        = size | (block->size & TLSF_BLOCK_FREE);
+
+    blockNext(tlsf, rest)->prevPhys = rest;
+    return rest;
+}
+
+/* Merges free block with its free neighbours and puts the result on a free list */
+static void releaseBlock(tlsf_t *tlsf, tlsf_block_t *block)
+{
+    tlsf_block_t *prev = block->prevPhys;
+    if (prev != NULL && blockIsFree(prev)) {
+        removeFreeBlock(tlsf, prev);
+        prev->size += tlsf->headerSize + blockSize(block);
+        block = prev;
+        blockNext(tlsf, block)->prevPhys = block;
+    }
+
+    tlsf_block_t *next = blockNext(tlsf, block);
+    if (blockIsFree(next)) {
+        removeFreeBlock(tlsf, next);
+        block->size += tlsf->headerSize + blockSize(next);
+        blockNext(tlsf, block)->prevPhys = block;
+    }
+
+    insertFreeBlock(tlsf, block);
+}
+
+static size_t adjustSize(const tlsf_t *tlsf, size_t size)
+{
+    if (size > TLSF_MAX_BLOCK_SIZE) {
+        return 0;
+    }
+    const size_t adjusted = alignUp(size, tlsf->alignment);
+    return adjusted < tlsf->minPayload ? tlsf->minPayload : adjusted;
+}
+
+static void accountUsed(tlsf_t *tlsf, tlsf_owner_t owner, size_t payload)
+{
+    tlsf_owner_stats_t *stats = &tlsf->owners[owner];
+    stats->usedBytes += payload;
+    stats->usedBlocks++;
+    if (stats->usedBytes > stats->peakUsedBytes) {
+        stats->peakUsedBytes = stats->usedBytes;
+    }
+
+    tlsf->usedBytes += payload + tlsf->headerSize;
+    tlsf->usedBlocks++;
+    if (tlsf->usedBytes > tlsf->peakUsedBytes) {
+        tlsf->peakUsedBytes = tlsf->usedBytes;
+    }
+}
+
+static void accountReleased(tlsf_t *tlsf, tlsf_owner_t owner, size_t payload)
+{
+    tlsf->owners[owner].usedBytes -= payload;
+    tlsf->owners[owner].usedBlocks--;
+    tlsf->usedBytes -= payload + tlsf->headerSize;
+    tlsf->usedBlocks--;
+}
+
+int tlsf_init(tlsf_t *tlsf, void *memory, size_t bytes, size_t alignment)
+{
+    if (tlsf == NULL || memory == NULL || alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) {
+        return -1;
+    }
+
+    memset(tlsf, 0, sizeof(*tlsf));
+    tlsf->alignment  = alignment;
+    tlsf->headerSize = alignUp(sizeof(tlsf_block_t), alignment);
+    tlsf->minPayload = alignUp(sizeof(tlsf_links_t), alignment);
+
+    const uintptr_t start = alignUp((uintptr_t)memory, alignment);
+    const uintptr_t end   = ((uintptr_t)memory + bytes) & ~(uintptr_t)(alignment - 1);
+    if (end <= start || end - start < 2 * tlsf->headerSize + tlsf->minPayload) {
+        return -1;
+    }
+
+    /* the last header is a sentinel which is never free, so blocks don't have to check heap boundaries */
+    size_t firstSize = (end - start) - 2 * tlsf->headerSize;
+    if (firstSize > TLSF_MAX_BLOCK_SIZE) {
+        firstSize = TLSF_MAX_BLOCK_SIZE & ~(alignment - 1);
+    }
+
+    tlsf_block_t *first = (tlsf_block_t *)start;
+    first->prevPhys     = NULL;
+    first->size         = firstSize;
+    first->owner        = 0;
+
+    tlsf_block_t *sentinel = blockNext(tlsf, first);
+    sentinel->prevPhys     = first;
+    sentinel->size         = 0;
+    sentinel->owner        = 0;
+    sentinel->marker       = TLSF_MARKER_USED;
+
+    tlsf->firstBlock = first;
+    tlsf->totalBytes = firstSize + tlsf->headerSize;
+    insertFreeBlock(tlsf, first);
+    return 0;
+}
+
+void *tlsf_malloc(tlsf_t *tlsf, size_t size, tlsf_owner_t owner)
+{
+    if (size == 0) {
+        return NULL;
+    }
+    if (owner >= TLSF_MAX_OWNERS) {
+        owner = 0;
+    }
+
+    const size_t adjusted = adjustSize(tlsf, size);
+    int fl, sl;
+    tlsf_block_t *block = NULL;
+    if (adjusted != 0) {
+        mappingSearch(adjusted, &fl, &sl);
+        if (fl < TLSF_FL_INDEX_COUNT) {
+            block = findSuitableBlock(tlsf, fl, sl);
+        }
+    }
+    if (block == NULL) {
+        tlsf->failedAllocations++;
+        return NULL;
+    }
+
+    removeFreeBlock(tlsf, block);
+    tlsf_block_t *rest = splitBlock(tlsf, block, adjusted);
+    if (rest != NULL) {
+        insertFreeBlock(tlsf, rest);
+    }
+
+    block->owner  = owner;
+    block->marker = TLSF_MARKER_USED;
+    accountUsed(tlsf, owner, blockSize(block));
+    return blockPayload(tlsf, block);
+}
+
+void tlsf_free(tlsf_t *tlsf, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    tlsf_block_t *block = blockFromPayload(tlsf, ptr);
+    if (block->marker != TLSF_MARKER_USED || blockIsFree(block)) {
+        /* double free or not a block from this heap - leave the heap untouched */
+        return;
+    }
+
+    accountReleased(tlsf, block->owner, blockSize(block));
+    releaseBlock(tlsf, block);
+}
+
+void *tlsf_realloc(tlsf_t *tlsf, void *ptr, size_t size, tlsf_owner_t owner)
+{
+    if (ptr == NULL) {
+        return tlsf_malloc(tlsf, size, owner);
+    }
+    if (size == 0) {
+        tlsf_free(tlsf, ptr);
+        return NULL;
+    }
+
+    tlsf_block_t *block   = blockFromPayload(tlsf, ptr);
+    const size_t current  = blockSize(block);
+    const size_t adjusted = adjustSize(tlsf, size);
+    if (adjusted == 0) {
+        tlsf->failedAllocations++;
+        return NULL;
+    }
+
+    tlsf_block_t *next = blockNext(tlsf, block);
+    if (adjusted > current && blockIsFree(next) && current + tlsf->headerSize + blockSize(next) >= adjusted) {
+        /* grow in place by taking over the following free block */
+        removeFreeBlock(tlsf, next);
+        block->size += tlsf->headerSize + blockSize(next);
+        blockNext(tlsf, block)->prevPhys = block;
+        accountReleased(tlsf, block->owner, current);
+        accountUsed(tlsf, block->owner, blockSize(block));
+    }
+
+    if (adjusted <= blockSize(block)) {
+        const size_t before = blockSize(block);
+        tlsf_block_t *rest  = splitBlock(tlsf, block, adjusted);
+        if (rest != NULL) {
+            accountReleased(tlsf, block->owner, before);
+            accountUsed(tlsf, block->owner, blockSize(block));
+            releaseBlock(tlsf, rest);
+        }
+        return ptr;
+    }
+
+    void *moved = tlsf_malloc(tlsf, size, owner);
+    if (moved != NULL) {
+        memcpy(moved, ptr, current);
+        tlsf_free(tlsf, ptr);
+    }
+    return moved;
+}
+
+size_t tlsf_block_size(const tlsf_t *tlsf, const void *ptr)
+{
+    return ptr != NULL ? blockSize(blockFromPayload(tlsf, ptr)) : 0;
+}
+
+tlsf_owner_t tlsf_block_owner(const tlsf_t *tlsf, const void *ptr)
+{
+    return ptr != NULL ? blockFromPayload(tlsf, ptr)->owner : 0;
+}
+
+void tlsf_get_stats(const tlsf_t *tlsf, tlsf_stats_t *stats)
+{
+    stats->totalBytes        = tlsf->totalBytes;
+    stats->usedBytes         = tlsf->usedBytes;
+    stats->peakUsedBytes     = tlsf->peakUsedBytes;
+    stats->freeBytes         = tlsf->freeBytes;
+    stats->usedBlocks        = tlsf->usedBlocks;
+    stats->freeBlocks        = tlsf->freeBlocks;
+    stats->failedAllocations = tlsf->failedAllocations;
+    stats->largestFreeBlock  = 0;
+
+    if (tlsf->flBitmap == 0) {
+        return;
+    }
+    const int fl = 31 - __builtin_clz(tlsf->flBitmap);
+    const int sl = 31 - __builtin_clz(tlsf->slBitmap[fl]);
+    for (const tlsf_block_t *block = tlsf->freeLists[fl][sl]; block != NULL; block = blockLinks(tlsf, block)->next) {
+        if (blockSize(block) > stats->largestFreeBlock) {
+            stats->largestFreeBlock = blockSize(block);
+        }
+    }
+}
+
+int tlsf_check(const tlsf_t *tlsf)
+{
+    size_t freeBytes = 0, freeBlocks = 0, usedBlocks = 0;
+    const tlsf_block_t *prev  = NULL;
+    const tlsf_block_t *block = tlsf->firstBlock;
+
+    while (block != NULL && !(blockSize(block) == 0 && !blockIsFree(block))) {
+        if (block->prevPhys != prev) {
+            return -1;
+        }
+        if (blockIsFree(block)) {
+            if (block->marker != TLSF_MARKER_FREE || (prev != NULL && blockIsFree(prev))) {
+                return -2;
+            }
+            int fl, sl;
+            mappingInsert(blockSize(block), &fl, &sl);
+            if ((tlsf->slBitmap[fl] & (1U << sl)) == 0) {
+                return -3;
+            }
+            freeBytes += blockSize(block);
+            freeBlocks++;
+        }
+        else {
+            if (block->marker != TLSF_MARKER_USED) {
+                return -4;
+            }
+            usedBlocks++;
+        }
+        prev  = block;
+        block = blockNext(tlsf, block);
+    }
+
+    if (block == NULL || block->prevPhys != prev) {
+        return -5;
+    }
+    if (freeBytes != tlsf->freeBytes || freeBlocks != tlsf->freeBlocks || usedBlocks != tlsf->usedBlocks) {
+        return -6;
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+/*
+ * Two-Level Segregated Fit allocator.
+ *
+ * Free blocks are kept in size-class segregated lists indexed by two bitmaps, so both allocation and release are
+ * O(1) and do not depend on the number of free blocks. Blocks are tagged with a small owner index to account
+ * memory per owner (i.e. per service).
+ *
+ * The allocator does no locking - it's up to the caller (see heap_tlsf.c and usermem_tlsf.c).
+ */
+
+#ifndef TLSF_H_
+#define TLSF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Number of owners tracked separately, owner 0 collects allocations which could not be assigned */
+#define TLSF_MAX_OWNERS 64
+
+/* Second level index: each power of two range is split into 2^TLSF_SL_INDEX_COUNT_LOG2 lists */
+#define TLSF_SL_INDEX_COUNT_LOG2 4
+#define TLSF_SL_INDEX_COUNT      (1U << TLSF_SL_INDEX_COUNT_LOG2)
+/* Sizes below 2^TLSF_FL_INDEX_SHIFT are mapped linearly to the first level 0 */
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + 3)
+/* Largest supported block is below 2^TLSF_FL_INDEX_MAX */
+#define TLSF_FL_INDEX_MAX   31
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+
+typedef uint16_t tlsf_owner_t;
+
+struct tlsf_block;
+
+typedef struct
+{
+    size_t usedBytes;     /*<< payload bytes held by the owner */
+    size_t peakUsedBytes; /*<< maximum of usedBytes */
+    size_t usedBlocks;    /*<< number of blocks held by the owner */
+} tlsf_owner_stats_t;
+
+typedef struct
+{
+    size_t totalBytes;       /*<< bytes available for blocks (payload and headers) */
+    size_t usedBytes;        /*<< bytes taken by allocated blocks including their headers */
+    size_t peakUsedBytes;    /*<< maximum of usedBytes */
+    size_t freeBytes;        /*<< payload bytes of all free blocks */
+    size_t largestFreeBlock; /*<< payload size of the largest free block */
+    size_t usedBlocks;
+    size_t freeBlocks;
+    size_t failedAllocations;
+} tlsf_stats_t;
+
+typedef struct
+{
+    size_t alignment;  /*<< alignment of returned pointers, power of two */
+    size_t headerSize; /*<< size of a block header rounded up to alignment */
+    size_t minPayload; /*<< smallest payload which can keep free list links */
+    uint32_t flBitmap;
+    uint32_t slBitmap[TLSF_FL_INDEX_COUNT];
+    struct tlsf_block *freeLists[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+    struct tlsf_block *firstBlock;
+
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t peakUsedBytes;
+    size_t freeBytes;
+    size_t usedBlocks;
+    size_t freeBlocks;
+    size_t failedAllocations;
+    tlsf_owner_stats_t owners[TLSF_MAX_OWNERS];
+} tlsf_t;
+
+/*
+ * Initializes allocator over the memory region. Returns 0 on success.
+ * @param alignment has to be a power of two, not smaller than the pointer size
+ */
+int tlsf_init(tlsf_t *tlsf, void *memory, size_t bytes, size_t alignment);
+
+/* Returns pointer to at least size bytes or NULL, the block is accounted to the owner */
+void *tlsf_malloc(tlsf_t *tlsf, size_t size, tlsf_owner_t owner);
+
+/* Releases block allocated with tlsf_malloc, NULL is ignored */
+void tlsf_free(tlsf_t *tlsf, void *ptr);
+
+/* Resizes the block in place if possible, otherwise moves it. Returns NULL (and keeps ptr) on failure */
+void *tlsf_realloc(tlsf_t *tlsf, void *ptr, size_t size, tlsf_owner_t owner);
+
+/* Returns usable size of the allocated block */
+size_t tlsf_block_size(const tlsf_t *tlsf, const void *ptr);
+
+/* Returns owner of the allocated block */
+tlsf_owner_t tlsf_block_owner(const tlsf_t *tlsf, const void *ptr);
+
+/* Fills allocator statistics, the largest free block lookup only walks the highest non empty size class */
+void tlsf_get_stats(const tlsf_t *tlsf, tlsf_stats_t *stats);
+
+/* Walks all blocks and verifies heap consistency. Returns 0 if heap is consistent */
+int tlsf_check(const tlsf_t *tlsf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TLSF_H_ */
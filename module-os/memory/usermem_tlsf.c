@@ -0,0 +1,112 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+/*
+ * User space heap (usermem.h) on top of the TLSF allocator. Used instead of usermem.c when USE_TLSF_HEAP is enabled.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "macros.h"
+#include "usermem.h"
+#include "heapstats.h"
+
+#ifndef PROJECT_CONFIG_USER_DYNMEM_SIZE
+#error "Define user heap size!"
+#else
+#define USERMEM_TOTAL_HEAP_SIZE PROJECT_CONFIG_USER_DYNMEM_SIZE
+#endif
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Cached memory regions require 32 bytes alignment, see usermem.c */
+#define usermemBYTE_ALIGNMENT 32
+
+#if USERMEM_TOTAL_HEAP_SIZE > 0
+CACHEABLE_SECTION_SDRAM_ALIGN(static uint8_t userUcHeap[USERMEM_TOTAL_HEAP_SIZE], usermemBYTE_ALIGNMENT);
+#endif
+
+static tlsf_t userHeap;
+static bool userHeapInitialised = false;
+
+static bool userHeapInit(void)
+{
+#if USERMEM_TOTAL_HEAP_SIZE > 0
+    if (!userHeapInitialised) {
+        userHeapInitialised = tlsf_init(&userHeap, userUcHeap, USERMEM_TOTAL_HEAP_SIZE, usermemBYTE_ALIGNMENT) == 0;
+    }
+#endif
+    return userHeapInitialised;
+}
+
+void *usermalloc(size_t xWantedSize)
+{
+    void *ptr = NULL;
+
+    // Preventing use of an allocator in an interrupt
+    if (isIRQ()) {
+        abort();
+    }
+
+    vTaskSuspendAll();
+    {
+        if (userHeapInit()) {
+            ptr = tlsf_malloc(&userHeap, xWantedSize, heap_current_owner());
+        }
+    }
+    (void)xTaskResumeAll();
+    return ptr;
+}
+
+void userfree(void *pv)
+{
+    if (pv == NULL) {
+        return;
+    }
+
+    // Preventing use of an allocator in an interrupt
+    if (isIRQ()) {
+        abort();
+    }
+
+    vTaskSuspendAll();
+    {
+        tlsf_free(&userHeap, pv);
+    }
+    (void)xTaskResumeAll();
+}
+
+void *userrealloc(void *pv, size_t xWantedSize)
+{
+    void *ptr = NULL;
+
+    // Preventing use of an allocator in an interrupt
+    if (isIRQ()) {
+        abort();
+    }
+
+    vTaskSuspendAll();
+    {
+        if (userHeapInit()) {
+            ptr = tlsf_realloc(&userHeap, pv, xWantedSize, heap_current_owner());
+        }
+    }
+    (void)xTaskResumeAll();
+    return ptr;
+}
+
+size_t usermemGetFreeHeapSize(void)
+{
+    return userHeapInitialised ? userHeap.totalBytes - userHeap.usedBytes : USERMEM_TOTAL_HEAP_SIZE;
+}
+
+size_t usermemGetMinimumEverFreeHeapSize(void)
+{
+    return userHeapInitialised ? userHeap.totalBytes - userHeap.peakUsedBytes : USERMEM_TOTAL_HEAP_SIZE;
+}
+
+tlsf_t *heap_user_tlsf(void)
+{
+    return userHeapInitialised ? &userHeap : NULL;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include <tlsf.h>
+
+#include <array>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+// Benchmarks are hidden from default run, use: catch2-tlsf "[benchmark]"
+namespace
+{
+    constexpr auto heapSize    = 4 * 1024 * 1024;
+    constexpr auto blocksCount = 1024;
+
+    // Mix of small message/string sized blocks with occasional big buffers, similar to the system heap usage
+    std::array<std::size_t, blocksCount> blockSizes()
+    {
+        std::mt19937 generator{42};
+        std::array<std::size_t, blocksCount> sizes{};
+        for (auto &size : sizes) {
+            size = generator() % 16 == 0 ? 1024 + generator() % 4096 : 8 + generator() % 120;
+        }
+        return sizes;
+    }
+
+    template <typename Alloc, typename Free>
+    void churn(const std::array<std::size_t, blocksCount> &sizes, Alloc &&alloc, Free &&release)
+    {
+        std::array<void *, blocksCount> blocks{};
+        for (std::size_t i = 0; i < blocksCount; ++i) {
+            blocks[i] = alloc(sizes[i]);
+        }
+        // release every other block to fragment the heap and refill the holes
+        for (std::size_t i = 0; i < blocksCount; i += 2) {
+            release(blocks[i]);
+            blocks[i] = alloc(sizes[blocksCount - 1 - i]);
+        }
+        for (auto ptr : blocks) {
+            release(ptr);
+        }
+    }
+} // namespace
+
+TEST_CASE("TLSF: allocation benchmark", "[.][benchmark]")
+{
+    const auto sizes = blockSizes();
+    auto memory      = std::make_unique<std::uint8_t[]>(heapSize);
+    auto tlsf        = std::make_unique<tlsf_t>();
+    REQUIRE(tlsf_init(tlsf.get(), memory.get(), heapSize, 8) == 0);
+
+    BENCHMARK("tlsf")
+    {
+        churn(
+            sizes,
+            [&tlsf](std::size_t size) { return tlsf_malloc(tlsf.get(), size, 1); },
+            [&tlsf](void *ptr) { tlsf_free(tlsf.get(), ptr); });
+    };
+
+    BENCHMARK("std::malloc reference")
+    {
+        churn(
+            sizes, [](std::size_t size) { return std::malloc(size); }, [](void *ptr) { std::free(ptr); });
+    };
+
+    REQUIRE(tlsf_check(tlsf.get()) == 0);
+}
@@ -0,0 +1,254 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <tlsf.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr auto heapSize  = 256 * 1024;
+    constexpr auto alignment = 8;
+
+    struct Heap
+    {
+        explicit Heap(std::size_t size = heapSize, std::size_t align = alignment)
+            : memory(std::make_unique<std::uint8_t[]>(size)), tlsf(std::make_unique<tlsf_t>())
+        {
+            REQUIRE(tlsf_init(tlsf.get(), memory.get(), size, align) == 0);
+        }
+
+        auto stats() const
+        {
+            tlsf_stats_t result{};
+            tlsf_get_stats(tlsf.get(), &result);
+            return result;
+        }
+
+        std::unique_ptr<std::uint8_t[]> memory;
+        std::unique_ptr<tlsf_t> tlsf;
+    };
+} // namespace
+
+TEST_CASE("TLSF: init")
+{
+    tlsf_t tlsf;
+    std::uint8_t memory[64];
+
+    SECTION("Too small region")
+    {
+        REQUIRE(tlsf_init(&tlsf, memory, sizeof(memory) / 4, alignment) != 0);
+    }
+    SECTION("Alignment not a power of two")
+    {
+        REQUIRE(tlsf_init(&tlsf, memory, sizeof(memory), 12) != 0);
+    }
+    SECTION("Whole region is one free block")
+    {
+        Heap heap;
+        const auto stats = heap.stats();
+        REQUIRE(stats.usedBytes == 0);
+        REQUIRE(stats.freeBlocks == 1);
+        REQUIRE(stats.largestFreeBlock == stats.freeBytes);
+        REQUIRE(stats.totalBytes <= heapSize);
+        REQUIRE(tlsf_check(heap.tlsf.get()) == 0);
+    }
+}
+
+TEST_CASE("TLSF: allocation")
+{
+    Heap heap;
+    auto tlsf = heap.tlsf.get();
+
+    SECTION("Zero size")
+    {
+        REQUIRE(tlsf_malloc(tlsf, 0, 0) == nullptr);
+    }
+    SECTION("Too big")
+    {
+        REQUIRE(tlsf_malloc(tlsf, heapSize, 0) == nullptr);
+        REQUIRE(heap.stats().failedAllocations == 1);
+    }
+    SECTION("Blocks are aligned and don't overlap")
+    {
+        std::vector<std::uint8_t *> blocks;
+        for (std::size_t size = 1; size < 2048; size += 37) {
+            auto ptr = static_cast<std::uint8_t *>(tlsf_malloc(tlsf, size, 0));
+            REQUIRE(ptr != nullptr);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0);
+            REQUIRE(tlsf_block_size(tlsf, ptr) >= size);
+            std::memset(ptr, static_cast<int>(blocks.size()), size);
+            blocks.push_back(ptr);
+        }
+        REQUIRE(tlsf_check(tlsf) == 0);
+
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            const auto size = 1 + i * 37;
+            REQUIRE(std::all_of(blocks[i], blocks[i] + size, [i](auto byte) { return byte == (i & 0xff); }));
+        }
+    }
+    SECTION("Whole heap is recovered after release")
+    {
+        const auto initial = heap.stats();
+        std::vector<void *> blocks;
+        while (auto ptr = tlsf_malloc(tlsf, 1000, 0)) {
+            blocks.push_back(ptr);
+        }
+        REQUIRE(blocks.size() > heapSize / 1100);
+        REQUIRE(tlsf_check(tlsf) == 0);
+
+        for (std::size_t i = 0; i < blocks.size(); i += 2) {
+            tlsf_free(tlsf, blocks[i]);
+        }
+        REQUIRE(tlsf_check(tlsf) == 0);
+        for (std::size_t i = 1; i < blocks.size(); i += 2) {
+            tlsf_free(tlsf, blocks[i]);
+        }
+        REQUIRE(tlsf_check(tlsf) == 0);
+
+        const auto stats = heap.stats();
+        REQUIRE(stats.usedBytes == 0);
+        REQUIRE(stats.freeBlocks == 1);
+        REQUIRE(stats.freeBytes == initial.freeBytes);
+        REQUIRE(stats.peakUsedBytes > 0);
+    }
+    SECTION("Double free is ignored")
+    {
+        auto first  = tlsf_malloc(tlsf, 100, 0);
+        auto second = tlsf_malloc(tlsf, 100, 0);
+        tlsf_free(tlsf, first);
+        tlsf_free(tlsf, first);
+        REQUIRE(tlsf_check(tlsf) == 0);
+        REQUIRE(heap.stats().usedBlocks == 1);
+        tlsf_free(tlsf, second);
+    }
+}
+
+TEST_CASE("TLSF: custom alignment")
+{
+    constexpr auto cacheLine = 32;
+    Heap heap(heapSize, cacheLine);
+    for (auto size : {1, 31, 32, 33, 100, 4000}) {
+        auto ptr = tlsf_malloc(heap.tlsf.get(), size, 0);
+        REQUIRE(ptr != nullptr);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % cacheLine == 0);
+    }
+    REQUIRE(tlsf_check(heap.tlsf.get()) == 0);
+}
+
+TEST_CASE("TLSF: realloc")
+{
+    Heap heap;
+    auto tlsf = heap.tlsf.get();
+
+    auto ptr = static_cast<std::uint8_t *>(tlsf_malloc(tlsf, 64, 1));
+    std::memset(ptr, 0x5a, 64);
+
+    SECTION("Grows in place when followed by a free block")
+    {
+        auto grown = static_cast<std::uint8_t *>(tlsf_realloc(tlsf, ptr, 4096, 1));
+        REQUIRE(grown == ptr);
+        REQUIRE(tlsf_block_size(tlsf, grown) >= 4096);
+        REQUIRE(std::all_of(grown, grown + 64, [](auto byte) { return byte == 0x5a; }));
+        REQUIRE(tlsf->owners[1].usedBytes == tlsf_block_size(tlsf, grown));
+    }
+    SECTION("Moves when followed by a used block")
+    {
+        auto blocker = tlsf_malloc(tlsf, 16, 2);
+        auto moved   = static_cast<std::uint8_t *>(tlsf_realloc(tlsf, ptr, 4096, 1));
+        REQUIRE(moved != ptr);
+        REQUIRE(std::all_of(moved, moved + 64, [](auto byte) { return byte == 0x5a; }));
+        REQUIRE(heap.stats().usedBlocks == 2);
+        tlsf_free(tlsf, blocker);
+    }
+    SECTION("Shrinks in place")
+    {
+        auto grown  = tlsf_realloc(tlsf, ptr, 4096, 1);
+        auto shrunk = tlsf_realloc(tlsf, grown, 32, 1);
+        REQUIRE(shrunk == ptr);
+        REQUIRE(tlsf_block_size(tlsf, shrunk) < 64);
+        REQUIRE(heap.stats().freeBlocks == 1);
+    }
+    SECTION("Failure keeps the block")
+    {
+        REQUIRE(tlsf_realloc(tlsf, ptr, heapSize, 1) == nullptr);
+        REQUIRE(tlsf_block_size(tlsf, ptr) >= 64);
+    }
+    REQUIRE(tlsf_check(tlsf) == 0);
+}
+
+TEST_CASE("TLSF: owners accounting")
+{
+    Heap heap;
+    auto tlsf = heap.tlsf.get();
+
+    auto first  = tlsf_malloc(tlsf, 100, 1);
+    auto second = tlsf_malloc(tlsf, 200, 2);
+    auto third  = tlsf_malloc(tlsf, 300, 2);
+    auto lost   = tlsf_malloc(tlsf, 50, TLSF_MAX_OWNERS);
+
+    REQUIRE(tlsf_block_owner(tlsf, first) == 1);
+    REQUIRE(tlsf_block_owner(tlsf, third) == 2);
+    REQUIRE(tlsf_block_owner(tlsf, lost) == 0);
+    REQUIRE(tlsf->owners[1].usedBlocks == 1);
+    REQUIRE(tlsf->owners[2].usedBlocks == 2);
+    REQUIRE(tlsf->owners[2].usedBytes == tlsf_block_size(tlsf, second) + tlsf_block_size(tlsf, third));
+
+    tlsf_free(tlsf, third);
+    REQUIRE(tlsf->owners[2].usedBytes == tlsf_block_size(tlsf, second));
+    REQUIRE(tlsf->owners[2].peakUsedBytes > tlsf->owners[2].usedBytes);
+
+    tlsf_free(tlsf, first);
+    tlsf_free(tlsf, second);
+    tlsf_free(tlsf, lost);
+    for (const auto &owner : tlsf->owners) {
+        REQUIRE(owner.usedBytes == 0);
+        REQUIRE(owner.usedBlocks == 0);
+    }
+}
+
+TEST_CASE("TLSF: random operations keep heap consistent")
+{
+    Heap heap;
+    auto tlsf = heap.tlsf.get();
+    std::mt19937 generator{1234};
+    std::uniform_int_distribution<std::size_t> sizes{1, 3000};
+    std::vector<void *> blocks;
+
+    for (int i = 0; i < 20000; ++i) {
+        const auto operation = generator() % 4;
+        if (operation < 2 || blocks.empty()) {
+            if (auto ptr = tlsf_malloc(tlsf, sizes(generator), generator() % 4)) {
+                blocks.push_back(ptr);
+            }
+        }
+        else if (operation == 2) {
+            const auto index = generator() % blocks.size();
+            tlsf_free(tlsf, blocks[index]);
+            blocks[index] = blocks.back();
+            blocks.pop_back();
+        }
+        else {
+            const auto index = generator() % blocks.size();
+            if (auto ptr = tlsf_realloc(tlsf, blocks[index], sizes(generator), 3)) {
+                blocks[index] = ptr;
+            }
+        }
+        if (i % 500 == 0) {
+            REQUIRE(tlsf_check(tlsf) == 0);
+        }
+    }
+
+    for (auto ptr : blocks) {
+        tlsf_free(tlsf, ptr);
+    }
+    REQUIRE(tlsf_check(tlsf) == 0);
+    REQUIRE(heap.stats().freeBlocks == 1);
+}
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <purefs/blkdev/disk.hpp>
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -15,7 +16,18 @@ namespace purefs::blkdev
         static constexpr auto syspart_size = 32 * 1024UL * 1024UL;
 
       public:
-        explicit disk_image(std::string_view image_filename, std::size_t sector_size = 512, hwpart_t num_parts = 8);
+        //! When the written data reaches the image file storage
+        enum class sync_policy
+        {
+            always,     //! Each write is synchronous (O_SYNC)
+            on_request, //! Data is synchronized on the disk sync request only
+            never       //! Synchronization is left to the host OS
+        };
+
+        explicit disk_image(std::string_view image_filename,
+                            std::size_t sector_size = 512,
+                            hwpart_t num_parts      = 8,
+                            sync_policy policy      = sync_policy::on_request);
         virtual ~disk_image()
         {}
 
@@ -32,15 +44,20 @@ namespace purefs::blkdev
         auto pm_read(pm_state &current_state) -> int override;
         auto range_valid(sector_t lba, std::size_t count, hwpart_t hwpart) const -> bool;
         auto open_and_truncate(hwpart_t hwpart) -> int;
+        auto descriptor(hwpart_t hwpart) -> int;
+        auto open_flags() const noexcept -> int;
 
       private:
         pm_state pmState{pm_state::active};
-        std::vector<int> m_filedes;
+        //! Opened once and never changed until cleanup, so the I/O doesn't need the lock
+        std::vector<std::atomic<int>> m_filedes;
         std::vector<std::size_t> m_sectors;
         const std::string m_image_name;
         const std::size_t m_sector_size;
         const std::size_t m_syspart_sectors;
         const hwpart_t m_sysparts;
-        mutable std::recursive_mutex m_mtx;
+        const sync_policy m_sync_policy;
+        //! Serializes opening and closing of the image files
+        mutable std::mutex m_mtx;
     };
 } // namespace purefs::blkdev
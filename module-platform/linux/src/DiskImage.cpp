@@ -5,42 +5,94 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <cstring>
 #include <sys/stat.h>
 
 namespace purefs::blkdev
 {
+    namespace
+    {
+        //! Maximum number of sectors filled by a single erase write
+        constexpr std::size_t erase_chunk_sectors = 64;
 
-    disk_image::disk_image(std::string_view image_filename, std::size_t sector_size, hwpart_t num_parts)
-        : m_image_name(image_filename), m_sector_size(sector_size), m_syspart_sectors(syspart_size / sector_size),
-          m_sysparts(num_parts)
+        auto read_all(int fd, std::uint8_t *buf, std::size_t size, off64_t offs) -> int
+        {
+            while (size > 0) {
+                const auto ret = ::pread64(fd, buf, size, offs);
+                if (ret < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return -errno;
+                }
+                if (ret == 0) {
+                    return -EIO;
+                }
+                size -= ret;
+                buf += ret;
+                offs += ret;
+            }
+            return 0;
+        }
+
+        auto write_all(int fd, const std::uint8_t *buf, std::size_t size, off64_t offs) -> int
+        {
+            while (size > 0) {
+                const auto ret = ::pwrite64(fd, buf, size, offs);
+                if (ret < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return -errno;
+                }
+                size -= ret;
+                buf += ret;
+                offs += ret;
+            }
+            return 0;
+        }
+    } // namespace
+
+    disk_image::disk_image(std::string_view image_filename,
+                           std::size_t sector_size,
+                           hwpart_t num_parts,
+                           sync_policy policy)
+        : m_filedes(num_parts), m_image_name(image_filename), m_sector_size(sector_size),
+          m_syspart_sectors(syspart_size / sector_size), m_sysparts(num_parts), m_sync_policy(policy)
     {
         if (num_parts < 1) {
             throw std::range_error("Number of partitions out of range");
         }
-        m_filedes.resize(num_parts, invalid_fd);
+        for (auto &fd : m_filedes) {
+            fd = invalid_fd;
+        }
         m_sectors.resize(num_parts, m_syspart_sectors);
         m_sectors[0] = 0;
     }
 
     auto disk_image::probe(unsigned int flags) -> int
     {
-        std::lock_guard<std::recursive_mutex> m_lock(m_mtx);
-        m_filedes[0] = ::open(m_image_name.c_str(), O_RDWR | O_SYNC);
-        if (!m_filedes[0])
-            return m_filedes[0];
+        std::lock_guard<std::mutex> m_lock(m_mtx);
+        const auto fd = ::open(m_image_name.c_str(), O_RDWR | open_flags());
+        if (fd < 0) {
+            return -errno;
+        }
         struct stat fst;
-        auto ret = ::fstat(m_filedes[0], &fst);
+        auto ret = ::fstat(fd, &fst);
         if (ret < 0) {
-            return -errno;
+            ret = -errno;
+            ::close(fd);
+            return ret;
         }
         m_sectors[0] = fst.st_size / m_sector_size;
+        m_filedes[0] = fd;
         return fst.st_size % m_sector_size;
     }
 
     auto disk_image::cleanup() -> int
     {
-        std::lock_guard<std::recursive_mutex> m_lock(m_mtx);
+        std::lock_guard<std::mutex> m_lock(m_mtx);
         int ret{};
         for (auto &fd : m_filedes)
             if (fd > 0) {
@@ -55,72 +107,62 @@ namespace purefs::blkdev
 
     auto disk_image::write(const void *buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int
     {
-        std::lock_guard<std::recursive_mutex> m_lock(m_mtx);
         if (!range_valid(lba, count, hwpart)) {
             return -ERANGE;
         }
-        const int err = open_and_truncate(hwpart);
-        if (err) {
-            return err;
-        }
-        auto offs = ::lseek64(m_filedes[hwpart], off64_t(lba) * off64_t(m_sector_size), SEEK_SET);
-        if (offs < 0) {
-            return offs;
+        const auto fd = descriptor(hwpart);
+        if (fd < 0) {
+            return fd;
         }
-        auto to_write = count * m_sector_size;
-        auto buf_b    = reinterpret_cast<const uint8_t *>(buf);
-        do {
-            auto ret = ::write(m_filedes[hwpart], buf_b, to_write);
-            if (ret < 0) {
-                return -errno;
-            }
-            to_write -= ret;
-            buf_b += ret;
-        } while (to_write > 0);
-        return 0;
+        return write_all(fd,
+                         reinterpret_cast<const std::uint8_t *>(buf),
+                         count * m_sector_size,
+                         off64_t(lba) * off64_t(m_sector_size));
     }
 
     auto disk_image::erase(sector_t lba, std::size_t count, hwpart_t hwpart) -> int
     {
-        std::unique_ptr<char[]> buf(new char[count * m_sector_size]);
-        std::memset(buf.get(), 0xff, count * m_sector_size);
-        return write(buf.get(), lba, count, hwpart);
+        if (!range_valid(lba, count, hwpart)) {
+            return -ERANGE;
+        }
+        const auto chunk = std::min(count, erase_chunk_sectors);
+        std::unique_ptr<char[]> buf(new char[chunk * m_sector_size]);
+        std::memset(buf.get(), 0xff, chunk * m_sector_size);
+        while (count > 0) {
+            const auto to_erase = std::min(count, chunk);
+            const auto err      = write(buf.get(), lba, to_erase, hwpart);
+            if (err) {
+                return err;
+            }
+            lba += to_erase;
+            count -= to_erase;
+        }
+        return 0;
     }
 
     auto disk_image::read(void *buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int
     {
-        std::lock_guard<std::recursive_mutex> m_lock(m_mtx);
         if (!range_valid(lba, count, hwpart)) {
             return -ERANGE;
         }
-        const int err = open_and_truncate(hwpart);
-        if (err) {
-            return err;
-        }
-        auto offs = ::lseek64(m_filedes[hwpart], off64_t(lba) * off64_t(m_sector_size), SEEK_SET);
-        if (offs < 0) {
-            return offs;
+        const auto fd = descriptor(hwpart);
+        if (fd < 0) {
+            return fd;
         }
-        auto to_read = count * m_sector_size;
-        auto buf_b   = reinterpret_cast<uint8_t *>(buf);
-        do {
-            auto ret = ::read(m_filedes[hwpart], buf_b, to_read);
-            if (ret < 0) {
-                return -errno;
-            }
-            to_read -= ret;
-            buf_b += ret;
-        } while (to_read > 0);
-        return 0;
+        return read_all(
+            fd, reinterpret_cast<std::uint8_t *>(buf), count * m_sector_size, off64_t(lba) * off64_t(m_sector_size));
     }
 
     auto disk_image::sync() -> int
     {
-        std::lock_guard<std::recursive_mutex> m_lock(m_mtx);
+        if (m_sync_policy == sync_policy::never) {
+            return 0;
+        }
+        std::lock_guard<std::mutex> m_lock(m_mtx);
         int ret{};
-        for (auto fd : m_filedes)
+        for (const auto &fd : m_filedes)
             if (fd > 0) {
-                ret = fsync(fd);
+                ret = ::fdatasync(fd);
                 if (ret < 0)
                     return -errno;
             }
@@ -129,7 +171,6 @@ namespace purefs::blkdev
 
     auto disk_image::status() const -> media_status
     {
-        std::lock_guard<std::recursive_mutex> m_lock(m_mtx);
         struct stat st;
         const auto ret = ::stat(m_image_name.c_str(), &st);
         if (ret < 0)
@@ -140,7 +181,6 @@ namespace purefs::blkdev
 
     auto disk_image::get_info(info_type what, hwpart_t hwpart) const -> scount_t
     {
-        std::lock_guard<std::recursive_mutex> m_lock(m_mtx);
         if (hwpart >= m_sysparts) {
             return -ERANGE;
         }
@@ -162,31 +202,59 @@ namespace purefs::blkdev
         return (hwpart < m_sysparts) && (lba < m_sectors[hwpart]) && ((lba + count) <= m_sectors[hwpart]);
     }
 
+    auto disk_image::descriptor(hwpart_t hwpart) -> int
+    {
+        const int fd = m_filedes[hwpart];
+        if (fd != invalid_fd) {
+            return fd;
+        }
+        std::lock_guard<std::mutex> m_lock(m_mtx);
+        const int err = open_and_truncate(hwpart);
+        if (err) {
+            return err;
+        }
+        return m_filedes[hwpart];
+    }
+
+    auto disk_image::open_flags() const noexcept -> int
+    {
+        return (m_sync_policy == sync_policy::always) ? O_SYNC : 0;
+    }
+
     auto disk_image::disk_image::open_and_truncate(hwpart_t hwpart) -> int
     {
         if (hwpart >= m_sysparts) {
             return -ERANGE;
         }
-        if (hwpart == 0 || m_filedes[hwpart] > 0) {
+        if (m_filedes[hwpart] != invalid_fd) {
             return 0;
         }
+        if (hwpart == 0) {
+            // Main image is opened by the probe only
+            return -EBADF;
+        }
         using namespace std::string_literals;
         const auto alt_filename = m_image_name + "."s + std::to_string(hwpart);
-        m_filedes[hwpart]       = ::open(alt_filename.c_str(), O_RDWR | O_CREAT | O_SYNC, 0644);
-        if (m_filedes[hwpart] < 0) {
+        const auto fd           = ::open(alt_filename.c_str(), O_RDWR | O_CREAT | open_flags(), 0644);
+        if (fd < 0) {
             return -errno;
         }
         struct stat fst;
-        auto ret = ::fstat(m_filedes[hwpart], &fst);
+        auto ret = ::fstat(fd, &fst);
         if (ret < 0) {
-            return -errno;
+            ret = -errno;
+            ::close(fd);
+            return ret;
         }
         if (static_cast<unsigned long>(fst.st_size) < m_sectors[hwpart] * m_sector_size) {
-            ret = ::ftruncate(m_filedes[hwpart], syspart_size);
+            ret = ::ftruncate(fd, syspart_size);
             if (ret < 0) {
+                ret = -errno;
+                ::close(fd);
                 return ret;
             }
         }
+        m_filedes[hwpart] = fd;
         return 0;
     }
 
@@ -0,0 +1,126 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <purefs/blkdev/disk_manager.hpp>
+
+#include <platform/linux/DiskImage.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Benchmarks are hidden from default run, use: catch2-vfs-disk "[benchmark]"
+namespace
+{
+    constexpr auto bench_image     = "benchmark_disk.img";
+    constexpr auto bench_dev       = "bench0";
+    constexpr auto image_size      = 16 * 1024 * 1024;
+    constexpr auto sector_size     = 512;
+    constexpr auto sectors         = image_size / sector_size;
+    constexpr auto transfer_size   = 64;
+    constexpr auto random_requests = 1024;
+    constexpr auto reader_threads  = 4;
+
+    std::shared_ptr<purefs::blkdev::disk_manager> make_manager(purefs::blkdev::disk_image::sync_policy policy)
+    {
+        std::ofstream ofc(bench_image);
+        ofc.close();
+        std::filesystem::resize_file(bench_image, image_size);
+        auto dm   = std::make_shared<purefs::blkdev::disk_manager>();
+        auto disk = std::make_shared<purefs::blkdev::disk_image>(bench_image, sector_size, 1, policy);
+        REQUIRE(dm->register_device(disk, bench_dev, purefs::blkdev::flags::no_parts_scan) == 0);
+        return dm;
+    }
+
+    std::vector<purefs::blkdev::sector_t> random_sectors()
+    {
+        std::mt19937 generator{42};
+        std::vector<purefs::blkdev::sector_t> lbas(random_requests);
+        for (auto &lba : lbas) {
+            lba = generator() % sectors;
+        }
+        return lbas;
+    }
+} // namespace
+
+TEST_CASE("Disk image: sequential throughput", "[.][benchmark]")
+{
+    using policy      = purefs::blkdev::disk_image::sync_policy;
+    auto dm           = make_manager(policy::on_request);
+    const auto handle = dm->device_handle(bench_dev);
+    std::vector<char> buf(transfer_size * sector_size, 0x5A);
+
+    BENCHMARK("write 16 MiB in 32 KiB requests")
+    {
+        auto ret = 0;
+        for (purefs::blkdev::sector_t lba = 0; lba < sectors; lba += transfer_size) {
+            ret |= dm->write(handle, buf.data(), lba, transfer_size);
+        }
+        return ret | dm->sync(handle);
+    };
+
+    BENCHMARK("read 16 MiB in 32 KiB requests")
+    {
+        auto ret = 0;
+        for (purefs::blkdev::sector_t lba = 0; lba < sectors; lba += transfer_size) {
+            ret |= dm->read(handle, buf.data(), lba, transfer_size);
+        }
+        return ret;
+    };
+
+    auto dm_sync           = make_manager(policy::always);
+    const auto handle_sync = dm_sync->device_handle(bench_dev);
+    BENCHMARK("write 1 MiB in 32 KiB requests with synchronous writes")
+    {
+        auto ret = 0;
+        for (purefs::blkdev::sector_t lba = 0; lba < 2048; lba += transfer_size) {
+            ret |= dm_sync->write(handle_sync, buf.data(), lba, transfer_size);
+        }
+        return ret;
+    };
+}
+
+TEST_CASE("Disk image: random sector access", "[.][benchmark]")
+{
+    auto dm           = make_manager(purefs::blkdev::disk_image::sync_policy::on_request);
+    const auto handle = dm->device_handle(bench_dev);
+    const auto lbas   = random_sectors();
+    std::vector<char> buf(sector_size);
+
+    BENCHMARK("1024 single sector reads")
+    {
+        auto ret = 0;
+        for (const auto lba : lbas) {
+            ret |= dm->read(handle, buf.data(), lba, 1);
+        }
+        return ret;
+    };
+
+    BENCHMARK("1024 single sector reads from 4 threads")
+    {
+        std::vector<std::thread> readers;
+        for (auto i = 0; i < reader_threads; ++i) {
+            readers.emplace_back([&, i]() {
+                std::vector<char> thread_buf(sector_size);
+                for (std::size_t j = i; j < lbas.size(); j += reader_threads) {
+                    dm->read(handle, thread_buf.data(), lbas[j], 1);
+                }
+            });
+        }
+        for (auto &reader : readers) {
+            reader.join();
+        }
+    };
+
+    BENCHMARK("1024 single sector writes")
+    {
+        auto ret = 0;
+        for (const auto lba : lbas) {
+            ret |= dm->write(handle, buf.data(), lba, 1);
+        }
+        return ret;
+    };
+}
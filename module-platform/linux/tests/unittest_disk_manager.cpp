@@ -8,6 +8,7 @@
 
 #include "test-setup.hpp"
 
+#include <algorithm>
 #include <filesystem>
 
 namespace
@@ -171,6 +172,149 @@ TEST_CASE("Disk manager EEPROM emulation")
     REQUIRE(buf_in2 == buf_out2);
 }
 
+TEST_CASE("Disk manager sector cache")
+{
+    using namespace purefs;
+    constexpr auto part_name = "emmc0sys1";
+    blkdev::disk_manager dm;
+    auto disk = std::make_shared<blkdev::disk_image>(::testing::vfs::disk_image);
+    REQUIRE(dm.register_device(disk, "emmc0") == 0);
+    // Second manager sees only the data which reached the device
+    blkdev::disk_manager dm_direct;
+    auto disk_direct = std::make_shared<blkdev::disk_image>(::testing::vfs::disk_image);
+    REQUIRE(dm_direct.register_device(disk_direct, "emmc0") == 0);
+
+    const auto sect_size = dm.get_info(part_name, blkdev::info_type::sector_size);
+    REQUIRE(sect_size > 0);
+    REQUIRE(!dm.cache_info(part_name));
+    std::vector<char> zero(sect_size, 0);
+    for (blkdev::sector_t lba = 0; lba < 8; ++lba) {
+        REQUIRE(dm.write(part_name, zero.data(), lba, 1) == 0);
+    }
+
+    SECTION("Read hits")
+    {
+        REQUIRE(dm.configure_cache(part_name, blkdev::cache_mode::write_through, 16) == 0);
+        std::vector<char> buf1(4 * sect_size, 1), buf2(4 * sect_size, 2);
+        REQUIRE(dm.read(part_name, buf1.data(), 0, 4) == 0);
+        REQUIRE(dm.read(part_name, buf2.data(), 0, 4) == 0);
+        REQUIRE(buf1 == buf2);
+        const auto stats = dm.cache_info(part_name);
+        REQUIRE(stats);
+        REQUIRE(stats->capacity == 16);
+        REQUIRE(stats->cached == 4);
+        REQUIRE(stats->misses == 4);
+        REQUIRE(stats->hits == 4);
+        REQUIRE(!dm.cache_info("emmc0"));
+    }
+
+    SECTION("Write through")
+    {
+        REQUIRE(dm.configure_cache(part_name, blkdev::cache_mode::write_through, 16) == 0);
+        std::vector<char> buf_in(sect_size, 0xAA), buf_out(sect_size);
+        REQUIRE(dm.read(part_name, buf_out.data(), 1, 1) == 0);
+        REQUIRE(dm.write(part_name, buf_in.data(), 1, 1) == 0);
+        REQUIRE(dm.read(part_name, buf_out.data(), 1, 1) == 0);
+        REQUIRE(buf_in == buf_out);
+        REQUIRE(dm.cache_info(part_name)->dirty == 0);
+        REQUIRE(dm_direct.read(part_name, buf_out.data(), 1, 1) == 0);
+        REQUIRE(buf_in == buf_out);
+    }
+
+    SECTION("Write back")
+    {
+        REQUIRE(dm.configure_cache(part_name, blkdev::cache_mode::write_back, 16) == 0);
+        std::vector<char> buf_in(2 * sect_size, 0xCC), buf_out(2 * sect_size);
+        REQUIRE(dm.write(part_name, buf_in.data(), 2, 2) == 0);
+        REQUIRE(dm.read(part_name, buf_out.data(), 2, 2) == 0);
+        REQUIRE(buf_in == buf_out);
+        REQUIRE(dm_direct.read(part_name, buf_out.data(), 2, 1) == 0);
+        REQUIRE(std::equal(std::begin(zero), std::end(zero), std::begin(buf_out)));
+        REQUIRE(dm.cache_info(part_name)->dirty == 2);
+
+        REQUIRE(dm.sync(part_name) == 0);
+        const auto stats = dm.cache_info(part_name);
+        REQUIRE(stats->dirty == 0);
+        REQUIRE(stats->writebacks == 2);
+        REQUIRE(dm_direct.read(part_name, buf_out.data(), 2, 2) == 0);
+        REQUIRE(buf_in == buf_out);
+    }
+
+    SECTION("Eviction of dirty sectors")
+    {
+        REQUIRE(dm.configure_cache(part_name, blkdev::cache_mode::write_back, 4) == 0);
+        std::vector<char> buf(sect_size);
+        for (blkdev::sector_t lba = 0; lba < 8; ++lba) {
+            std::fill(std::begin(buf), std::end(buf), char(lba + 1));
+            REQUIRE(dm.write(part_name, buf.data(), lba, 1) == 0);
+        }
+        auto stats = dm.cache_info(part_name);
+        REQUIRE(stats->cached == 4);
+        REQUIRE(stats->dirty == 4);
+        REQUIRE(stats->evictions == 4);
+        REQUIRE(stats->writebacks == 4);
+
+        // Disabling the cache writes the remaining sectors
+        REQUIRE(dm.configure_cache(part_name, blkdev::cache_mode::disabled, 0) == 0);
+        REQUIRE(!dm.cache_info(part_name));
+        for (blkdev::sector_t lba = 0; lba < 8; ++lba) {
+            REQUIRE(dm_direct.read(part_name, buf.data(), lba, 1) == 0);
+            REQUIRE(buf[0] == char(lba + 1));
+            REQUIRE(buf[sect_size - 1] == char(lba + 1));
+        }
+    }
+
+    SECTION("Large transfers bypass the cache")
+    {
+        REQUIRE(dm.configure_cache(part_name, blkdev::cache_mode::write_back, 4) == 0);
+        std::vector<char> buf(8 * sect_size, 0x11);
+        REQUIRE(dm.write(part_name, buf.data(), 0, 8) == 0);
+        REQUIRE(dm.read(part_name, buf.data(), 0, 8) == 0);
+        const auto stats = dm.cache_info(part_name);
+        REQUIRE(stats->cached == 0);
+        REQUIRE(stats->dirty == 0);
+        REQUIRE(stats->misses == 8);
+    }
+}
+
+TEST_CASE("Disk manager I/O statistics")
+{
+    using namespace purefs;
+    blkdev::disk_manager dm;
+    auto disk = std::make_shared<blkdev::disk_image>(::testing::vfs::disk_image);
+    REQUIRE(dm.register_device(disk, "emmc0") == 0);
+    dm.reset_io_statistics();
+    REQUIRE(dm.io_statistics().empty());
+
+    const auto sect_size = dm.get_info("emmc0", blkdev::info_type::sector_size);
+    REQUIRE(sect_size > 0);
+    std::vector<char> buf(4 * sect_size);
+    REQUIRE(dm.read("emmc0", buf.data(), 0, 4) == 0);
+    REQUIRE(dm.write("emmc0", buf.data(), 0, 1) == 0);
+    REQUIRE(dm.read("emmc0", buf.data(), 2, 2) == 0);
+    REQUIRE(dm.sync("emmc0") == 0);
+    REQUIRE(dm.read("emmc0part0", buf.data(), 0, 1) == 0);
+    REQUIRE(dm.read("emmc0", buf.data(), dm.get_info("emmc0", blkdev::info_type::sector_count), 1) < 0);
+
+    const auto stats = dm.io_statistics();
+    REQUIRE(stats.size() == 2);
+    REQUIRE(stats[0].source == "emmc0");
+    REQUIRE(stats[0].driver == "emmc0");
+    REQUIRE(stats[0].op(io_op::read).calls == 2);
+    REQUIRE(stats[0].op(io_op::read).errors == 0);
+    REQUIRE(stats[0].op(io_op::read).bytes == 6U * sect_size);
+    REQUIRE(stats[0].op(io_op::write).calls == 1);
+    REQUIRE(stats[0].op(io_op::write).bytes == std::uint64_t(sect_size));
+    REQUIRE(stats[0].op(io_op::fsync).calls == 1);
+    REQUIRE(stats[1].source == "emmc0part0");
+    REQUIRE(stats[1].driver == "emmc0");
+    REQUIRE(stats[1].op(io_op::read).calls == 1);
+    REQUIRE(stats[1].task == stats[0].task);
+
+    dm.reset_io_statistics();
+    REQUIRE(dm.io_statistics().empty());
+}
+
 TEST_CASE("Null pointer passed to disk manager functions")
 {
     using namespace purefs;
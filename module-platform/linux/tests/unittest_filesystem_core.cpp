@@ -437,3 +437,83 @@ TEST_CASE("Corefs: stat extended")
     // Final umount
     REQUIRE(fs_core.umount("/sys") == 0);
 }
+
+TEST_CASE("Corefs: I/O statistics")
+{
+    using namespace purefs;
+    auto dm   = std::make_shared<blkdev::disk_manager>();
+    auto disk = std::make_shared<blkdev::disk_image>(::testing::vfs::disk_image);
+    REQUIRE(disk);
+    REQUIRE(dm->register_device(disk, "emmc0") == 0);
+    purefs::fs::filesystem fs_core(dm);
+    const auto vfs_vfat = std::make_shared<fs::drivers::filesystem_vfat>();
+    REQUIRE(fs_core.register_filesystem("vfat", vfs_vfat) == 0);
+    REQUIRE(fs_core.mount("emmc0part0", "/sys", "vfat") == 0);
+    dm->reset_io_statistics();
+    REQUIRE(fs_core.io_statistics().empty());
+
+    const std::string text = "I/O statistics test";
+    auto fd                = fs_core.open("/sys/iostats.txt", O_RDWR | O_CREAT, 0660);
+    REQUIRE(fd >= 3);
+    REQUIRE(fs_core.write(fd, text.c_str(), text.size()) == ssize_t(text.size()));
+    REQUIRE(fs_core.fsync(fd) == 0);
+    REQUIRE(fs_core.seek(fd, 0, SEEK_SET) == 0);
+    char buf[64]{};
+    REQUIRE(fs_core.read(fd, buf, sizeof(buf)) == ssize_t(text.size()));
+    REQUIRE(fs_core.close(fd) == 0);
+    REQUIRE(fs_core.open("/sys/not_existing_file", O_RDONLY, 0) < 0);
+    struct stat st;
+    REQUIRE(fs_core.stat("/sys/iostats.txt", st) == 0);
+    const auto dirhandle = fs_core.diropen("/sys");
+    REQUIRE(dirhandle);
+    std::string fname;
+    REQUIRE(fs_core.dirnext(dirhandle, fname, st) == 0);
+    REQUIRE(fs_core.dirclose(dirhandle) == 0);
+
+    SECTION("VFS layer")
+    {
+        const auto stats = fs_core.io_statistics();
+        REQUIRE(stats.size() == 1);
+        const auto &entry = stats.front();
+        REQUIRE(entry.source == "/sys");
+        REQUIRE(entry.driver == "vfat");
+        REQUIRE(!entry.task.empty());
+        REQUIRE(entry.op(io_op::open).calls == 3);
+        REQUIRE(entry.op(io_op::open).errors == 1);
+        REQUIRE(entry.op(io_op::write).calls == 1);
+        REQUIRE(entry.op(io_op::write).bytes == text.size());
+        REQUIRE(entry.op(io_op::read).calls == 1);
+        REQUIRE(entry.op(io_op::read).bytes == text.size());
+        REQUIRE(entry.op(io_op::fsync).calls == 1);
+        REQUIRE(entry.op(io_op::stat).calls == 1);
+        REQUIRE(entry.op(io_op::readdir).calls == 1);
+        REQUIRE(entry.op(io_op::erase).calls == 0);
+        for (const auto &op : entry.ops) {
+            std::uint32_t histogram_calls = 0;
+            for (const auto count : op.histogram) {
+                histogram_calls += count;
+            }
+            REQUIRE(histogram_calls == op.calls);
+        }
+        fs_core.reset_io_statistics();
+        REQUIRE(fs_core.io_statistics().empty());
+    }
+
+    SECTION("Block layer")
+    {
+        const auto sect_size = dm->get_info("emmc0part0", blkdev::info_type::sector_size);
+        REQUIRE(sect_size > 0);
+        const auto stats = dm->io_statistics();
+        REQUIRE(stats.size() == 1);
+        const auto &entry = stats.front();
+        REQUIRE(entry.source == "emmc0part0");
+        REQUIRE(entry.driver == "emmc0");
+        REQUIRE(entry.op(io_op::write).calls > 0);
+        REQUIRE(entry.op(io_op::write).bytes % sect_size == 0);
+        REQUIRE(entry.op(io_op::write).bytes >= entry.op(io_op::write).calls * std::uint64_t(sect_size));
+        REQUIRE(entry.op(io_op::write).errors == 0);
+    }
+
+    REQUIRE(fs_core.unlink("/sys/iostats.txt") == 0);
+    REQUIRE(fs_core.umount("/sys") == 0);
+}
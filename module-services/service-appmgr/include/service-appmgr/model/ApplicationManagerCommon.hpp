@@ -8,6 +8,7 @@
 #include "ActionsRegistry.hpp"
 #include "ApplicationStack.hpp"
 #include "OnActionPolicy.hpp"
+#include "WarmApplicationCache.hpp"
 #include <service-appmgr/messages/Message.hpp>
 
 #include <apps-common/ApplicationLauncher.hpp>
@@ -73,6 +74,7 @@ namespace app::manager
       protected:
         ApplicationsRegistry applications;
         ApplicationStack stack;
+        WarmApplicationCache warmApplications;
 
       private:
         State state = State::Running;
@@ -117,6 +119,9 @@ namespace app::manager
         void closeNoLongerNeededApplications();
         auto closeApplications() -> bool;
         void closeApplication(ApplicationHandle *application);
+        /// checks whether application losing focus may stay in the background in the warm applications cache
+        auto keepApplicationWarm(ApplicationHandle &app) -> bool;
+        void closeEvictedApplications(const std::vector<ApplicationName> &evicted);
 
         // Message handlers
         void handleActionRequest(ActionRequest *actionMsg);
@@ -146,6 +151,7 @@ namespace app::manager
         void onApplicationInitialised(ApplicationHandle &app, StartInBackground startInBackground);
         void onApplicationInitFailure(ApplicationHandle &app);
         auto onSwitchConfirmed(ApplicationHandle &app) -> bool;
+        void onSwitchRequested(ApplicationHandle &app);
         void onLaunchFinished(ApplicationHandle &app);
         void onFinalizingClose();
         auto onCloseConfirmed(ApplicationHandle &app) -> bool;
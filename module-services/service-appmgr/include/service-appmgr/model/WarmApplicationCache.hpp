@@ -0,0 +1,83 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace app::manager
+{
+    using ApplicationName = std::string;
+
+    /// Keeps recently used applications running in the background instead of closing them on focus loss,
+    /// so that switching back to them doesn't require to recreate the application, its windows and models.
+    class WarmApplicationCache
+    {
+      public:
+        using FreeMemoryProvider = std::function<std::size_t()>;
+
+        struct SwitchStatistics
+        {
+            std::uint32_t lastMs    = 0;
+            std::uint32_t maxMs     = 0;
+            std::uint32_t totalMs   = 0;
+            std::uint32_t count     = 0;
+            std::uint32_t warmCount = 0;
+
+            [[nodiscard]] auto averageMs() const noexcept -> std::uint32_t
+            {
+                return count == 0 ? 0 : totalMs / count;
+            }
+        };
+        using Statistics = std::map<ApplicationName, SwitchStatistics>;
+
+        /// @param capacity maximal number of applications kept in the cache
+        /// @param minFreeMemory applications are evicted when free memory drops below this value
+        /// @param freeMemoryProvider returns number of free bytes, memory pressure isn't checked if not provided
+        WarmApplicationCache(std::size_t capacity,
+                             std::size_t minFreeMemory,
+                             FreeMemoryProvider freeMemoryProvider = nullptr);
+
+        /// Adds application as the most recently used one.
+        /// @return applications which have to be closed to keep the cache within its limits
+        [[nodiscard]] auto admit(const ApplicationName &appName) -> std::vector<ApplicationName>;
+        /// @return least recently used applications which have to be closed due to low memory
+        [[nodiscard]] auto evictUnderPressure() -> std::vector<ApplicationName>;
+        void remove(const ApplicationName &appName) noexcept;
+        void clear() noexcept;
+
+        [[nodiscard]] auto contains(const ApplicationName &appName) const noexcept -> bool;
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+        [[nodiscard]] auto isEnabled() const noexcept -> bool;
+
+        /// Switch latency measurement, time is provided by the caller in milliseconds.
+        void switchRequested(const ApplicationName &appName, std::uint32_t timestampMs);
+        /// @return measured switch time, if switch to the application was requested
+        auto switchFinished(const ApplicationName &appName, std::uint32_t timestampMs) -> std::optional<std::uint32_t>;
+        [[nodiscard]] auto getStatistics() const noexcept -> const Statistics &;
+
+      private:
+        [[nodiscard]] auto isMemoryLow() const -> bool;
+
+        std::size_t capacity;
+        std::size_t minFreeMemory;
+        FreeMemoryProvider freeMemoryProvider;
+        /// front is the most recently used application
+        std::deque<ApplicationName> applications;
+
+        struct PendingSwitch
+        {
+            ApplicationName appName;
+            std::uint32_t startMs;
+            bool warm;
+        };
+        std::optional<PendingSwitch> pendingSwitch;
+        Statistics statistics;
+    };
+} // namespace app::manager
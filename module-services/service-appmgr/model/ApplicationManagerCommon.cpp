@@ -25,7 +25,11 @@
 #include <service-eink/ServiceEink.hpp>
 #include <service-evtmgr/EventManagerCommon.hpp>
 
+#include <memory/usermem.h>
+#include <ticks.hpp>
+
 #include <algorithm>
+#include <cinttypes>
 #include <utility>
 
 namespace app::manager
@@ -33,10 +37,25 @@ namespace app::manager
     namespace
     {
         constexpr auto ApplicationManagerStackDepth = 3072;
+        /// number of closeable applications kept running in the background after losing focus
+        constexpr auto WarmApplicationsLimit = 3;
+        /// warm applications are closed when free user heap drops below this value
+#if PROJECT_CONFIG_USER_DYNMEM_SIZE > 0
+        constexpr auto WarmApplicationsMinFreeMemory = 1024 * 1024;
+#else
+        // user heap is not used (i.e. on Linux) so its free size is always 0
+        constexpr auto WarmApplicationsMinFreeMemory = 0;
+#endif
+
+        auto currentTimeMs() -> std::uint32_t
+        {
+            return cpp_freertos::Ticks::TicksToMs(cpp_freertos::Ticks::GetTicks());
+        }
     } // namespace
 
     ApplicationManagerBase::ApplicationManagerBase(std::vector<std::unique_ptr<app::ApplicationLauncher>> &&launchers)
-        : applications{std::move(launchers)}
+        : applications{std::move(launchers)},
+          warmApplications{WarmApplicationsLimit, WarmApplicationsMinFreeMemory, usermemGetFreeHeapSize}
     {}
 
     void ApplicationManagerBase::setState(State _state) noexcept
@@ -316,6 +335,7 @@ namespace app::manager
 
     auto ApplicationManagerCommon::closeApplications() -> bool
     {
+        warmApplications.clear();
         for (const auto &app : getApplications()) {
             if (app->started()) {
                 LOG_INFO("Closing application %s", app->name().c_str());
@@ -329,7 +349,8 @@ namespace app::manager
     void ApplicationManagerCommon::closeNoLongerNeededApplications()
     {
         for (const auto &app : getApplications()) {
-            if (app->started() && app->closeable() && !stack.contains(app->name())) {
+            if (app->started() && app->closeable() && !stack.contains(app->name()) &&
+                !warmApplications.contains(app->name())) {
                 closeApplication(app.get());
                 app->setState(ApplicationHandle::State::DEACTIVATED);
             }
@@ -342,6 +363,7 @@ namespace app::manager
             return;
         }
 
+        warmApplications.remove(application->name());
         if (sys::SystemManagerCommon::DestroyApplication(application->name(), this)) {
             LOG_INFO("Application %s closed", application->name().c_str());
         }
@@ -351,6 +373,42 @@ namespace app::manager
         application->close();
     }
 
+    auto ApplicationManagerCommon::keepApplicationWarm(ApplicationHandle &app) -> bool
+    {
+        if (!warmApplications.isEnabled()) {
+            return false;
+        }
+        auto evicted           = warmApplications.admit(app.name());
+        const auto selfEvicted = std::find(evicted.begin(), evicted.end(), app.name()) != evicted.end();
+        evicted.erase(std::remove(evicted.begin(), evicted.end(), app.name()), evicted.end());
+        closeEvictedApplications(evicted);
+        if (!selfEvicted) {
+            LOG_INFO("Application %s kept in the background, warm applications: %zu",
+                     app.name().c_str(),
+                     warmApplications.size());
+        }
+        return !selfEvicted;
+    }
+
+    void ApplicationManagerCommon::closeEvictedApplications(const std::vector<ApplicationName> &evicted)
+    {
+        for (const auto &appName : evicted) {
+            auto app = getApplication(appName);
+            if (app == nullptr || app->state() != ApplicationHandle::State::ACTIVE_BACKGROUND ||
+                stack.contains(appName) || !app->closeable()) {
+                continue;
+            }
+            LOG_INFO("Closing warm application %s", appName.c_str());
+            closeApplication(app);
+            app->setState(ApplicationHandle::State::DEACTIVATED);
+        }
+    }
+
+    void ApplicationManagerCommon::onSwitchRequested(ApplicationHandle &app)
+    {
+        warmApplications.switchRequested(app.name(), currentTimeMs());
+    }
+
     auto ApplicationManagerCommon::handlePowerSavingModeInit() -> bool
     {
         LOG_INFO("Going to suspend mode");
@@ -368,6 +426,7 @@ namespace app::manager
         auto currentlyFocusedApp = getFocusedApplication();
         if (currentlyFocusedApp == nullptr) {
             LOG_INFO("No focused application at the moment. Starting new application...");
+            onSwitchRequested(*app);
             onApplicationSwitch(*app, std::move(msg->getData()), msg->getWindow());
             startApplication(*app);
             return false;
@@ -390,7 +449,10 @@ namespace app::manager
             return false;
         }
 
-        requestApplicationClose(*currentlyFocusedApp, isApplicationCloseable(currentlyFocusedApp));
+        onSwitchRequested(*app);
+        const auto closeFocusedApp =
+            isApplicationCloseable(currentlyFocusedApp) && !keepApplicationWarm(*currentlyFocusedApp);
+        requestApplicationClose(*currentlyFocusedApp, closeFocusedApp);
         return true;
     }
 
@@ -572,6 +634,7 @@ namespace app::manager
         auto currentlyFocusedApp = getFocusedApplication();
         if (currentlyFocusedApp == nullptr) {
             LOG_INFO("No focused application at the moment. Starting previous application...");
+            onSwitchRequested(*previousApp);
             onApplicationSwitchToPrev(*previousApp, std::move(msg->getData()));
             startApplication(*previousApp);
             return true;
@@ -592,8 +655,11 @@ namespace app::manager
                   previousApp->switchWindow.c_str(),
                   app::ApplicationCommon::stateStr(previousApp->state()));
 
+        onSwitchRequested(*previousApp);
         onApplicationSwitchToPrev(*previousApp, std::move(msg->getData()));
-        requestApplicationClose(*currentlyFocusedApp, isApplicationCloseable(currentlyFocusedApp));
+        const auto closeFocusedApp =
+            isApplicationCloseable(currentlyFocusedApp) && !keepApplicationWarm(*currentlyFocusedApp);
+        requestApplicationClose(*currentlyFocusedApp, closeFocusedApp);
         return true;
     }
 
@@ -711,6 +777,11 @@ namespace app::manager
         if (getState() == State::AwaitingFocusConfirmation || getState() == State::Running) {
             app.setState(ApplicationHandle::State::ACTIVE_FORGROUND);
             setState(State::Running);
+            warmApplications.remove(app.name());
+            if (const auto switchTime = warmApplications.switchFinished(app.name(), currentTimeMs());
+                switchTime.has_value()) {
+                LOG_INFO("Switch to %s took %" PRIu32 " ms", app.name().c_str(), switchTime.value());
+            }
             EventManagerCommon::messageSetApplication(this, app.name());
             onLaunchFinished(app);
             return true;
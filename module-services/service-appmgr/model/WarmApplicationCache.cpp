@@ -0,0 +1,107 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "WarmApplicationCache.hpp"
+
+#include <algorithm>
+
+namespace app::manager
+{
+    WarmApplicationCache::WarmApplicationCache(std::size_t capacity,
+                                               std::size_t minFreeMemory,
+                                               FreeMemoryProvider freeMemoryProvider)
+        : capacity{capacity}, minFreeMemory{minFreeMemory}, freeMemoryProvider{std::move(freeMemoryProvider)}
+    {}
+
+    auto WarmApplicationCache::admit(const ApplicationName &appName) -> std::vector<ApplicationName>
+    {
+        remove(appName);
+        if (capacity == 0) {
+            return {appName};
+        }
+        applications.push_front(appName);
+
+        std::vector<ApplicationName> evicted;
+        while (applications.size() > capacity) {
+            evicted.push_back(applications.back());
+            applications.pop_back();
+        }
+        auto pressureEvicted = evictUnderPressure();
+        evicted.insert(evicted.end(), pressureEvicted.begin(), pressureEvicted.end());
+        return evicted;
+    }
+
+    auto WarmApplicationCache::evictUnderPressure() -> std::vector<ApplicationName>
+    {
+        std::vector<ApplicationName> evicted;
+        if (!applications.empty() && isMemoryLow()) {
+            // memory is released asynchronously, when application's service is destroyed, so it can't be checked
+            // again after each eviction - drop half of the cache at once
+            const auto toEvict = (applications.size() + 1) / 2;
+            for (std::size_t i = 0; i < toEvict; ++i) {
+                evicted.push_back(applications.back());
+                applications.pop_back();
+            }
+        }
+        return evicted;
+    }
+
+    void WarmApplicationCache::remove(const ApplicationName &appName) noexcept
+    {
+        applications.erase(std::remove(applications.begin(), applications.end(), appName), applications.end());
+    }
+
+    void WarmApplicationCache::clear() noexcept
+    {
+        applications.clear();
+    }
+
+    auto WarmApplicationCache::contains(const ApplicationName &appName) const noexcept -> bool
+    {
+        return std::find(applications.begin(), applications.end(), appName) != applications.end();
+    }
+
+    auto WarmApplicationCache::size() const noexcept -> std::size_t
+    {
+        return applications.size();
+    }
+
+    auto WarmApplicationCache::isEnabled() const noexcept -> bool
+    {
+        return capacity != 0;
+    }
+
+    auto WarmApplicationCache::isMemoryLow() const -> bool
+    {
+        return freeMemoryProvider && freeMemoryProvider() < minFreeMemory;
+    }
+
+    void WarmApplicationCache::switchRequested(const ApplicationName &appName, std::uint32_t timestampMs)
+    {
+        pendingSwitch = PendingSwitch{appName, timestampMs, contains(appName)};
+    }
+
+    auto WarmApplicationCache::switchFinished(const ApplicationName &appName, std::uint32_t timestampMs)
+        -> std::optional<std::uint32_t>
+    {
+        if (!pendingSwitch.has_value() || pendingSwitch->appName != appName) {
+            return std::nullopt;
+        }
+        const auto elapsed = timestampMs - pendingSwitch->startMs;
+        auto &entry        = statistics[appName];
+        entry.lastMs       = elapsed;
+        entry.maxMs        = std::max(entry.maxMs, elapsed);
+        entry.totalMs += elapsed;
+        ++entry.count;
+        if (pendingSwitch->warm) {
+            ++entry.warmCount;
+        }
+        pendingSwitch.reset();
+        return elapsed;
+    }
+
+    auto WarmApplicationCache::getStatistics() const noexcept -> const Statistics &
+    {
+        return statistics;
+    }
+} // namespace app::manager
@@ -0,0 +1,105 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include <service-appmgr/model/WarmApplicationCache.hpp>
+
+using namespace app::manager;
+
+TEST_CASE("WarmApplicationCache - admit")
+{
+    SECTION("Disabled cache")
+    {
+        WarmApplicationCache cache{0, 0};
+        REQUIRE_FALSE(cache.isEnabled());
+        REQUIRE(cache.admit("A") == std::vector<ApplicationName>{"A"});
+        REQUIRE(cache.size() == 0);
+    }
+    SECTION("Within capacity")
+    {
+        WarmApplicationCache cache{2, 0};
+        REQUIRE(cache.admit("A").empty());
+        REQUIRE(cache.admit("B").empty());
+        REQUIRE(cache.contains("A"));
+        REQUIRE(cache.contains("B"));
+        REQUIRE(cache.size() == 2);
+    }
+    SECTION("Least recently used evicted")
+    {
+        WarmApplicationCache cache{2, 0};
+        REQUIRE(cache.admit("A").empty());
+        REQUIRE(cache.admit("B").empty());
+        REQUIRE(cache.admit("A").empty());
+        REQUIRE(cache.admit("C") == std::vector<ApplicationName>{"B"});
+        REQUIRE(cache.contains("A"));
+        REQUIRE(cache.contains("C"));
+        REQUIRE_FALSE(cache.contains("B"));
+    }
+}
+
+TEST_CASE("WarmApplicationCache - remove")
+{
+    WarmApplicationCache cache{3, 0};
+    REQUIRE(cache.admit("A").empty());
+    REQUIRE(cache.admit("B").empty());
+    cache.remove("A");
+    REQUIRE_FALSE(cache.contains("A"));
+    REQUIRE(cache.size() == 1);
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("WarmApplicationCache - memory pressure")
+{
+    std::size_t freeMemory = 1000;
+    WarmApplicationCache cache{4, 500, [&freeMemory]() { return freeMemory; }};
+    REQUIRE(cache.admit("A").empty());
+    REQUIRE(cache.admit("B").empty());
+    REQUIRE(cache.admit("C").empty());
+    REQUIRE(cache.evictUnderPressure().empty());
+
+    freeMemory = 100;
+    REQUIRE(cache.evictUnderPressure() == std::vector<ApplicationName>{"A", "B"});
+    REQUIRE(cache.contains("C"));
+
+    SECTION("Newly admitted application evicted when memory is low")
+    {
+        REQUIRE(cache.admit("D") == std::vector<ApplicationName>{"C"});
+        REQUIRE(cache.evictUnderPressure() == std::vector<ApplicationName>{"D"});
+        REQUIRE(cache.size() == 0);
+    }
+}
+
+TEST_CASE("WarmApplicationCache - switch statistics")
+{
+    WarmApplicationCache cache{2, 0};
+
+    SECTION("Cold switch")
+    {
+        cache.switchRequested("A", 100);
+        REQUIRE(cache.switchFinished("A", 350) == 250U);
+        const auto &stats = cache.getStatistics().at("A");
+        REQUIRE(stats.lastMs == 250);
+        REQUIRE(stats.count == 1);
+        REQUIRE(stats.warmCount == 0);
+    }
+    SECTION("Warm switch")
+    {
+        REQUIRE(cache.admit("A").empty());
+        cache.switchRequested("A", 100);
+        REQUIRE(cache.switchFinished("A", 120) == 20U);
+        cache.switchRequested("A", 200);
+        REQUIRE(cache.switchFinished("A", 240) == 40U);
+        const auto &stats = cache.getStatistics().at("A");
+        REQUIRE(stats.warmCount == 2);
+        REQUIRE(stats.maxMs == 40);
+        REQUIRE(stats.averageMs() == 30);
+    }
+    SECTION("Switch to other application not measured")
+    {
+        cache.switchRequested("A", 100);
+        REQUIRE_FALSE(cache.switchFinished("B", 120).has_value());
+        REQUIRE(cache.getStatistics().empty());
+    }
+}
@@ -50,12 +50,13 @@ class NetworkSettings
     explicit NetworkSettings(ServiceCellular &cellularService) : cellularService(cellularService)
     {}
     /**
-     * Scan for operator, return string list see param fullInfoList
-     * @param fullInfoList for tru scan wit details (as space separated) in case of false scan only
-     * for full names without duplicates
+     * Operators found by the scan (AT+COPS=?), return string list see param fullInfoList
+     * @param resp response of the scan
+     * @param fullInfoList for true list with details (as space separated) in case of false list only
+     * full names without duplicates
      * @return
      */
-    std::vector<std::string> scanOperators(bool fullInfoList = false);
+    static std::vector<std::string> operatorNames(const at::Result &resp, bool fullInfoList = false);
     at::Result::Code setVoLTEState(VoLTEState state);
 
     /// This is information about configuration setup, not information
@@ -81,10 +81,12 @@
 
 #include <queries/messages/sms/QuerySMSUpdate.hpp>
 #include <queries/messages/sms/QuerySMSAdd.hpp>
+#include <queries/messages/sms/QuerySMSAddMultiple.hpp>
 
 #include <algorithm>
 #include <bits/exception.h>
 #include <cassert>
+#include <deque>
 #include <iostream>
 #include <map>
 #include <optional>
@@ -97,6 +99,7 @@
 #include <ticks.hpp>
 
 #include "ServiceCellularPriv.hpp"
+#include "messages.hpp"
 #include <service-cellular/api/request/sim.hpp>
 #include <service-cellular/api/notification/notification.hpp>
 
@@ -255,12 +258,14 @@ sys::ReturnCodes ServiceCellular::InitHandler()
     bus.sendUnicast(sentinelRegistrationMsg, ::service::name::system_manager);
 
     cmux->registerCellularDevice();
+    priv->startATCommandWorker();
 
     return sys::ReturnCodes::Success;
 }
 
 sys::ReturnCodes ServiceCellular::DeinitHandler()
 {
+    priv->stopATCommandWorker();
     settings->deinit();
     return sys::ReturnCodes::Success;
 }
@@ -309,6 +314,7 @@ void ServiceCellular::registerMessageHandlers()
     priv->connectNetworkTime();
     priv->connectSimContacts();
     priv->connectImeiGetHandler();
+    priv->connectATCommandWorker();
 
     connect(typeid(CellularStartOperatorsScanMessage), [&](sys::Message *request) -> sys::MessagePointer {
         auto msg = static_cast<CellularStartOperatorsScanMessage *>(request);
@@ -780,6 +786,12 @@ bool ServiceCellular::handle_power_down_waiting()
 bool ServiceCellular::handle_power_down()
 {
     LOG_DEBUG("Powered Down");
+    if (priv->atCommandWorker) {
+        priv->atCommandWorker->flush();
+    }
+    receivingMessages = false;
+    pendingMessages.clear();
+    receivedMessages.clear();
     cmux->closeChannels();
     cmux.reset();
     cmux = std::make_unique<CellularMux>(PortSpeed_e::PS460800, this);
@@ -914,19 +926,42 @@ std::optional<std::shared_ptr<sys::Message>> ServiceCellular::identifyNotificati
 
 auto ServiceCellular::receiveSMS(std::string messageNumber) -> bool
 {
-    constexpr auto ucscSetMaxRetries = 3;
-
-    auto retVal = true;
+    auto records = std::make_shared<std::vector<SMSRecord>>();
+    priv->atCommandWorker->enqueue(
+        [this, messageNumber, records](at::BaseChannel &channel) {
+            // listing in progress must not remove this message with the others before it's stored
+            pendingMessagesFailed = true;
+            setUCS2Charset(channel);
+            const auto read = readSMS(channel, messageNumber, *records);
+            restoreGSMCharset(channel);
+            return at::Result{read ? at::Result::Code::OK : at::Result::Code::ERROR, {}};
+        },
+        [this, messageNumber, records](const at::Result &result) {
+            if (!result) {
+                LOG_ERROR("Could not read text message");
+                return;
+            }
+            if (!records->empty() && !dbAddSMSRecords(std::move(*records))) {
+                LOG_ERROR("Failed to add text message to db");
+                return;
+            }
+            // delete message from modem memory
+            priv->atCommandWorker->enqueue(at::factory(at::AT::CMGD) + messageNumber, [](const at::Result &resp) {
+                if (!resp) {
+                    LOG_ERROR("Could not delete SMS from modem");
+                }
+            });
+        });
+    return true;
+}
 
-    auto channel = cmux->get(CellularMux::Channel::Commands);
-    if (channel == nullptr) {
-        retVal = false;
-        return retVal;
-    }
+void ServiceCellular::setUCS2Charset(at::BaseChannel &channel)
+{
+    constexpr auto ucscSetMaxRetries = 3;
 
     auto ucscSetRetries = 0;
     while (ucscSetRetries < ucscSetMaxRetries) {
-        if (!channel->cmd(at::AT::SMS_UCSC2)) {
+        if (!channel.cmd(at::AT::SMS_UCSC2)) {
             ++ucscSetRetries;
             LOG_ERROR("Could not set UCS2 charset mode for TE. Retry %d", ucscSetRetries);
         }
@@ -934,23 +969,26 @@ auto ServiceCellular::receiveSMS(std::string messageNumber) -> bool
             break;
         }
     }
-    auto _ = gsl::finally([&channel, &retVal, &messageNumber] {
-        if (!channel->cmd(at::AT::SMS_GSM)) {
-            LOG_ERROR("Could not set GSM (default) charset mode for TE");
-        }
+}
 
-        // delete message from modem memory
-        if (retVal && !channel->cmd(at::factory(at::AT::CMGD) + messageNumber)) {
-            LOG_ERROR("Could not delete SMS from modem");
-        }
-    });
+void ServiceCellular::restoreGSMCharset(at::BaseChannel &channel)
+{
+    if (!channel.cmd(at::AT::SMS_GSM)) {
+        LOG_ERROR("Could not set GSM (default) charset mode for TE");
+    }
+}
 
+bool ServiceCellular::readSMS(at::BaseChannel &channel,
+                              const std::string &messageNumber,
+                              std::vector<SMSRecord> &records)
+{
+    auto retVal        = true;
     bool messageParsed = false;
 
     std::string messageRawBody;
     UTF8 receivedNumber;
     const auto &cmd = at::factory(at::AT::QCMGR);
-    auto ret        = channel->cmd(cmd + messageNumber, cmd.getTimeout());
+    auto ret        = channel.cmd(cmd + messageNumber, cmd.getTimeout());
     if (!ret) {
         LOG_ERROR("!!!! Could not read text message !!!!");
         retVal = false;
@@ -1001,7 +1039,7 @@ auto ServiceCellular::receiveSMS(std::string messageNumber) -> bool
                         current = std::stoi(tokens[6]);
                     }
                     catch (const std::exception &e) {
-                        LOG_ERROR("ServiceCellular::receiveSMS error %s", e.what());
+                        LOG_ERROR("ServiceCellular::readSMS error %s", e.what());
                         retVal = false;
                         break;
                     }
@@ -1023,14 +1061,7 @@ auto ServiceCellular::receiveSMS(std::string messageNumber) -> bool
                     messageParsed = false;
 
                     const auto decodedMessage = UCS2(messageRawBody).toUTF8();
-
-                    const auto record = createSMSRecord(decodedMessage, receivedNumber, messageDate);
-
-                    if (!dbAddSMSRecord(record)) {
-                        LOG_ERROR("Failed to add text message to db");
-                        retVal = false;
-                        break;
-                    }
+                    records.push_back(createSMSRecord(decodedMessage, receivedNumber, messageDate));
                 }
             }
         }
@@ -1088,45 +1119,55 @@ bool ServiceCellular::getIMSI(std::string &destination, bool fullNumber)
     LOG_ERROR("ServiceCellular::getIMSI failed.");
     return false;
 }
-std::vector<std::string> ServiceCellular::getNetworkInfo(void)
+void ServiceCellular::requestNetworkInfo(const std::string &requester)
 {
-    std::vector<std::string> data;
-    auto channel = cmux->get(CellularMux::Channel::Commands);
-    if (channel) {
-        auto resp = channel->cmd(at::AT::CSQ);
-        if (resp.code == at::Result::Code::OK) {
-            data.push_back(resp.response[0]);
-        }
-        else {
-            LOG_ERROR("CSQ Error");
-            data.push_back("");
-        }
+    // informative only - queued behind anything more important, so it doesn't hold calls or the service
+    using Priority = at::CommandQueue::Priority;
+    auto message   = std::make_shared<cellular::RawCommandRespAsync>(CellularMessage::Type::NetworkInfoResult);
 
-        resp = channel->cmd(at::AT::CREG);
-        if (resp.code == at::Result::Code::OK) {
-            data.push_back(resp.response[0]);
-        }
-        else {
-            LOG_ERROR("CREG Error");
-            data.push_back("");
-        }
+    priv->atCommandWorker->enqueue(
+        at::factory(at::AT::CSQ),
+        [message](const at::Result &resp) {
+            if (resp.code == at::Result::Code::OK) {
+                message->data.push_back(resp.response[0]);
+            }
+            else {
+                LOG_ERROR("CSQ Error");
+                message->data.push_back("");
+            }
+        },
+        Priority::Housekeeping);
+
+    priv->atCommandWorker->enqueue(
+        at::factory(at::AT::CREG),
+        [message](const at::Result &resp) {
+            if (resp.code == at::Result::Code::OK) {
+                message->data.push_back(resp.response[0]);
+            }
+            else {
+                LOG_ERROR("CREG Error");
+                message->data.push_back("");
+            }
+        },
+        Priority::Housekeeping);
 
-        resp = channel->cmd(at::AT::QNWINFO);
-        if (resp.code == at::Result::Code::OK) {
+    priv->atCommandWorker->enqueue(
+        at::factory(at::AT::QNWINFO),
+        [this, message, requester](const at::Result &resp) {
             std::string ret;
-            if (at::response::parseQNWINFO(resp.response[0], ret)) {
-                data.push_back(ret);
+            if (resp.code == at::Result::Code::OK) {
+                auto response = resp.response[0];
+                if (!at::response::parseQNWINFO(response, ret)) {
+                    ret.clear();
+                }
             }
             else {
-                data.push_back("");
+                LOG_ERROR("QNWINFO Error");
             }
-        }
-        else {
-            LOG_ERROR("QNWINFO Error");
-            data.push_back("");
-        }
-    }
-    return data;
+            message->data.push_back(ret);
+            bus.sendUnicast(message, requester);
+        },
+        Priority::Housekeeping);
 }
 
 std::vector<std::string> get_last_AT_error(DLCChannel *channel)
@@ -1298,55 +1339,154 @@ SMSRecord ServiceCellular::createSMSRecord(const UTF8 &decodedMessage,
     return record;
 }
 
-bool ServiceCellular::dbAddSMSRecord(const SMSRecord &record)
+bool ServiceCellular::dbAddSMSRecords(std::vector<SMSRecord> records)
 {
-    return DBServiceAPI::AddSMS(
-        this, record, db::QueryCallback::fromFunction([this, number = record.number](auto response) {
-            auto result = dynamic_cast<db::query::SMSAddResult *>(response);
-            if (result == nullptr || !result->result) {
-                return false;
+    auto query = std::make_unique<db::query::SMSAddMultiple>(std::move(records));
+    query->setQueryListener(db::QueryCallback::fromFunction([this](auto response) {
+        auto result = dynamic_cast<db::query::SMSAddMultipleResult *>(response);
+        if (result == nullptr || result->added == 0) {
+            return false;
+        }
+        std::vector<utils::PhoneNumber::View> numbers;
+        for (const auto &record : result->records) {
+            if (record.ID != DB_ID_NONE) {
+                numbers.push_back(record.number);
             }
-            onSMSReceived(number);
-            return true;
-        }));
+        }
+        onSMSReceived(numbers);
+        return true;
+    }));
+    const auto [succeed, _] = DBServiceAPI::GetQuery(this, db::Interface::Name::SMS, std::move(query));
+    return succeed;
 }
 
-void ServiceCellular::onSMSReceived(const utils::PhoneNumber::View &number)
+void ServiceCellular::onSMSReceived(const std::vector<utils::PhoneNumber::View> &numbers)
 {
     DBServiceAPI::GetQuery(
         this,
         db::Interface::Name::Notifications,
-        std::make_unique<db::query::notifications::Increment>(NotificationsRecord::Key::Sms, number));
+        std::make_unique<db::query::notifications::MultipleIncrement>(NotificationsRecord::Key::Sms, numbers));
 
+    // single notification for the whole batch
     bus.sendMulticast(std::make_shared<CellularIncomingSMSNotificationMessage>(),
                       sys::BusChannel::ServiceCellularNotifications);
 }
 
 bool ServiceCellular::receiveAllMessages()
 {
-    auto channel = cmux->get(CellularMux::Channel::Commands);
-    if (channel == nullptr) {
-        return false;
+    if (receivingMessages) {
+        // the previous listing is still being read
+        return true;
     }
 
-    constexpr std::string_view cmd = "CMGL: ";
-    if (auto ret = channel->cmd(at::AT::LIST_MESSAGES)) {
-        for (std::size_t i = 0; i < ret.response.size(); i++) {
-            if (auto pos = ret.response[i].find(cmd); pos != std::string::npos) {
-                auto startPos = pos + cmd.size();
-                auto endPos   = ret.response[i].find_first_of(',');
-                if (receiveSMS(ret.response[i].substr(startPos, endPos - startPos))) {
-                    LOG_WARN("Cannot receive text message - %" PRIu32 " / %" PRIu32,
-                             static_cast<uint32_t>(i),
-                             static_cast<uint32_t>(ret.response.size()));
+    // listing and reading take a while with the full memory, calls and URCs are handled in between
+    using Priority = at::CommandQueue::Priority;
+    auto indexes   = std::make_shared<std::vector<std::string>>();
+    priv->atCommandWorker->enqueue(
+        [this, indexes](at::BaseChannel &channel) {
+            pendingMessagesFailed = false;
+            auto ret              = channel.cmd(at::AT::LIST_MESSAGES);
+            if (ret && !at::response::cmgl::parseIndexes(ret.response, *indexes)) {
+                ret.code = at::Result::Code::ERROR;
+            }
+            return ret;
+        },
+        [this, indexes](const at::Result &result) {
+            if (!result) {
+                if (result.code != at::Result::Code::CANCELLED) {
+                    LOG_ERROR("Receiving all messages from modem failed");
                 }
+                receivingMessages = false;
+                return;
             }
-        }
-        return true;
-    }
-    else {
-        return false;
+            if (indexes->empty()) {
+                receivingMessages = false;
+                return;
+            }
+
+            LOG_INFO("Receiving %zu text messages", indexes->size());
+            pendingMessages.assign(std::make_move_iterator(indexes->begin()), std::make_move_iterator(indexes->end()));
+            receivedMessages.clear();
+            receivePendingMessages();
+        },
+        Priority::Housekeeping);
+    receivingMessages = true;
+    return true;
+}
+
+void ServiceCellular::receivePendingMessages()
+{
+    std::vector<std::string> batch;
+    while (batch.size() < smsReceiveBatchSize && !pendingMessages.empty()) {
+        batch.push_back(std::move(pendingMessages.front()));
+        pendingMessages.pop_front();
     }
+
+    using Priority = at::CommandQueue::Priority;
+    auto records   = std::make_shared<std::vector<SMSRecord>>();
+    auto read      = std::make_shared<std::vector<std::string>>();
+    priv->atCommandWorker->enqueue(
+        [this, batch = std::move(batch), records, read](at::BaseChannel &channel) {
+            setUCS2Charset(channel);
+            for (const auto &messageNumber : batch) {
+                if (readSMS(channel, messageNumber, *records)) {
+                    read->push_back(messageNumber);
+                }
+                else {
+                    LOG_WARN("Cannot receive text message - %s", messageNumber.c_str());
+                    pendingMessagesFailed = true;
+                }
+            }
+            restoreGSMCharset(channel);
+            return at::Result{at::Result::Code::OK, {}};
+        },
+        [this, records, read](const at::Result &result) {
+            if (result.code == at::Result::Code::CANCELLED) {
+                // modem is powered down, the listing is dropped
+                return;
+            }
+            if (!result || (!records->empty() && !dbAddSMSRecords(std::move(*records)))) {
+                LOG_ERROR("Failed to add text messages to db");
+                pendingMessagesFailed = true;
+            }
+            else {
+                receivedMessages.insert(receivedMessages.end(),
+                                        std::make_move_iterator(read->begin()),
+                                        std::make_move_iterator(read->end()));
+            }
+
+            if (!pendingMessages.empty()) {
+                receivePendingMessages();
+                return;
+            }
+            deleteReceivedMessages();
+        },
+        Priority::Housekeeping);
+}
+
+void ServiceCellular::deleteReceivedMessages()
+{
+    using Priority = at::CommandQueue::Priority;
+    priv->atCommandWorker->enqueue(
+        [this, messages = std::move(receivedMessages)](at::BaseChannel &channel) {
+            // listing has marked all messages as read, remove all of them at once if each one was stored
+            if (!pendingMessagesFailed) {
+                if (auto ret = channel.cmd(at::factory(at::AT::CMGD) + smsDeleteAllRead); ret) {
+                    return ret;
+                }
+                LOG_WARN("Could not delete read SMS from modem, deleting one by one");
+            }
+
+            for (const auto &messageNumber : messages) {
+                if (!channel.cmd(at::factory(at::AT::CMGD) + messageNumber)) {
+                    LOG_ERROR("Could not delete SMS from modem");
+                }
+            }
+            return at::Result{at::Result::Code::OK, {}};
+        },
+        [this](const at::Result &) { receivingMessages = false; },
+        Priority::Housekeeping);
+    receivedMessages.clear();
 }
 
 bool ServiceCellular::handle_failure()
@@ -1590,15 +1730,20 @@ void ServiceCellular::setUSSDTimer(void)
     ussdTimer.start();
 }
 
-std::shared_ptr<cellular::RawCommandRespAsync> ServiceCellular::handleCellularStartOperatorsScan(
+std::shared_ptr<CellularResponseMessage> ServiceCellular::handleCellularStartOperatorsScan(
     CellularStartOperatorsScanMessage *msg)
 {
     LOG_INFO("CellularStartOperatorsScan handled");
-    auto ret = std::make_shared<cellular::RawCommandRespAsync>(CellularMessage::Type::OperatorsScanResult);
-    NetworkSettings networkSettings(*this);
-    ret->data = networkSettings.scanOperators(msg->getFullInfo());
-    bus.sendUnicast(ret, msg->sender);
-    return ret;
+    // the scan takes up to minutes, it mustn't hold calls nor the service
+    priv->atCommandWorker->enqueue(
+        at::factory(at::AT::COPS) + "=?",
+        [this, fullInfo = msg->getFullInfo(), requester = msg->sender](const at::Result &resp) {
+            auto ret  = std::make_shared<cellular::RawCommandRespAsync>(CellularMessage::Type::OperatorsScanResult);
+            ret->data = NetworkSettings::operatorNames(resp, fullInfo);
+            bus.sendUnicast(ret, requester);
+        },
+        at::CommandQueue::Priority::Housekeeping);
+    return std::make_shared<CellularResponseMessage>(true);
 }
 
 bool ServiceCellular::handle_apn_conf_procedure()
@@ -1763,6 +1908,7 @@ namespace
         case at::Result::Code::RECEIVING_NOT_STARTED:
         case at::Result::Code::DATA_NOT_USED:
         case at::Result::Code::CMUX_FRAME_ERROR:
+        case at::Result::Code::CANCELLED:
             return CellularCallRequestGeneralError::ErrorType::TransmissionError;
         case at::Result::Code::OK:
         case at::Result::Code::NONE:
@@ -1939,10 +2085,7 @@ auto ServiceCellular::handleCellularGetOwnNumberMessage(sys::Message *msg) -> st
 
 auto ServiceCellular::handleCellularGetNetworkInfoMessage(sys::Message *msg) -> std::shared_ptr<sys::ResponseMessage>
 {
-    auto message  = std::make_shared<cellular::RawCommandRespAsync>(CellularMessage::Type::NetworkInfoResult);
-    message->data = getNetworkInfo();
-    bus.sendUnicast(message, msg->sender);
-
+    requestNetworkInfo(msg->sender);
     return std::make_shared<CellularResponseMessage>(true);
 }
 
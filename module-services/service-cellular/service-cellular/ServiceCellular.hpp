@@ -28,6 +28,8 @@
 #include <service-db/DBServiceName.hpp>
 #include <service-db/DBNotificationMessage.hpp>
 
+#include <atomic>
+#include <deque>
 #include <optional> // for optional
 #include <memory>   // for unique_ptr, allocator, make_unique, shared_ptr
 #include <string>   // for string
@@ -100,7 +102,11 @@ class ServiceCellular : public sys::Service
      * @return true when succeed, false when fails
      */
     bool getIMSI(std::string &destination, bool fullNumber = false);
-    std::vector<std::string> getNetworkInfo();
+    /**
+     * @brief Queries signal strength, registration and network info in the background.
+     * @param requester Service which gets the RawCommandRespAsync with the results.
+     */
+    void requestNetworkInfo(const std::string &requester);
 
   private:
     at::ATURCStream atURCStream;
@@ -134,8 +140,21 @@ class ServiceCellular : public sys::Service
     /// URC GSM notification handler
     std::optional<std::shared_ptr<sys::Message>> identifyNotification(const std::string &data);
 
+    /// Parts of the concatenated message, used only by the commands sent from the AT command worker
     std::vector<std::string> messageParts;
 
+    /// Listing of the messages from the modem memory is in progress
+    bool receivingMessages = false;
+    /// Messages listed from the modem memory which are still to be read
+    std::deque<std::string> pendingMessages;
+    /// Messages from the current listing stored in the database, to be deleted from the modem memory
+    std::vector<std::string> receivedMessages;
+    /// Messages can't be deleted all at once, some listed one wasn't stored or a new one was read meanwhile.
+    /// Set from the AT command worker
+    std::atomic_bool pendingMessagesFailed = false;
+    static constexpr std::size_t smsReceiveBatchSize = 16;
+    static constexpr auto smsDeleteAllRead           = "0,1";
+
     CellularCall::CellularCall ongoingCall;
     std::vector<CalllogRecord> tetheringCalllog;
 
@@ -197,9 +216,11 @@ class ServiceCellular : public sys::Service
                                             const UTF8 &receivedNumber,
                                             const time_t messageDate,
                                             const SMSType &smsType = SMSType::INBOX) const noexcept;
-    bool dbAddSMSRecord(const SMSRecord &record);
-    void onSMSReceived(const utils::PhoneNumber::View &number);
+    bool dbAddSMSRecords(std::vector<SMSRecord> records);
+    void onSMSReceived(const std::vector<utils::PhoneNumber::View> &numbers);
     [[nodiscard]] bool receiveAllMessages();
+    void receivePendingMessages();
+    void deleteReceivedMessages();
     /// @}
 
     bool transmitDtmfTone(uint32_t digit);
@@ -226,8 +247,7 @@ class ServiceCellular : public sys::Service
     bool handleUSSDURC();
     void handleUSSDTimer();
 
-    std::shared_ptr<cellular::RawCommandRespAsync> handleCellularStartOperatorsScan(
-        CellularStartOperatorsScanMessage *msg);
+    std::shared_ptr<CellularResponseMessage> handleCellularStartOperatorsScan(CellularStartOperatorsScanMessage *msg);
 
     std::shared_ptr<CellularSetOperatorAutoSelectResponse> handleCellularSetOperatorAutoSelect(
         CellularSetOperatorAutoSelectMessage *msg);
@@ -305,6 +325,9 @@ class ServiceCellular : public sys::Service
     auto handleCellularSetConnectionFrequencyMessage(sys::Message *msg) -> std::shared_ptr<sys::ResponseMessage>;
 
     auto receiveSMS(std::string messageNumber) -> bool;
+    bool readSMS(at::BaseChannel &channel, const std::string &messageNumber, std::vector<SMSRecord> &records);
+    void setUCS2Charset(at::BaseChannel &channel);
+    void restoreGSMCharset(at::BaseChannel &channel);
 
     auto hangUpCall() -> bool;
     auto hangUpCallBusy() -> bool;
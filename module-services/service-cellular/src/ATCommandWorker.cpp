@@ -0,0 +1,120 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "ATCommandWorker.hpp"
+#include "messages.hpp"
+
+#include <modem/ATCommon.hpp>
+#include <log/log.hpp>
+
+namespace cellular::service
+{
+    ATCommandWorker::ATCommandWorker(sys::Service *service, ChannelProvider channelProvider)
+        : Worker(service), service{service}, channelProvider{std::move(channelProvider)}
+    {}
+
+    bool ATCommandWorker::init(std::list<sys::WorkerQueueInfo> queuesList)
+    {
+        queuesList.emplace_back(SignallingQueueName, SignalSize, SignallingQueueCapacity);
+        return Worker::init(queuesList);
+    }
+
+    auto ATCommandWorker::enqueue(at::Cmd cmd, at::CommandQueue::Callback callback, Priority priority)
+        -> at::CommandQueue::Id
+    {
+        const auto id = commands.push(std::move(cmd), std::move(callback), priority);
+        notify(Signal::CommandQueued);
+        return id;
+    }
+
+    auto ATCommandWorker::enqueue(at::CommandQueue::Sequence sequence,
+                                  at::CommandQueue::Callback callback,
+                                  Priority priority) -> at::CommandQueue::Id
+    {
+        const auto id = commands.push(std::move(sequence), std::move(callback), priority);
+        notify(Signal::CommandQueued);
+        return id;
+    }
+
+    bool ATCommandWorker::cancel(at::CommandQueue::Id id)
+    {
+        auto entry = commands.cancel(id);
+        if (!entry.has_value()) {
+            return false;
+        }
+        complete(std::move(entry->callback), at::Result{at::Result::Code::CANCELLED, {}});
+        return true;
+    }
+
+    void ATCommandWorker::flush()
+    {
+        cpp_freertos::LockGuard lock(sendMutex);
+        for (auto &entry : commands.clear()) {
+            complete(std::move(entry.callback), at::Result{at::Result::Code::CANCELLED, {}});
+        }
+    }
+
+    bool ATCommandWorker::handleMessage(std::uint32_t queueID)
+    {
+        if (const auto queue = queues[queueID]; queue->GetQueueName() == SignallingQueueName) {
+            if (Signal signal; queue->Dequeue(&signal, 0)) {
+                sendQueuedCommands();
+            }
+        }
+        return true;
+    }
+
+    void ATCommandWorker::notify(Signal signal)
+    {
+        if (auto queue = getQueueByName(SignallingQueueName); !queue->Overwrite(&signal)) {
+            LOG_ERROR("Unable to overwrite the command in the commands queue.");
+        }
+    }
+
+    void ATCommandWorker::sendQueuedCommands()
+    {
+        while (true) {
+            std::optional<at::CommandQueue::Entry> entry;
+            at::Result result;
+            {
+                // taken together with the command so flush() can't miss the one just being sent
+                cpp_freertos::LockGuard lock(sendMutex);
+                entry = commands.pop();
+                if (!entry.has_value()) {
+                    return;
+                }
+
+                if (auto channel = channelProvider(); channel != nullptr) {
+                    result = send(*channel, *entry);
+                }
+                else {
+                    LOG_ERROR("No channel for queued command");
+                    result.code = at::Result::Code::TRANSMISSION_NOT_STARTED;
+                }
+            }
+            complete(std::move(entry->callback), std::move(result));
+        }
+    }
+
+    auto ATCommandWorker::send(at::BaseChannel &channel, const at::CommandQueue::Entry &entry) -> at::Result
+    {
+        if (!entry.sequence) {
+            return channel.cmd(entry.cmd);
+        }
+        // commands sent from the other tasks must not change the modem state in the middle of the sequence
+        std::optional<cpp_freertos::LockGuard> commandSequence;
+        if (auto commandChannel = dynamic_cast<at::Channel *>(&channel); commandChannel != nullptr) {
+            commandSequence.emplace(commandChannel->getCommandMutex());
+        }
+        return entry.sequence(channel);
+    }
+
+    void ATCommandWorker::complete(at::CommandQueue::Callback callback, at::Result result)
+    {
+        if (callback == nullptr) {
+            return;
+        }
+        auto msg = std::make_shared<internal::msg::ATCommandResult>(std::move(callback), std::move(result));
+        service->bus.sendUnicast(std::move(msg), service->GetName());
+    }
+} // namespace cellular::service
@@ -0,0 +1,64 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <modem/ATCommandQueue.hpp>
+#include <Service/Worker.hpp>
+
+#include <functional>
+
+namespace at
+{
+    class BaseChannel;
+} // namespace at
+
+namespace cellular::service
+{
+    /// Sends queued AT commands from its own task, so the service keeps handling messages (URCs, call control) while
+    /// slow commands wait for the modem. Queued commands are sent one after another without waiting for the service to
+    /// handle the previous result. Callbacks are called in the service context.
+    class ATCommandWorker : public sys::Worker
+    {
+      public:
+        using ChannelProvider = std::function<at::BaseChannel *()>;
+        using Priority        = at::CommandQueue::Priority;
+
+        enum class Signal
+        {
+            CommandQueued,
+        };
+        static constexpr auto SignallingQueueName     = "ATSignallingQueue";
+        static constexpr auto SignallingQueueCapacity = 1;
+        static constexpr auto SignalSize              = sizeof(Signal);
+
+        ATCommandWorker(sys::Service *service, ChannelProvider channelProvider);
+
+        bool init(std::list<sys::WorkerQueueInfo> queuesList = std::list<sys::WorkerQueueInfo>()) override;
+
+        /// Queues the command, its timeout is taken from the at::Cmd
+        auto enqueue(at::Cmd cmd, at::CommandQueue::Callback callback, Priority priority = Priority::Normal)
+            -> at::CommandQueue::Id;
+        /// Queues the commands sent by the sequence, no other command is sent on the channel until it returns
+        auto enqueue(at::CommandQueue::Sequence sequence,
+                     at::CommandQueue::Callback callback,
+                     Priority priority = Priority::Normal) -> at::CommandQueue::Id;
+        /// Removes the command if it wasn't sent yet, its callback gets at::Result::Code::CANCELLED
+        bool cancel(at::CommandQueue::Id id);
+        /// Cancels all queued commands and waits for the one being sent
+        void flush();
+
+        auto handleMessage(std::uint32_t queueID) -> bool override;
+
+      private:
+        void notify(Signal signal);
+        void sendQueuedCommands();
+        auto send(at::BaseChannel &channel, const at::CommandQueue::Entry &entry) -> at::Result;
+        void complete(at::CommandQueue::Callback callback, at::Result result);
+
+        sys::Service *service;
+        ChannelProvider channelProvider;
+        at::CommandQueue commands;
+        cpp_freertos::MutexStandard sendMutex;
+    };
+} // namespace cellular::service
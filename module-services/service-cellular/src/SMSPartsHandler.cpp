@@ -6,61 +6,228 @@
 #include <service-cellular/service-cellular/MessageConstants.hpp>
 #include <log/log.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
 namespace cellular::internal::sms
 {
     namespace
     {
-        constexpr auto UCS2SingleCharacterLen = 4;
+        /// Limits in characters of the encoding, GSM7 septets or UTF-16 code units
+        constexpr std::size_t GSM7SingleLimit       = 160;
+        constexpr std::size_t GSM7ConcatenatedLimit = 153;
+        constexpr std::size_t UCS2SingleLimit       = 70;
+        constexpr std::size_t UCS2ConcatenatedLimit = msgConstants::singleMessageMaxLen;
+
+        constexpr std::uint8_t notInGSM7       = 0;
+        constexpr char32_t replacementChar     = 0xFFFD;
+        constexpr char32_t euroSign            = 0x20AC;
+        constexpr char32_t firstSupplementary  = 0x10000;
+        constexpr auto UCS2SingleCharacterLen  = 4;
+        constexpr char hexDigits[]             = "0123456789ABCDEF";
+        constexpr std::string_view GSM7Escaped = "\f^{}\\[~]|";
+
+        /// Septets taken by the ASCII characters, escaped ones take two
+        constexpr auto makeASCIISeptets()
+        {
+            std::array<std::uint8_t, 128> septets{};
+            for (auto c = ' '; c < 0x7F; ++c) {
+                septets[c] = 1;
+            }
+            septets['\n'] = 1;
+            septets['\r'] = 1;
+            septets['`']  = notInGSM7;
+            for (auto c : GSM7Escaped) {
+                septets[c] = 2;
+            }
+            return septets;
+        }
+        constexpr auto ASCIISeptets = makeASCIISeptets();
+
+        /// Non ASCII characters of the GSM 03.38 default alphabet, sorted
+        constexpr std::array<char16_t, 39> GSM7NonASCII = {
+            0x00A1, 0x00A3, 0x00A4, 0x00A5, 0x00A7, 0x00BF, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+            0x00C9, 0x00D1, 0x00D6, 0x00D8, 0x00DC, 0x00DF, 0x00E0, 0x00E4, 0x00E5, 0x00E6,
+            0x00E8, 0x00E9, 0x00EC, 0x00F1, 0x00F2, 0x00F6, 0x00F8, 0x00F9, 0x00FC, 0x0393,
+            0x0394, 0x0398, 0x039B, 0x039E, 0x03A0, 0x03A3, 0x03A6, 0x03A8, 0x03A9};
+
+        std::uint8_t septetsOf(char32_t c) noexcept
+        {
+            if (c < ASCIISeptets.size()) {
+                return ASCIISeptets[c];
+            }
+            if (c == euroSign) {
+                return 2;
+            }
+            if (c <= 0xFFFF && std::binary_search(GSM7NonASCII.begin(), GSM7NonASCII.end(), c)) {
+                return 1;
+            }
+            return notInGSM7;
+        }
+
+        std::size_t UTF16UnitsOf(char32_t c) noexcept
+        {
+            return (c < firstSupplementary) ? 1 : 2;
+        }
+
+        /// Decodes the code point at pos and moves pos past it, malformed sequences are replaced with U+FFFD
+        char32_t decodeUTF8(const std::string &str, std::size_t &pos) noexcept
+        {
+            const auto lead = static_cast<unsigned char>(str[pos++]);
+            if (lead < 0x80) {
+                return lead;
+            }
+
+            std::size_t continuation;
+            char32_t c;
+            char32_t minimum;
+            if ((lead & 0xE0) == 0xC0) {
+                continuation = 1;
+                c            = lead & 0x1F;
+                minimum      = 0x80;
+            }
+            else if ((lead & 0xF0) == 0xE0) {
+                continuation = 2;
+                c            = lead & 0x0F;
+                minimum      = 0x800;
+            }
+            else if ((lead & 0xF8) == 0xF0) {
+                continuation = 3;
+                c            = lead & 0x07;
+                minimum      = firstSupplementary;
+            }
+            else {
+                return replacementChar;
+            }
+
+            for (std::size_t i = 0; i < continuation; ++i) {
+                if (pos >= str.size() || (static_cast<unsigned char>(str[pos]) & 0xC0) != 0x80) {
+                    return replacementChar;
+                }
+                c = (c << 6) | (static_cast<unsigned char>(str[pos++]) & 0x3F);
+            }
+
+            if (c < minimum || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+                return replacementChar;
+            }
+            return c;
+        }
+
+        void appendUnitHex(std::string &out, char16_t unit)
+        {
+            out.push_back(hexDigits[(unit >> 12) & 0xF]);
+            out.push_back(hexDigits[(unit >> 8) & 0xF]);
+            out.push_back(hexDigits[(unit >> 4) & 0xF]);
+            out.push_back(hexDigits[unit & 0xF]);
+        }
+
+        /// Boundaries of the concatenated parts, characters are never split between the parts
+        class PartsSplitter
+        {
+          public:
+            explicit PartsSplitter(std::size_t limit) : limit{limit}
+            {}
+
+            void add(std::size_t units, std::size_t index)
+            {
+                if (used + units > limit) {
+                    ends.push_back(index);
+                    used = 0;
+                }
+                used += units;
+                total += units;
+            }
+
+            std::vector<std::size_t> finish(std::size_t singleLimit, std::size_t length)
+            {
+                if (total <= singleLimit) {
+                    ends.clear();
+                }
+                if (length > 0) {
+                    ends.push_back(length);
+                }
+                return std::move(ends);
+            }
+
+          private:
+            const std::size_t limit;
+            std::size_t used  = 0;
+            std::size_t total = 0;
+            std::vector<std::size_t> ends;
+        };
     } // anonymous namespace
 
-    SMSPartsHandler::SMSPartsHandler(const std::string &rawMessage)
-        : rawMessageUTF{UTF8(rawMessage)}, partsCount{0}, lastIndex{0}
+    SMSPartsHandler::SMSPartsHandler(const std::string &rawMessage) : encoding{Encoding::GSM7}, nextPart{0}
     {
-        partsCount = rawMessage.length() / msgConstants::singleMessageMaxLen;
-        if ((rawMessage.length() % msgConstants::singleMessageMaxLen) != 0) {
-            partsCount++;
+        codePoints.reserve(rawMessage.size());
+        PartsSplitter GSM7Parts{GSM7ConcatenatedLimit};
+        PartsSplitter UCS2Parts{UCS2ConcatenatedLimit};
+
+        std::size_t pos = 0;
+        while (pos < rawMessage.size()) {
+            const auto c     = decodeUTF8(rawMessage, pos);
+            const auto index = codePoints.size();
+            if (encoding == Encoding::GSM7) {
+                if (const auto septets = septetsOf(c); septets != notInGSM7) {
+                    GSM7Parts.add(septets, index);
+                }
+                else {
+                    encoding = Encoding::UCS2;
+                }
+            }
+            UCS2Parts.add(UTF16UnitsOf(c), index);
+            codePoints.push_back(c);
         }
+
+        partEnds = (encoding == Encoding::GSM7) ? GSM7Parts.finish(GSM7SingleLimit, codePoints.size())
+                                                : UCS2Parts.finish(UCS2SingleLimit, codePoints.size());
     }
 
     bool SMSPartsHandler::isPartsCountAboveLimit() const
     {
-        return partsCount > msgConstants::maxConcatenatedCount;
+        return getPartsCount() > msgConstants::maxConcatenatedCount;
     }
 
     bool SMSPartsHandler::isSinglePartSMS() const
     {
-        return partsCount == 1;
+        return getPartsCount() == 1;
     }
 
     unsigned SMSPartsHandler::getPartsCount() const
     {
-        return partsCount;
+        return partEnds.size();
+    }
+
+    Encoding SMSPartsHandler::getEncoding() const
+    {
+        return encoding;
     }
 
     const std::string SMSPartsHandler::getNextSmsPart()
     {
-        auto partLength = msgConstants::singleMessageMaxLen;
-        if (rawMessageUTF.length() - lastIndex < msgConstants::singleMessageMaxLen) {
-            partLength = rawMessageUTF.length() - lastIndex;
-        }
-        if (partLength == 0) {
+        if (nextPart >= partEnds.size()) {
             LOG_ERROR("No more next parts");
             return "";
         }
-        UTF8 messagePart = rawMessageUTF.substr(lastIndex, partLength);
+        const auto begin = (nextPart == 0) ? 0 : partEnds[nextPart - 1];
+        const auto end   = partEnds[nextPart++];
 
-        while (UCS2(messagePart).str().length() > (msgConstants::singleMessageMaxLen * UCS2SingleCharacterLen)) {
-            partLength--;
-            if (partLength <= 0) {
-                // Just for safety
-                LOG_ERROR("Invalid part length");
-                return "";
+        std::string part;
+        part.reserve((end - begin) * UCS2SingleCharacterLen);
+        for (auto i = begin; i < end; ++i) {
+            const auto c = codePoints[i];
+            if (c < firstSupplementary) {
+                appendUnitHex(part, c);
+            }
+            else {
+                const auto offset = c - firstSupplementary;
+                appendUnitHex(part, 0xD800 + (offset >> 10));
+                appendUnitHex(part, 0xDC00 + (offset & 0x3FF));
             }
-            messagePart = rawMessageUTF.substr(lastIndex, partLength);
         }
-        lastIndex += messagePart.length();
-
-        return UCS2(messagePart).str();
+        return part;
     }
 
 } // namespace cellular::internal::sms
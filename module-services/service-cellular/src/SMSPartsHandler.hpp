@@ -3,12 +3,25 @@
 
 #pragma once
 
-#include <ucs2/UCS2.hpp>
-
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace cellular::internal::sms
 {
+    /// Data coding of the message body
+    enum class Encoding
+    {
+        GSM7, /// GSM 03.38 default alphabet with the extension table, up to 160 characters per SMS
+        UCS2  /// UTF-16, up to 70 characters per SMS
+    };
+
+    /**
+     * Splits the message into parts in a single pass.
+     * GSM7 is chosen when every character is in the GSM alphabet, UCS2 otherwise. Part boundaries are computed
+     * up front in the units of the chosen encoding and never split the escaped GSM characters nor the surrogate
+     * pairs. The parts are returned as the UCS2 hex strings expected by the modem with the UCS2 TE charset.
+     */
     class SMSPartsHandler
     {
       public:
@@ -20,12 +33,16 @@ namespace cellular::internal::sms
 
         unsigned getPartsCount() const;
 
+        Encoding getEncoding() const;
+
         const std::string getNextSmsPart();
 
       private:
-        const UTF8 rawMessageUTF;
-        unsigned partsCount;
-        size_t lastIndex;
+        std::vector<char32_t> codePoints;
+        /// Index of the code point following each part
+        std::vector<std::size_t> partEnds;
+        Encoding encoding;
+        std::size_t nextPart;
     };
 
 } // namespace cellular::internal::sms
@@ -22,6 +22,8 @@
 #include "service-cellular/MessageConstants.hpp"
 #include "checkSmsCenter.hpp"
 
+#include <optional>
+
 using service::name::service_time;
 
 namespace cellular::internal
@@ -90,7 +92,10 @@ namespace cellular::internal
                 owner->bus.sendMulticast<notification::SimNotInserted>();
                 return sys::MessageNone{};
             }
-            return std::make_shared<request::sim::ChangePin::Response>(simCard->handleChangePin(msg->oldPin, msg->pin));
+            simCard->handleChangePin(msg->oldPin, msg->pin, [this, sender = msg->sender](bool result) {
+                owner->bus.sendUnicast(std::make_shared<request::sim::ChangePin::Response>(result), sender);
+            });
+            return sys::MessageNone{};
         });
         owner->connect(typeid(request::sim::UnblockWithPuk), [&](sys::Message *request) -> sys::MessagePointer {
             auto msg = static_cast<request::sim::UnblockWithPuk *>(request);
@@ -98,8 +103,10 @@ namespace cellular::internal
                 owner->bus.sendMulticast<notification::SimNotInserted>();
                 return sys::MessageNone{};
             }
-            return std::make_shared<request::sim::UnblockWithPuk::Response>(
-                simCard->handleUnblockWithPuk(msg->puk, msg->pin));
+            simCard->handleUnblockWithPuk(msg->puk, msg->pin, [this, sender = msg->sender](bool result) {
+                owner->bus.sendUnicast(std::make_shared<request::sim::UnblockWithPuk::Response>(result), sender);
+            });
+            return sys::MessageNone{};
         });
         owner->connect(typeid(request::sim::SetPinLock), [&](sys::Message *request) -> sys::MessagePointer {
             auto msg = static_cast<request::sim::SetPinLock *>(request);
@@ -107,8 +114,10 @@ namespace cellular::internal
                 owner->bus.sendMulticast<notification::SimNotInserted>();
                 return sys::MessageNone{};
             }
-            return std::make_shared<request::sim::SetPinLock::Response>(simCard->handleSetPinLock(msg->pin, msg->lock),
-                                                                        msg->lock);
+            simCard->handleSetPinLock(msg->pin, msg->lock, [this, sender = msg->sender, lock = msg->lock](bool result) {
+                owner->bus.sendUnicast(std::make_shared<request::sim::SetPinLock::Response>(result, lock), sender);
+            });
+            return sys::MessageNone{};
         });
         owner->connect(typeid(request::sim::PinUnlock), [&](sys::Message *request) -> sys::MessagePointer {
             auto msg = static_cast<request::sim::PinUnlock *>(request);
@@ -116,7 +125,10 @@ namespace cellular::internal
                 owner->bus.sendMulticast<notification::SimNotInserted>();
                 return sys::MessageNone{};
             }
-            return std::make_shared<request::sim::PinUnlock::Response>(simCard->handlePinUnlock(msg->pin));
+            simCard->handlePinUnlock(msg->pin, [this, sender = msg->sender](bool result) {
+                owner->bus.sendUnicast(std::make_shared<request::sim::PinUnlock::Response>(result), sender);
+            });
+            return sys::MessageNone{};
         });
 
         /**
@@ -147,6 +159,45 @@ namespace cellular::internal
                        });
     }
 
+    void ServiceCellularPriv::connectATCommandWorker()
+    {
+        owner->connect(typeid(internal::msg::ATCommandResult), [&](sys::Message *request) -> sys::MessagePointer {
+            auto msg = static_cast<internal::msg::ATCommandResult *>(request);
+            msg->callback(msg->result);
+            return sys::MessageNone{};
+        });
+    }
+
+    void ServiceCellularPriv::startATCommandWorker()
+    {
+        atCommandWorker = std::make_unique<ATCommandWorker>(
+            owner, [this]() -> at::BaseChannel * { return owner->cmux->get(CellularMux::Channel::Commands); });
+        atCommandWorker->init();
+        atCommandWorker->run();
+
+        // PIN and PUK are verified by the SIM card for a while, the service keeps handling calls and URCs meanwhile
+        simCard->setExecutor([this](std::function<service::sim::Result()> operation,
+                                    std::function<void(service::sim::Result)> onDone) {
+            auto result = std::make_shared<service::sim::Result>(service::sim::Result::Unknown);
+            atCommandWorker->enqueue(
+                [operation = std::move(operation), result](at::BaseChannel &) {
+                    *result = operation();
+                    return at::Result{at::Result::Code::OK, {}};
+                },
+                [onDone = std::move(onDone), result](const at::Result &) { onDone(*result); });
+        });
+    }
+
+    void ServiceCellularPriv::stopATCommandWorker()
+    {
+        if (atCommandWorker) {
+            simCard->setExecutor(nullptr);
+            atCommandWorker->flush();
+            atCommandWorker->close();
+            atCommandWorker.reset();
+        }
+    }
+
     void ServiceCellularPriv::connectNetworkTime()
     {
         owner->connect(typeid(stm::message::AutomaticDateAndTimeChangedMessage),
@@ -206,11 +257,18 @@ namespace cellular::internal
         auto channel        = owner->cmux->get(CellularMux::Channel::Commands);
         auto receiver       = record.number.getEntered();
         bool channelSetup   = false;
+        auto partHandler    = sms::SMSPartsHandler(record.body);
 
+        // charset, prompt and message body can't be interleaved with commands sent from other tasks
+        std::optional<cpp_freertos::LockGuard> commandSequence;
         if (channel) {
+            commandSequence.emplace(channel->getCommandMutex());
             channelSetup = true;
-            if (!channel->cmd(at::AT::SET_SMS_TEXT_MODE_UCS2)) {
-                LOG_ERROR("Could not set UCS2 mode for SMS");
+            // TE charset stays UCS2, the data coding scheme decides how the modem encodes the message
+            const auto textMode = (partHandler.getEncoding() == sms::Encoding::GSM7) ? at::AT::SET_SMS_TEXT_MODE_GSM
+                                                                                      : at::AT::SET_SMS_TEXT_MODE_UCS2;
+            if (!channel->cmd(textMode)) {
+                LOG_ERROR("Could not set text mode for SMS");
                 channelSetup = false;
             }
             if (!channel->cmd(at::AT::SMS_UCSC2)) {
@@ -220,7 +278,6 @@ namespace cellular::internal
         }
 
         if (channelSetup) {
-            auto partHandler = sms::SMSPartsHandler(record.body);
             if (partHandler.isSinglePartSMS()) {
                 std::string command      = std::string(at::factory(at::AT::CMGS));
                 std::string body         = UCS2(UTF8(receiver)).str();
@@ -13,9 +13,11 @@
 #include "ImeiGetHandler.hpp"
 #include "TetheringHandler.hpp"
 #include "ModemResetHandler.hpp"
+#include "ATCommandWorker.hpp"
 
 namespace cellular::internal
 {
+    using service::ATCommandWorker;
     using service::ModemResetHandler;
     using service::NetworkTime;
     using service::SimCard;
@@ -35,6 +37,7 @@ namespace cellular::internal
         std::unique_ptr<service::ImeiGetHandler> imeiGetHandler;
         std::unique_ptr<TetheringHandler> tetheringHandler;
         std::unique_ptr<ModemResetHandler> modemResetHandler;
+        std::unique_ptr<ATCommandWorker> atCommandWorker;
         State::PowerState nextPowerState = State::PowerState::Off;
         std::uint8_t multiPartSMSUID     = 0;
 
@@ -45,6 +48,10 @@ namespace cellular::internal
         void connectNetworkTime();
         void connectSimContacts();
         void connectImeiGetHandler();
+        void connectATCommandWorker();
+
+        void startATCommandWorker();
+        void stopATCommandWorker();
 
         void requestNetworkTimeSettings();
         void setInitialMultiPartSMSUID(std::uint8_t uid);
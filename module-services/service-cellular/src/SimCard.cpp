@@ -59,6 +59,11 @@ namespace cellular
             this->channel = channel;
         }
 
+        void SimCard::setExecutor(Executor executor)
+        {
+            this->executor = std::move(executor);
+        }
+
         bool SimCard::handleSetActiveSim(api::SimSlot sim)
         {
             Store::GSM::get()->selected = static_cast<Store::GSM::SIM>(sim);
@@ -74,30 +79,31 @@ namespace cellular
             return isPinLocked();
         }
 
-        bool SimCard::handleChangePin(const api::SimCode &oldPin, const api::SimCode &pin)
+        void SimCard::handleChangePin(const api::SimCode &oldPin, const api::SimCode &pin, OnResult onResult)
         {
             const auto _oldPin = internal::simCodeToString(oldPin);
             const auto _pin    = internal::simCodeToString(pin);
-            return processPinResult(changePin(_oldPin, _pin));
+            execute([this, _oldPin, _pin]() { return changePin(_oldPin, _pin); }, std::move(onResult));
         }
 
-        bool SimCard::handleUnblockWithPuk(const api::SimCode &puk, const api::SimCode &pin)
+        void SimCard::handleUnblockWithPuk(const api::SimCode &puk, const api::SimCode &pin, OnResult onResult)
         {
             const auto _puk = internal::simCodeToString(puk);
             const auto _pin = internal::simCodeToString(pin);
-            return processPinResult(supplyPuk(_puk, _pin));
+            execute([this, _puk, _pin]() { return supplyPuk(_puk, _pin); }, std::move(onResult));
         }
 
-        bool SimCard::handleSetPinLock(const api::SimCode &pin, api::SimLockState lock)
+        void SimCard::handleSetPinLock(const api::SimCode &pin, api::SimLockState lock, OnResult onResult)
         {
             const auto _pin = internal::simCodeToString(pin);
-            return processPinResult(setPinLock(_pin, lock == cellular::api::SimLockState::Enabled));
+            execute([this, _pin, lock]() { return setPinLock(_pin, lock == cellular::api::SimLockState::Enabled); },
+                    std::move(onResult));
         }
 
-        bool SimCard::handlePinUnlock(const api::SimCode &pin)
+        void SimCard::handlePinUnlock(const api::SimCode &pin, OnResult onResult)
         {
             const auto _pin = internal::simCodeToString(pin);
-            return processPinResult(supplyPin(_pin));
+            execute([this, _pin]() { return supplyPin(_pin); }, std::move(onResult));
         }
 
         void SimCard::handleATSimStateChange(at::SimState state)
@@ -233,6 +239,21 @@ namespace cellular
             return result == sim::Result::OK;
         }
 
+        void SimCard::execute(std::function<sim::Result()> operation, OnResult onResult)
+        {
+            auto onDone = [this, onResult = std::move(onResult)](sim::Result result) {
+                const auto succeed = processPinResult(result);
+                if (onResult) {
+                    onResult(succeed);
+                }
+            };
+            if (executor) {
+                executor(std::move(operation), std::move(onDone));
+                return;
+            }
+            onDone(operation());
+        }
+
         sim::Result SimCard::supplyPin(const std::string &pin) const
         {
             return sendCommand(sim::LockType::PIN, at::factory(at::AT::CPIN) + "\"" + pin + "\"");
@@ -9,6 +9,8 @@
 
 #include <module-cellular/at/SimInsertedState.hpp>
 
+#include <functional>
+
 namespace at
 {
     class Cmd;
@@ -65,6 +67,11 @@ namespace cellular::service
     class SimCard
     {
       public:
+        using OnResult = std::function<void(bool)>;
+        /// Sends the commands of the operation and calls onDone with its result in the task of the SimCard
+        using Executor = std::function<void(std::function<sim::Result()> operation,
+                                            std::function<void(sim::Result)> onDone)>;
+
         /** Check if cmd channel is set
          * @return true if ready to communicate
          */
@@ -80,15 +87,21 @@ namespace cellular::service
          */
         void setChannel(at::BaseChannel *channel);
 
+        /** Set executor of the PIN and PUK operations
+         * \param executor executor (or nullptr to send the commands in place)
+         */
+        void setExecutor(Executor executor);
+
         /**
          * Request message handlers
+         * PIN and PUK operations are sent by the executor, onResult is called when they are done
          */
         bool handleSetActiveSim(api::SimSlot sim);
         bool handleIsPinLocked() const;
-        bool handleChangePin(const api::SimCode &old_pin, const api::SimCode &pin);
-        bool handleUnblockWithPuk(const api::SimCode &puk, const api::SimCode &pin);
-        bool handleSetPinLock(const api::SimCode &pin, api::SimLockState lock);
-        bool handlePinUnlock(const api::SimCode &pin);
+        void handleChangePin(const api::SimCode &old_pin, const api::SimCode &pin, OnResult onResult);
+        void handleUnblockWithPuk(const api::SimCode &puk, const api::SimCode &pin, OnResult onResult);
+        void handleSetPinLock(const api::SimCode &pin, api::SimLockState lock, OnResult onResult);
+        void handlePinUnlock(const api::SimCode &pin, OnResult onResult);
 
         /**
          * Notification message handlers
@@ -241,6 +254,10 @@ namespace cellular::service
          */
         bool processPinResult(sim::Result result);
 
+        /** Send the PIN or PUK operation using the executor and process its result
+         */
+        void execute(std::function<sim::Result()> operation, OnResult onResult);
+
         sim::Result sendCommand(sim::LockType check, const at::Cmd &cmd) const;
 
         void handleSimState(at::SimState state);
@@ -252,6 +269,7 @@ namespace cellular::service
         std::optional<at::SimInsertedStatus> readSimCardInsertStatus();
 
         at::BaseChannel *channel        = nullptr;
+        Executor executor               = nullptr;
         std::optional<api::SimSlot> sim = std::nullopt;
         std::optional<at::SimInsertedStatus> simInserted = std::nullopt;
         bool simSelectInProgress                         = false;
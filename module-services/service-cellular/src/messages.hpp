@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <service-cellular/api/common.hpp>
 #include <service-cellular/api/message.hpp>
 #include <at/SimState.hpp>
+#include <modem/ATCommandQueue.hpp>
 
 namespace cellular::internal::msg
 {
@@ -14,4 +16,13 @@ namespace cellular::internal::msg
         {}
         const at::SimState state;
     };
+
+    struct ATCommandResult : public cellular::msg::Request
+    {
+        ATCommandResult(at::CommandQueue::Callback callback, at::Result result)
+            : callback(std::move(callback)), result(std::move(result))
+        {}
+        at::CommandQueue::Callback callback;
+        const at::Result result;
+    };
 } // namespace cellular::internal::msg
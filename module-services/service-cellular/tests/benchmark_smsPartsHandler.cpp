@@ -0,0 +1,56 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <service-cellular/src/SMSPartsHandler.hpp>
+#include <ucs2/UCS2.hpp>
+
+#include <string>
+
+using namespace cellular::internal::sms;
+
+// Benchmarks are hidden from default run, use: catch2-cellular-smsPartsHandler "[benchmark]"
+// Every run splits the longest message accepted by the modem, 7 concatenated parts
+namespace
+{
+    std::string repeat(const std::string &text, std::size_t count)
+    {
+        std::string result;
+        for (std::size_t i = 0; i < count; ++i) {
+            result += text;
+        }
+        return result;
+    }
+
+    std::size_t splitAll(const std::string &message)
+    {
+        SMSPartsHandler parts{message};
+        std::size_t size = 0;
+        for (unsigned i = 0; i < parts.getPartsCount(); ++i) {
+            size += parts.getNextSmsPart().size();
+        }
+        return size;
+    }
+} // namespace
+
+TEST_CASE("SMS parts handler benchmark", "[.][benchmark]")
+{
+    const auto GSM7Message     = repeat("Meeting at 3:30PM {room 2}, bring the notes! ", 22);
+    const auto UCS2Message     = repeat("Zażółć gęślą jaźń \U0001f601 ", 22);
+    const auto GSM7MessageUTF8 = UTF8(GSM7Message);
+
+    BENCHMARK("GSM7 message")
+    {
+        return splitAll(GSM7Message);
+    };
+
+    BENCHMARK("UCS2 message with emoji")
+    {
+        return splitAll(UCS2Message);
+    };
+
+    BENCHMARK("UCS2 class conversion of the GSM7 message")
+    {
+        return UCS2(GSM7MessageUTF8).str().size();
+    };
+}
@@ -76,7 +76,8 @@ TEST_CASE("SimCard functionality test")
         bool event             = false;
         simCard.onUnhandledCME = [&event](unsigned int code) { event = true; };
 
-        auto result = simCard.handlePinUnlock({});
+        bool result = false;
+        simCard.handlePinUnlock({}, [&result](bool succeed) { result = succeed; });
         REQUIRE(result);
         REQUIRE(!event);
     }
@@ -91,7 +92,8 @@ TEST_CASE("SimCard functionality test")
         bool event             = false;
         simCard.onUnhandledCME = [&event](unsigned int code) { event = true; };
 
-        auto result = simCard.handlePinUnlock({});
+        bool result = false;
+        simCard.handlePinUnlock({}, [&result](bool succeed) { result = succeed; });
         REQUIRE(!result);
         REQUIRE(!event);
     }
@@ -106,8 +108,38 @@ TEST_CASE("SimCard functionality test")
         bool event             = false;
         simCard.onUnhandledCME = [&event](unsigned int code) { event = true; };
 
-        auto result = simCard.handlePinUnlock({});
+        bool result = false;
+        simCard.handlePinUnlock({}, [&result](bool succeed) { result = succeed; });
         REQUIRE(!result);
         REQUIRE(event);
     }
+
+    SECTION("Unlock with PIN - sent by the executor")
+    {
+        cellular::service::SimCard simCard;
+
+        auto mockChannel = at::QPINC_Channel(at::Result::Code::ERROR);
+        simCard.setChannel(&mockChannel);
+
+        std::function<cellular::service::sim::Result()> pendingOperation;
+        std::function<void(cellular::service::sim::Result)> pendingDone;
+        simCard.setExecutor([&](auto operation, auto onDone) {
+            pendingOperation = std::move(operation);
+            pendingDone      = std::move(onDone);
+        });
+
+        bool event             = false;
+        simCard.onUnhandledCME = [&event](unsigned int code) { event = true; };
+
+        std::optional<bool> result;
+        simCard.handlePinUnlock({}, [&result](bool succeed) { result = succeed; });
+        REQUIRE(!result.has_value());
+        REQUIRE(!event);
+
+        REQUIRE(pendingOperation);
+        pendingDone(pendingOperation());
+        REQUIRE(result.has_value());
+        REQUIRE(!*result);
+        REQUIRE(event);
+    }
 }
@@ -5,71 +5,132 @@
 
 #include <catch2/catch.hpp>
 #include <service-cellular/src/SMSPartsHandler.hpp>
+#include <ucs2/UCS2.hpp>
 
 namespace
 {
-    constexpr auto singleSMSLimit            = 67;
+    constexpr auto GSM7SingleSMSLimit        = 160;
+    constexpr auto GSM7ConcatenatedSMSLimit  = 153;
+    constexpr auto UCS2SingleSMSLimit        = 70;
+    constexpr auto UCS2ConcatenatedSMSLimit  = 67;
     constexpr auto singleUCS2CharacterLength = 4;
-    constexpr auto singleSMSLimitUCS2        = singleUCS2CharacterLength * singleSMSLimit;
     const std::string smileEmojiUTF          = "\U0001f601";
     const std::string winkEmojiUTF           = "\U0001f609";
+    const std::string euroSignUTF            = "€";
 } // namespace
 
-TEST_CASE("SMS Parts handler")
+TEST_CASE("SMS Parts handler - GSM7")
 {
     using namespace cellular::internal::sms;
 
     SECTION("Fit to SMS limit")
     {
-        std::string smsAt67SignsLimit = "qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345";
-        SMSPartsHandler parts{smsAt67SignsLimit};
+        SMSPartsHandler parts{std::string(GSM7SingleSMSLimit, 'a')};
+        CHECK(parts.getEncoding() == Encoding::GSM7);
         CHECK(parts.isSinglePartSMS());
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
+        CHECK(parts.getNextSmsPart().length() == GSM7SingleSMSLimit * singleUCS2CharacterLength);
         CHECK(parts.getNextSmsPart().length() == 0);
     }
 
+    SECTION("Above single SMS limit")
+    {
+        SMSPartsHandler parts{std::string(GSM7SingleSMSLimit + 1, 'a')};
+        CHECK(parts.getEncoding() == Encoding::GSM7);
+        CHECK(!parts.isSinglePartSMS());
+        CHECK(parts.getPartsCount() == 2);
+        CHECK(parts.getNextSmsPart().length() == GSM7ConcatenatedSMSLimit * singleUCS2CharacterLength);
+        CHECK(parts.getNextSmsPart().length() ==
+              (GSM7SingleSMSLimit + 1 - GSM7ConcatenatedSMSLimit) * singleUCS2CharacterLength);
+        CHECK(parts.getNextSmsPart().length() == 0);
+    }
+
+    SECTION("Extension table characters take two septets")
+    {
+        SMSPartsHandler single{std::string(GSM7SingleSMSLimit / 2, '{')};
+        CHECK(single.getEncoding() == Encoding::GSM7);
+        CHECK(single.isSinglePartSMS());
+
+        SMSPartsHandler parts{std::string(GSM7SingleSMSLimit / 2 + 1, '{')};
+        CHECK(parts.getEncoding() == Encoding::GSM7);
+        CHECK(parts.getPartsCount() == 2);
+        CHECK(parts.getNextSmsPart().length() == (GSM7ConcatenatedSMSLimit / 2) * singleUCS2CharacterLength);
+    }
+
+    SECTION("Escaped character is not split between parts")
+    {
+        const auto prefix = std::string(GSM7ConcatenatedSMSLimit - 1, 'a');
+        SMSPartsHandler parts{prefix + euroSignUTF + "0123456789"};
+        CHECK(parts.getEncoding() == Encoding::GSM7);
+        CHECK(parts.getPartsCount() == 2);
+        CHECK(parts.getNextSmsPart() == UCS2(UTF8(prefix)).str());
+        CHECK(parts.getNextSmsPart() == "20AC" + UCS2(UTF8("0123456789")).str());
+    }
+
+    SECTION("GSM alphabet characters outside ASCII")
+    {
+        SMSPartsHandler parts{"Café £5 ÄÖÜ ßø ΔΩ §¿¡ \r\n ^{}\\[~]|"};
+        CHECK(parts.getEncoding() == Encoding::GSM7);
+        CHECK(SMSPartsHandler{"Zażółć"}.getEncoding() == Encoding::UCS2);
+    }
+
+    SECTION("Characters outside the GSM alphabet")
+    {
+        CHECK(SMSPartsHandler{"grave `accent"}.getEncoding() == Encoding::UCS2);
+        CHECK(SMSPartsHandler{"tab\tcharacter"}.getEncoding() == Encoding::UCS2);
+        CHECK(SMSPartsHandler{"emoji " + smileEmojiUTF}.getEncoding() == Encoding::UCS2);
+    }
+
+    SECTION("7-part SMS limit")
+    {
+        SMSPartsHandler atLimit{std::string(GSM7ConcatenatedSMSLimit * 7, 'a')};
+        CHECK(atLimit.getPartsCount() == 7);
+        CHECK(!atLimit.isPartsCountAboveLimit());
+
+        SMSPartsHandler aboveLimit{std::string(GSM7ConcatenatedSMSLimit * 7 + 1, 'a')};
+        CHECK(aboveLimit.getPartsCount() == 8);
+        CHECK(aboveLimit.isPartsCountAboveLimit());
+    }
+}
+
+TEST_CASE("SMS Parts handler - UCS2")
+{
+    using namespace cellular::internal::sms;
+
     SECTION("Fit to SMS limit with emoji")
     {
-        std::string smsAt67SignsLimit =
-            "qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm1" + smileEmojiUTF;
-        CHECK(smsAt67SignsLimit.length() == singleSMSLimit);
-        SMSPartsHandler parts{smsAt67SignsLimit};
+        const auto text = std::string(UCS2SingleSMSLimit - 2, 'a') + smileEmojiUTF;
+        SMSPartsHandler parts{text};
+        CHECK(parts.getEncoding() == Encoding::UCS2);
         CHECK(parts.isSinglePartSMS());
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
+        CHECK(parts.getNextSmsPart().length() == UCS2SingleSMSLimit * singleUCS2CharacterLength);
         CHECK(parts.getNextSmsPart().length() == 0);
     }
 
-    SECTION("Above single SMS limit")
+    SECTION("Above single SMS limit with emoji")
     {
-        std::string smsAbove67SignsLimit = "qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm123456";
-        SMSPartsHandler parts{smsAbove67SignsLimit};
-        CHECK(!parts.isSinglePartSMS());
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() == singleUCS2CharacterLength);
+        const auto text = std::string(UCS2SingleSMSLimit - 1, 'a') + smileEmojiUTF;
+        SMSPartsHandler parts{text};
+        CHECK(parts.getPartsCount() == 2);
+        CHECK(parts.getNextSmsPart().length() == UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
+        CHECK(parts.getNextSmsPart().length() == 4 * singleUCS2CharacterLength);
         CHECK(parts.getNextSmsPart().length() == 0);
     }
 
-    SECTION("Above single SMS limit with emoji")
+    SECTION("Surrogate pair is not split between parts")
     {
-        std::string smsAbove67SignsLimit =
-            "qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm1234" + smileEmojiUTF + "abcd";
-        CHECK(smsAbove67SignsLimit.length() > singleSMSLimit);
-        SMSPartsHandler parts{smsAbove67SignsLimit};
-        CHECK(!parts.isSinglePartSMS());
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() > 0);
+        const auto prefix = std::string(UCS2ConcatenatedSMSLimit - 1, 'a');
+        SMSPartsHandler parts{prefix + smileEmojiUTF + "abcd"};
+        CHECK(parts.getPartsCount() == 2);
+        CHECK(parts.getNextSmsPart() == UCS2(UTF8(prefix)).str());
+        CHECK(parts.getNextSmsPart() == "D83DDE01" + UCS2(UTF8("abcd")).str());
     }
 
-    SECTION("3-part SMS limit")
+    SECTION("Same hex as the UCS2 conversion")
     {
-        std::string smsAt67SignsLimit = "qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345";
-        SMSPartsHandler parts{smsAt67SignsLimit + smsAt67SignsLimit + smsAt67SignsLimit};
-        CHECK(!parts.isSinglePartSMS());
-        CHECK(parts.getPartsCount() == 3);
-        CHECK(parts.getNextSmsPart().length() == singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() == singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() == singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() == 0);
+        const std::string text = "Zażółć gęślą jaźń € ÄÖÜ";
+        SMSPartsHandler parts{text};
+        CHECK(parts.getEncoding() == Encoding::UCS2);
+        CHECK(parts.getNextSmsPart() == UCS2(UTF8(text)).str());
     }
 
     SECTION("Multi-part SMS with emojis")
@@ -79,33 +140,41 @@ TEST_CASE("SMS Parts handler")
             smileEmojiUTF + smileEmojiUTF + "ghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345" + smileEmojiUTF +
             "teststringteststring" + smileEmojiUTF;
         SMSPartsHandler parts{multiPartSMS};
-        UTF8 multiPartSMSUTF8{multiPartSMS};
-        unsigned numOfParts = (multiPartSMSUTF8.length() / singleSMSLimit);
-        numOfParts += (multiPartSMSUTF8.length() % singleSMSLimit) ? 1 : 0;
-        CHECK(!parts.isSinglePartSMS());
-        CHECK(parts.getPartsCount() == numOfParts);
+        CHECK(parts.getPartsCount() == 3);
 
-        for (unsigned i = 0; i < numOfParts; ++i) {
-            CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
+        std::size_t totalLength = 0;
+        for (unsigned i = 0; i < parts.getPartsCount(); ++i) {
+            const auto part = parts.getNextSmsPart();
+            CHECK(part.length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
+            totalLength += part.length();
         }
+        CHECK(totalLength == (140 + 6 * 2) * singleUCS2CharacterLength);
     }
 
     SECTION("7-part SMS limit")
     {
-        std::string smsAbove7PartLimit =
-            std::string{"qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345"} +
-            std::string{"qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345"} +
-            std::string{"qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345"} +
-            std::string{"qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345"} +
-            std::string{"qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345"} +
-            std::string{"qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345"} +
-            std::string{"qwertyuiopasdfghjklzxcvbnm1234567890qwertyuiopasdfghjklzxcvbnm12345"} + std::string{"qwerty"};
-        SMSPartsHandler parts{smsAbove7PartLimit};
-        CHECK(parts.isPartsCountAboveLimit());
-        CHECK(parts.getPartsCount() == 8);
+        SMSPartsHandler aboveLimit{std::string(UCS2ConcatenatedSMSLimit * 7, 'a') + smileEmojiUTF};
+        CHECK(aboveLimit.getPartsCount() == 8);
+        CHECK(aboveLimit.isPartsCountAboveLimit());
+    }
+
+    SECTION("Malformed UTF-8 is replaced")
+    {
+        SMSPartsHandler parts{std::string{"a\xC3"} + "b"};
+        CHECK(parts.getEncoding() == Encoding::UCS2);
+        CHECK(parts.getNextSmsPart() == "0061FFFD0062");
     }
 }
 
+TEST_CASE("SMS Parts handler - empty message")
+{
+    using namespace cellular::internal::sms;
+    SMSPartsHandler parts{""};
+    CHECK(parts.getPartsCount() == 0);
+    CHECK(!parts.isSinglePartSMS());
+    CHECK(parts.getNextSmsPart().empty());
+}
+
 TEST_CASE("EGD-7372 cases")
 {
     using namespace cellular::internal::sms;
@@ -116,8 +185,8 @@ TEST_CASE("EGD-7372 cases")
             "Hello everyone! Mudita Pure test today? I propose a meeting at 3:30PM " + winkEmojiUTF + ".";
         SMSPartsHandler parts{testString};
         CHECK(parts.getPartsCount() == 2);
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
+        CHECK(parts.getNextSmsPart().length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
+        CHECK(parts.getNextSmsPart().length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
     }
 
     SECTION("Second")
@@ -126,8 +195,8 @@ TEST_CASE("EGD-7372 cases")
             "Hello everyone! Mudita Pure test today? " + winkEmojiUTF + " I propose a meeting at 3:30PM.";
         SMSPartsHandler parts{testString};
         CHECK(parts.getPartsCount() == 2);
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
+        CHECK(parts.getNextSmsPart().length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
+        CHECK(parts.getNextSmsPart().length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
     }
 
     SECTION("Third")
@@ -136,8 +205,8 @@ TEST_CASE("EGD-7372 cases")
                                  winkEmojiUTF + ". Extra random text.";
         SMSPartsHandler parts{testString};
         CHECK(parts.getPartsCount() == 2);
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
+        CHECK(parts.getNextSmsPart().length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
+        CHECK(parts.getNextSmsPart().length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
     }
 
     SECTION("Fourth")
@@ -146,7 +215,7 @@ TEST_CASE("EGD-7372 cases")
             "Hello! Mudita Pure test today? I propose a meeting at 3:30PM " + winkEmojiUTF + ". Extra random text.";
         SMSPartsHandler parts{testString};
         CHECK(parts.getPartsCount() == 2);
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
-        CHECK(parts.getNextSmsPart().length() <= singleSMSLimitUCS2);
+        CHECK(parts.getNextSmsPart().length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
+        CHECK(parts.getNextSmsPart().length() <= UCS2ConcatenatedSMSLimit * singleUCS2CharacterLength);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <service-desktop/BackupManifest.hpp>
+
+#include <log/log.hpp>
+
+namespace
+{
+    namespace key
+    {
+        inline constexpr auto taskId = "id";
+        inline constexpr auto base   = "base";
+        inline constexpr auto depth  = "depth";
+        inline constexpr auto files  = "files";
+        inline constexpr auto size   = "size";
+        inline constexpr auto crc32  = "crc32";
+    } // namespace key
+} // namespace
+
+bool BackupManifest::IsUnchanged(const std::string &fileName, const FileInfo &info) const
+{
+    const auto file = files.find(fileName);
+    return file != files.end() && file->second == info;
+}
+
+void BackupManifest::SetBase(const BackupManifest &baseManifest)
+{
+    base  = baseManifest.taskId;
+    depth = baseManifest.depth + 1;
+}
+
+json11::Json BackupManifest::to_json() const
+{
+    auto filesJson = json11::Json::object{};
+    for (const auto &[name, info] : files) {
+        filesJson[name] = json11::Json::object{{key::size, static_cast<double>(info.size)}, {key::crc32, info.crc32}};
+    }
+
+    return json11::Json::object{{key::taskId, taskId},
+                                {key::base, base},
+                                {key::depth, static_cast<int>(depth)},
+                                {key::files, filesJson}};
+}
+
+std::optional<BackupManifest> BackupManifest::FromJson(const std::string &jsonString)
+{
+    std::string err;
+    const auto json = json11::Json::parse(jsonString, err);
+    if (!json.is_object() || !json[key::taskId].is_string() || !json[key::depth].is_number() ||
+        !json[key::files].is_object()) {
+        LOG_ERROR("Invalid backup manifest: %s", err.c_str());
+        return std::nullopt;
+    }
+
+    BackupManifest manifest;
+    manifest.taskId = json[key::taskId].string_value();
+    manifest.base   = json[key::base].string_value();
+    manifest.depth  = static_cast<unsigned>(json[key::depth].int_value());
+    for (const auto &[name, info] : json[key::files].object_items()) {
+        if (!info[key::size].is_number() || !info[key::crc32].is_string()) {
+            LOG_ERROR("Invalid backup manifest entry: %s", name.c_str());
+            return std::nullopt;
+        }
+        manifest.files[name] = FileInfo{static_cast<std::uintmax_t>(info[key::size].number_value()),
+                                        info[key::crc32].string_value()};
+    }
+
+    return manifest;
+}
@@ -5,7 +5,9 @@
 #include <endpoints/JsonKeyNames.hpp>
 
 #include <SystemManager/SystemManagerCommon.hpp>
+#include <LogCompressor.hpp>
 #include <log/log.hpp>
+#include <crc32.h>
 #include <microtar.hpp>
 #include <purefs/filesystem_paths.hpp>
 #include <service-db/DBServiceAPI.hpp>
@@ -33,6 +35,14 @@ namespace sys
 namespace bkp
 {
     inline constexpr auto backupInfo = "backup.json";
+    inline constexpr auto manifest   = "manifest.json";
+
+    /// manifest of the latest backup, the base of the next incremental backup
+    inline constexpr auto lastManifest        = ".backup_manifest.json";
+    inline constexpr auto compressedExtension = ".lz4";
+
+    /// limits the chain of the incremental backups followed during the restore
+    inline constexpr auto maxBaseBackups = BackupManifest::maxDepth;
 };
 
 static const long unsigned int empty_dirlist_size = 2;
@@ -41,11 +51,13 @@ static bool isValidDirentry(const std::filesystem::directory_entry &direntry)
     return direntry.path() != "." && direntry.path() != ".." && direntry.path() != "...";
 }
 
-BackupRestore::CompletionCode BackupRestore::BackupUserFiles(sys::Service *ownerService, std::filesystem::path &path)
+BackupRestore::CompletionCode BackupRestore::BackupUserFiles(sys::Service *ownerService, OperationStatus &status)
 {
     assert(ownerService != nullptr);
     LOG_INFO("Backup started...");
 
+    const auto &path = status.backupTempDir;
+
     if (BackupRestore::RemoveBackupDir(path) == false) {
         return CompletionCode::FSError;
     }
@@ -67,6 +79,28 @@ BackupRestore::CompletionCode BackupRestore::BackupUserFiles(sys::Service *owner
         return CompletionCode::CopyError;
     }
 
+    BackupManifest manifest;
+    manifest.taskId = status.taskId;
+    std::optional<BackupManifest> baseManifest;
+
+    if (status.incremental) {
+        baseManifest = ReadManifest(LastManifestPath());
+        if (!baseManifest.has_value()) {
+            LOG_INFO("No previous backup, creating full backup");
+        }
+        else if (!baseManifest->CanBeBase()) {
+            LOG_INFO("Chain of %u incremental backups is full, creating full backup", baseManifest->depth);
+            baseManifest.reset();
+        }
+    }
+
+    LOG_DEBUG("Preparing files");
+    if (BackupRestore::PrepareBackupFiles(path, baseManifest, manifest) == false) {
+        LOG_ERROR("Failed to prepare backup files");
+        BackupRestore::RemoveBackupDir(path);
+        return CompletionCode::PackError;
+    }
+
     LOG_DEBUG("Packing files");
     if (BackupRestore::PackUserFiles(path) == false) {
         LOG_ERROR("Failed pack backup");
@@ -74,9 +108,153 @@ BackupRestore::CompletionCode BackupRestore::BackupUserFiles(sys::Service *owner
         return CompletionCode::PackError;
     }
 
+    if (WriteManifest(manifest, LastManifestPath()) == false) {
+        LOG_WARN("Failed to save backup manifest, next backup will be full");
+        std::error_code errorCode;
+        std::filesystem::remove(LastManifestPath(), errorCode);
+    }
+
+    status.base = manifest.base;
     return CompletionCode::Success;
 }
 
+bool BackupRestore::PrepareBackupFiles(const std::filesystem::path &path,
+                                       const std::optional<BackupManifest> &baseManifest,
+                                       BackupManifest &manifest)
+{
+    std::error_code errorCode;
+    std::vector<std::filesystem::path> files;
+
+    for (const auto &direntry : std::filesystem::directory_iterator(path, errorCode)) {
+        if (isValidDirentry(direntry) && direntry.path().filename() != bkp::backupInfo) {
+            files.push_back(direntry.path());
+        }
+    }
+
+    if (errorCode) {
+        LOG_ERROR("Can't list contents of %s, error: %d", path.c_str(), errorCode.value());
+        return false;
+    }
+
+    for (const auto &file : files) {
+        const auto fileName = file.filename().string();
+        const BackupManifest::FileInfo info{std::filesystem::file_size(file, errorCode), FileCrc32(file)};
+
+        if (errorCode || info.crc32.empty()) {
+            LOG_ERROR("Can't read %s", fileName.c_str());
+            return false;
+        }
+
+        manifest.files[fileName] = info;
+
+        // the unchanged files are restored from the base backup
+        if (baseManifest.has_value() && baseManifest->IsUnchanged(fileName, info)) {
+            LOG_DEBUG("%s unchanged since %s", fileName.c_str(), baseManifest->taskId.c_str());
+            std::filesystem::remove(file, errorCode);
+            continue;
+        }
+
+        if (!CompressFile(file, file.string() + bkp::compressedExtension) ||
+            !std::filesystem::remove(file, errorCode)) {
+            LOG_ERROR("Can't compress %s", fileName.c_str());
+            return false;
+        }
+    }
+
+    if (baseManifest.has_value()) {
+        manifest.SetBase(*baseManifest);
+    }
+
+    return WriteManifest(manifest, path / bkp::manifest);
+}
+
+std::optional<BackupManifest> BackupRestore::ReadManifest(const std::filesystem::path &path)
+{
+    if (!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+
+    return BackupManifest::FromJson(ReadFileAsString(path));
+}
+
+bool BackupRestore::WriteManifest(const BackupManifest &manifest, const std::filesystem::path &path)
+{
+    std::ofstream file(path);
+    file << json11::Json(manifest).dump();
+    file.close();
+
+    if (!file.good()) {
+        LOG_ERROR("Can't write %s", path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+auto BackupRestore::LastManifestPath() -> std::filesystem::path
+{
+    return purefs::dir::getBackupOSPath() / bkp::lastManifest;
+}
+
+std::string BackupRestore::FileCrc32(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open()) {
+        LOG_ERROR("Can't open %s", path.c_str());
+        return {};
+    }
+
+    auto buffer = std::make_unique<char[]>(purefs::buffer::tar_buf);
+    CRC32 digest;
+
+    while (file.read(buffer.get(), purefs::buffer::tar_buf) || file.gcount() > 0) {
+        digest.add(buffer.get(), file.gcount());
+    }
+
+    return file.eof() ? digest.getHash() : std::string{};
+}
+
+bool BackupRestore::CompressFile(const std::filesystem::path &source, const std::filesystem::path &destination)
+{
+    std::ifstream input(source, std::ios::binary);
+    std::ofstream output(destination, std::ios::binary);
+
+    if (!input.is_open() || !output.is_open()) {
+        LOG_ERROR("Can't open %s for compression", source.c_str());
+        return false;
+    }
+
+    auto buffer = std::make_unique<char[]>(purefs::buffer::tar_buf);
+    Log::LogCompressor compressor{output};
+    compressor.writeFileHeader();
+
+    while (input.read(buffer.get(), purefs::buffer::tar_buf) || input.gcount() > 0) {
+        compressor.write(std::string_view(buffer.get(), input.gcount()));
+    }
+    compressor.flush();
+
+    LOG_DEBUG("%s compressed from %u to %u bytes",
+              source.filename().c_str(),
+              static_cast<unsigned>(compressor.getInputBytes()),
+              static_cast<unsigned>(compressor.getOutputBytes()));
+
+    return input.eof() && output.good();
+}
+
+bool BackupRestore::DecompressFile(const std::filesystem::path &source, const std::filesystem::path &destination)
+{
+    std::ifstream input(source, std::ios::binary);
+    std::ofstream output(destination, std::ios::binary);
+
+    if (!input.is_open() || !output.is_open()) {
+        LOG_ERROR("Can't open %s for decompression", source.c_str());
+        return false;
+    }
+
+    return Log::LogCompressor::decompress(input, output);
+}
+
 bool BackupRestore::WriteBackupInfo(sys::Service *ownerService, const std::filesystem::path &path)
 {
     LOG_INFO("Writing backup info");
@@ -113,6 +291,11 @@ BackupRestore::CompletionCode BackupRestore::RestoreUserFiles(sys::Service *owne
         return CompletionCode::UnpackError;
     }
 
+    if (BackupRestore::PrepareRestoreFiles(TempPathForBackupFile(path)) == false) {
+        LOG_ERROR("Can't prepare user files");
+        return CompletionCode::UnpackError;
+    }
+
     if (BackupRestore::CanRestoreFromBackup(TempPathForBackupFile(path)) == false) {
         LOG_ERROR("Can't restore user files");
         return CompletionCode::FSError;
@@ -130,9 +313,100 @@ BackupRestore::CompletionCode BackupRestore::RestoreUserFiles(sys::Service *owne
         return CompletionCode::CopyError;
     }
 
+    // user files no longer match the last backup
+    std::error_code errorCode;
+    std::filesystem::remove(LastManifestPath(), errorCode);
+
     return CompletionCode::Success;
 }
 
+bool BackupRestore::PrepareRestoreFiles(const std::filesystem::path &extractedBackup)
+{
+    const auto manifestPath = extractedBackup / bkp::manifest;
+
+    if (!std::filesystem::exists(manifestPath)) {
+        LOG_INFO("No backup manifest, restoring uncompressed full backup");
+        return true;
+    }
+
+    const auto manifest = ReadManifest(manifestPath);
+    if (!manifest.has_value()) {
+        return false;
+    }
+
+    // walk the incremental backups down to the full one, the newest version of every file is taken
+    auto baseTaskId = manifest->base;
+    std::error_code errorCode;
+
+    for (auto baseBackups = 0u; !baseTaskId.empty(); ++baseBackups) {
+        const auto baseBackup = purefs::dir::getBackupOSPath() / baseTaskId;
+
+        if (baseBackups == bkp::maxBaseBackups || !std::filesystem::exists(baseBackup)) {
+            LOG_ERROR("Base backup %s not available", baseTaskId.c_str());
+            return false;
+        }
+
+        LOG_INFO("Applying base backup %s", baseTaskId.c_str());
+        if (UnpackBackupFile(baseBackup) == false) {
+            return false;
+        }
+
+        const auto extractedBase = TempPathForBackupFile(baseBackup);
+        const auto baseManifest  = ReadManifest(extractedBase / bkp::manifest);
+
+        if (!baseManifest.has_value()) {
+            LOG_ERROR("Base backup %s has no manifest", baseTaskId.c_str());
+            RemoveBackupDir(extractedBase);
+            return false;
+        }
+
+        for (const auto &[fileName, info] : manifest->files) {
+            const auto compressedFileName = fileName + bkp::compressedExtension;
+            if (std::filesystem::exists(extractedBackup / compressedFileName) ||
+                !std::filesystem::exists(extractedBase / compressedFileName)) {
+                continue;
+            }
+
+            std::filesystem::rename(
+                extractedBase / compressedFileName, extractedBackup / compressedFileName, errorCode);
+            if (errorCode) {
+                LOG_ERROR("Can't move %s, error: %d", fileName.c_str(), errorCode.value());
+                RemoveBackupDir(extractedBase);
+                return false;
+            }
+        }
+
+        baseTaskId = baseManifest->base;
+        RemoveBackupDir(extractedBase);
+    }
+
+    return DecompressBackupFiles(extractedBackup, *manifest);
+}
+
+bool BackupRestore::DecompressBackupFiles(const std::filesystem::path &extractedBackup,
+                                          const BackupManifest &manifest)
+{
+    std::error_code errorCode;
+
+    for (const auto &[fileName, info] : manifest.files) {
+        const auto file           = extractedBackup / fileName;
+        const auto compressedFile = extractedBackup / (fileName + bkp::compressedExtension);
+
+        if (!DecompressFile(compressedFile, file)) {
+            LOG_ERROR("Can't decompress %s", fileName.c_str());
+            return false;
+        }
+        std::filesystem::remove(compressedFile, errorCode);
+
+        if (FileCrc32(file) != info.crc32) {
+            LOG_ERROR("%s CRC32 mismatch", fileName.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool BackupRestore::RemoveBackupDir(const std::filesystem::path &path)
 {
     /* prepare directories */
@@ -519,8 +793,8 @@ bool BackupRestore::ReplaceUserFiles(const std::filesystem::path &path)
             continue;
         }
 
-        // dont restore the information file
-        if (direntry.path().filename() == bkp::backupInfo) {
+        // dont restore the information files
+        if (direntry.path().filename() == bkp::backupInfo || direntry.path().filename() == bkp::manifest) {
             continue;
         }
 
@@ -552,7 +826,7 @@ json11::Json BackupRestore::GetBackupFiles()
             LOG_ERROR("Can't get directory %s contents: %d", purefs::dir::getBackupOSPath().c_str(), errorCode.value());
             return json11::Json();
         }
-        if (!p.is_directory()) {
+        if (!p.is_directory() && p.path().filename() != bkp::lastManifest) {
             LOG_DEBUG("Possible restore file");
             dirEntryVector.push_back(p.path().filename());
         }
@@ -40,6 +40,26 @@ namespace sdesktop
             context.setEndpoint(EndpointType::developerMode);
             context.setResponseBody(json11::Json::object{{json::developerMode::cellularSleepModeInfo, isInSleepMode}});
         }
+
+        CpuStatisticsInfoRequestEvent::CpuStatisticsInfoRequestEvent(std::uint32_t cpuLoad,
+                                                                     const std::vector<sys::TaskLoad> &tasksLoad)
+        {
+            using namespace json::developerMode::cpuStatistics;
+
+            json11::Json::array tasksJson;
+            for (const auto &task : tasksLoad) {
+                tasksJson.emplace_back(json11::Json::object{{name, task.name},
+                                                            {owner, task.owner},
+                                                            {runTime, static_cast<int>(task.runTime)},
+                                                            {permille, static_cast<int>(task.permille)}});
+            }
+
+            context.setResponseStatus(http::Code::OK);
+            context.setEndpoint(EndpointType::developerMode);
+            context.setResponseBody(json11::Json::object{
+                {json::developerMode::cpuStatisticsInfo,
+                 json11::Json::object{{load, static_cast<int>(cpuLoad)}, {tasks, std::move(tasksJson)}}}});
+        }
     } // namespace developerMode
 
     namespace usb
@@ -116,8 +116,7 @@ sys::ReturnCodes ServiceDesktop::InitHandler()
         sdesktop::BackupMessage *backupMessage = dynamic_cast<sdesktop::BackupMessage *>(msg);
         if (backupMessage != nullptr) {
             backupRestoreStatus.state = BackupRestore::OperationState::Running;
-            backupRestoreStatus.completionCode =
-                BackupRestore::BackupUserFiles(this, backupRestoreStatus.backupTempDir);
+            backupRestoreStatus.completionCode = BackupRestore::BackupUserFiles(this, backupRestoreStatus);
             backupRestoreStatus.location = backupRestoreStatus.taskId;
 
             if (backupRestoreStatus.completionCode == BackupRestore::CompletionCode::Success) {
@@ -277,12 +276,14 @@ std::string ServiceDesktop::prepareBackupFilename()
     return std::string(backupFileName.data());
 }
 
-void ServiceDesktop::prepareBackupData()
+void ServiceDesktop::prepareBackupData(bool incremental)
 {
     backupRestoreStatus.operation     = BackupRestore::Operation::Backup;
     backupRestoreStatus.taskId        = prepareBackupFilename();
     backupRestoreStatus.state         = BackupRestore::OperationState::Stopped;
     backupRestoreStatus.backupTempDir = purefs::dir::getTemporaryPath() / backupRestoreStatus.taskId;
+    backupRestoreStatus.incremental   = incremental;
+    backupRestoreStatus.base.clear();
 }
 
 void ServiceDesktop::prepareRestoreData(const std::filesystem::path &restoreLocation)
@@ -291,4 +292,5 @@ void ServiceDesktop::prepareRestoreData(const std::filesystem::path &restoreLoca
     backupRestoreStatus.taskId    = restoreLocation.filename();
     backupRestoreStatus.state     = BackupRestore::OperationState::Stopped;
     backupRestoreStatus.location  = purefs::dir::getBackupOSPath() / backupRestoreStatus.taskId;
+    backupRestoreStatus.base.clear();
 }
@@ -102,10 +102,15 @@ bool WorkerDesktop::handleMessage(uint32_t queueID)
         }
 
         using namespace sdesktop::endpoints;
-        auto factory = EndpointFactory::create(securityModel.getEndpointSecurity());
-        auto handler = std::make_unique<MessageHandler>(ownerService, std::move(factory));
+        const auto endpointSecurity = securityModel.getEndpointSecurity();
+        if (parserSecurity != endpointSecurity) {
+            auto factory = EndpointFactory::create(endpointSecurity);
+            auto handler = std::make_unique<MessageHandler>(ownerService, std::move(factory));
+
+            parser.setMessageHandler(std::move(handler));
+            parserSecurity = endpointSecurity;
+        }
 
-        parser.setMessageHandler(std::move(handler));
         parser.processMessage(std::move(*receivedMsg));
 
         delete receivedMsg;
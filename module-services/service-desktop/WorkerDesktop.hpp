@@ -15,6 +15,7 @@
 
 #include <filesystem>
 #include <atomic>
+#include <optional>
 
 namespace constants
 {
@@ -50,6 +51,8 @@ class WorkerDesktop : public sys::Worker
     const std::string serialNumber;
     sys::Service *ownerService = nullptr;
     sdesktop::endpoints::StateMachine parser;
+    /// the message handler is recreated only when the endpoint security changes
+    std::optional<sdesktop::endpoints::EndpointSecurity> parserSecurity;
     sys::TimerHandle usbSuspendTimer;
     bsp::USBDeviceStatus usbStatus = bsp::USBDeviceStatus::Disconnected;
 
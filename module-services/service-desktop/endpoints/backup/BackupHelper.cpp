@@ -38,8 +38,8 @@ namespace sdesktop::endpoints
         }
         else {
             LOG_DEBUG("Starting backup");
-            // initialize new backup information
-            ownerServicePtr->prepareBackupData();
+            // initialize new backup information, incremental backups contain only the files changed since the last one
+            ownerServicePtr->prepareBackupData(context.getBody()[json::incremental].bool_value());
 
             // start the backup process in the background
             ownerServicePtr->bus.sendUnicast(std::make_shared<sdesktop::BackupMessage>(),
@@ -28,6 +28,13 @@
 
 #include <ctime>
 #include <locks/data/PhoneLockMessages.hpp>
+#include <purefs/vfs_subsystem.hpp>
+
+#if USE_TLSF_HEAP
+#include <memory/heapstats.h>
+#include <array>
+#endif
+
 namespace
 {
 
@@ -38,6 +45,75 @@ namespace
         return state == tetheringOn ? sys::phone_modes::Tethering::On : sys::phone_modes::Tethering::Off;
     }
 
+#if USE_TLSF_HEAP
+    auto toJson(heap_id_t heap) -> json11::Json
+    {
+        using namespace sdesktop::endpoints::json::developerMode::heapStats;
+
+        tlsf_stats_t stats{};
+        if (heap_get_stats(heap, &stats) != 0) {
+            return json11::Json();
+        }
+
+        std::array<heap_owner_info_t, TLSF_MAX_OWNERS> ownersInfo{};
+        const auto ownersCount = heap_get_owners_stats(heap, ownersInfo.data(), ownersInfo.size());
+        json11::Json::array ownersJson;
+        for (std::size_t i = 0; i < ownersCount; ++i) {
+            ownersJson.emplace_back(json11::Json::object{
+                {name, ownersInfo[i].name},
+                {usedBytes, static_cast<int>(ownersInfo[i].stats.usedBytes)},
+                {peakUsedBytes, static_cast<int>(ownersInfo[i].stats.peakUsedBytes)},
+                {usedBlocks, static_cast<int>(ownersInfo[i].stats.usedBlocks)}});
+        }
+
+        return json11::Json::object{{totalBytes, static_cast<int>(stats.totalBytes)},
+                                    {usedBytes, static_cast<int>(stats.usedBytes)},
+                                    {peakUsedBytes, static_cast<int>(stats.peakUsedBytes)},
+                                    {freeBytes, static_cast<int>(stats.freeBytes)},
+                                    {largestFreeBlock, static_cast<int>(stats.largestFreeBlock)},
+                                    {usedBlocks, static_cast<int>(stats.usedBlocks)},
+                                    {freeBlocks, static_cast<int>(stats.freeBlocks)},
+                                    {failedAllocations, static_cast<int>(stats.failedAllocations)},
+                                    {owners, std::move(ownersJson)}};
+    }
+#endif
+
+    auto toJson(const purefs::io_op_stats &stats) -> json11::Json
+    {
+        using namespace sdesktop::endpoints::json::developerMode::ioStats;
+
+        json11::Json::array histogramJson;
+        for (const auto count : stats.histogram) {
+            histogramJson.emplace_back(static_cast<int>(count));
+        }
+        return json11::Json::object{{calls, static_cast<int>(stats.calls)},
+                                    {errors, static_cast<int>(stats.errors)},
+                                    {bytes, static_cast<double>(stats.bytes)},
+                                    {totalUs, static_cast<double>(stats.total_us)},
+                                    {maxUs, static_cast<int>(stats.max_us)},
+                                    {p50Us, static_cast<int>(stats.percentile_us(50))},
+                                    {p99Us, static_cast<int>(stats.percentile_us(99))},
+                                    {histogram, std::move(histogramJson)}};
+    }
+
+    auto toJson(const std::vector<purefs::io_stats_entry> &entries) -> json11::Json
+    {
+        using namespace sdesktop::endpoints::json::developerMode::ioStats;
+
+        json11::Json::array entriesJson;
+        for (const auto &entry : entries) {
+            json11::Json::object opsJson;
+            for (std::size_t op = 0; op < purefs::io_op_count; ++op) {
+                if (entry.ops[op].calls > 0) {
+                    opsJson[std::string(purefs::io_op_name(static_cast<purefs::io_op>(op)))] = toJson(entry.ops[op]);
+                }
+            }
+            entriesJson.emplace_back(json11::Json::object{
+                {source, entry.source}, {driver, entry.driver}, {task, entry.task}, {ops, std::move(opsJson)}});
+        }
+        return entriesJson;
+    }
+
 } // namespace
 
 namespace sdesktop::endpoints
@@ -143,6 +219,11 @@ namespace sdesktop::endpoints
                        ? http::Code::NoContent
                        : http::Code::InternalServerError;
         }
+        else if (body[json::developerMode::resetIoStats].bool_value()) {
+            purefs::subsystem::vfs_core()->reset_io_statistics();
+            purefs::subsystem::disk_mgr()->reset_io_statistics();
+            code = http::Code::NoContent;
+        }
 
         else {
             context.setResponseStatus(http::Code::BadRequest);
@@ -181,6 +262,34 @@ namespace sdesktop::endpoints
                     return {sent::delayed, std::nullopt};
                 }
             }
+            else if (keyValue == json::developerMode::cpuStatisticsInfo) {
+                if (!requestCpuStatisticsInfo(owner)) {
+                    return {sent::no, ResponseContext{.status = http::Code::NotAcceptable}};
+                }
+                else {
+                    return {sent::delayed, std::nullopt};
+                }
+            }
+            else if (keyValue == json::developerMode::heapStatsInfo) {
+#if USE_TLSF_HEAP
+                auto response = ResponseContext{
+                    .body = json11::Json::object({{json::developerMode::heapStats::system, toJson(HeapSystem)},
+                                                  {json::developerMode::heapStats::user, toJson(HeapUser)}})};
+                response.status = http::Code::OK;
+                return {sent::no, std::move(response)};
+#else
+                return {sent::no, ResponseContext{.status = http::Code::NotAcceptable}};
+#endif
+            }
+            else if (keyValue == json::developerMode::ioStatsInfo) {
+                auto response = ResponseContext{
+                    .body = json11::Json::object(
+                        {{json::developerMode::ioStats::vfs, toJson(purefs::subsystem::vfs_core()->io_statistics())},
+                         {json::developerMode::ioStats::blkdev,
+                          toJson(purefs::subsystem::disk_mgr()->io_statistics())}})};
+                response.status = http::Code::OK;
+                return {sent::no, std::move(response)};
+            }
             else {
                 return {sent::no, ResponseContext{.status = http::Code::BadRequest}};
             }
@@ -337,4 +446,11 @@ namespace sdesktop::endpoints
         return serv->bus.sendUnicast(std::move(msg), ServiceCellular::serviceName);
     }
 
+    bool DeveloperModeHelper::requestCpuStatisticsInfo(sys::Service *serv)
+    {
+        auto event = std::make_unique<sdesktop::developerMode::CpuStatisticsInfoRequestEvent>();
+        auto msg   = std::make_shared<sdesktop::developerMode::DeveloperModeRequest>(std::move(event));
+        return serv->bus.sendUnicast(std::move(msg), service::name::system_manager);
+    }
+
 } // namespace sdesktop::endpoints
@@ -6,6 +6,7 @@
 #include <service-desktop/DesktopMessages.hpp>
 #include <service-desktop/ServiceDesktop.hpp>
 #include <endpoints/JsonKeyNames.hpp>
+#include <endpoints/message/Common.hpp>
 #include <endpoints/message/Sender.hpp>
 #include <purefs/filesystem_paths.hpp>
 
@@ -25,6 +26,9 @@ namespace sdesktop::endpoints
         if (body[json::fs::fileName].is_string()) {
             response = startGetFile(context);
         }
+        else if (body[json::fs::rxID].is_number() && fileOps.isBinaryReceiveID(body[json::fs::rxID].int_value())) {
+            return getRawFileChunk(context);
+        }
         else if (body[json::fs::rxID].is_number()) {
             response = getFileChunk(context);
         }
@@ -47,8 +51,11 @@ namespace sdesktop::endpoints
         auto code        = http::Code::BadRequest;
         ResponseContext response{};
 
-        if (body[json::fs::fileName].is_string() && body[json::fs::fileSize].is_number() &&
-            body[json::fs::fileCrc32].is_string()) {
+        if (!context.getRawData().empty()) {
+            response = sendRawFileChunk(context);
+        }
+        else if (body[json::fs::fileName].is_string() && body[json::fs::fileSize].is_number() &&
+                 body[json::fs::fileCrc32].is_string()) {
             response = startSendFile(context);
         }
         else if (body[json::fs::txID].is_number() && body[json::fs::chunkNo].is_number() &&
@@ -104,6 +111,7 @@ namespace sdesktop::endpoints
     auto FS_Helper::startGetFile(Context &context) const -> ResponseContext
     {
         const std::filesystem::path filePath = context.getBody()[json::fs::fileName].string_value();
+        const auto binary                    = context.getBody()[json::fs::binary].bool_value();
 
         try {
             requestLogsFlush();
@@ -128,12 +136,17 @@ namespace sdesktop::endpoints
         LOG_DEBUG("Checking file");
 
         try {
-            auto [rxID, fileSize] = fileOps.createReceiveIDForFile(filePath);
+            auto [rxID, fileSize] = fileOps.createReceiveIDForFile(filePath, binary);
 
             code     = http::Code::OK;
             response = json11::Json::object({{json::fs::rxID, static_cast<int>(rxID)},
                                              {json::fs::fileSize, static_cast<int>(fileSize)},
                                              {json::fs::chunkSize, static_cast<int>(FileOperations::ChunkSize)}});
+            if (binary) {
+                response[json::fs::binary]    = true;
+                response[json::fs::chunkSize] = static_cast<int>(FileOperations::BinaryChunkSize);
+                response[json::fs::window]    = static_cast<int>(FileOperations::BinaryChunksInFlight);
+            }
         }
         catch (std::runtime_error &e) {
             LOG_ERROR("FileOperations exception: %s", e.what());
@@ -192,12 +205,46 @@ namespace sdesktop::endpoints
         return ResponseContext{.status = code, .body = response};
     }
 
+    auto FS_Helper::getRawFileChunk(Context &context) const -> ProcessResult
+    {
+        const auto rxID    = context.getBody()[json::fs::rxID].int_value();
+        const auto chunkNo = context.getBody()[json::fs::chunkNo].int_value();
+        FileOperations::BinaryData binaryData;
+
+        try {
+            binaryData = fileOps.getBinaryDataForReceiveID(rxID, chunkNo);
+        }
+        catch (std::exception &e) {
+            LOG_ERROR("%s", e.what());
+
+            json11::Json::object response({{json::reason, e.what()}});
+            return {sent::no, ResponseContext{.status = http::Code::BadRequest, .body = response}};
+        }
+
+        if (binaryData.data.empty()) {
+            std::ostringstream errorReason;
+            errorReason << "Invalid request rxID: " << std::to_string(rxID) << ", chunkNo: " << std::to_string(chunkNo);
+            LOG_ERROR("%s", errorReason.str().c_str());
+
+            json11::Json::object response({{json::reason, errorReason.str()}});
+            return {sent::no, ResponseContext{.status = http::Code::BadRequest, .body = response}};
+        }
+
+        const message::RawDataHeader header{static_cast<std::uint32_t>(rxID),
+                                            static_cast<std::uint32_t>(chunkNo),
+                                            binaryData.crc32};
+        putToSendQueue(message::buildRawResponse(header, binaryData.data.data(), binaryData.data.size()));
+
+        return {sent::yes, std::nullopt};
+    }
+
     auto FS_Helper::startSendFile(Context &context) const -> ResponseContext
     {
         const auto &body               = context.getBody();
         std::filesystem::path filePath = body[json::fs::fileName].string_value();
         const uint32_t fileSize        = body[json::fs::fileSize].int_value();
         const auto fileCrc32           = body[json::fs::fileCrc32].string_value();
+        const auto binary              = body[json::fs::binary].bool_value();
         auto code                      = http::Code::BadRequest;
 
         LOG_DEBUG("Start sending of file: %s", filePath.c_str());
@@ -220,11 +267,16 @@ namespace sdesktop::endpoints
         json11::Json::object response{};
 
         try {
-            auto txID = fileOps.createTransmitIDForFile(filePath, fileSize, fileCrc32);
+            auto txID = fileOps.createTransmitIDForFile(filePath, fileSize, fileCrc32, binary);
 
             code     = http::Code::OK;
             response = json11::Json::object({{json::fs::txID, static_cast<int>(txID)},
                                              {json::fs::chunkSize, static_cast<int>(FileOperations::ChunkSize)}});
+            if (binary) {
+                response[json::fs::binary]    = true;
+                response[json::fs::chunkSize] = static_cast<int>(FileOperations::BinaryChunkSize);
+                response[json::fs::window]    = static_cast<int>(FileOperations::BinaryChunksInFlight);
+            }
         }
         catch (std::runtime_error &e) {
             LOG_ERROR("FileOperations exception: %s", e.what());
@@ -294,6 +346,48 @@ namespace sdesktop::endpoints
         return ResponseContext{.status = code, .body = response};
     }
 
+    auto FS_Helper::sendRawFileChunk(Context &context) const -> ResponseContext
+    {
+        const auto &payload = context.getRawData();
+        const auto header   = message::getRawDataHeader(payload);
+
+        if (!header.has_value()) {
+            LOG_ERROR("Invalid raw data frame");
+            return ResponseContext{.status = http::Code::BadRequest};
+        }
+
+        const auto txID    = static_cast<int>(header->transferID);
+        const auto chunkNo = static_cast<int>(header->chunkNo);
+        auto returnCode    = sys::ReturnCodes::Success;
+
+        try {
+            returnCode = fileOps.sendBinaryDataForTransmitID(
+                header->transferID,
+                header->chunkNo,
+                header->crc32,
+                reinterpret_cast<const std::uint8_t *>(payload.data()) + message::size_raw_data_header,
+                payload.size() - message::size_raw_data_header);
+        }
+        catch (std::exception &e) {
+            LOG_ERROR("%s", e.what());
+
+            auto code     = http::Code::NotAcceptable;
+            auto response = json11::Json::object({{json::reason, e.what()}});
+
+            return ResponseContext{.status = code, .body = response};
+        }
+
+        auto code = http::Code::OK;
+
+        if (returnCode != sys::ReturnCodes::Success) {
+            LOG_ERROR("FileOperations::sendBinaryDataForTransmitID failed");
+            code = http::Code::BadRequest;
+        }
+
+        auto response = json11::Json::object({{json::fs::txID, txID}, {json::fs::chunkNo, chunkNo}});
+        return ResponseContext{.status = code, .body = response};
+    }
+
     auto FS_Helper::requestFileRemoval(const std::string &fileName) -> bool
     {
         return std::filesystem::remove(fileName);
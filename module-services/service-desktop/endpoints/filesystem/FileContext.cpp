@@ -3,6 +3,7 @@
 
 #include <endpoints/filesystem/FileContext.hpp>
 #include <log/log.hpp>
+#include <algorithm>
 #include <utility>
 #include <fstream>
 
@@ -79,20 +80,41 @@ auto FileContext::fileHash() const -> std::string
     return runningCrc32Digest.getHash();
 }
 
+auto FileContext::runningCrc32() const -> std::uint32_t
+{
+    return static_cast<std::uint32_t>(std::stoul(fileHash(), nullptr, 16));
+}
+
+auto FileContext::nextChunkSize() const -> std::size_t
+{
+    return std::min(chunkSize, size - std::min(offset, size));
+}
+
+auto FileContext::setBinaryTransfer(bool binary) -> void
+{
+    binaryTransfer = binary;
+}
+
+auto FileContext::isBinaryTransfer() const -> bool
+{
+    return binaryTransfer;
+}
+
 auto FileReadContext::read() -> std::vector<std::uint8_t>
 {
     LOG_DEBUG("Getting file data");
 
-    std::ifstream file(path, std::ios::binary);
-
-    if (!file.is_open() || file.fail()) {
-        LOG_ERROR("File %s open error", path.c_str());
-        throw std::runtime_error("File open error");
+    // the file is kept open for the whole transfer
+    if (!file.is_open()) {
+        file.open(path, std::ios::binary);
+        if (!file.is_open() || file.fail()) {
+            LOG_ERROR("File %s open error", path.c_str());
+            throw std::runtime_error("File open error");
+        }
+        file.seekg(offset);
     }
 
-    file.seekg(offset);
-
-    auto dataLeft = std::min(static_cast<std::size_t>(chunkSize), (size - offset));
+    auto dataLeft = nextChunkSize();
 
     std::vector<std::uint8_t> buffer(dataLeft);
 
@@ -109,6 +131,7 @@ auto FileReadContext::read() -> std::vector<std::uint8_t>
     advanceFileOffset(dataLeft);
 
     if (reachedEOF()) {
+        file.close();
         LOG_INFO("Reached EOF");
     }
 
@@ -117,34 +140,41 @@ auto FileReadContext::read() -> std::vector<std::uint8_t>
 
 auto FileWriteContext::write(const std::vector<std::uint8_t> &data) -> void
 {
-    LOG_DEBUG("Sending file data");
+    write(data.data(), data.size());
+}
 
-    std::ofstream file(path, std::ios::binary | std::ios::app);
+auto FileWriteContext::write(const std::uint8_t *data, std::size_t dataSize) -> void
+{
+    LOG_DEBUG("Sending file data");
 
-    if (!file.is_open() || file.fail()) {
-        LOG_ERROR("File %s open error", path.c_str());
-        throw std::runtime_error("File open error");
+    // the file is kept open for the whole transfer
+    if (!file.is_open()) {
+        const auto mode = offset == 0 ? std::ios::trunc : std::ios::in;
+        file.open(path, std::ios::binary | std::ios::out | mode);
+        if (!file.is_open() || file.fail()) {
+            LOG_ERROR("File %s open error", path.c_str());
+            throw std::runtime_error("File open error");
+        }
+        file.seekp(offset);
     }
 
-    file.seekp(offset);
-
-    auto dataLeft = std::min(static_cast<std::size_t>(chunkSize), (size - offset));
+    auto dataLeft = std::min(dataSize, nextChunkSize());
 
-    file.write(reinterpret_cast<const char *>(data.data()), dataLeft);
-    file.flush();
+    file.write(reinterpret_cast<const char *>(data), dataLeft);
 
     if (file.bad()) {
         LOG_ERROR("File %s write error", path.c_str());
         throw std::runtime_error("File write error");
     }
 
-    runningCrc32Digest.add(data.data(), dataLeft);
+    runningCrc32Digest.add(data, dataLeft);
 
     LOG_DEBUG("Written %u bytes", static_cast<unsigned int>(dataLeft));
 
     advanceFileOffset(dataLeft);
 
     if (reachedEOF()) {
+        file.close();
         LOG_INFO("Reached EOF of %s", path.c_str());
     }
 }
@@ -157,6 +187,7 @@ auto FileWriteContext::crc32Matches() const -> bool
 
 auto FileWriteContext::removeFile() -> void
 {
+    file.close();
     std::error_code ec;
     std::filesystem::remove(path, ec);
 }
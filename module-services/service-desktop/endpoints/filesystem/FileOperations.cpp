@@ -11,7 +11,8 @@ FileOperations &FileOperations::instance()
     return instance;
 }
 
-auto FileOperations::createReceiveIDForFile(const std::filesystem::path &file) -> std::pair<transfer_id, std::size_t>
+auto FileOperations::createReceiveIDForFile(const std::filesystem::path &file, bool binary)
+    -> std::pair<transfer_id, std::size_t>
 {
     cancelTimedOutReadTransfer();
     const auto rxID = ++runningRxId;
@@ -24,7 +25,7 @@ auto FileOperations::createReceiveIDForFile(const std::filesystem::path &file) -
 
     LOG_DEBUG("Creating rxID %u", static_cast<unsigned>(rxID));
 
-    createFileReadContextFor(file, size, rxID);
+    createFileReadContextFor(file, size, rxID, binary);
 
     return std::make_pair(rxID, size);
 }
@@ -73,19 +74,25 @@ void FileOperations::cancelTimedOutWriteTransfer()
 
 auto FileOperations::createFileReadContextFor(const std::filesystem::path &file,
                                               std::size_t fileSize,
-                                              transfer_id xfrId) -> void
+                                              transfer_id xfrId,
+                                              bool binary) -> void
 {
-    readTransfers.insert(
-        std::make_pair(xfrId, std::make_unique<FileReadContext>(file, fileSize, FileOperations::ChunkSize)));
+    const auto chunkSize = binary ? FileOperations::BinaryChunkSize : FileOperations::ChunkSize;
+    auto fileCtx         = std::make_unique<FileReadContext>(file, fileSize, chunkSize);
+    fileCtx->setBinaryTransfer(binary);
+    readTransfers.insert(std::make_pair(xfrId, std::move(fileCtx)));
 }
 
 auto FileOperations::createFileWriteContextFor(const std::filesystem::path &file,
                                                std::size_t fileSize,
                                                const std::string &Crc32,
-                                               transfer_id xfrId) -> void
+                                               transfer_id xfrId,
+                                               bool binary) -> void
 {
-    writeTransfers.insert(
-        std::make_pair(xfrId, std::make_unique<FileWriteContext>(file, fileSize, FileOperations::ChunkSize, Crc32)));
+    const auto chunkSize = binary ? FileOperations::BinaryChunkSize : FileOperations::ChunkSize;
+    auto fileCtx         = std::make_unique<FileWriteContext>(file, fileSize, chunkSize, Crc32);
+    fileCtx->setBinaryTransfer(binary);
+    writeTransfers.insert(std::make_pair(xfrId, std::move(fileCtx)));
 }
 
 auto FileOperations::encodedSize(std::size_t binarySize) const -> std::size_t
@@ -126,27 +133,38 @@ auto FileOperations::decodeDataFromBase64(const std::string &encodedData) const
     return decodedData;
 }
 
-auto FileOperations::getDataForReceiveID(transfer_id rxID, std::uint32_t chunkNo) -> DataWithCrc32
+auto FileOperations::getReadContext(transfer_id rxID, std::uint32_t chunkNo) -> FileReadContext *
 {
-    LOG_DEBUG("Getting chunk %u for rxID %u", static_cast<unsigned>(chunkNo), static_cast<unsigned>(rxID));
-
     const auto fileCtxEntry = readTransfers.find(rxID);
-    std::string fileCrc32   = {};
 
     if (fileCtxEntry == readTransfers.end()) {
         LOG_ERROR("Invalid rxID %u", static_cast<unsigned>(rxID));
-        return {};
+        return nullptr;
     }
 
     auto fileCtx = fileCtxEntry->second.get();
 
     if (!fileCtx) {
         LOG_ERROR("Invalid fileCtx for rxID %u", static_cast<unsigned>(rxID));
-        return {};
+        return nullptr;
     }
 
     if (!fileCtx->validateChunkRequest(chunkNo)) {
         LOG_ERROR("Invalid chunkNo %u", static_cast<unsigned>(chunkNo));
+        return nullptr;
+    }
+
+    return fileCtx;
+}
+
+auto FileOperations::getDataForReceiveID(transfer_id rxID, std::uint32_t chunkNo) -> DataWithCrc32
+{
+    LOG_DEBUG("Getting chunk %u for rxID %u", static_cast<unsigned>(chunkNo), static_cast<unsigned>(rxID));
+
+    auto fileCtx          = getReadContext(rxID, chunkNo);
+    std::string fileCrc32 = {};
+
+    if (!fileCtx) {
         return {};
     }
 
@@ -160,48 +178,106 @@ auto FileOperations::getDataForReceiveID(transfer_id rxID, std::uint32_t chunkNo
     if (fileCtx->reachedEOF()) {
         LOG_INFO("Reached EOF for rxID %u", static_cast<unsigned>(rxID));
         fileCrc32 = fileCtx->fileHash();
-        writeTransfers.erase(rxID);
+        readTransfers.erase(rxID);
     }
 
     return {std::move(encodeDataAsBase64(data)), std::move(fileCrc32)};
 }
 
+auto FileOperations::getBinaryDataForReceiveID(transfer_id rxID, std::uint32_t chunkNo) -> BinaryData
+{
+    LOG_DEBUG("Getting binary chunk %u for rxID %u", static_cast<unsigned>(chunkNo), static_cast<unsigned>(rxID));
+
+    auto fileCtx = getReadContext(rxID, chunkNo);
+
+    if (!fileCtx) {
+        return {};
+    }
+
+    auto data        = fileCtx->read();
+    const auto crc32 = fileCtx->runningCrc32();
+
+    if (fileCtx->reachedEOF()) {
+        LOG_INFO("Reached EOF for rxID %u", static_cast<unsigned>(rxID));
+        readTransfers.erase(rxID);
+    }
+
+    return {std::move(data), crc32};
+}
+
+auto FileOperations::isBinaryReceiveID(transfer_id rxID) const -> bool
+{
+    const auto fileCtxEntry = readTransfers.find(rxID);
+    return fileCtxEntry != readTransfers.end() && fileCtxEntry->second && fileCtxEntry->second->isBinaryTransfer();
+}
+
 auto FileOperations::createTransmitIDForFile(const std::filesystem::path &file,
                                              std::size_t size,
-                                             const std::string &Crc32) -> transfer_id
+                                             const std::string &Crc32,
+                                             bool binary) -> transfer_id
 {
     cancelTimedOutWriteTransfer();
     const auto txID = ++runningTxId;
 
     LOG_DEBUG("Creating txID %u", static_cast<unsigned>(txID));
 
-    createFileWriteContextFor(file, size, Crc32, txID);
+    createFileWriteContextFor(file, size, Crc32, txID, binary);
 
     return txID;
 }
 
-auto FileOperations::sendDataForTransmitID(transfer_id txID, std::uint32_t chunkNo, const std::string &data)
-    -> sys::ReturnCodes
+auto FileOperations::getWriteContext(transfer_id txID, std::uint32_t chunkNo) -> FileWriteContext *
 {
-    LOG_DEBUG("Transmitting chunk %u for txID %u", static_cast<unsigned>(chunkNo), static_cast<unsigned>(txID));
-    auto returnCode = sys::ReturnCodes::Success;
-
     const auto fileCtxEntry = writeTransfers.find(txID);
 
     if (fileCtxEntry == writeTransfers.end()) {
         LOG_ERROR("Invalid txID %u", static_cast<unsigned>(txID));
-        return sys::ReturnCodes::Failure;
+        return nullptr;
     }
 
     auto fileCtx = fileCtxEntry->second.get();
 
     if (!fileCtx) {
         LOG_ERROR("Invalid fileCtx for txID %u", static_cast<unsigned>(txID));
-        return sys::ReturnCodes::Failure;
+        return nullptr;
     }
 
     if (!fileCtx->validateChunkRequest(chunkNo)) {
         LOG_ERROR("Invalid chunkNo %u", static_cast<unsigned>(chunkNo));
+        return nullptr;
+    }
+
+    return fileCtx;
+}
+
+auto FileOperations::finishWriteTransfer(transfer_id txID, FileWriteContext *fileCtx) -> void
+{
+    if (!fileCtx->reachedEOF()) {
+        return;
+    }
+
+    LOG_INFO("Reached EOF for txID %u", static_cast<unsigned>(txID));
+
+    auto fileOK = fileCtx->crc32Matches();
+
+    if (!fileOK) {
+        LOG_ERROR("File CRC32 mismatch");
+        fileCtx->removeFile();
+        writeTransfers.erase(txID);
+
+        throw std::runtime_error("File CRC32 mismatch");
+    }
+    writeTransfers.erase(txID);
+}
+
+auto FileOperations::sendDataForTransmitID(transfer_id txID, std::uint32_t chunkNo, const std::string &data)
+    -> sys::ReturnCodes
+{
+    LOG_DEBUG("Transmitting chunk %u for txID %u", static_cast<unsigned>(chunkNo), static_cast<unsigned>(txID));
+
+    auto fileCtx = getWriteContext(txID, chunkNo);
+
+    if (!fileCtx) {
         return sys::ReturnCodes::Failure;
     }
 
@@ -209,20 +285,42 @@ auto FileOperations::sendDataForTransmitID(transfer_id txID, std::uint32_t chunk
 
     fileCtx->write(binaryData);
 
-    if (fileCtx->reachedEOF()) {
-        LOG_INFO("Reached EOF for txID %u", static_cast<unsigned>(txID));
+    finishWriteTransfer(txID, fileCtx);
+
+    return sys::ReturnCodes::Success;
+}
+
+auto FileOperations::sendBinaryDataForTransmitID(transfer_id txID,
+                                                 std::uint32_t chunkNo,
+                                                 std::uint32_t crc32,
+                                                 const std::uint8_t *data,
+                                                 std::size_t dataSize) -> sys::ReturnCodes
+{
+    LOG_DEBUG("Transmitting binary chunk %u for txID %u", static_cast<unsigned>(chunkNo), static_cast<unsigned>(txID));
 
-        auto fileOK = fileCtx->crc32Matches();
+    auto fileCtx = getWriteContext(txID, chunkNo);
 
-        if (!fileOK) {
-            LOG_ERROR("File CRC32 mismatch");
-            fileCtx->removeFile();
-            writeTransfers.erase(txID);
+    if (!fileCtx || !fileCtx->isBinaryTransfer()) {
+        return sys::ReturnCodes::Failure;
+    }
 
-            throw std::runtime_error("File CRC32 mismatch");
-        }
+    if (dataSize != fileCtx->nextChunkSize()) {
+        LOG_ERROR("Invalid chunk size %u", static_cast<unsigned>(dataSize));
+        return sys::ReturnCodes::Failure;
+    }
+
+    fileCtx->write(data, dataSize);
+
+    // the running CRC32 detects corrupted transfers without waiting for the end of the file
+    if (fileCtx->runningCrc32() != crc32) {
+        LOG_ERROR("Chunk %u CRC32 mismatch", static_cast<unsigned>(chunkNo));
+        fileCtx->removeFile();
         writeTransfers.erase(txID);
+
+        throw std::runtime_error("Chunk CRC32 mismatch");
     }
 
-    return returnCode;
+    finishWriteTransfer(txID, fileCtx);
+
+    return sys::ReturnCodes::Success;
 }
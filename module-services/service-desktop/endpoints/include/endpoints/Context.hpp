@@ -41,6 +41,7 @@ namespace sdesktop::endpoints
         int uuid;
         http::Method method;
         ResponseContext responseContext;
+        std::string rawData;
 
         auto validate() -> void
         {
@@ -119,6 +120,15 @@ namespace sdesktop::endpoints
         {
             return method;
         }
+        auto setRawData(std::string &&data)
+        {
+            rawData = std::move(data);
+        }
+        /// Payload of the raw data frame, empty for the endpoint messages
+        auto getRawData() -> const std::string &
+        {
+            return rawData;
+        }
     };
 
     class PagedContext : public Context
@@ -49,6 +49,8 @@ namespace sdesktop::endpoints::json
     inline constexpr auto fileList            = "fileList";
     inline constexpr auto files               = "files";
     inline constexpr auto backupLocation      = "backupLocation";
+    inline constexpr auto incremental         = "incremental";
+    inline constexpr auto base                = "base";
 
     namespace updateprocess
     {
@@ -21,6 +21,7 @@ namespace sdesktop::endpoints
         bool requestCellularPowerStateChange(int simSelected);
         bool requestServiceStateInfo(sys::Service *serv);
         bool requestCellularSleepModeInfo(sys::Service *serv);
+        bool requestCpuStatisticsInfo(sys::Service *serv);
         auto prepareSMS(Context &context) -> ProcessResult;
 
       public:
@@ -50,6 +51,7 @@ namespace sdesktop::endpoints
         inline constexpr auto switchApplication      = "switchApplication";
         inline constexpr auto switchWindow           = "switchWindow";
         inline constexpr auto phoneLockCodeEnabled   = "phoneLockCodeEnabled";
+        inline constexpr auto resetIoStats           = "resetIoStats";
 
         namespace switchData
         {
@@ -61,6 +63,56 @@ namespace sdesktop::endpoints
         inline constexpr auto simStateInfo          = "simState";
         inline constexpr auto cellularStateInfo     = "cellularState";
         inline constexpr auto cellularSleepModeInfo = "cellularSleepMode";
+        inline constexpr auto heapStatsInfo         = "heapStats";
+        inline constexpr auto cpuStatisticsInfo     = "cpuStatistics";
+        inline constexpr auto ioStatsInfo           = "ioStats";
+
+        /// keys of cpuStatistics response
+        namespace cpuStatistics
+        {
+            inline constexpr auto load     = "load";
+            inline constexpr auto tasks    = "tasks";
+            inline constexpr auto name     = "name";
+            inline constexpr auto owner    = "owner";
+            inline constexpr auto runTime  = "runTime";
+            inline constexpr auto permille = "permille";
+        } // namespace cpuStatistics
+
+        /// keys of heapStats response
+        namespace heapStats
+        {
+            inline constexpr auto system            = "system";
+            inline constexpr auto user              = "user";
+            inline constexpr auto totalBytes        = "totalBytes";
+            inline constexpr auto usedBytes         = "usedBytes";
+            inline constexpr auto peakUsedBytes     = "peakUsedBytes";
+            inline constexpr auto freeBytes         = "freeBytes";
+            inline constexpr auto largestFreeBlock  = "largestFreeBlock";
+            inline constexpr auto usedBlocks        = "usedBlocks";
+            inline constexpr auto freeBlocks        = "freeBlocks";
+            inline constexpr auto failedAllocations = "failedAllocations";
+            inline constexpr auto owners            = "owners";
+            inline constexpr auto name              = "name";
+        } // namespace heapStats
+
+        /// keys of ioStats response
+        namespace ioStats
+        {
+            inline constexpr auto vfs       = "vfs";
+            inline constexpr auto blkdev    = "blkdev";
+            inline constexpr auto source    = "source";
+            inline constexpr auto driver    = "driver";
+            inline constexpr auto task      = "task";
+            inline constexpr auto ops       = "ops";
+            inline constexpr auto calls     = "calls";
+            inline constexpr auto errors    = "errors";
+            inline constexpr auto bytes     = "bytes";
+            inline constexpr auto totalUs   = "totalUs";
+            inline constexpr auto maxUs     = "maxUs";
+            inline constexpr auto p50Us     = "p50Us";
+            inline constexpr auto p99Us     = "p99Us";
+            inline constexpr auto histogram = "histogram";
+        } // namespace ioStats
 
         /// values for smsCommand
         inline constexpr auto smsAdd = "smsAdd";
@@ -23,6 +23,8 @@ namespace sdesktop::endpoints
         inline constexpr auto data         = "data";
         inline constexpr auto rxID         = "rxID";
         inline constexpr auto txID         = "txID";
+        inline constexpr auto binary       = "binary";
+        inline constexpr auto window       = "window";
 
         inline constexpr auto fileDoesNotExist = "file does not exist";
     } // namespace json::fs
@@ -40,9 +42,11 @@ namespace sdesktop::endpoints
       private:
         auto startGetFile(Context &context) const -> ResponseContext;
         auto getFileChunk(Context &context) const -> ResponseContext;
+        auto getRawFileChunk(Context &context) const -> ProcessResult;
 
         auto startSendFile(Context &context) const -> ResponseContext;
         auto sendFileChunk(Context &context) const -> ResponseContext;
+        auto sendRawFileChunk(Context &context) const -> ResponseContext;
 
         auto requestFileRemoval(const std::string &fileName) -> bool;
         auto requestFileRename(const std::string &fileName, const std::string &destFileName) noexcept -> bool;
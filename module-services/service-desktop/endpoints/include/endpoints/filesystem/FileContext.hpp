@@ -37,12 +37,21 @@ class FileContext
 
     auto fileHash() const -> std::string;
 
+    auto runningCrc32() const -> std::uint32_t;
+
+    auto nextChunkSize() const -> std::size_t;
+
+    auto setBinaryTransfer(bool binary) -> void;
+
+    auto isBinaryTransfer() const -> bool;
+
   protected:
     std::filesystem::path path{};
     std::size_t size{};
     std::size_t offset{};
     std::size_t chunkSize{};
     CRC32 runningCrc32Digest;
+    bool binaryTransfer{false};
 };
 
 class FileReadContext : public FileContext
@@ -56,6 +65,9 @@ class FileReadContext : public FileContext
     ~FileReadContext();
 
     auto read() -> std::vector<std::uint8_t>;
+
+  private:
+    std::ifstream file;
 };
 
 class FileWriteContext : public FileContext
@@ -75,6 +87,9 @@ class FileWriteContext : public FileContext
 
     auto write(const std::vector<std::uint8_t> &data) -> void;
 
+    auto write(const std::uint8_t *data, std::size_t dataSize) -> void;
+
   private:
     std::string crc32Digest{};
+    std::ofstream file;
 };
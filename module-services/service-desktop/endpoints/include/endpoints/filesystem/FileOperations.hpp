@@ -26,12 +26,22 @@ class FileOperations
     std::atomic<transfer_id> runningRxId{0};
     std::atomic<transfer_id> runningTxId{0};
 
-    auto createFileReadContextFor(const std::filesystem::path &file, std::size_t fileSize, transfer_id xfrId) -> void;
+    auto createFileReadContextFor(const std::filesystem::path &file,
+                                  std::size_t fileSize,
+                                  transfer_id xfrId,
+                                  bool binary) -> void;
 
     auto createFileWriteContextFor(const std::filesystem::path &file,
                                    std::size_t fileSize,
                                    const std::string &Crc32,
-                                   transfer_id xfrId) -> void;
+                                   transfer_id xfrId,
+                                   bool binary) -> void;
+
+    auto getReadContext(transfer_id rxID, std::uint32_t chunkNo) -> FileReadContext *;
+
+    auto getWriteContext(transfer_id txID, std::uint32_t chunkNo) -> FileWriteContext *;
+
+    auto finishWriteTransfer(transfer_id txID, FileWriteContext *fileCtx) -> void;
 
     auto encodeDataAsBase64(const std::vector<std::uint8_t> &binaryData) const -> std::string;
 
@@ -53,6 +63,10 @@ class FileOperations
     static constexpr auto SingleChunkSize     = Base64ToBinFactor * BinToBase64Factor * 1024u; // 12KB
     static constexpr auto ChunkSizeMultiplier = 12u;
     static constexpr auto ChunkSize           = ChunkSizeMultiplier * SingleChunkSize;
+    // Binary chunks are sent as raw data frames, without the base64 and JSON overhead
+    static constexpr auto BinaryChunkSize = 16u * SingleChunkSize;
+    // Number of chunk requests or raw data frames the client may send without waiting for the responses
+    static constexpr auto BinaryChunksInFlight = 4u;
 
     struct DataWithCrc32
     {
@@ -60,14 +74,33 @@ class FileOperations
         std::string crc32;
     };
 
+    struct BinaryData
+    {
+        std::vector<std::uint8_t> data;
+        std::uint32_t crc32; ///< running CRC32 of the file up to the end of the chunk
+    };
+
     static FileOperations &instance();
 
-    auto createReceiveIDForFile(const std::filesystem::path &file) -> std::pair<transfer_id, std::size_t>;
+    auto createReceiveIDForFile(const std::filesystem::path &file, bool binary = false)
+        -> std::pair<transfer_id, std::size_t>;
 
     auto getDataForReceiveID(transfer_id, std::uint32_t chunkNo) -> DataWithCrc32;
 
-    auto createTransmitIDForFile(const std::filesystem::path &file, std::size_t size, const std::string &Crc32)
-        -> transfer_id;
+    auto getBinaryDataForReceiveID(transfer_id, std::uint32_t chunkNo) -> BinaryData;
+
+    auto isBinaryReceiveID(transfer_id rxID) const -> bool;
+
+    auto createTransmitIDForFile(const std::filesystem::path &file,
+                                 std::size_t size,
+                                 const std::string &Crc32,
+                                 bool binary = false) -> transfer_id;
 
     auto sendDataForTransmitID(transfer_id, std::uint32_t chunkNo, const std::string &data) -> sys::ReturnCodes;
+
+    auto sendBinaryDataForTransmitID(transfer_id,
+                                     std::uint32_t chunkNo,
+                                     std::uint32_t crc32,
+                                     const std::uint8_t *data,
+                                     std::size_t dataSize) -> sys::ReturnCodes;
 };
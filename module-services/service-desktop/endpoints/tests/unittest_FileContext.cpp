@@ -0,0 +1,94 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <endpoints/filesystem/FileContext.hpp>
+
+#include <filesystem>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("FileContext UT Test Valid Input")
+{
+    auto filePath{"/sys/user/data/applications/settings/quotes.json"};
+    auto fileSize{1536u};
+    auto fileOffset{128 * 6u};
+    auto chunkSize{128 * 3u};
+
+    SECTION("Create file context for file")
+    {
+        auto fileCtx = FileReadContext(filePath, fileSize, chunkSize, fileOffset);
+
+        REQUIRE(3 == fileCtx.expectedChunkInFile());
+
+        REQUIRE(true == fileCtx.validateChunkRequest(3));
+        REQUIRE(false == fileCtx.validateChunkRequest(4));
+
+        REQUIRE(4 == fileCtx.totalChunksInFile());
+        REQUIRE(chunkSize == fileCtx.nextChunkSize());
+
+        fileCtx.advanceFileOffset(fileSize - fileOffset);
+        REQUIRE(true == fileCtx.reachedEOF());
+        REQUIRE(0 == fileCtx.nextChunkSize());
+    }
+}
+
+TEST_CASE("FileContext UT Test Invalid Input")
+{
+    auto filePath{"/sys/user/music/Nick_Lewis_-_Bring_The_Light.mp3"};
+
+    SECTION("Create file context for file with invalid file size")
+    {
+        auto fileSize{0u};
+        auto chunkSize{1024 * 3u};
+
+        REQUIRE_THROWS_WITH(FileReadContext(filePath, fileSize, chunkSize), "Invalid FileContext arguments");
+    }
+
+    SECTION("Create file context for file with invalid chunk size")
+    {
+        auto fileSize{5431340u};
+        auto chunkSize{0u};
+
+        REQUIRE_THROWS_WITH(FileReadContext(filePath, fileSize, chunkSize), "Invalid FileContext arguments");
+    }
+}
+
+TEST_CASE("FileContext chunked transfer")
+{
+    const auto filePath = std::filesystem::temp_directory_path() / "unittest_FileContext.bin";
+    const auto chunkSize{100u};
+    std::vector<std::uint8_t> data(chunkSize * 2 + 50);
+    std::iota(data.begin(), data.end(), 0);
+
+    FileWriteContext writeCtx(filePath, data.size(), chunkSize, "");
+    for (std::size_t offset = 0; offset < data.size(); offset += chunkSize) {
+        REQUIRE(writeCtx.nextChunkSize() == std::min<std::size_t>(chunkSize, data.size() - offset));
+        writeCtx.write(data.data() + offset, writeCtx.nextChunkSize());
+    }
+    REQUIRE(writeCtx.reachedEOF());
+    REQUIRE(std::filesystem::file_size(filePath) == data.size());
+
+    SECTION("Running CRC32 of the read chunks matches the written ones")
+    {
+        FileReadContext readCtx(filePath, data.size(), chunkSize);
+        std::vector<std::uint8_t> readData;
+        while (!readCtx.reachedEOF()) {
+            const auto chunk = readCtx.read();
+            readData.insert(readData.end(), chunk.begin(), chunk.end());
+        }
+        REQUIRE(readData == data);
+        REQUIRE(readCtx.runningCrc32() == writeCtx.runningCrc32());
+    }
+
+    SECTION("Restarted upload truncates the file")
+    {
+        FileWriteContext restartCtx(filePath, chunkSize, chunkSize, "");
+        restartCtx.write(data.data(), chunkSize);
+        REQUIRE(std::filesystem::file_size(filePath) == chunkSize);
+    }
+
+    std::filesystem::remove(filePath);
+}
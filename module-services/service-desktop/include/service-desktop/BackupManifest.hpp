@@ -0,0 +1,53 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <json11.hpp>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+
+/**
+ * Description of the files in a backup, packed into every backup archive.
+ * An incremental backup packs only the files changed since its base backup, the rest of the files listed in the
+ * manifest is restored from the base backups.
+ */
+struct BackupManifest
+{
+    struct FileInfo
+    {
+        std::uintmax_t size = 0;
+        std::string crc32;
+
+        bool operator==(const FileInfo &other) const
+        {
+            return size == other.size && crc32 == other.crc32;
+        }
+    };
+
+    /// longest chain of the base backups followed during the restore
+    static constexpr unsigned maxDepth = 64;
+
+    std::string taskId;
+    std::string base;   ///< task id of the backup this one is based on, empty for the full backups
+    unsigned depth = 0; ///< number of the base backups needed to restore this one, 0 for the full backups
+    std::map<std::string, FileInfo> files;
+
+    bool IsIncremental() const
+    {
+        return !base.empty();
+    }
+    /// the next backup has to be full when the chain of the base backups is at its limit
+    bool CanBeBase() const
+    {
+        return depth < maxDepth;
+    }
+    void SetBase(const BackupManifest &baseManifest);
+    bool IsUnchanged(const std::string &fileName, const FileInfo &info) const;
+
+    json11::Json to_json() const;
+    static std::optional<BackupManifest> FromJson(const std::string &jsonString);
+};
@@ -5,8 +5,10 @@
 
 #include <Service/Service.hpp>
 #include <endpoints/JsonKeyNames.hpp>
+#include <service-desktop/BackupManifest.hpp>
 #include <json11.hpp>
 #include <filesystem>
+#include <optional>
 
 namespace sys
 {
@@ -88,6 +90,8 @@ class BackupRestore
         std::string taskId;
         OperationState state = OperationState::Stopped;
         Operation operation  = Operation::Backup;
+        bool incremental     = false;
+        std::string base; ///< task id of the base backup of the incremental backup
         json11::Json to_json() const
         {
             auto response = json11::Json::object{{sdesktop::endpoints::json::taskId, taskId},
@@ -97,11 +101,15 @@ class BackupRestore
                 response[sdesktop::endpoints::json::reason] = completionCodeToString(completionCode);
             }
 
+            if (!base.empty()) {
+                response[sdesktop::endpoints::json::base] = base;
+            }
+
             return response;
         }
     };
 
-    static CompletionCode BackupUserFiles(sys::Service *ownerService, std::filesystem::path &path);
+    static CompletionCode BackupUserFiles(sys::Service *ownerService, OperationStatus &status);
     static CompletionCode RestoreUserFiles(sys::Service *ownerService, const std::filesystem::path &path);
     static json11::Json GetBackupFiles();
 
@@ -117,4 +125,15 @@ class BackupRestore
     static bool ReplaceUserFiles(const std::filesystem::path &path);
     static bool WriteBackupInfo(sys::Service *ownerService, const std::filesystem::path &path);
     static std::string ReadFileAsString(const std::filesystem::path &fileToRead);
+    static bool PrepareBackupFiles(const std::filesystem::path &path,
+                                   const std::optional<BackupManifest> &baseManifest,
+                                   BackupManifest &manifest);
+    static bool PrepareRestoreFiles(const std::filesystem::path &extractedBackup);
+    static bool DecompressBackupFiles(const std::filesystem::path &extractedBackup, const BackupManifest &manifest);
+    static std::optional<BackupManifest> ReadManifest(const std::filesystem::path &path);
+    static bool WriteManifest(const BackupManifest &manifest, const std::filesystem::path &path);
+    static auto LastManifestPath() -> std::filesystem::path;
+    static std::string FileCrc32(const std::filesystem::path &path);
+    static bool CompressFile(const std::filesystem::path &source, const std::filesystem::path &destination);
+    static bool DecompressFile(const std::filesystem::path &source, const std::filesystem::path &destination);
 };
@@ -9,6 +9,7 @@
 #include <MessageType.hpp>
 #include <service-desktop/DeveloperModeMessage.hpp>
 #include <service-desktop/DesktopEvent.hpp>
+#include <SystemManager/TaskStatistics.hpp>
 
 namespace sdesktop
 {
@@ -100,6 +101,12 @@ namespace sdesktop
             CellularSleepModeInfoRequestEvent() = default;
             explicit CellularSleepModeInfoRequestEvent(bool isInSleepMode);
         };
+        class CpuStatisticsInfoRequestEvent : public Event
+        {
+          public:
+            CpuStatisticsInfoRequestEvent() = default;
+            CpuStatisticsInfoRequestEvent(std::uint32_t cpuLoad, const std::vector<sys::TaskLoad> &tasksLoad);
+        };
         class ScreenlockCheckEvent : public Event
         {
           public:
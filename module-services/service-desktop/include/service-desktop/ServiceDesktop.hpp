@@ -62,7 +62,7 @@ class ServiceDesktop : public sys::Service
     std::unique_ptr<WorkerDesktop> desktopWorker;
 
     std::string prepareBackupFilename();
-    void prepareBackupData();
+    void prepareBackupData(bool incremental = false);
     void prepareRestoreData(const std::filesystem::path &restoreLocation);
     const BackupRestore::OperationStatus getBackupRestoreStatus()
     {
@@ -4,6 +4,9 @@
 #pragma once
 
 #include <log/log.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 #include <json11.hpp>
 
@@ -16,10 +19,15 @@ namespace sdesktop::endpoints::message
     inline constexpr auto endpointChar = '#';
     inline constexpr auto rawDataChar  = '$';
 
-    inline void removeHeader(std::string &msg)
+    /// Header of the raw data frames of the binary file transfer, every field is sent as little endian uint32
+    struct RawDataHeader
     {
-        msg.erase(msg.begin(), msg.begin() + size_header);
-    }
+        std::uint32_t transferID;
+        std::uint32_t chunkNo;
+        std::uint32_t crc32; ///< running CRC32 of the file up to the end of the chunk
+    };
+
+    inline constexpr auto size_raw_data_header = 3 * sizeof(std::uint32_t);
 
     inline unsigned long calcPayloadLength(const std::string &header)
     {
@@ -37,32 +45,50 @@ namespace sdesktop::endpoints::message
         return msg.substr(0, size_header);
     }
 
-    inline void eraseFront(std::string &msg, size_t pos)
-    {
-        msg.erase(msg.begin(), msg.begin() + pos);
-    }
-    inline std::string extractPayload(std::string &msg, size_t payloadLength)
+    /// Writes the payload length to the header at the beginning of the frame
+    inline void writePayloadSize(std::string &frame, std::size_t payloadSize)
     {
-        if (msg.size() > payloadLength) {
-            return msg.substr(0, payloadLength);
-        }
-        else {
-            return msg;
+        for (auto i = message::size_length; i > 0; --i) {
+            frame[i] = static_cast<char>('0' + payloadSize % 10);
+            payloadSize /= 10;
         }
     }
 
+    /// JSON is serialized straight into the frame, after the header
     inline std::unique_ptr<std::string> buildResponse(const json11::Json &msg)
     {
-        const auto jsonStr                 = msg.dump();
-        const auto pos                     = 0;
-        const auto count                   = 1;
-        std::string responsePayloadSizeStr = std::to_string(jsonStr.size());
+        auto response = std::make_unique<std::string>(message::size_header, message::endpointChar);
+        msg.dump(*response);
+        writePayloadSize(*response, response->size() - message::size_header);
+        return response;
+    }
 
-        while (responsePayloadSizeStr.length() < message::size_length) {
-            responsePayloadSizeStr.insert(pos, count, '0');
+    inline std::unique_ptr<std::string> buildRawResponse(const RawDataHeader &header,
+                                                         const std::uint8_t *data,
+                                                         std::size_t dataSize)
+    {
+        auto response = std::make_unique<std::string>(size_header, message::rawDataChar);
+        response->reserve(size_header + size_raw_data_header + dataSize);
+        writePayloadSize(*response, size_raw_data_header + dataSize);
+        for (const auto field : {header.transferID, header.chunkNo, header.crc32}) {
+            for (auto i = 0; i < 4; ++i) {
+                response->push_back(static_cast<char>(field >> (8 * i)));
+            }
         }
+        response->append(reinterpret_cast<const char *>(data), dataSize);
+        return response;
+    }
 
-        return std::make_unique<std::string>(message::endpointChar + responsePayloadSizeStr + jsonStr);
+    inline std::optional<RawDataHeader> getRawDataHeader(const std::string &payload)
+    {
+        if (payload.size() < size_raw_data_header) {
+            return std::nullopt;
+        }
+        std::uint32_t fields[3] = {};
+        for (std::size_t i = 0; i < size_raw_data_header; ++i) {
+            fields[i / 4] |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(payload[i])) << (8 * (i % 4));
+        }
+        return RawDataHeader{fields[0], fields[1], fields[2]};
     }
 
 } // namespace sdesktop::endpoints::message
@@ -0,0 +1,136 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <functional>
+#include <string>
+
+namespace sdesktop::endpoints::message
+{
+    enum class FrameType
+    {
+        Endpoint,
+        RawData
+    };
+
+    /**
+     * Incremental framing of the service-desktop stream.
+     * Received chunks are gathered in one buffer and the frames are found in place. A chunk holding exactly one frame
+     * is handed over without copying it, a frame split into many chunks is reassembled in a buffer reserved for its
+     * whole size as soon as its header is known.
+     */
+    class FrameParser
+    {
+      public:
+        using FrameHandler = std::function<void(FrameType type, std::string &&payload)>;
+
+        /// Frames are reassembled without reallocations up to this size
+        static constexpr std::size_t maxReservedFrameSize = 256 * 1024;
+
+        explicit FrameParser(FrameHandler handler) : handler{std::move(handler)}
+        {}
+
+        /// @return number of the frames passed to the handler
+        std::size_t feed(std::string &&chunk)
+        {
+            if (buffer.empty()) {
+                buffer = std::move(chunk);
+            }
+            else {
+                buffer.append(chunk);
+            }
+
+            std::size_t frames = 0;
+            std::size_t pos    = 0;
+
+            while (pos < buffer.size()) {
+                if (!isFrameStart(buffer[pos])) {
+                    const auto next = buffer.find_first_of(frameStartChars, pos);
+                    LOG_ERROR("This is not a valid endpoint message! Type=%c", buffer[pos]);
+                    pos = (next == std::string::npos) ? buffer.size() : next;
+                    continue;
+                }
+
+                if (buffer.size() - pos < size_header) {
+                    break;
+                }
+
+                const auto payloadLength = parsePayloadLength(pos);
+                if (payloadLength == 0) {
+                    LOG_ERROR("Damaged header!");
+                    ++pos;
+                    continue;
+                }
+
+                const auto frameSize = size_header + payloadLength;
+                if (buffer.size() - pos < frameSize) {
+                    buffer.erase(0, pos);
+                    if (frameSize <= maxReservedFrameSize) {
+                        buffer.reserve(frameSize);
+                    }
+                    return frames;
+                }
+
+                const auto type = (buffer[pos] == rawDataChar) ? FrameType::RawData : FrameType::Endpoint;
+                ++frames;
+
+                if (pos == 0 && frameSize == buffer.size()) {
+                    // the most common case, whole frame received in one chunk
+                    buffer.erase(0, size_header);
+                    handler(type, std::move(buffer));
+                    buffer.clear();
+                    return frames;
+                }
+
+                handler(type, buffer.substr(pos + size_header, payloadLength));
+                pos += frameSize;
+            }
+
+            buffer.erase(0, pos);
+            return frames;
+        }
+
+        void reset() noexcept
+        {
+            buffer.clear();
+        }
+
+        [[nodiscard]] bool isEmpty() const noexcept
+        {
+            return buffer.empty();
+        }
+
+        [[nodiscard]] bool hasPartialHeader() const noexcept
+        {
+            return !buffer.empty() && buffer.size() < size_header;
+        }
+
+      private:
+        static constexpr auto frameStartChars = "#$";
+
+        static bool isFrameStart(char c) noexcept
+        {
+            return c == endpointChar || c == rawDataChar;
+        }
+
+        /// @return 0 if the length is not a number
+        std::size_t parsePayloadLength(std::size_t pos) const noexcept
+        {
+            std::size_t length = 0;
+            for (auto i = pos + 1; i < pos + size_header; ++i) {
+                const auto digit = buffer[i] - '0';
+                if (digit < 0 || digit > 9) {
+                    return 0;
+                }
+                length = length * 10 + digit;
+            }
+            return length;
+        }
+
+        FrameHandler handler;
+        std::string buffer;
+    };
+} // namespace sdesktop::endpoints::message
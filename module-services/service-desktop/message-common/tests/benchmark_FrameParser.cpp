@@ -0,0 +1,91 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include <endpoints/message/FrameParser.hpp>
+
+#include <string>
+
+using namespace sdesktop::endpoints::message;
+
+// Benchmarks are hidden from default run, use: catch2-desktop-message-common "[benchmark]"
+// Every run handles messagesPerRun messages, messages per second = messagesPerRun / mean time
+namespace
+{
+    constexpr auto messagesPerRun = 100;
+    constexpr auto usbPacketSize  = 64;
+
+    json11::Json createContact(int id)
+    {
+        return json11::Json::object{
+            {"endpoint", 7},
+            {"method", 3},
+            {"uuid", id},
+            {"body",
+             json11::Json::object{{"address", "6 Czeczota St. 02600 Warsaw"},
+                                  {"altName", "Kowalski"},
+                                  {"priName", "Jan"},
+                                  {"blocked", false},
+                                  {"favourite", true},
+                                  {"numbers", json11::Json::array{"+48123456789", "+48987654321"}}}}};
+    }
+
+    std::string createStream()
+    {
+        std::string stream;
+        for (auto i = 0; i < messagesPerRun; ++i) {
+            stream += *buildResponse(createContact(i));
+        }
+        return stream;
+    }
+} // namespace
+
+TEST_CASE("Frame parser benchmark", "[.][benchmark]")
+{
+    const auto stream = createStream();
+    std::vector<std::string> frames;
+    for (std::size_t pos = 0; pos < stream.size();) {
+        const auto size = size_header + calcPayloadLength(stream.substr(pos, size_header));
+        frames.push_back(stream.substr(pos, size));
+        pos += size;
+    }
+
+    int parsed = 0;
+    FrameParser parser{[&parsed](FrameType, std::string &&payload) {
+        std::string err;
+        parsed += json11::Json::parse(payload, err)["uuid"].is_number();
+    }};
+
+    BENCHMARK("frame per chunk")
+    {
+        for (const auto &frame : frames) {
+            parser.feed(std::string{frame});
+        }
+        return parsed;
+    };
+
+    BENCHMARK("all frames in one chunk")
+    {
+        parser.feed(std::string{stream});
+        return parsed;
+    };
+
+    BENCHMARK("USB packets")
+    {
+        for (std::size_t pos = 0; pos < stream.size(); pos += usbPacketSize) {
+            parser.feed(stream.substr(pos, usbPacketSize));
+        }
+        return parsed;
+    };
+
+    const auto contact = createContact(1);
+    BENCHMARK("response serialization")
+    {
+        std::size_t size = 0;
+        for (auto i = 0; i < messagesPerRun; ++i) {
+            size += buildResponse(contact)->size();
+        }
+        return size;
+    };
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <endpoints/message/FrameParser.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace sdesktop::endpoints::message;
+
+namespace
+{
+    const std::string payload = R"({"endpoint":1, "method":1, "body":{"test":"test"}})";
+    const std::string frame   = "#000000050" + payload;
+
+    struct Frames
+    {
+        std::vector<std::pair<FrameType, std::string>> received;
+        FrameParser parser{[this](FrameType type, std::string &&payload) {
+            received.emplace_back(type, std::move(payload));
+        }};
+    };
+} // namespace
+
+TEST_CASE("Frame parser")
+{
+    Frames frames;
+
+    SECTION("Whole frame")
+    {
+        REQUIRE(frames.parser.feed(std::string{frame}) == 1);
+        REQUIRE(frames.parser.isEmpty());
+        REQUIRE(frames.received.size() == 1);
+        REQUIRE(frames.received[0].first == FrameType::Endpoint);
+        REQUIRE(frames.received[0].second == payload);
+    }
+
+    SECTION("Frame split into single bytes")
+    {
+        for (std::size_t i = 0; i + 1 < frame.size(); ++i) {
+            REQUIRE(frames.parser.feed(frame.substr(i, 1)) == 0);
+            REQUIRE(frames.parser.hasPartialHeader() == (i + 1 < size_header));
+        }
+        REQUIRE(frames.parser.feed(frame.substr(frame.size() - 1)) == 1);
+        REQUIRE(frames.parser.isEmpty());
+        REQUIRE(frames.received[0].second == payload);
+    }
+
+    SECTION("Many frames in one chunk")
+    {
+        REQUIRE(frames.parser.feed(frame + frame + frame.substr(0, 20)) == 2);
+        REQUIRE_FALSE(frames.parser.isEmpty());
+        REQUIRE(frames.parser.feed(frame.substr(20)) == 1);
+        REQUIRE(frames.parser.isEmpty());
+        REQUIRE(frames.received.size() == 3);
+        for (const auto &[type, received] : frames.received) {
+            REQUIRE(received == payload);
+        }
+    }
+
+    SECTION("Junk before the frame")
+    {
+        REQUIRE(frames.parser.feed("junk" + frame) == 1);
+        REQUIRE(frames.received[0].second == payload);
+
+        REQUIRE(frames.parser.feed(R"({"address": "6 Czeczota St.\n02600 Warsaw"})") == 0);
+        REQUIRE(frames.parser.isEmpty());
+    }
+
+    SECTION("Damaged header")
+    {
+        REQUIRE(frames.parser.feed("#00000x050" + payload + frame) == 1);
+        REQUIRE(frames.parser.isEmpty());
+        REQUIRE(frames.received[0].second == payload);
+    }
+
+    SECTION("Raw data frame")
+    {
+        const std::vector<std::uint8_t> data{'#', 0, '$', 0xff};
+        const auto rawFrame = buildRawResponse({1, 2, 3}, data.data(), data.size());
+
+        REQUIRE(frames.parser.feed(*rawFrame + frame) == 2);
+        REQUIRE(frames.received[0].first == FrameType::RawData);
+        REQUIRE(frames.received[0].second == rawFrame->substr(size_header));
+        REQUIRE(frames.received[1].first == FrameType::Endpoint);
+    }
+
+    SECTION("Raw data frame split inside the payload")
+    {
+        const std::vector<std::uint8_t> data{'#', 0, 1, '$', 0xff};
+        const auto rawFrame = buildRawResponse({1, 1, 0}, data.data(), data.size());
+
+        REQUIRE(frames.parser.feed(rawFrame->substr(0, size_header + 4)) == 0);
+        REQUIRE_FALSE(frames.parser.isEmpty());
+        REQUIRE(frames.parser.feed(rawFrame->substr(size_header + 4)) == 1);
+        REQUIRE(frames.parser.isEmpty());
+        REQUIRE(frames.received[0].first == FrameType::RawData);
+        REQUIRE(frames.received[0].second == rawFrame->substr(size_header));
+    }
+
+    SECTION("Reset")
+    {
+        frames.parser.feed(frame.substr(0, 20));
+        frames.parser.reset();
+        REQUIRE(frames.parser.isEmpty());
+        REQUIRE(frames.parser.feed(std::string{frame}) == 1);
+    }
+}
+
+TEST_CASE("Response frame")
+{
+    const json11::Json response = json11::Json::object{{"endpoint", 1}, {"status", 200}, {"uuid", 12}};
+    const auto frame            = buildResponse(response);
+
+    REQUIRE(frame->front() == endpointChar);
+    REQUIRE(calcPayloadLength(getHeader(*frame)) == response.dump().size());
+    REQUIRE(frame->substr(size_header) == response.dump());
+}
+
+TEST_CASE("Raw data frame")
+{
+    const std::vector<std::uint8_t> data{0x00, 0x24, 0x23, 0xff};
+    const RawDataHeader header{7, 3, 0x4a36d291};
+
+    SECTION("Build and parse raw data frame")
+    {
+        const auto frame = buildRawResponse(header, data.data(), data.size());
+
+        REQUIRE(frame->front() == rawDataChar);
+        REQUIRE(calcPayloadLength(getHeader(*frame)) == size_raw_data_header + data.size());
+
+        const auto payload = frame->substr(size_header);
+        const auto parsed  = getRawDataHeader(payload);
+        REQUIRE(parsed.has_value());
+        REQUIRE(parsed->transferID == header.transferID);
+        REQUIRE(parsed->chunkNo == header.chunkNo);
+        REQUIRE(parsed->crc32 == header.crc32);
+        REQUIRE(payload.substr(size_raw_data_header) == std::string(data.begin(), data.end()));
+    }
+
+    SECTION("Raw data frame too short for the header")
+    {
+        REQUIRE_FALSE(getRawDataHeader(std::string(size_raw_data_header - 1, '0')).has_value());
+    }
+}
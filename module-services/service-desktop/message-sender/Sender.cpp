@@ -22,3 +22,13 @@ void sdesktop::endpoints::sender::putToSendQueue(const json11::Json &msg)
         xQueueSend(sendQueue, &responseString, portMAX_DELAY);
     }
 }
+
+void sdesktop::endpoints::sender::putToSendQueue(std::unique_ptr<std::string> msg)
+{
+    if (uxQueueSpacesAvailable(sendQueue) == 0) {
+        LOG_ERROR("Send queue full, message dropped");
+        return;
+    }
+    auto responseString = msg.release();
+    xQueueSend(sendQueue, &responseString, portMAX_DELAY);
+}
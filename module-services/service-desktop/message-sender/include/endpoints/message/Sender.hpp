@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <json11.hpp>
 
@@ -17,5 +18,7 @@ namespace sdesktop::endpoints::sender
 
     void setSendQueueHandle(xQueueHandle handle);
     void putToSendQueue(const json11::Json &msg);
+    /// Sends an already built message, e.g. a raw data frame
+    void putToSendQueue(std::unique_ptr<std::string> msg);
 
 } // namespace sdesktop::endpoints::sender
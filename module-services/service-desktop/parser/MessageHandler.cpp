@@ -18,6 +18,8 @@ namespace sdesktop::endpoints
 
     void MessageHandler::parseMessage(const std::string &msg)
     {
+        // the handler is reused, json11 sets the error only when parsing fails
+        JsonErrorMsg.clear();
         try {
             messageJson = json11::Json::parse(msg, JsonErrorMsg);
         }
@@ -45,4 +47,22 @@ namespace sdesktop::endpoints
         }
     }
 
+    void MessageHandler::processRawMessage(std::string &&payload)
+    {
+        json11::Json rawMessageJson =
+            json11::Json::object{{json::endpoint, static_cast<int>(EndpointType::filesystemUpload)},
+                                 {json::method, static_cast<int>(http::Method::put)}};
+        Context context{rawMessageJson};
+        context.setRawData(std::move(payload));
+
+        auto handler = endpointFactory->create(context, OwnerServicePtr);
+
+        if (handler != nullptr) {
+            handler->handle(context);
+        }
+        else {
+            LOG_ERROR("No way to handle raw data!");
+        }
+    }
+
 } // namespace sdesktop::endpoints
@@ -35,6 +35,8 @@ namespace sdesktop::endpoints
         };
         void parseMessage(const std::string &msg);
         void processMessage();
+        /// Raw data frames carry the chunks of the binary file upload
+        void processRawMessage(std::string &&payload);
     };
 
 } // namespace sdesktop::endpoints
@@ -6,6 +6,7 @@
 #include "MessageHandler.hpp"
 
 #include <Timers/TimerHandle.hpp>
+#include <endpoints/message/FrameParser.hpp>
 
 #include <json11.hpp>
 #include <magic_enum.hpp>
@@ -26,35 +27,19 @@ namespace sdesktop::endpoints
       public:
         explicit StateMachine(sys::Service *OwnerService);
         void processMessage(std::string &&msg);
-        [[nodiscard]] auto getCurrentState() const noexcept -> State
-        {
-            return state;
-        };
-
-        void setState(const State newState) noexcept
-        {
-            state = newState;
-        }
+        [[nodiscard]] auto getCurrentState() const noexcept -> State;
 
         void setMessageHandler(std::unique_ptr<MessageHandler> handler);
 
       private:
-        std::string receivedMsg;
-        State state = State::NoMsg;
-        std::string payload;
-        std::string header;
-        unsigned long payloadLength   = 0;
         sys::Service *OwnerServicePtr = nullptr;
         std::unique_ptr<MessageHandler> messageHandler;
+        message::FrameParser frameParser;
         sys::TimerHandle parserTimer;
 
-        void parseHeader();
         void resetParser();
         void restartTimer();
-        void parsePartialHeader();
-        void parseNewMessage();
-        void parsePartialMessage();
-        void parsePayload();
+        void parsePayload(message::FrameType type, std::string &&payload);
     };
 
 } // namespace sdesktop::endpoints
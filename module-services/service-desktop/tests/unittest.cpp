@@ -8,7 +8,6 @@
 #include <endpoints/contacts/ContactHelper.hpp>
 #include <endpoints/contacts/ContactsEndpoint.hpp>
 #include <endpoints/messages/MessageHelper.hpp>
-#include <endpoints/filesystem/FileContext.hpp>
 #include <endpoints/filesystem/FileOperations.hpp>
 #include <ParserFSM.hpp>
 
@@ -333,50 +332,6 @@ TEST_CASE("FileOperations UT Test Get File")
     }
 }
 
-TEST_CASE("FileContext UT Test Valid Input")
-{
-    auto filePath{"/sys/user/data/applications/settings/quotes.json"};
-    auto fileSize{1536u};
-    auto fileOffset{128 * 6u};
-    auto chunkSize{128 * 3u};
-
-    SECTION("Create file context for file")
-    {
-        auto fileCtx = FileReadContext(filePath, fileSize, chunkSize, fileOffset);
-
-        REQUIRE(3 == fileCtx.expectedChunkInFile());
-
-        REQUIRE(true == fileCtx.validateChunkRequest(3));
-        REQUIRE(false == fileCtx.validateChunkRequest(4));
-
-        REQUIRE(4 == fileCtx.totalChunksInFile());
-
-        fileCtx.advanceFileOffset(fileSize - fileOffset);
-        REQUIRE(true == fileCtx.reachedEOF());
-    }
-}
-
-TEST_CASE("FileContext UT Test Invalid Input")
-{
-    auto filePath{"/sys/user/music/Nick_Lewis_-_Bring_The_Light.mp3"};
-
-    SECTION("Create file context for file with invalid file size")
-    {
-        auto fileSize{0u};
-        auto chunkSize{1024 * 3u};
-
-        REQUIRE_THROWS_WITH(FileReadContext(filePath, fileSize, chunkSize), "Invalid FileContext arguments");
-    }
-
-    SECTION("Create file context for file with invalid chunk size")
-    {
-        auto fileSize{5431340u};
-        auto chunkSize{0u};
-
-        REQUIRE_THROWS_WITH(FileReadContext(filePath, fileSize, chunkSize), "Invalid FileContext arguments");
-    }
-}
-
 TEST_CASE("FileOperations UT Test Send File")
 {
     auto &fileOps = FileOperations::instance();
@@ -0,0 +1,79 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <service-desktop/BackupManifest.hpp>
+
+#include <string>
+
+TEST_CASE("Backup manifest")
+{
+    BackupManifest manifest;
+    manifest.taskId               = "2021-08-20T120000Z";
+    manifest.base                 = "2021-08-19T120000Z";
+    manifest.depth                = 3;
+    manifest.files["contacts.db"] = {16384, "4a36d291"};
+    manifest.files["notes.db"]    = {8192, "0badf00d"};
+
+    SECTION("Serialization")
+    {
+        const auto restored = BackupManifest::FromJson(json11::Json(manifest).dump());
+
+        REQUIRE(restored.has_value());
+        REQUIRE(restored->taskId == manifest.taskId);
+        REQUIRE(restored->base == manifest.base);
+        REQUIRE(restored->depth == manifest.depth);
+        REQUIRE(restored->IsIncremental());
+        REQUIRE(restored->files == manifest.files);
+    }
+
+    SECTION("Changed files")
+    {
+        REQUIRE(manifest.IsUnchanged("contacts.db", {16384, "4a36d291"}));
+        REQUIRE_FALSE(manifest.IsUnchanged("contacts.db", {16384, "4a36d292"}));
+        REQUIRE_FALSE(manifest.IsUnchanged("contacts.db", {20480, "4a36d291"}));
+        REQUIRE_FALSE(manifest.IsUnchanged("calllog.db", {16384, "4a36d291"}));
+    }
+
+    SECTION("Invalid manifest")
+    {
+        REQUIRE_FALSE(BackupManifest::FromJson("").has_value());
+        REQUIRE_FALSE(BackupManifest::FromJson(R"({"id":"2021-08-20T120000Z"})").has_value());
+        REQUIRE_FALSE(
+            BackupManifest::FromJson(R"({"id":"id","depth":0,"files":{"notes.db":{"size":1}}})").has_value());
+        REQUIRE_FALSE(BackupManifest::FromJson(R"({"id":"id","base":"base","files":{}})").has_value());
+    }
+}
+
+TEST_CASE("Backup manifest chain")
+{
+    constexpr auto backups = 3 * BackupManifest::maxDepth;
+
+    // every backup is based on the manifest of the previous one, as stored on the phone
+    BackupManifest last;
+    last.taskId = "0";
+    auto fullBackups{1u};
+
+    for (auto i = 1u; i <= backups; ++i) {
+        BackupManifest next;
+        next.taskId = std::to_string(i);
+        if (last.CanBeBase()) {
+            next.SetBase(last);
+        }
+        else {
+            ++fullBackups;
+        }
+
+        REQUIRE(next.depth <= BackupManifest::maxDepth);
+        REQUIRE(next.IsIncremental() == (next.depth > 0));
+        REQUIRE(next.depth == i % (BackupManifest::maxDepth + 1));
+
+        const auto stored = BackupManifest::FromJson(json11::Json(next).dump());
+        REQUIRE(stored.has_value());
+        last = *stored;
+    }
+
+    REQUIRE(fullBackups == 1 + backups / (BackupManifest::maxDepth + 1));
+}
@@ -103,23 +103,10 @@ namespace service::eink
         EinkFillScreenWithColor(EinkDisplayColorFilling_e::EinkDisplayColorWhite);
     }
 
-    EinkStatus_e EinkDisplay::update(std::uint8_t *displayBuffer)
+    EinkStatus_e EinkDisplay::update(std::uint8_t *displayBuffer, EinkBpp_e bpp)
     {
-        return EinkUpdateFrame(pointTopLeft.x,
-                               pointTopLeft.y,
-                               size.width,
-                               size.height,
-                               displayBuffer,
-                               getCurrentBitsPerPixelFormat(),
-                               displayMode);
-    }
-
-    EinkBpp_e EinkDisplay::getCurrentBitsPerPixelFormat() const noexcept
-    {
-        if ((currentWaveform.mode == EinkWaveformA2) || (currentWaveform.mode == EinkWaveformDU2)) {
-            return Eink4Bpp; // this should be 1Bpp, but the OS is not ready for this (in 1Bpp → halftones disappear)
-        }
-        return Eink4Bpp;
+        return EinkUpdateFrame(
+            pointTopLeft.x, pointTopLeft.y, size.width, size.height, displayBuffer, bpp, displayMode);
     }
 
     EinkStatus_e EinkDisplay::refresh(EinkDisplayTimingsMode_e refreshMode)
@@ -27,7 +27,7 @@ namespace service::eink
         ~EinkDisplay() noexcept;
 
         EinkStatus_e resetAndInit();
-        EinkStatus_e update(std::uint8_t *displayBuffer);
+        EinkStatus_e update(std::uint8_t *displayBuffer, EinkBpp_e bpp);
         EinkStatus_e refresh(EinkDisplayTimingsMode_e refreshMode);
         void dither();
         void powerOn();
@@ -51,7 +51,6 @@ namespace service::eink
         bool isNewWaveformNeeded(EinkWaveforms_e newMode, int32_t newTemperature) const;
         void resetWaveformSettings();
 
-        EinkBpp_e getCurrentBitsPerPixelFormat() const noexcept;
         static constexpr ::gui::Point pointTopLeft{0, 0};
         const ::gui::Size size;
         EinkWaveformSettings_t currentWaveform;
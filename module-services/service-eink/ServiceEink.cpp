@@ -37,12 +37,18 @@ namespace service::eink
             }
             return "1";
         }
+
+        EinkWaveforms_e toWaveform(::gui::RefreshModes refreshMode)
+        {
+            return refreshMode == ::gui::RefreshModes::GUI_REFRESH_DEEP ? EinkWaveformGC16 : EinkWaveformDU2;
+        }
     } // namespace
 
     ServiceEink::ServiceEink(ExitAction exitAction, const std::string &name, std::string parent)
         : sys::Service(name, std::move(parent), ServceEinkStackDepth),
           exitAction{exitAction}, display{{BOARD_EINK_DISPLAY_RES_X, BOARD_EINK_DISPLAY_RES_Y}},
-          currentState{State::Running}, settings{std::make_unique<settings::Settings>()}
+          waveformSelector{display.getSize()}, currentState{State::Running},
+          settings{std::make_unique<settings::Settings>()}
     {
         displayPowerOffTimer = sys::TimerFactory::createSingleShotTimer(
             this, "einkDisplayPowerOff", displayPowerOffTimeout, [this](sys::Timer &) { display.powerOff(); });
@@ -134,6 +140,7 @@ namespace service::eink
         if (const auto status = display.resetAndInit(); status != EinkOK) {
             LOG_FATAL("Error: Could not initialize Eink display!");
         }
+        waveformSelector.invalidate();
         display.powerOn();
         display.powerOff();
     }
@@ -163,6 +170,7 @@ namespace service::eink
             display.setMode(EinkDisplayColorMode_e::EinkDisplayColorModeStandard);
         }
         internal::StaticData::get().setInvertedMode(invertedModeRequested);
+        waveformSelector.invalidate();
     }
 
     sys::MessagePointer ServiceEink::handleImageMessage(sys::Message *request)
@@ -184,52 +192,53 @@ namespace service::eink
 
         auto displayPowerOffTimerReload = gsl::finally([this]() { displayPowerOffTimer.start(); });
 
-        if (const auto status = prepareDisplay(refreshMode, WaveformTemperature::KEEP_CURRENT);
+        const auto selection = waveformSelector.select(frameBuffer, refreshMode);
+        if (!selection.refreshNeeded) {
+            return;
+        }
+
+        if (const auto status = prepareDisplay(selection.waveform, WaveformTemperature::KEEP_CURRENT);
             status != EinkStatus_e ::EinkOK) {
             LOG_FATAL("Failed to prepare frame");
+            waveformSelector.invalidate();
             return;
         }
 
-        if (const auto status = updateDisplay(frameBuffer, refreshMode); status != EinkStatus_e ::EinkOK) {
+        if (const auto status = updateDisplay(frameBuffer, selection.bpp); status != EinkStatus_e ::EinkOK) {
             LOG_FATAL("Failed to update frame");
+            waveformSelector.invalidate();
             return;
         }
 
-        if (const auto status = refreshDisplay(refreshMode); status != EinkStatus_e ::EinkOK) {
+        if (const auto status = refreshDisplay(selection.waveform); status != EinkStatus_e ::EinkOK) {
             LOG_FATAL("Failed to refresh frame");
+            waveformSelector.invalidate();
             return;
         }
     }
 
-    EinkStatus_e ServiceEink::updateDisplay(std::uint8_t *frameBuffer, ::gui::RefreshModes refreshMode)
+    EinkStatus_e ServiceEink::updateDisplay(std::uint8_t *frameBuffer, EinkBpp_e bpp)
     {
-        return display.update(frameBuffer);
+        return display.update(frameBuffer, bpp);
     }
 
-    EinkStatus_e ServiceEink::refreshDisplay(::gui::RefreshModes refreshMode)
+    EinkStatus_e ServiceEink::refreshDisplay(EinkWaveforms_e waveform)
     {
-        const auto isDeepRefresh = refreshMode == ::gui::RefreshModes::GUI_REFRESH_DEEP;
+        const auto isDeepRefresh = waveform == EinkWaveforms_e::EinkWaveformGC16;
         return display.refresh(isDeepRefresh ? EinkDisplayTimingsDeepCleanMode : EinkDisplayTimingsFastRefreshMode);
     }
 
-    EinkStatus_e ServiceEink::prepareDisplay(::gui::RefreshModes refreshMode, WaveformTemperature behaviour)
+    EinkStatus_e ServiceEink::prepareDisplay(EinkWaveforms_e waveform, WaveformTemperature behaviour)
     {
-        EinkStatus_e status;
-
         displayPowerOffTimer.stop();
         display.powerOn();
 
         const auto temperature = behaviour == WaveformTemperature::KEEP_CURRENT ? display.getLastTemperature()
                                                                                 : EinkGetTemperatureInternal();
 
-        if (refreshMode == ::gui::RefreshModes::GUI_REFRESH_DEEP) {
-            status = display.setWaveform(EinkWaveforms_e::EinkWaveformGC16, temperature);
-            if (status == EinkOK) {
-                display.dither();
-            }
-        }
-        else {
-            status = display.setWaveform(EinkWaveforms_e::EinkWaveformDU2, temperature);
+        const auto status = display.setWaveform(waveform, temperature);
+        if (status == EinkOK && waveform == EinkWaveforms_e::EinkWaveformGC16) {
+            display.dither();
         }
         return status;
     }
@@ -237,7 +246,7 @@ namespace service::eink
     sys::MessagePointer ServiceEink::handlePrepareEarlyRequest(sys::Message *message)
     {
         const auto waveformUpdateMsg = static_cast<service::eink::PrepareDisplayEarlyRequest *>(message);
-        prepareDisplay(waveformUpdateMsg->getRefreshMode(), WaveformTemperature::MEASURE_NEW);
+        prepareDisplay(toWaveform(waveformUpdateMsg->getRefreshMode()), WaveformTemperature::MEASURE_NEW);
         return sys::MessageNone{};
     }
 
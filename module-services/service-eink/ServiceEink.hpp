@@ -10,6 +10,7 @@
 
 #include "EinkSentinel.hpp"
 #include "EinkDisplay.hpp"
+#include "WaveformSelector.hpp"
 
 #include <service-db/DBServiceName.hpp>
 #include <service-db/Settings.hpp>
@@ -62,9 +63,9 @@ namespace service::eink
         void suspend();
 
         void showImage(std::uint8_t *frameBuffer, ::gui::RefreshModes refreshMode);
-        EinkStatus_e prepareDisplay(::gui::RefreshModes refreshMode, WaveformTemperature behaviour);
-        EinkStatus_e refreshDisplay(::gui::RefreshModes refreshMode);
-        EinkStatus_e updateDisplay(uint8_t *frameBuffer, ::gui::RefreshModes refreshMode);
+        EinkStatus_e prepareDisplay(EinkWaveforms_e waveform, WaveformTemperature behaviour);
+        EinkStatus_e refreshDisplay(EinkWaveforms_e waveform);
+        EinkStatus_e updateDisplay(uint8_t *frameBuffer, EinkBpp_e bpp);
         void setDisplayMode(EinkModeMessage::Mode mode);
 
         sys::MessagePointer handleEinkModeChangedMessage(sys::Message *message);
@@ -75,6 +76,7 @@ namespace service::eink
 
         ExitAction exitAction;
         EinkDisplay display;
+        WaveformSelector waveformSelector;
         State currentState;
         sys::TimerHandle displayPowerOffTimer;
         std::shared_ptr<EinkSentinel> eInkSentinel;
@@ -0,0 +1,184 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "WaveformSelector.hpp"
+
+namespace service::eink
+{
+    namespace
+    {
+        constexpr std::uint8_t levelMask = 0x0F;
+
+        /// Full screens of DU2 updates the display can take before the ghosting gets visible
+        constexpr auto ghostingBudgetScreens = 8U;
+        /// Deep refresh requests of the changed frame clean the display if it is at least that ghosted (fraction of
+        /// the budget), deep refresh of the unchanged frame always cleans it
+        constexpr auto deepRequestGhostingDivider = 4U;
+        /// Frames with more than that fraction of the changed pixels being grey need the greyscale waveform
+        constexpr auto greyscaleFrameDivider = 4U;
+
+        constexpr auto ghostingWeightA2  = 4U;
+        constexpr auto ghostingWeightDU2 = 2U;
+
+        /// Levels kept by the 2bpp transfer
+        constexpr auto levels2BppStep = 5U;
+
+        constexpr bool isBinary(std::uint8_t level) noexcept
+        {
+            return level == ::gui::Color::Black || level == ::gui::Color::White;
+        }
+
+        constexpr bool is2BppLevel(std::uint8_t level) noexcept
+        {
+            return level % levels2BppStep == 0;
+        }
+
+        inline void classify(FrameStatistics &stats, std::uint8_t previous, std::uint8_t next) noexcept
+        {
+            if (previous == next) {
+                return;
+            }
+            ++stats.changedPixels;
+            ++stats.changedLevels[next];
+            if (!isBinary(previous)) {
+                --stats.greyPixels;
+            }
+            if (!is2BppLevel(previous)) {
+                --stats.fineGreyPixels;
+            }
+            if (!is2BppLevel(next)) {
+                ++stats.fineGreyPixels;
+            }
+            if (!isBinary(next)) {
+                ++stats.greyPixels;
+                ++stats.toGreyTransitions;
+            }
+            else if (isBinary(previous)) {
+                ++stats.binaryTransitions;
+            }
+            else {
+                ++stats.toBinaryTransitions;
+            }
+        }
+    } // namespace
+
+    WaveformSelector::WaveformSelector(::gui::Size screenSize)
+        : pixelCount{static_cast<std::uint32_t>(screenSize.width) * screenSize.height},
+          ghostingBudget{pixelCount * ghostingWeightDU2 * ghostingBudgetScreens},
+          lastFrame{std::make_unique<std::uint8_t[]>((pixelCount + 1) / 2)}
+    {}
+
+    WaveformSelection WaveformSelector::select(const std::uint8_t *frameBuffer, ::gui::RefreshModes refreshMode)
+    {
+        const auto wasValid = lastFrameValid;
+        lastStatistics      = analyse(frameBuffer);
+        lastFrameValid      = true;
+
+        if (!wasValid) {
+            // Nothing to compare with, rely on the caller
+            const auto waveform = refreshMode == ::gui::RefreshModes::GUI_REFRESH_DEEP ? EinkWaveformGC16
+                                                                                       : EinkWaveformDU2;
+            accumulateGhosting(waveform, pixelCount);
+            return {true, waveform, selectBitsPerPixel(lastStatistics, waveform)};
+        }
+
+        const auto waveform = selectWaveform(lastStatistics, refreshMode);
+        if (lastStatistics.changedPixels == 0 && refreshMode != ::gui::RefreshModes::GUI_REFRESH_DEEP) {
+            // Same frame, only the explicitly requested deep clean is worth a refresh
+            return {false, waveform, selectBitsPerPixel(lastStatistics, waveform)};
+        }
+        accumulateGhosting(waveform, lastStatistics.changedPixels);
+        return {true, waveform, selectBitsPerPixel(lastStatistics, waveform)};
+    }
+
+    EinkWaveforms_e WaveformSelector::selectWaveform(const FrameStatistics &stats,
+                                                     ::gui::RefreshModes refreshMode) const
+    {
+        const auto isDeepRequested  = refreshMode == ::gui::RefreshModes::GUI_REFRESH_DEEP;
+        const auto isGreyscaleFrame = stats.toGreyTransitions * greyscaleFrameDivider > stats.changedPixels;
+        const auto isCleanRequested =
+            isDeepRequested && (stats.changedPixels == 0 || ghosting >= ghostingBudget / deepRequestGhostingDivider);
+        const auto isGhostingVisible = ghosting + stats.changedPixels * ghostingWeightA2 >= ghostingBudget;
+
+        if (isGreyscaleFrame || isGhostingVisible || isCleanRequested) {
+            return EinkWaveformGC16;
+        }
+        if (stats.binaryTransitions == stats.changedPixels && !isDeepRequested) {
+            return EinkWaveformA2;
+        }
+        return EinkWaveformDU2;
+    }
+
+    EinkBpp_e WaveformSelector::selectBitsPerPixel(const FrameStatistics &stats, EinkWaveforms_e waveform) noexcept
+    {
+        const auto isBinaryFrame = stats.greyPixels == 0;
+        switch (waveform) {
+        case EinkWaveformA2:
+            // A2 can't drive halftones, they are sent unchanged so they are not damaged by the update
+            return isBinaryFrame ? Eink1Bpp : Eink4Bpp;
+        case EinkWaveformDU2:
+            // 1bpp would lose the halftones (e.g. anti-aliased text), 2bpp keeps them only if they are at its levels
+            if (isBinaryFrame) {
+                return Eink1Bpp;
+            }
+            return stats.fineGreyPixels == 0 ? Eink2Bpp : Eink4Bpp;
+        default:
+            return Eink4Bpp;
+        }
+    }
+
+    void WaveformSelector::accumulateGhosting(EinkWaveforms_e waveform, std::uint32_t changedPixels) noexcept
+    {
+        switch (waveform) {
+        case EinkWaveformA2:
+            ghosting += changedPixels * ghostingWeightA2;
+            break;
+        case EinkWaveformDU2:
+            ghosting += changedPixels * ghostingWeightDU2;
+            break;
+        default:
+            ghosting = 0;
+            break;
+        }
+    }
+
+    FrameStatistics WaveformSelector::analyse(const std::uint8_t *frameBuffer)
+    {
+        FrameStatistics stats;
+        stats.greyPixels     = lastStatistics.greyPixels;
+        stats.fineGreyPixels = lastStatistics.fineGreyPixels;
+        const auto pairs = pixelCount / 2;
+        for (std::uint32_t i = 0; i < pairs; ++i) {
+            const auto first  = static_cast<std::uint8_t>(frameBuffer[2 * i] & levelMask);
+            const auto second = static_cast<std::uint8_t>(frameBuffer[2 * i + 1] & levelMask);
+            const auto packed = static_cast<std::uint8_t>(first | (second << 4));
+            if (packed == lastFrame[i]) {
+                continue;
+            }
+            classify(stats, lastFrame[i] & levelMask, first);
+            classify(stats, lastFrame[i] >> 4, second);
+            lastFrame[i] = packed;
+        }
+        if (pixelCount % 2 != 0) {
+            const auto last = static_cast<std::uint8_t>(frameBuffer[pixelCount - 1] & levelMask);
+            classify(stats, lastFrame[pairs] & levelMask, last);
+            lastFrame[pairs] = last;
+        }
+        return stats;
+    }
+
+    void WaveformSelector::invalidate() noexcept
+    {
+        lastFrameValid = false;
+    }
+
+    auto WaveformSelector::getLastStatistics() const noexcept -> const FrameStatistics &
+    {
+        return lastStatistics;
+    }
+
+    auto WaveformSelector::getGhosting() const noexcept -> std::uint32_t
+    {
+        return ghosting;
+    }
+} // namespace service::eink
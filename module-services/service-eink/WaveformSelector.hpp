@@ -0,0 +1,71 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <gui/Common.hpp>
+#include <gui/core/Color.hpp>
+
+#include <EinkIncludes.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace service::eink
+{
+    /// Grey level transitions of the pixels changed since the last displayed frame
+    struct FrameStatistics
+    {
+        std::uint32_t changedPixels       = 0;
+        std::uint32_t binaryTransitions   = 0; ///< From black or white to black or white
+        std::uint32_t toBinaryTransitions = 0; ///< From grey to black or white
+        std::uint32_t toGreyTransitions   = 0; ///< From any level to grey
+        std::uint32_t greyPixels          = 0; ///< Grey pixels in the whole frame
+        std::uint32_t fineGreyPixels      = 0; ///< Grey pixels which can't be sent with 2bpp, in the whole frame
+        std::array<std::uint32_t, ::gui::ColorScheme::numberOfColors> changedLevels{}; ///< New levels histogram
+    };
+
+    struct WaveformSelection
+    {
+        bool refreshNeeded;
+        EinkWaveforms_e waveform;
+        EinkBpp_e bpp; ///< Lowest transfer depth which keeps the frame content for the waveform
+    };
+
+    /**
+     * Picks the cheapest waveform which keeps the quality of the frame being displayed.
+     * Compares each frame with the last displayed one:
+     * - black and white only transitions are displayed with A2,
+     * - transitions to black and white (e.g. anti-aliased text) are displayed with DU2,
+     * - greyscale content is displayed with GC16.
+     * Ghosting left by the fast waveforms is accumulated and a GC16 deep clean is scheduled once it gets visible.
+     * The fast waveforms are transferred with 1 or 2 bits per pixel if the frame has no levels which would be lost.
+     */
+    class WaveformSelector
+    {
+      public:
+        explicit WaveformSelector(::gui::Size screenSize);
+
+        /// Analyses the frame and stores it as the last displayed one, invalidate() if it could not be displayed
+        WaveformSelection select(const std::uint8_t *frameBuffer, ::gui::RefreshModes refreshMode);
+        /// The content of the display is unknown, e.g. after the controller reset or the color mode change
+        void invalidate() noexcept;
+
+        [[nodiscard]] auto getLastStatistics() const noexcept -> const FrameStatistics &;
+        [[nodiscard]] auto getGhosting() const noexcept -> std::uint32_t;
+
+      private:
+        FrameStatistics analyse(const std::uint8_t *frameBuffer);
+        EinkWaveforms_e selectWaveform(const FrameStatistics &stats, ::gui::RefreshModes refreshMode) const;
+        static EinkBpp_e selectBitsPerPixel(const FrameStatistics &stats, EinkWaveforms_e waveform) noexcept;
+        void accumulateGhosting(EinkWaveforms_e waveform, std::uint32_t changedPixels) noexcept;
+
+        const std::uint32_t pixelCount;
+        const std::uint32_t ghostingBudget;
+        std::unique_ptr<std::uint8_t[]> lastFrame; ///< 4 bits per pixel
+        bool lastFrameValid    = false;
+        std::uint32_t ghosting = 0;
+        FrameStatistics lastStatistics;
+    };
+} // namespace service::eink
@@ -0,0 +1,243 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include "WaveformSelector.hpp"
+
+#include <vector>
+
+using namespace service::eink;
+
+namespace
+{
+    constexpr auto width  = 4;
+    constexpr auto height = 3;
+    constexpr auto grey   = 0x07;
+
+    std::vector<std::uint8_t> createFrame(std::uint8_t level)
+    {
+        return std::vector<std::uint8_t>(width * height, level);
+    }
+
+    WaveformSelection select(WaveformSelector &selector,
+                             std::vector<std::uint8_t> &frame,
+                             ::gui::RefreshModes mode = ::gui::RefreshModes::GUI_REFRESH_FAST)
+    {
+        return selector.select(frame.data(), mode);
+    }
+} // namespace
+
+TEST_CASE("Waveform selector - first frame follows the requested mode")
+{
+    auto frame = createFrame(::gui::Color::White);
+
+    WaveformSelector fastSelector{{width, height}};
+    const auto fast = select(fastSelector, frame);
+    REQUIRE(fast.refreshNeeded);
+    REQUIRE(fast.waveform == EinkWaveformDU2);
+    REQUIRE(fast.bpp == Eink1Bpp);
+
+    WaveformSelector deepSelector{{width, height}};
+    const auto deep = select(deepSelector, frame, ::gui::RefreshModes::GUI_REFRESH_DEEP);
+    REQUIRE(deep.refreshNeeded);
+    REQUIRE(deep.waveform == EinkWaveformGC16);
+    REQUIRE(deepSelector.getGhosting() == 0);
+}
+
+TEST_CASE("Waveform selector - frame analysis")
+{
+    WaveformSelector selector{{width, height}};
+    auto frame = createFrame(::gui::Color::White);
+    select(selector, frame, ::gui::RefreshModes::GUI_REFRESH_DEEP);
+
+    SECTION("Unchanged frame")
+    {
+        REQUIRE_FALSE(select(selector, frame).refreshNeeded);
+        REQUIRE(selector.getLastStatistics().changedPixels == 0);
+    }
+
+    SECTION("Black and white transitions")
+    {
+        frame[0] = ::gui::Color::Black;
+        frame[5] = ::gui::Color::Black;
+
+        const auto selection = select(selector, frame);
+        REQUIRE(selection.refreshNeeded);
+        REQUIRE(selection.waveform == EinkWaveformA2);
+
+        const auto &stats = selector.getLastStatistics();
+        REQUIRE(stats.changedPixels == 2);
+        REQUIRE(stats.binaryTransitions == 2);
+        REQUIRE(stats.changedLevels[::gui::Color::Black] == 2);
+    }
+
+    SECTION("Deep request never uses A2")
+    {
+        frame[0] = ::gui::Color::Black;
+        REQUIRE(select(selector, frame, ::gui::RefreshModes::GUI_REFRESH_DEEP).waveform == EinkWaveformDU2);
+    }
+
+    SECTION("Anti-aliased text")
+    {
+        frame[0] = grey;
+        frame[1] = frame[2] = frame[3] = frame[4] = frame[5] = ::gui::Color::Black;
+        REQUIRE(select(selector, frame).waveform == EinkWaveformDU2);
+
+        const auto &stats = selector.getLastStatistics();
+        REQUIRE(stats.changedPixels == 6);
+        REQUIRE(stats.toGreyTransitions == 1);
+        REQUIRE(stats.binaryTransitions == 5);
+        REQUIRE(stats.changedLevels[grey] == 1);
+
+        frame[0] = ::gui::Color::Black;
+        REQUIRE(select(selector, frame).waveform == EinkWaveformDU2);
+        REQUIRE(selector.getLastStatistics().toBinaryTransitions == 1);
+    }
+
+    SECTION("Greyscale image")
+    {
+        frame[0] = frame[1] = grey;
+        frame[2]            = ::gui::Color::Black;
+        const auto selection = select(selector, frame);
+        REQUIRE(selection.waveform == EinkWaveformGC16);
+        REQUIRE(selector.getLastStatistics().toGreyTransitions == 2);
+    }
+
+    SECTION("Binary frame")
+    {
+        frame[0] = grey;
+        REQUIRE(select(selector, frame).bpp == Eink4Bpp);
+        REQUIRE(selector.getLastStatistics().greyPixels == 1);
+
+        frame[0] = ::gui::Color::Black;
+        REQUIRE(select(selector, frame).bpp == Eink1Bpp);
+        REQUIRE(selector.getLastStatistics().greyPixels == 0);
+    }
+
+    SECTION("Invalidated frame follows the requested mode")
+    {
+        selector.invalidate();
+        REQUIRE(select(selector, frame).refreshNeeded);
+    }
+}
+
+TEST_CASE("Waveform selector - transfer depth")
+{
+    constexpr auto grey2Bpp = 0x05;
+    WaveformSelector selector{{width, height}};
+    auto frame = createFrame(::gui::Color::White);
+    REQUIRE(select(selector, frame, ::gui::RefreshModes::GUI_REFRESH_DEEP).bpp == Eink4Bpp);
+
+    SECTION("Black and white frame")
+    {
+        frame[0] = ::gui::Color::Black;
+        const auto selection = select(selector, frame);
+        REQUIRE(selection.waveform == EinkWaveformA2);
+        REQUIRE(selection.bpp == Eink1Bpp);
+    }
+
+    SECTION("Halftones at the 2bpp levels")
+    {
+        frame[0] = grey2Bpp;
+        frame[1] = frame[2] = frame[3] = frame[4] = frame[5] = ::gui::Color::Black;
+        const auto selection = select(selector, frame);
+        REQUIRE(selection.waveform == EinkWaveformDU2);
+        REQUIRE(selection.bpp == Eink2Bpp);
+        REQUIRE(selector.getLastStatistics().fineGreyPixels == 0);
+    }
+
+    SECTION("Halftones between the 2bpp levels")
+    {
+        frame[0] = grey;
+        frame[1] = frame[2] = frame[3] = frame[4] = frame[5] = ::gui::Color::Black;
+        const auto selection = select(selector, frame);
+        REQUIRE(selection.waveform == EinkWaveformDU2);
+        REQUIRE(selection.bpp == Eink4Bpp);
+        REQUIRE(selector.getLastStatistics().fineGreyPixels == 1);
+    }
+
+    SECTION("Unchanged greyscale content is kept by the fast update")
+    {
+        frame[0] = frame[1] = grey;
+        REQUIRE(select(selector, frame).waveform == EinkWaveformGC16);
+
+        frame[0] = ::gui::Color::Black;
+        const auto selection = select(selector, frame);
+        REQUIRE(selection.waveform == EinkWaveformDU2);
+        REQUIRE(selection.bpp == Eink4Bpp);
+
+        frame[1] = ::gui::Color::Black;
+        REQUIRE(select(selector, frame).bpp == Eink1Bpp);
+        REQUIRE(selector.getLastStatistics().fineGreyPixels == 0);
+    }
+
+    SECTION("Halftones with A2")
+    {
+        frame[0] = grey2Bpp;
+        frame[1] = frame[2] = frame[3] = frame[4] = frame[5] = ::gui::Color::Black;
+        select(selector, frame);
+
+        frame[6] = ::gui::Color::Black;
+        const auto selection = select(selector, frame);
+        REQUIRE(selection.waveform == EinkWaveformA2);
+        REQUIRE(selection.bpp == Eink4Bpp);
+    }
+}
+
+TEST_CASE("Waveform selector - deep request of the unchanged frame")
+{
+    WaveformSelector selector{{width, height}};
+    auto white = createFrame(::gui::Color::White);
+    auto black = createFrame(::gui::Color::Black);
+    select(selector, white, ::gui::RefreshModes::GUI_REFRESH_DEEP);
+    select(selector, black);
+    REQUIRE(selector.getGhosting() > 0);
+
+    REQUIRE_FALSE(select(selector, black).refreshNeeded);
+
+    const auto selection = select(selector, black, ::gui::RefreshModes::GUI_REFRESH_DEEP);
+    REQUIRE(selection.refreshNeeded);
+    REQUIRE(selection.waveform == EinkWaveformGC16);
+    REQUIRE(selector.getGhosting() == 0);
+
+    // Display is cleaned on every explicit request, even if it is not ghosted
+    REQUIRE(select(selector, black, ::gui::RefreshModes::GUI_REFRESH_DEEP).waveform == EinkWaveformGC16);
+}
+
+TEST_CASE("Waveform selector - ghosting")
+{
+    WaveformSelector selector{{width, height}};
+    auto white = createFrame(::gui::Color::White);
+    auto black = createFrame(::gui::Color::Black);
+    select(selector, white, ::gui::RefreshModes::GUI_REFRESH_DEEP);
+
+    auto fastRefreshes = 0;
+    for (;;) {
+        const auto selection = select(selector, fastRefreshes % 2 == 0 ? black : white);
+        if (selection.waveform == EinkWaveformGC16) {
+            break;
+        }
+        REQUIRE(selection.waveform == EinkWaveformA2);
+        REQUIRE(selector.getGhosting() > 0);
+        ++fastRefreshes;
+    }
+    REQUIRE(fastRefreshes > 1);
+    REQUIRE(selector.getGhosting() == 0);
+
+    SECTION("Deep request cleans ghosted display")
+    {
+        white[0] = ::gui::Color::Black;
+        REQUIRE(select(selector, white).waveform == EinkWaveformA2);
+        // Changed frame of the barely ghosted display does not need the deep clean
+        white[1] = ::gui::Color::Black;
+        REQUIRE(select(selector, white, ::gui::RefreshModes::GUI_REFRESH_DEEP).waveform == EinkWaveformDU2);
+
+        for (auto i = 0; i < fastRefreshes; ++i) {
+            select(selector, i % 2 == 0 ? black : white);
+        }
+        const auto selection = select(selector, white, ::gui::RefreshModes::GUI_REFRESH_DEEP);
+        REQUIRE(selection.refreshNeeded);
+        REQUIRE(selection.waveform == EinkWaveformGC16);
+    }
+}
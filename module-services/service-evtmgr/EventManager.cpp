@@ -13,7 +13,6 @@
 #include <BaseInterface.hpp>
 #include <MessageType.hpp>
 #include <Service/Worker.hpp>
-#include <Timers/TimerFactory.hpp>
 #include <system/Constants.hpp>
 #include <SystemManager/SystemManagerCommon.hpp>
 #include <bsp/common.hpp>
@@ -50,12 +49,6 @@
 #define debug_input_events(...)
 #endif
 
-namespace
-{
-    constexpr auto loggerDelayMs   = 1000 * 60 * 5;
-    constexpr auto loggerTimerName = "Logger";
-} // namespace
-
 EventManagerSentinel::EventManagerSentinel(std::shared_ptr<sys::CpuSentinel> cpuSentinel,
                                            bsp::CpuFrequencyMHz frequencyToHold)
     : cpuSentinel(cpuSentinel)
@@ -69,18 +62,13 @@ EventManagerSentinel::~EventManagerSentinel()
 }
 
 EventManagerCommon::EventManagerCommon(LogDumpFunction logDumpFunction, const std::string &name)
-    : sys::Service(name, "", stackDepth), loggerTimer{sys::TimerFactory::createPeriodicTimer(
-                                              this,
-                                              loggerTimerName,
-                                              std::chrono::milliseconds{loggerDelayMs},
-                                              [this](sys::Timer & /*timer*/) { dumpLogsToFile(); })},
-      logDumpFunction(logDumpFunction), settings(std::make_shared<settings::Settings>())
+    : sys::Service(name, "", stackDepth), logDumpFunction(logDumpFunction),
+      settings(std::make_shared<settings::Settings>())
 {
     LOG_INFO("[%s] Initializing", name.c_str());
     alarmTimestamp = 0;
     alarmID        = 0;
     bus.channels.push_back(sys::BusChannel::ServiceDBNotifications);
-    loggerTimer.start();
 }
 
 EventManagerCommon::~EventManagerCommon()
@@ -12,6 +12,7 @@
 #include <purefs/fs/inotify_message.hpp>
 #include <purefs/fs/inotify.hpp>
 #include <service-db/DBServiceAPI.hpp>
+#include <tags_fetcher/SoundsCatalog.hpp>
 #include <tags_fetcher/TagsFetcher.hpp>
 
 namespace service::detail
@@ -102,7 +103,8 @@ namespace service::detail
             return {};
         }
 
-        std::optional<db::multimedia_files::MultimediaFilesRecord> CreateMultimediaFilesRecord(const fs::path &path)
+        std::optional<db::multimedia_files::MultimediaFilesRecord> CreateMultimediaFilesRecord(
+            const fs::path &path, const tags::fetcher::Tags &tags)
         {
             std::error_code errorCode;
             auto fileSize = fs::file_size(path, errorCode);
@@ -111,7 +113,6 @@ namespace service::detail
                 return {};
             }
             auto mimeType = getMimeType(path);
-            auto tags     = tags::fetcher::fetchTags(path);
 
             db::multimedia_files::MultimediaFilesRecord record{
                 Record(DB_ID_NONE),
@@ -153,7 +154,10 @@ namespace service::detail
             return;
         }
 
-        auto record = CreateMultimediaFilesRecord(path);
+        const auto tags = tags::fetcher::fetchTags(std::string(path));
+        tags::SoundsCatalog::getInstance().update(tags);
+
+        auto record = CreateMultimediaFilesRecord(path, tags);
         if (record.has_value()) {
             auto query = std::make_unique<db::multimedia_files::query::Add>(record.value());
             DBServiceAPI::GetQuery(svc.get(), db::Interface::Name::MultimediaFiles, std::move(query));
@@ -178,6 +182,8 @@ namespace service::detail
             return;
         }
 
+        tags::SoundsCatalog::getInstance().remove(path);
+
         auto query = std::make_unique<db::multimedia_files::query::RemoveByPath>(std::string(path));
         DBServiceAPI::GetQuery(svc.get(), db::Interface::Name::MultimediaFiles, std::move(query));
     }
@@ -7,6 +7,7 @@
 
 #include <log/log.hpp>
 #include <purefs/filesystem_paths.hpp>
+#include <tags_fetcher/SoundsCatalog.hpp>
 
 namespace
 {
@@ -33,6 +34,8 @@ namespace service
     // Initialize data notification handler
     sys::ReturnCodes ServiceFileIndexer::InitHandler()
     {
+        tags::SoundsCatalog::getInstance().init(purefs::dir::getCurrentOSPath());
+
         if (mInotifyHandler.init(shared_from_this())) {
             mInotifyHandler.addWatch(getMusicPath());
 
@@ -6,6 +6,7 @@
 #include "MessageType.hpp"     // for MessageType, MessageType::MessageType...
 #include "Service/Mailbox.hpp" // for Mailbox
 #include <Service/Message.hpp> // for Message, MessagePointer, DataMessage, Resp...
+#include <Service/StackRegistry.hpp>
 #include "Timers/SystemTimer.hpp"
 #include "Timers/TimerHandle.hpp"  // for Timer
 #include "Timers/TimerMessage.hpp" // for TimerMessage
@@ -70,7 +71,9 @@ namespace sys
         : cpp_freertos::Thread(name, stackDepth / 4 /* Stack depth in bytes */, static_cast<UBaseType_t>(priority)),
           parent(parent), bus(this, watchdog), mailbox(this), watchdog(watchdog), pingTimestamp(UINT32_MAX),
           isReady(false), enableRunLoop(false)
-    {}
+    {
+        StackRegistry::add(GetName(), stackDepth);
+    }
 
     Service::~Service()
     {
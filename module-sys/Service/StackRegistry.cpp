@@ -0,0 +1,49 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <Service/StackRegistry.hpp>
+
+#include <FreeRTOS.h>
+#include <LockGuard.hpp>
+#include <mutex.hpp>
+
+#include <map>
+
+namespace sys
+{
+    namespace
+    {
+        struct Registry
+        {
+            cpp_freertos::MutexStandard mutex;
+            std::map<std::string, std::uint32_t> sizes;
+        };
+
+        Registry &getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        /// The scheduler reports task names truncated to configMAX_TASK_NAME_LEN
+        std::string toTaskName(const std::string &name)
+        {
+            return name.substr(0, configMAX_TASK_NAME_LEN - 1);
+        }
+    } // namespace
+
+    void StackRegistry::add(const std::string &taskName, std::uint32_t stackSizeBytes)
+    {
+        auto &registry = getRegistry();
+        LockGuard lock(registry.mutex);
+        registry.sizes[toTaskName(taskName)] = stackSizeBytes;
+    }
+
+    auto StackRegistry::getSize(const std::string &taskName) -> std::uint32_t
+    {
+        auto &registry = getRegistry();
+        LockGuard lock(registry.mutex);
+        const auto it = registry.sizes.find(toTaskName(taskName));
+        return it != registry.sizes.end() ? it->second : 0;
+    }
+} // namespace sys
@@ -2,6 +2,7 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include <Service/Worker.hpp>
+#include <Service/StackRegistry.hpp>
 
 extern "C"
 {
@@ -210,6 +211,7 @@ namespace sys
         assert(getState() == State::Initiated);
 
         runnerTask = xTaskGetCurrentTaskHandle();
+        StackRegistry::add(name, stackDepth);
 
         BaseType_t task_error = 0;
         task_error            = xTaskCreate(
@@ -0,0 +1,20 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace sys
+{
+    /// Stack sizes of the system tasks. The scheduler reports only the free stack of a task, so the sizes requested
+    /// by services and workers are kept here to report the stack usage.
+    class StackRegistry
+    {
+      public:
+        static void add(const std::string &taskName, std::uint32_t stackSizeBytes);
+        /// @return stack size in bytes, 0 if the task is unknown
+        [[nodiscard]] static auto getSize(const std::string &taskName) -> std::uint32_t;
+    };
+} // namespace sys
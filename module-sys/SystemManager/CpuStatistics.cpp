@@ -2,6 +2,7 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include <SystemManager/CpuStatistics.hpp>
+#include <Service/StackRegistry.hpp>
 #include <log/log.hpp>
 #include <FreeRTOS.h>
 #include <task.h>
@@ -9,6 +10,9 @@
 
 namespace sys
 {
+    CpuStatistics::CpuStatistics() : stackStatistics{StackRegistry::getSize}
+    {}
+
     void CpuStatistics::Update()
     {
         uint32_t idleTickCount  = xTaskGetIdleRunTimeCounter();
@@ -26,6 +30,33 @@ namespace sys
 
         lastIdleTickCount  = idleTickCount;
         lastTotalTickCount = totalTickCount;
+
+        UpdateTaskStatistics();
+    }
+
+    void CpuStatistics::UpdateTaskStatistics()
+    {
+        // some room for tasks created in the meantime
+        constexpr auto spareEntries = 4;
+        tasksStatus.resize(uxTaskGetNumberOfTasks() + spareEntries);
+
+        uint32_t totalRunTime = 0;
+        const auto filled     = uxTaskGetSystemState(tasksStatus.data(), tasksStatus.size(), &totalRunTime);
+        if (filled == 0) {
+            return;
+        }
+
+        taskRunTimes.clear();
+        taskStacks.clear();
+        for (UBaseType_t i = 0; i < filled; ++i) {
+            const auto &status = tasksStatus[i];
+            taskRunTimes.push_back({status.xTaskNumber, status.pcTaskName, status.ulRunTimeCounter});
+            taskStacks.push_back({status.xTaskNumber,
+                                  status.pcTaskName,
+                                  static_cast<std::uint32_t>(status.usStackHighWaterMark * sizeof(StackType_t))});
+        }
+        taskStatistics.Update(totalRunTime, taskRunTimes);
+        stackStatistics.Update(taskStacks);
     }
 
     uint32_t CpuStatistics::GetPercentageCpuLoad() const noexcept
@@ -33,6 +64,16 @@ namespace sys
         return cpuLoad;
     }
 
+    const TaskStatistics &CpuStatistics::GetTaskStatistics() const noexcept
+    {
+        return taskStatistics;
+    }
+
+    StackStatistics &CpuStatistics::GetStackStatistics() noexcept
+    {
+        return stackStatistics;
+    }
+
     uint32_t CpuStatistics::ComputeIncrease(uint32_t currentCount, uint32_t lastCount) const
     {
         if (currentCount >= lastCount) {
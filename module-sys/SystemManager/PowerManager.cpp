@@ -3,6 +3,8 @@
 
 #include <log/log.hpp>
 
+#include <algorithm>
+
 #include <SystemManager/PowerManager.hpp>
 
 namespace sys
@@ -12,6 +14,7 @@ namespace sys
         constexpr auto lowestLevelName{"lowestCpuFrequency"};
         constexpr auto middleLevelName{"middleCpuFrequency"};
         constexpr auto highestLevelName{"highestCpuFrequency"};
+        constexpr auto loadOwnersToLog{3};
     } // namespace
 
     CpuFrequencyMonitor::CpuFrequencyMonitor(const std::string name) : levelName(name)
@@ -71,8 +74,9 @@ namespace sys
         }
     }
 
-    void PowerManager::UpdateCpuFrequency(uint32_t cpuLoad)
+    void PowerManager::UpdateCpuFrequency(const CpuStatistics &cpuStatistics)
     {
+        const auto cpuLoad                  = cpuStatistics.GetPercentageCpuLoad();
         const auto currentCpuFreq           = lowPowerControl->GetCurrentFrequencyLevel();
         const auto minFrequencyRequested    = cpuGovernor->GetMinimumFrequencyRequested();
         const auto permanentFrequencyToHold = cpuGovernor->GetPermanentFrequencyRequested();
@@ -114,6 +118,7 @@ namespace sys
             IncreaseCpuFrequency(minFrequencyRequested);
         }
         else if (aboveThresholdCounter >= powerProfile.maxAboveThresholdCount) {
+            LogCpuLoadOwners(cpuStatistics);
             if (powerProfile.frequencyIncreaseIntermediateStep && currentCpuFreq < bsp::CpuFrequencyMHz::Level_4) {
                 ResetFrequencyShiftCounter();
                 IncreaseCpuFrequency(bsp::CpuFrequencyMHz::Level_4);
@@ -276,6 +281,16 @@ namespace sys
         lastCpuFrequencyChangeTimestamp = ticks;
     }
 
+    void PowerManager::LogCpuLoadOwners(const CpuStatistics &cpuStatistics) const
+    {
+        const auto owners = cpuStatistics.GetTaskStatistics().GetOwnersLoad();
+        std::string log{"CPU load above threshold, top consumers: "};
+        for (std::size_t i = 0; i < std::min<std::size_t>(owners.size(), loadOwnersToLog); ++i) {
+            log.append(owners[i].owner + ": " + std::to_string(owners[i].permille / 10) + "% ");
+        }
+        LOG_INFO("%s", log.c_str());
+    }
+
     void PowerManager::LogPowerManagerEfficiency()
     {
         std::string log{"PowerManager Efficiency: "};
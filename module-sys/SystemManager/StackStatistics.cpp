@@ -0,0 +1,147 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <SystemManager/StackStatistics.hpp>
+
+#include <json11.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace sys
+{
+    namespace
+    {
+        namespace json
+        {
+            constexpr auto size      = "size";
+            constexpr auto minFree   = "minFree";
+            constexpr auto peak      = "peak";
+            constexpr auto suggested = "suggested";
+        } // namespace json
+
+        constexpr auto noPeak = std::numeric_limits<std::uint32_t>::max();
+
+        auto toPermille(const StackUsage &usage) -> std::uint64_t
+        {
+            if (usage.sizeBytes == 0) {
+                return std::numeric_limits<std::uint64_t>::max();
+            }
+            return static_cast<std::uint64_t>(usage.minFreeBytes) * 1000 / usage.sizeBytes;
+        }
+    } // namespace
+
+    auto StackUsage::GetPeakBytes() const noexcept -> std::uint32_t
+    {
+        return sizeBytes > minFreeBytes ? sizeBytes - minFreeBytes : 0;
+    }
+
+    auto StackUsage::GetSuggestedSize() const noexcept -> std::uint32_t
+    {
+        if (sizeBytes == 0) {
+            return 0;
+        }
+        const auto peak     = GetPeakBytes();
+        const auto required = peak + std::max(peak / 4, minMarginBytes);
+        return (required + alignmentBytes - 1) / alignmentBytes * alignmentBytes;
+    }
+
+    auto StackUsage::IsNearOverflow() const noexcept -> bool
+    {
+        return sizeBytes != 0 &&
+               static_cast<std::uint64_t>(minFreeBytes) * 100 < static_cast<std::uint64_t>(sizeBytes) * warningPercent;
+    }
+
+    StackStatistics::StackStatistics(StackSizeProvider getStackSize) : getStackSize{std::move(getStackSize)}
+    {}
+
+    void StackStatistics::Update(const std::vector<TaskStack> &tasks)
+    {
+        ++updatesCount;
+        for (const auto &task : tasks) {
+            auto [info, created] = tasksInfo.try_emplace(task.id);
+            if (created) {
+                info->second.usage = &GetUsage(task.name != nullptr ? task.name : "");
+            }
+            info->second.lastSeen = updatesCount;
+
+            auto &usage = *info->second.usage;
+            if (task.freeBytes < usage.minFreeBytes) {
+                usage.minFreeBytes = task.freeBytes;
+                modified           = true;
+            }
+        }
+
+        for (auto it = tasksInfo.begin(); it != tasksInfo.end();) {
+            if (it->second.lastSeen != updatesCount) {
+                it = tasksInfo.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    auto StackStatistics::GetUsage(const std::string &name) -> StackUsage &
+    {
+        const auto size       = getStackSize(name);
+        auto [usage, created] = peaks.try_emplace(name, StackUsage{name, size, noPeak});
+        if (!created && size != 0 && usage->second.sizeBytes != size) {
+            // peaks of the previous stack size are not relevant anymore
+            usage->second = StackUsage{name, size, noPeak};
+        }
+        return usage->second;
+    }
+
+    auto StackStatistics::GetUsage() const -> std::vector<StackUsage>
+    {
+        std::vector<StackUsage> usages;
+        usages.reserve(peaks.size());
+        for (const auto &[name, usage] : peaks) {
+            if (usage.minFreeBytes != noPeak) {
+                usages.push_back(usage);
+            }
+        }
+        std::stable_sort(usages.begin(), usages.end(), [](const auto &lhs, const auto &rhs) {
+            return toPermille(lhs) < toPermille(rhs);
+        });
+        return usages;
+    }
+
+    auto StackStatistics::IsModified() const noexcept -> bool
+    {
+        return modified;
+    }
+
+    auto StackStatistics::Deserialize(const std::string &data) -> bool
+    {
+        std::string error;
+        const auto stored = json11::Json::parse(data, error);
+        if (!error.empty() || !stored.is_object()) {
+            return false;
+        }
+
+        for (const auto &[name, value] : stored.object_items()) {
+            const auto size       = static_cast<std::uint32_t>(value[json::size].int_value());
+            const auto minFree    = static_cast<std::uint32_t>(value[json::minFree].int_value());
+            auto [usage, created] = peaks.try_emplace(name, StackUsage{name, size, minFree});
+            if (!created && usage->second.sizeBytes == size) {
+                usage->second.minFreeBytes = std::min(usage->second.minFreeBytes, minFree);
+            }
+        }
+        return true;
+    }
+
+    auto StackStatistics::Serialize() -> std::string
+    {
+        json11::Json::object stored;
+        for (const auto &usage : GetUsage()) {
+            stored[usage.name] = json11::Json::object{{json::size, static_cast<int>(usage.sizeBytes)},
+                                                      {json::minFree, static_cast<int>(usage.minFreeBytes)},
+                                                      {json::peak, static_cast<int>(usage.GetPeakBytes())},
+                                                      {json::suggested, static_cast<int>(usage.GetSuggestedSize())}};
+        }
+        modified = false;
+        return json11::Json{stored}.dump();
+    }
+} // namespace sys
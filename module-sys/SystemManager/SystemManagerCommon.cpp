@@ -11,6 +11,9 @@
 #include "ticks.hpp"
 #include "critical.hpp"
 #include <algorithm>
+#include <cinttypes>
+#include <fstream>
+#include <sstream>
 #include <service-evtmgr/KbdMessage.hpp>
 #include <service-evtmgr/BatteryMessages.hpp>
 #include <service-evtmgr/Constants.hpp>
@@ -18,6 +21,7 @@
 #include <service-evtmgr/EVMessages.hpp>
 #include <service-appmgr/messages/UserPowerDownRequest.hpp>
 #include <service-desktop/Constants.hpp>
+#include <service-desktop/DesktopMessages.hpp>
 #include <service-appmgr/Constants.hpp>
 #include <service-appmgr/Controller.hpp>
 #include <system/messages/DeviceRegistrationMessage.hpp>
@@ -27,6 +31,8 @@
 #include "Timers/TimerFactory.hpp"
 #include <service-appmgr/StartupType.hpp>
 #include <purefs/vfs_subsystem.hpp>
+#include <purefs/filesystem_paths.hpp>
+#include <Service/StackRegistry.hpp>
 #include <service-gui/Common.hpp>
 #include <service-db/DBServiceName.hpp>
 #include <module-gui/gui/Common.hpp>
@@ -40,6 +46,14 @@ namespace sys
     {
         constexpr std::chrono::milliseconds preShutdownRoutineTimeout{1500};
         constexpr std::chrono::milliseconds lowBatteryShutdownDelayTime{5000};
+        constexpr auto stackUsageFileName = "stack_usage.json";
+        constexpr auto idleTaskName       = "IDLE";
+        constexpr auto timerTaskName      = "Tmr Svc";
+
+        std::filesystem::path getStackUsagePath()
+        {
+            return purefs::dir::getLogsPath() / stackUsageFileName;
+        }
     } // namespace
 
     namespace state
@@ -248,6 +262,17 @@ namespace sys
                 powerManager->LogPowerManagerEfficiency();
             });
         powerManagerEfficiencyTimer.start();
+
+        StackRegistry::add(idleTaskName, configMINIMAL_STACK_SIZE * sizeof(StackType_t));
+        StackRegistry::add(timerTaskName, configTIMER_TASK_STACK_DEPTH * sizeof(StackType_t));
+#if defined(TARGET_RT1051)
+        // tasks of the Linux port run on their own pthread stacks, so their high-water marks are meaningless
+        stackUsageTimer = sys::TimerFactory::createPeriodicTimer(
+            this, "stackUsage", constants::stackUsageReportInterval, [this](sys::Timer &) {
+                StackUsageTimerHandler();
+            });
+        stackUsageTimer.start();
+#endif
     }
 
     bool SystemManagerCommon::Restore(Service *s)
@@ -415,6 +440,10 @@ namespace sys
 
     void SystemManagerCommon::preCloseRoutine(CloseReason closeReason)
     {
+        if (stackUsageLoaded) {
+            StoreStackUsage();
+        }
+
         for (const auto &service : servicesList) {
             auto msg = std::make_shared<ServiceCloseReasonMessage>(closeReason);
             bus.sendUnicast(std::move(msg), service->GetName());
@@ -629,6 +658,18 @@ namespace sys
             return sys::MessageNone{};
         });
 
+        connect(typeid(sdesktop::developerMode::DeveloperModeRequest), [this](sys::Message *message) {
+            auto request = static_cast<sdesktop::developerMode::DeveloperModeRequest *>(message);
+            if (request->event != nullptr &&
+                typeid(*request->event) == typeid(sdesktop::developerMode::CpuStatisticsInfoRequestEvent)) {
+                auto event = std::make_unique<sdesktop::developerMode::CpuStatisticsInfoRequestEvent>(
+                    cpuStatistics->GetPercentageCpuLoad(), cpuStatistics->GetTaskStatistics().GetTasksLoad());
+                bus.sendUnicast(std::make_shared<sdesktop::developerMode::DeveloperModeRequest>(std::move(event)),
+                                service::name::service_desktop);
+            }
+            return sys::MessageNone{};
+        });
+
         deviceManager->RegisterNewDevice(powerManager->getExternalRamDevice());
 
         cpuSentinel = std::make_shared<sys::CpuSentinel>(
@@ -716,7 +757,62 @@ namespace sys
         }
 
         cpuStatistics->Update();
-        powerManager->UpdateCpuFrequency(cpuStatistics->GetPercentageCpuLoad());
+        powerManager->UpdateCpuFrequency(*cpuStatistics);
+    }
+
+    void SystemManagerCommon::StackUsageTimerHandler()
+    {
+        auto &stackStatistics = cpuStatistics->GetStackStatistics();
+        if (!stackUsageLoaded) {
+            stackUsageLoaded = true;
+            std::ifstream file(getStackUsagePath());
+            if (file.good()) {
+                std::stringstream buffer;
+                buffer << file.rdbuf();
+                if (!stackStatistics.Deserialize(buffer.str())) {
+                    LOG_WARN("Failed to parse the stored stack usage");
+                }
+            }
+        }
+
+        LogStackUsage();
+        StoreStackUsage();
+    }
+
+    void SystemManagerCommon::LogStackUsage() const
+    {
+        std::uint32_t reclaimableBytes = 0;
+        const auto usages              = cpuStatistics->GetStackStatistics().GetUsage();
+        for (const auto &usage : usages) {
+            if (usage.IsNearOverflow()) {
+                LOG_WARN("Stack of %s is close to overflow: %" PRIu32 " of %" PRIu32 " bytes used",
+                         usage.name.c_str(),
+                         usage.GetPeakBytes(),
+                         usage.sizeBytes);
+            }
+            else if (const auto suggested = usage.GetSuggestedSize(); suggested < usage.sizeBytes) {
+                reclaimableBytes += usage.sizeBytes - suggested;
+                LOG_DEBUG("Stack of %s: %" PRIu32 " of %" PRIu32 " bytes used, suggested size: %" PRIu32,
+                          usage.name.c_str(),
+                          usage.GetPeakBytes(),
+                          usage.sizeBytes,
+                          suggested);
+            }
+        }
+        LOG_INFO("Stack usage of %zu tasks, %" PRIu32 " bytes could be reclaimed", usages.size(), reclaimableBytes);
+    }
+
+    void SystemManagerCommon::StoreStackUsage()
+    {
+        auto &stackStatistics = cpuStatistics->GetStackStatistics();
+        if (!stackStatistics.IsModified()) {
+            return;
+        }
+        std::ofstream file(getStackUsagePath(), std::ios::trunc);
+        file << stackStatistics.Serialize();
+        if (!file.good()) {
+            LOG_ERROR("Failed to store the stack usage");
+        }
     }
 
     void SystemManagerCommon::UpdateResourcesAfterCpuFrequencyChange(bsp::CpuFrequencyMHz newFrequency)
@@ -0,0 +1,140 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <SystemManager/TaskStatistics.hpp>
+
+#include <algorithm>
+#include <cctype>
+
+namespace sys
+{
+    namespace
+    {
+        constexpr auto workerSuffix = "_w";
+
+        auto toPermille(std::uint64_t runTime, std::uint64_t totalRunTime) -> std::uint32_t
+        {
+            if (totalRunTime == 0) {
+                return 0;
+            }
+            return static_cast<std::uint32_t>(std::min<std::uint64_t>(runTime * 1000 / totalRunTime, 1000));
+        }
+
+        void sortByRunTime(std::vector<TaskLoad> &loads)
+        {
+            std::sort(loads.begin(), loads.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.runTime > rhs.runTime;
+            });
+        }
+    } // namespace
+
+    void TaskStatistics::Update(std::uint32_t totalRunTime, const std::vector<TaskRunTime> &tasks)
+    {
+        const bool firstUpdate = updatesCount++ == 0;
+        auto &sample           = samples[nextSample];
+        sample.tasks.clear();
+        // unsigned arithmetic handles counters overflow
+        sample.totalRunTime = totalRunTime - lastTotalRunTime;
+        lastTotalRunTime    = totalRunTime;
+
+        for (const auto &task : tasks) {
+            auto [info, created] = tasksInfo.try_emplace(task.id);
+            if (created) {
+                info->second.name        = task.name != nullptr ? task.name : "";
+                info->second.owner       = GetOwnerName(info->second.name);
+                info->second.lastRunTime = firstUpdate ? task.runTime : 0;
+            }
+            sample.tasks.push_back({task.id, task.runTime - info->second.lastRunTime});
+            info->second.lastRunTime = task.runTime;
+            info->second.lastSeen    = updatesCount;
+        }
+
+        if (firstUpdate) {
+            // only the reference point is known
+            return;
+        }
+        nextSample   = (nextSample + 1) % historySize;
+        samplesCount = std::min(samplesCount + 1, historySize);
+        RemoveFinishedTasks();
+    }
+
+    void TaskStatistics::RemoveFinishedTasks()
+    {
+        for (auto it = tasksInfo.begin(); it != tasksInfo.end();) {
+            // keep information as long as the task may be referenced by the stored samples
+            if (updatesCount - it->second.lastSeen > historySize) {
+                it = tasksInfo.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    auto TaskStatistics::GetTotalRunTime() const -> std::uint64_t
+    {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < samplesCount; ++i) {
+            total += samples[i].totalRunTime;
+        }
+        return total;
+    }
+
+    auto TaskStatistics::GetTasksLoad() const -> std::vector<TaskLoad>
+    {
+        std::map<std::uint32_t, std::uint64_t> runTimes;
+        for (std::size_t i = 0; i < samplesCount; ++i) {
+            for (const auto &entry : samples[i].tasks) {
+                runTimes[entry.id] += entry.runTime;
+            }
+        }
+
+        const auto total = GetTotalRunTime();
+        std::vector<TaskLoad> loads;
+        loads.reserve(runTimes.size());
+        for (const auto &[id, runTime] : runTimes) {
+            if (const auto info = tasksInfo.find(id); info != tasksInfo.end()) {
+                loads.push_back(TaskLoad{info->second.name,
+                                         info->second.owner,
+                                         static_cast<std::uint32_t>(runTime),
+                                         toPermille(runTime, total)});
+            }
+        }
+        sortByRunTime(loads);
+        return loads;
+    }
+
+    auto TaskStatistics::GetOwnersLoad() const -> std::vector<TaskLoad>
+    {
+        std::map<std::string, std::uint64_t> runTimes;
+        for (const auto &task : GetTasksLoad()) {
+            runTimes[task.owner] += task.runTime;
+        }
+
+        const auto total = GetTotalRunTime();
+        std::vector<TaskLoad> loads;
+        loads.reserve(runTimes.size());
+        for (const auto &[owner, runTime] : runTimes) {
+            loads.push_back(TaskLoad{owner, owner, static_cast<std::uint32_t>(runTime), toPermille(runTime, total)});
+        }
+        sortByRunTime(loads);
+        return loads;
+    }
+
+    auto TaskStatistics::GetSamplesCount() const noexcept -> std::size_t
+    {
+        return samplesCount;
+    }
+
+    auto TaskStatistics::GetOwnerName(const std::string &taskName) -> std::string
+    {
+        const auto suffix = taskName.rfind(workerSuffix);
+        if (suffix == std::string::npos || suffix == 0 || suffix + 2 == taskName.size()) {
+            return taskName;
+        }
+        const bool isWorker = std::all_of(taskName.begin() + suffix + 2, taskName.end(), [](unsigned char c) {
+            return std::isdigit(c) != 0;
+        });
+        return isWorker ? taskName.substr(0, suffix) : taskName;
+    }
+} // namespace sys
@@ -3,7 +3,14 @@
 
 #pragma once
 
+#include "StackStatistics.hpp"
+#include "TaskStatistics.hpp"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
 #include <cstdint>
+#include <vector>
 
 namespace sys
 {
@@ -12,15 +19,26 @@ namespace sys
     {
 
       public:
+        CpuStatistics();
+
         void Update();
         [[nodiscard]] uint32_t GetPercentageCpuLoad() const noexcept;
+        [[nodiscard]] const TaskStatistics &GetTaskStatistics() const noexcept;
+        [[nodiscard]] StackStatistics &GetStackStatistics() noexcept;
 
       private:
         uint32_t ComputeIncrease(uint32_t currentCount, uint32_t lastCount) const;
+        void UpdateTaskStatistics();
 
         uint32_t lastIdleTickCount{0};
         uint32_t lastTotalTickCount{0};
         uint32_t cpuLoad{0};
+
+        TaskStatistics taskStatistics;
+        StackStatistics stackStatistics;
+        std::vector<TaskStatus_t> tasksStatus;
+        std::vector<TaskRunTime> taskRunTimes;
+        std::vector<TaskStack> taskStacks;
     };
 
 } // namespace sys
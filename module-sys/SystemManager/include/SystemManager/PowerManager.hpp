@@ -9,6 +9,7 @@
 #include "bsp/lpm/bsp_lpm.hpp"
 #include "drivers/semc/DriverSEMC.hpp"
 #include "CpuGovernor.hpp"
+#include "CpuStatistics.hpp"
 #include <bsp/lpm/PowerProfile.hpp>
 #include <vector>
 
@@ -45,8 +46,8 @@ namespace sys
         /// limit (frequencyShiftUpperThreshold), CPU frequency is increased; if for the last 'maxBelowThresholdCount'
         /// periods the current CPU usage was below the lower limit (frequencyShiftLowerThreshold), CPU frequency is
         /// reduced frequency
-        /// @param current cpu load
-        void UpdateCpuFrequency(uint32_t cpuLoad);
+        /// @param cpuStatistics current cpu load and load of particular tasks
+        void UpdateCpuFrequency(const CpuStatistics &cpuStatistics);
 
         [[nodiscard]] auto getExternalRamDevice() const noexcept -> std::shared_ptr<devices::Device>;
 
@@ -71,6 +72,7 @@ namespace sys
         void SetCpuFrequency(bsp::CpuFrequencyMHz freq);
 
         void UpdateCpuFrequencyMonitor(bsp::CpuFrequencyMHz currentFreq);
+        void LogCpuLoadOwners(const CpuStatistics &cpuStatistics) const;
 
         uint32_t belowThresholdCounter{0};
         uint32_t aboveThresholdCounter{0};
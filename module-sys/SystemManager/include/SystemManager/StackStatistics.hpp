@@ -0,0 +1,76 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace sys
+{
+    /// Stack high-water mark of a task as reported by the scheduler
+    struct TaskStack
+    {
+        std::uint32_t id;        ///< unique task number
+        const char *name;        ///< read only when the task is seen for the first time
+        std::uint32_t freeBytes; ///< minimal amount of free stack since the task creation
+    };
+
+    /// Peak stack usage of a task
+    struct StackUsage
+    {
+        static constexpr std::uint32_t minMarginBytes = 512;
+        static constexpr std::uint32_t alignmentBytes = 512;
+        static constexpr std::uint32_t warningPercent = 10;
+
+        std::string name;
+        std::uint32_t sizeBytes;    ///< 0 if the stack size of the task is unknown
+        std::uint32_t minFreeBytes; ///< minimal amount of free stack ever seen
+
+        [[nodiscard]] auto GetPeakBytes() const noexcept -> std::uint32_t;
+        /// Peak usage with a margin of a quarter of the peak (at least minMarginBytes), 0 if the size is unknown
+        [[nodiscard]] auto GetSuggestedSize() const noexcept -> std::uint32_t;
+        /// Less than warningPercent of the stack has ever been left free
+        [[nodiscard]] auto IsNearOverflow() const noexcept -> bool;
+    };
+
+    /// Tracks the stack high-water marks of all tasks. Peaks are kept per task name, so they can be stored and
+    /// merged with the peaks of the previous boots; peaks of a task are reset when its stack size changes.
+    class StackStatistics
+    {
+      public:
+        using StackSizeProvider = std::function<std::uint32_t(const std::string &taskName)>;
+
+        explicit StackStatistics(StackSizeProvider getStackSize);
+
+        void Update(const std::vector<TaskStack> &tasks);
+
+        /// Peaks of all tasks ever seen, sorted from the least free stack relative to its size
+        [[nodiscard]] auto GetUsage() const -> std::vector<StackUsage>;
+        /// A new peak has been seen since the last Serialize()
+        [[nodiscard]] auto IsModified() const noexcept -> bool;
+
+        /// Merges peaks stored by Serialize()
+        /// @return false if the data couldn't be parsed
+        auto Deserialize(const std::string &data) -> bool;
+        [[nodiscard]] auto Serialize() -> std::string;
+
+      private:
+        struct TaskInfo
+        {
+            StackUsage *usage;
+            std::uint32_t lastSeen;
+        };
+
+        auto GetUsage(const std::string &name) -> StackUsage &;
+
+        StackSizeProvider getStackSize;
+        std::map<std::uint32_t, TaskInfo> tasksInfo;
+        std::map<std::string, StackUsage> peaks;
+        std::uint32_t updatesCount{0};
+        bool modified{false};
+    };
+} // namespace sys
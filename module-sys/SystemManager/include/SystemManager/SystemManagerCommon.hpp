@@ -33,6 +33,7 @@ namespace sys
         inline constexpr std::chrono::milliseconds timerInitInterval{30s};
         inline constexpr std::chrono::milliseconds timerPeriodInterval{100ms};
         inline constexpr std::chrono::milliseconds powerManagerLogsTimerInterval{1h};
+        inline constexpr std::chrono::milliseconds stackUsageReportInterval{10min};
         inline constexpr auto restoreTimeout{5000};
     } // namespace constants
 
@@ -182,10 +183,16 @@ namespace sys
         /// periodic update of cpu statistics
         void CpuStatisticsTimerHandler();
 
+        /// periodic report of the stack usage, peaks are merged with the ones stored during the previous boots
+        void StackUsageTimerHandler();
+        void LogStackUsage() const;
+        void StoreStackUsage();
+
         /// used for power management control for the filesystem
         void UpdateResourcesAfterCpuFrequencyChange(bsp::CpuFrequencyMHz newFrequency);
 
         bool cpuStatisticsTimerInit{false};
+        bool stackUsageLoaded{false};
 
         UpdateReason updateReason{UpdateReason::Update};
         std::vector<std::unique_ptr<BaseServiceCreator>> systemServiceCreators;
@@ -193,6 +200,7 @@ namespace sys
         sys::TimerHandle servicesPreShutdownRoutineTimeout;
         sys::TimerHandle lowBatteryShutdownDelay;
         sys::TimerHandle powerManagerEfficiencyTimer;
+        sys::TimerHandle stackUsageTimer;
         InitFunction userInit;
         InitFunction systemInit;
         DeinitFunction systemDeinit;
@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace sys
+{
+    /// Run time counter of a task as reported by the scheduler
+    struct TaskRunTime
+    {
+        std::uint32_t id;      ///< unique task number
+        const char *name;      ///< read only when the task is seen for the first time
+        std::uint32_t runTime; ///< run time counter since the task creation
+    };
+
+    /// Load of a task (or of all tasks of a service) over the stored history
+    struct TaskLoad
+    {
+        std::string name;
+        std::string owner;     ///< service the task belongs to, workers are attributed to their service
+        std::uint32_t runTime; ///< run time counter increase
+        std::uint32_t permille;
+    };
+
+    /// Keeps run time increase of every task for the last historySize periods, so the load can be attributed to
+    /// services and workers. Samples are stored in preallocated buffers - updating doesn't allocate in the steady
+    /// state.
+    class TaskStatistics
+    {
+      public:
+        static constexpr std::size_t historySize = 50;
+
+        void Update(std::uint32_t totalRunTime, const std::vector<TaskRunTime> &tasks);
+
+        /// Tasks load over the stored history, sorted from the most demanding
+        [[nodiscard]] auto GetTasksLoad() const -> std::vector<TaskLoad>;
+        /// Tasks load summed per owner, sorted from the most demanding; TaskLoad::name equals owner
+        [[nodiscard]] auto GetOwnersLoad() const -> std::vector<TaskLoad>;
+        [[nodiscard]] auto GetSamplesCount() const noexcept -> std::size_t;
+
+        /// Owner of the task: worker names are "<service>_w<number>"
+        [[nodiscard]] static auto GetOwnerName(const std::string &taskName) -> std::string;
+
+      private:
+        struct TaskInfo
+        {
+            std::string name;
+            std::string owner;
+            std::uint32_t lastRunTime;
+            std::uint32_t lastSeen;
+        };
+
+        struct Entry
+        {
+            std::uint32_t id;
+            std::uint32_t runTime;
+        };
+
+        struct Sample
+        {
+            std::uint32_t totalRunTime{0};
+            std::vector<Entry> tasks;
+        };
+
+        void RemoveFinishedTasks();
+        [[nodiscard]] auto GetTotalRunTime() const -> std::uint64_t;
+
+        std::map<std::uint32_t, TaskInfo> tasksInfo;
+        std::array<Sample, historySize> samples;
+        std::size_t samplesCount{0};
+        std::size_t nextSample{0};
+        std::uint32_t lastTotalRunTime{0};
+        std::uint32_t updatesCount{0};
+    };
+} // namespace sys
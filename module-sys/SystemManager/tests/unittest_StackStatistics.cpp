@@ -0,0 +1,122 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+#include <SystemManager/StackStatistics.hpp>
+
+#include <algorithm>
+#include <map>
+
+using namespace sys;
+
+namespace
+{
+    std::map<std::string, std::uint32_t> stackSizes = {{"ServiceGUI", 4096}, {"ServiceGUI_w0", 2048}};
+
+    std::uint32_t getStackSize(const std::string &taskName)
+    {
+        const auto it = stackSizes.find(taskName);
+        return it != stackSizes.end() ? it->second : 0;
+    }
+
+    auto findTask(const std::vector<StackUsage> &usages, const std::string &name)
+    {
+        return std::find_if(usages.begin(), usages.end(), [&name](const auto &usage) { return usage.name == name; });
+    }
+} // namespace
+
+TEST_CASE("Stack usage suggestions")
+{
+    SECTION("Over-provisioned stack")
+    {
+        const StackUsage usage{"ServiceGUI", 8192, 6144};
+        REQUIRE(usage.GetPeakBytes() == 2048);
+        REQUIRE(usage.GetSuggestedSize() == 2560);
+        REQUIRE_FALSE(usage.IsNearOverflow());
+    }
+
+    SECTION("Margin of a small stack")
+    {
+        const StackUsage usage{"IDLE", 512, 412};
+        REQUIRE(usage.GetSuggestedSize() == 1024);
+    }
+
+    SECTION("Stack close to overflow")
+    {
+        const StackUsage usage{"ServiceCellular", 8192, 512};
+        REQUIRE(usage.IsNearOverflow());
+        REQUIRE(usage.GetSuggestedSize() > usage.sizeBytes);
+    }
+
+    SECTION("Unknown stack size")
+    {
+        const StackUsage usage{"battery", 0, 100};
+        REQUIRE(usage.GetPeakBytes() == 0);
+        REQUIRE(usage.GetSuggestedSize() == 0);
+        REQUIRE_FALSE(usage.IsNearOverflow());
+    }
+}
+
+TEST_CASE("Stack statistics peaks")
+{
+    StackStatistics statistics{getStackSize};
+    REQUIRE_FALSE(statistics.IsModified());
+
+    statistics.Update({{1, "ServiceGUI", 3000}, {2, "ServiceGUI_w0", 100}, {3, "battery", 400}});
+    REQUIRE(statistics.IsModified());
+
+    SECTION("Sorted from the least free stack")
+    {
+        const auto usages = statistics.GetUsage();
+        REQUIRE(usages.size() == 3);
+        REQUIRE(usages[0].name == "ServiceGUI_w0");
+        REQUIRE(usages[0].IsNearOverflow());
+        REQUIRE(usages[1].name == "ServiceGUI");
+        REQUIRE(usages[1].GetPeakBytes() == 1096);
+        REQUIRE(usages[2].name == "battery");
+    }
+
+    SECTION("Minimal free stack is kept")
+    {
+        statistics.Update({{1, "ServiceGUI", 2500}});
+        statistics.Update({{1, "ServiceGUI", 2800}});
+        REQUIRE(findTask(statistics.GetUsage(), "ServiceGUI")->minFreeBytes == 2500);
+    }
+
+    SECTION("Peaks of finished tasks are kept")
+    {
+        statistics.Update({{1, "ServiceGUI", 3000}});
+        statistics.Update({{4, "ServiceGUI_w0", 1500}});
+        REQUIRE(findTask(statistics.GetUsage(), "ServiceGUI_w0")->minFreeBytes == 100);
+    }
+
+    SECTION("Peaks are reset when the stack size changes")
+    {
+        stackSizes["ServiceGUI_w0"] = 3072;
+        statistics.Update({{4, "ServiceGUI_w0", 2000}});
+        const auto worker = findTask(statistics.GetUsage(), "ServiceGUI_w0");
+        REQUIRE(worker->sizeBytes == 3072);
+        REQUIRE(worker->minFreeBytes == 2000);
+        stackSizes["ServiceGUI_w0"] = 2048;
+    }
+
+    SECTION("Peaks are merged with the stored ones")
+    {
+        const auto stored = statistics.Serialize();
+        REQUIRE_FALSE(statistics.IsModified());
+
+        StackStatistics nextBoot{getStackSize};
+        nextBoot.Update({{1, "ServiceGUI", 2000}, {2, "ServiceGUI_w0", 1000}});
+        REQUIRE(nextBoot.Deserialize(stored));
+
+        const auto usages = nextBoot.GetUsage();
+        REQUIRE(usages.size() == 3);
+        REQUIRE(findTask(usages, "ServiceGUI")->minFreeBytes == 2000);
+        REQUIRE(findTask(usages, "ServiceGUI_w0")->minFreeBytes == 100);
+        REQUIRE(findTask(usages, "battery")->minFreeBytes == 400);
+
+        REQUIRE_FALSE(nextBoot.Deserialize("not a json"));
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+#include <SystemManager/TaskStatistics.hpp>
+
+#include <algorithm>
+#include <limits>
+
+using namespace sys;
+
+namespace
+{
+    auto findTask(const std::vector<TaskLoad> &loads, const std::string &name)
+    {
+        return std::find_if(loads.begin(), loads.end(), [&name](const auto &load) { return load.name == name; });
+    }
+} // namespace
+
+TEST_CASE("Task statistics owner names")
+{
+    REQUIRE(TaskStatistics::GetOwnerName("ServiceCellular") == "ServiceCellular");
+    REQUIRE(TaskStatistics::GetOwnerName("ServiceCellular_w0") == "ServiceCellular");
+    REQUIRE(TaskStatistics::GetOwnerName("ServiceDesktop_w12") == "ServiceDesktop");
+    REQUIRE(TaskStatistics::GetOwnerName("ApplicationDesktop_worker") == "ApplicationDesktop_worker");
+    REQUIRE(TaskStatistics::GetOwnerName("Service_w") == "Service_w");
+    REQUIRE(TaskStatistics::GetOwnerName("_w1") == "_w1");
+}
+
+TEST_CASE("Task statistics load accounting")
+{
+    TaskStatistics statistics;
+
+    SECTION("First update is a reference point only")
+    {
+        statistics.Update(1000, {{1, "IDLE", 900}, {2, "ServiceGUI", 100}});
+        REQUIRE(statistics.GetSamplesCount() == 0);
+        REQUIRE(statistics.GetTasksLoad().empty());
+    }
+
+    SECTION("Run time increase is attributed to tasks and owners")
+    {
+        statistics.Update(1000, {{1, "IDLE", 900}, {2, "ServiceGUI", 50}, {3, "ServiceGUI_w0", 50}});
+        statistics.Update(2000, {{1, "IDLE", 1400}, {2, "ServiceGUI", 250}, {3, "ServiceGUI_w0", 350}});
+
+        const auto tasks = statistics.GetTasksLoad();
+        REQUIRE(tasks.size() == 3);
+        REQUIRE(tasks.front().name == "IDLE");
+        REQUIRE(tasks.front().permille == 500);
+        REQUIRE(findTask(tasks, "ServiceGUI")->permille == 200);
+        REQUIRE(findTask(tasks, "ServiceGUI_w0")->permille == 300);
+        REQUIRE(findTask(tasks, "ServiceGUI_w0")->owner == "ServiceGUI");
+
+        const auto owners = statistics.GetOwnersLoad();
+        REQUIRE(owners.size() == 2);
+        REQUIRE(owners.front().owner == "IDLE");
+        REQUIRE(owners.back().owner == "ServiceGUI");
+        REQUIRE(owners.back().runTime == 500);
+        REQUIRE(owners.back().permille == 500);
+    }
+
+    SECTION("Counters overflow")
+    {
+        constexpr auto max = std::numeric_limits<std::uint32_t>::max();
+        statistics.Update(max - 99, {{1, "IDLE", max - 49}});
+        statistics.Update(100, {{1, "IDLE", 50}});
+        const auto tasks = statistics.GetTasksLoad();
+        REQUIRE(tasks.size() == 1);
+        REQUIRE(tasks.front().runTime == 100);
+        REQUIRE(tasks.front().permille == 500);
+    }
+
+    SECTION("Task created between samples")
+    {
+        statistics.Update(1000, {{1, "IDLE", 1000}});
+        statistics.Update(2000, {{1, "IDLE", 1500}, {2, "ApplicationCall", 500}});
+        REQUIRE(findTask(statistics.GetTasksLoad(), "ApplicationCall")->permille == 500);
+    }
+
+    SECTION("History is limited")
+    {
+        std::uint32_t time = 0;
+        statistics.Update(time, {{1, "IDLE", 0}, {2, "ServiceAudio", 0}});
+        // audio is busy at first, then only the idle task runs
+        for (std::size_t i = 0; i < TaskStatistics::historySize; ++i) {
+            time += 100;
+            statistics.Update(time, {{1, "IDLE", 0}, {2, "ServiceAudio", time}});
+        }
+        const auto audioTime = time;
+        REQUIRE(findTask(statistics.GetTasksLoad(), "ServiceAudio")->permille == 1000);
+
+        for (std::size_t i = 0; i < TaskStatistics::historySize; ++i) {
+            time += 100;
+            statistics.Update(time, {{1, "IDLE", time - audioTime}, {2, "ServiceAudio", audioTime}});
+        }
+        REQUIRE(statistics.GetSamplesCount() == TaskStatistics::historySize);
+        REQUIRE(findTask(statistics.GetTasksLoad(), "ServiceAudio")->permille == 0);
+        REQUIRE(findTask(statistics.GetTasksLoad(), "IDLE")->permille == 1000);
+    }
+
+    SECTION("Finished tasks are forgotten after leaving the history")
+    {
+        statistics.Update(0, {{1, "IDLE", 0}, {2, "ApplicationCall", 0}});
+        statistics.Update(100, {{1, "IDLE", 50}, {2, "ApplicationCall", 50}});
+        for (std::uint32_t i = 2; i <= TaskStatistics::historySize + 1; ++i) {
+            statistics.Update(i * 100, {{1, "IDLE", i * 100 - 50}});
+        }
+        const auto tasks = statistics.GetTasksLoad();
+        REQUIRE(findTask(tasks, "ApplicationCall") == tasks.end());
+    }
+}
@@ -3,6 +3,7 @@
 
 #include "EventStore.hpp"
 #include <log/log.hpp>
+#include <algorithm>
 #include <memory>
 #include <mutex.hpp>
 
@@ -30,33 +31,40 @@ namespace Store
         return ptr;
     }
 
-    void GSM::setSignalStrength(const SignalStrength &signalStrength)
+    template <typename Modifier> void GSM::publish(Modifier &&modifier)
     {
         cpp_freertos::LockGuard lock(mutex);
+        auto state = snapshot.read();
+        modifier(state);
+        snapshot.write(state);
+        for (const auto &entry : callbacks) {
+            entry.second(state);
+        }
+    }
+
+    void GSM::setSignalStrength(const SignalStrength &signalStrength)
+    {
         LOG_INFO("Setting signal strength to rssi = %d dBm (%d) : %d bars",
                  signalStrength.rssidBm,
                  signalStrength.rssi,
                  static_cast<int>(signalStrength.rssiBar));
 
-        this->signalStrength = signalStrength;
+        publish([&signalStrength](Snapshot &state) { state.signalStrength = signalStrength; });
     }
 
     SignalStrength GSM::getSignalStrength() const
     {
-        cpp_freertos::LockGuard lock(mutex);
-        return signalStrength;
+        return snapshot.read().signalStrength;
     }
 
     void GSM::setNetwork(const Network &network)
     {
-        cpp_freertos::LockGuard lock(mutex);
-        this->network = network;
+        publish([&network](Snapshot &state) { state.network = network; });
     }
 
     Network GSM::getNetwork() const
     {
-        cpp_freertos::LockGuard lock(mutex);
-        return network;
+        return snapshot.read().network;
     }
 
     bool GSM::simCardInserted()
@@ -66,12 +74,46 @@ namespace Store
     }
     void GSM::setNetworkOperatorName(const std::string &newNetworkOperatorName)
     {
-        cpp_freertos::LockGuard lock(mutex);
-        networkOperatorName = newNetworkOperatorName;
+        publish([&newNetworkOperatorName](Snapshot &state) {
+            auto length = std::min(newNetworkOperatorName.size(), maxNetworkOperatorNameLength);
+            // don't split a multibyte character, UTF-8 continuation bytes are 10xxxxxx
+            while (length > 0 && length < newNetworkOperatorName.size() &&
+                   (static_cast<unsigned char>(newNetworkOperatorName[length]) & 0xC0) == 0x80) {
+                --length;
+            }
+            newNetworkOperatorName.copy(state.networkOperatorName.data(), length);
+            state.networkOperatorName[length] = '\0';
+        });
     }
+
     std::string GSM::getNetworkOperatorName() const
+    {
+        return snapshot.read().networkOperatorName.data();
+    }
+
+    GSM::Snapshot GSM::getSnapshot() const
+    {
+        return snapshot.read();
+    }
+
+    std::uint32_t GSM::getGeneration() const noexcept
+    {
+        return snapshot.getGeneration();
+    }
+
+    GSM::ChangeCallbackId GSM::subscribe(ChangeCallback callback)
+    {
+        cpp_freertos::LockGuard lock(mutex);
+        const auto id = nextCallbackId++;
+        callbacks.emplace_back(id, std::move(callback));
+        return id;
+    }
+
+    void GSM::unsubscribe(ChangeCallbackId id)
     {
         cpp_freertos::LockGuard lock(mutex);
-        return networkOperatorName;
+        callbacks.erase(
+            std::remove_if(callbacks.begin(), callbacks.end(), [id](const auto &entry) { return entry.first == id; }),
+            callbacks.end());
     }
 }; // namespace Store
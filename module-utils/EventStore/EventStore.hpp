@@ -9,10 +9,16 @@
 // - gsm SIM tray
 // it's not meant to serve as polling interface - rather to serve data
 
+#include "SnapshotBuffer.hpp"
+
 #include <hal/cellular/SIM.hpp>
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace cpp_freertos
 {
@@ -99,14 +105,31 @@ namespace Store
 
     struct GSM
     {
+        /// Maximum operator name bytes kept in the snapshot, longer names are cut at a character boundary
+        static constexpr std::size_t maxNetworkOperatorNameLength = 32;
+
+        /// Cellular state published as a whole, readers always get a consistent copy without locking
+        struct Snapshot
+        {
+            SignalStrength signalStrength;
+            Network network;
+            std::array<char, maxNetworkOperatorNameLength + 1> networkOperatorName{};
+        };
+
+        using ChangeCallback   = std::function<void(const Snapshot &)>;
+        using ChangeCallbackId = std::uint32_t;
+
       private:
         GSM() = default;
-        SignalStrength signalStrength;
-        Network network;
-        std::string networkOperatorName;
+        SnapshotBuffer<Snapshot> snapshot;
+        std::vector<std::pair<ChangeCallbackId, ChangeCallback>> callbacks;
+        ChangeCallbackId nextCallbackId = 0;
 
+        /// serializes writers and guards the callbacks list, never taken by the getters
         static cpp_freertos::MutexStandard mutex;
 
+        template <typename Modifier> void publish(Modifier &&modifier);
+
       public:
         GSM(const GSM &) = delete;
         GSM &operator=(const GSM &) = delete;
@@ -148,6 +171,18 @@ namespace Store
         void setNetworkOperatorName(const std::string &newNetworkOperatorName);
         std::string getNetworkOperatorName() const;
 
+        /// Returns the whole cellular state at once
+        Snapshot getSnapshot() const;
+
+        /// Returns the generation of the cellular state, changes on every update
+        std::uint32_t getGeneration() const noexcept;
+
+        /// Registers a callback called after every update of the cellular state.
+        /// The callback runs in the context of the updating service, so it has to be short and must not block,
+        /// nor (un)subscribe itself.
+        ChangeCallbackId subscribe(ChangeCallback callback);
+        void unsubscribe(ChangeCallbackId id);
+
         static GSM *get();
     };
 }; // namespace Store
@@ -0,0 +1,78 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Store
+{
+    /// Double buffered, versioned value for one writer and many readers.
+    /// The writer always fills the buffer which is not published and then bumps the generation, so readers never
+    /// wait for it: they copy the published buffer and retry only if the writer managed to reuse that very buffer
+    /// in the meantime (i.e. the reader was preempted for two consecutive writes).
+    /// Writes have to be serialized by the owner.
+    template <typename T> class SnapshotBuffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshot has to be copyable with memcpy");
+
+      public:
+        explicit SnapshotBuffer(const T &initial = T{}) noexcept
+        {
+            buffers[0].value = initial;
+        }
+
+        SnapshotBuffer(const SnapshotBuffer &) = delete;
+        SnapshotBuffer &operator=(const SnapshotBuffer &) = delete;
+
+        [[nodiscard]] T read() const noexcept
+        {
+            T copy;
+            while (true) {
+                const auto &buffer = buffers[generation.load(std::memory_order_acquire) & 1U];
+                const auto before  = buffer.sequence.load(std::memory_order_acquire);
+                if ((before & 1U) != 0) {
+                    continue;
+                }
+                std::memcpy(&copy, &buffer.value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (buffer.sequence.load(std::memory_order_relaxed) == before) {
+                    return copy;
+                }
+            }
+        }
+
+        void write(const T &value) noexcept
+        {
+            const auto next = generation.load(std::memory_order_relaxed) + 1;
+            auto &buffer    = buffers[next & 1U];
+
+            buffer.sequence.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&buffer.value, &value, sizeof(T));
+            buffer.sequence.fetch_add(1, std::memory_order_release);
+
+            generation.store(next, std::memory_order_release);
+        }
+
+        /// Incremented on every write, can be used to detect changes without copying the value
+        [[nodiscard]] std::uint32_t getGeneration() const noexcept
+        {
+            return generation.load(std::memory_order_acquire);
+        }
+
+      private:
+        struct Buffer
+        {
+            std::atomic<std::uint32_t> sequence{0};
+            T value{};
+        };
+
+        std::array<Buffer, 2> buffers;
+        std::atomic<std::uint32_t> generation{0};
+    };
+} // namespace Store
@@ -0,0 +1,121 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+
+#include <catch2/catch.hpp>
+
+#include <EventStore.hpp>
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE("SnapshotBuffer")
+{
+    SECTION("Initial value")
+    {
+        Store::SnapshotBuffer<int> buffer{42};
+        REQUIRE(buffer.read() == 42);
+        REQUIRE(buffer.getGeneration() == 0);
+    }
+
+    SECTION("Write publishes new value and generation")
+    {
+        Store::SnapshotBuffer<int> buffer;
+        buffer.write(1);
+        REQUIRE(buffer.read() == 1);
+        REQUIRE(buffer.getGeneration() == 1);
+        buffer.write(2);
+        buffer.write(3);
+        REQUIRE(buffer.read() == 3);
+        REQUIRE(buffer.getGeneration() == 3);
+    }
+
+    SECTION("Readers never see torn values")
+    {
+        struct Pair
+        {
+            std::uint64_t first;
+            std::uint64_t second;
+        };
+        Store::SnapshotBuffer<Pair> buffer;
+        std::atomic<bool> done{false};
+        std::atomic<bool> torn{false};
+
+        std::thread reader([&]() {
+            while (!done) {
+                const auto value = buffer.read();
+                if (value.first != value.second) {
+                    torn = true;
+                }
+            }
+        });
+        for (std::uint64_t i = 1; i <= 100000; ++i) {
+            buffer.write(Pair{i, i});
+        }
+        done = true;
+        reader.join();
+
+        REQUIRE_FALSE(torn);
+        REQUIRE(buffer.read().first == 100000);
+    }
+}
+
+TEST_CASE("GSM snapshot")
+{
+    auto gsm = Store::GSM::get();
+
+    SECTION("Getters read published state")
+    {
+        const auto generation = gsm->getGeneration();
+        gsm->setSignalStrength(Store::SignalStrength{10, -93, Store::RssiBar::two});
+        gsm->setNetwork(Store::Network{Store::Network::Status::RegisteredHomeNetwork,
+                                       Store::Network::AccessTechnology::EUtran});
+        gsm->setNetworkOperatorName("Operator");
+
+        REQUIRE(gsm->getGeneration() == generation + 3);
+        REQUIRE(gsm->getSignalStrength().rssiBar == Store::RssiBar::two);
+        REQUIRE(gsm->getNetwork().accessTechnology == Store::Network::AccessTechnology::EUtran);
+        REQUIRE(gsm->getNetworkOperatorName() == "Operator");
+
+        const auto snapshot = gsm->getSnapshot();
+        REQUIRE(snapshot.signalStrength.rssidBm == -93);
+        REQUIRE(snapshot.network.status == Store::Network::Status::RegisteredHomeNetwork);
+    }
+
+    SECTION("Too long operator name is truncated")
+    {
+        const std::string name(Store::GSM::maxNetworkOperatorNameLength + 10, 'x');
+        gsm->setNetworkOperatorName(name);
+        REQUIRE(gsm->getNetworkOperatorName() == name.substr(0, Store::GSM::maxNetworkOperatorNameLength));
+    }
+
+    SECTION("Too long operator name is truncated at a character boundary")
+    {
+        // two bytes per character, the last one which fits is split by the limit
+        std::string name = "x";
+        while (name.size() <= Store::GSM::maxNetworkOperatorNameLength) {
+            name += "\u0142";
+        }
+        gsm->setNetworkOperatorName(name);
+        REQUIRE(gsm->getNetworkOperatorName() == name.substr(0, Store::GSM::maxNetworkOperatorNameLength - 1));
+    }
+
+    SECTION("Change callbacks")
+    {
+        int calls       = 0;
+        std::string lastName;
+        const auto id = gsm->subscribe([&](const Store::GSM::Snapshot &snapshot) {
+            ++calls;
+            lastName = snapshot.networkOperatorName.data();
+        });
+
+        gsm->setNetworkOperatorName("First");
+        REQUIRE(calls == 1);
+        REQUIRE(lastName == "First");
+
+        gsm->unsubscribe(id);
+        gsm->setNetworkOperatorName("Second");
+        REQUIRE(calls == 1);
+    }
+}
@@ -26,6 +26,7 @@ namespace utils
             const std::vector<std::string> get_array(const std::string &str);
             using i18n::getDisplayLanguage;
             using i18n::getDisplayLanguagePath;
+            using i18n::getDisplayLanguageVersion;
             using i18n::getInputLanguage;
             using i18n::getInputLanguageFilename;
             using i18n::getInputLanguagePath;
@@ -165,6 +166,7 @@ namespace utils
     {
         cpp_freertos::LockGuard lock(mutex);
         displayLanguage = lang;
+        ++displayLanguageVersion;
     }
 
     void i18n::loadFallbackLanguage()
@@ -172,6 +174,7 @@ namespace utils
         cpp_freertos::LockGuard lock(mutex);
         currentDisplayLanguage = fallbackLanguageName;
         fallbackLanguage       = loader.createJson(fallbackLanguageName);
+        ++displayLanguageVersion;
     }
 
     const std::string &translate(const std::string &text)
@@ -189,6 +192,11 @@ namespace utils
         return utils::localize.getDisplayLanguage();
     }
 
+    std::uint32_t getDisplayLanguageVersion()
+    {
+        return utils::localize.getDisplayLanguageVersion();
+    }
+
     const std::string &getInputLanguage()
     {
         return utils::localize.getInputLanguage();
@@ -224,6 +232,7 @@ namespace utils
         currentDisplayLanguage.clear();
         displayLanguage  = json11::Json();
         fallbackLanguage = json11::Json();
+        ++displayLanguageVersion;
     }
 
     void resetDisplayLanguages()
@@ -7,6 +7,8 @@
 #include <json11.hpp>
 #include <i18n/i18n.hpp>
 
+#include <atomic>
+
 namespace utils
 {
 
@@ -28,6 +30,7 @@ namespace utils
         Language currentDisplayLanguage;
         std::filesystem::path InputLanguageDirPath   = "assets/profiles";
         std::filesystem::path DisplayLanguageDirPath = "assets/lang";
+        std::atomic<std::uint32_t> displayLanguageVersion{0};
         mutable cpp_freertos::MutexStandard mutex;
 
         void changeDisplayLanguage(const json11::Json &lang);
@@ -47,6 +50,10 @@ namespace utils
         {
             return currentDisplayLanguage;
         }
+        std::uint32_t getDisplayLanguageVersion() const
+        {
+            return displayLanguageVersion;
+        }
         const std::string &getInputLanguage()
         {
             return inputLanguage;
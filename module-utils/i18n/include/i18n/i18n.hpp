@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <filesystem>
 #include <vector>
@@ -28,6 +29,8 @@ namespace utils
     const std::string &translate(const std::string &text);
     const std::vector<std::string> translate_array(const std::string &text);
     const std::string &getDisplayLanguage();
+    /// incremented on every display language change, lets users of translations invalidate cached values
+    std::uint32_t getDisplayLanguageVersion();
     const std::string &getInputLanguage();
     const std::string &getInputLanguageFilename(const std::string &inputMode);
 
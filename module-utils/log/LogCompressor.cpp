@@ -0,0 +1,298 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "LogCompressor.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Log
+{
+    namespace
+    {
+        constexpr std::size_t minMatch     = 4;
+        constexpr std::size_t lastLiterals = 5;  ///< LZ4: last 5 bytes are always literals
+        constexpr std::size_t matchLimit   = 12; ///< LZ4: last match starts at least 12 bytes before the end
+        constexpr std::size_t maxOffset    = 65535;
+        constexpr unsigned hashLog         = 12;
+        constexpr std::size_t hashSize     = 1U << hashLog;
+        constexpr std::uint8_t runMask     = 15;
+
+        static_assert(LogCompressor::blockSize <= maxOffset, "Positions are kept in 16 bits");
+
+        inline std::uint32_t read32(const std::uint8_t *p) noexcept
+        {
+            std::uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline std::uint32_t hash(std::uint32_t sequence) noexcept
+        {
+            return (sequence * 2654435761U) >> (32 - hashLog);
+        }
+
+        inline std::uint8_t *writeLength(std::uint8_t *op, std::size_t length) noexcept
+        {
+            for (; length >= 255; length -= 255) {
+                *op++ = 255;
+            }
+            *op++ = static_cast<std::uint8_t>(length);
+            return op;
+        }
+
+        inline std::uint8_t *writeLiterals(std::uint8_t *op,
+                                           std::uint8_t *token,
+                                           const std::uint8_t *src,
+                                           std::size_t n)
+        {
+            if (n >= runMask) {
+                *token = runMask << 4;
+                op     = writeLength(op, n - runMask);
+            }
+            else {
+                *token = static_cast<std::uint8_t>(n << 4);
+            }
+            std::memcpy(op, src, n);
+            return op + n;
+        }
+
+        inline void writeLE32(std::uint8_t *dst, std::uint32_t value) noexcept
+        {
+            for (auto i = 0; i < 4; ++i) {
+                dst[i] = static_cast<std::uint8_t>(value >> (8 * i));
+            }
+        }
+
+        inline std::uint32_t readLE32(const std::uint8_t *src) noexcept
+        {
+            std::uint32_t value = 0;
+            for (auto i = 0; i < 4; ++i) {
+                value |= static_cast<std::uint32_t>(src[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        inline bool readLength(const std::uint8_t *src, std::size_t srcSize, std::size_t &ip, std::size_t &length)
+        {
+            if (length != runMask) {
+                return true;
+            }
+            std::uint8_t byte;
+            do {
+                if (ip >= srcSize) {
+                    return false;
+                }
+                byte = src[ip++];
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+    } // namespace
+
+    LogCompressor::LogCompressor(std::ostream &output)
+        : output{output}, block{std::make_unique<std::uint8_t[]>(blockSize)},
+          compressedBlock{std::make_unique<std::uint8_t[]>(compressBound(blockSize))},
+          hashTable{std::make_unique<std::uint16_t[]>(hashSize)}
+    {}
+
+    void LogCompressor::writeFileHeader()
+    {
+        writeBytes(magic, std::strlen(magic));
+        writeBytes(&version, sizeof(version));
+    }
+
+    void LogCompressor::write(std::string_view data)
+    {
+        inputBytes += data.size();
+        while (!data.empty()) {
+            const auto chunk = std::min(data.size(), blockSize - blockFill);
+            std::memcpy(block.get() + blockFill, data.data(), chunk);
+            blockFill += chunk;
+            data.remove_prefix(chunk);
+            if (blockFill == blockSize) {
+                writeBlock();
+            }
+        }
+    }
+
+    void LogCompressor::flush()
+    {
+        if (blockFill > 0) {
+            writeBlock();
+        }
+        output.flush();
+    }
+
+    void LogCompressor::writeBlock()
+    {
+        auto compressedSize = compressBlock(block.get(), blockFill, compressedBlock.get(), hashTable.get());
+        const auto *payload = compressedBlock.get();
+        auto storedSize     = static_cast<std::uint32_t>(compressedSize);
+        if (compressedSize >= blockFill) {
+            payload        = block.get();
+            compressedSize = blockFill;
+            storedSize     = static_cast<std::uint32_t>(blockFill) | uncompressedBlockFlag;
+        }
+
+        std::uint8_t blockHeader[8];
+        writeLE32(blockHeader, static_cast<std::uint32_t>(blockFill));
+        writeLE32(blockHeader + 4, storedSize);
+        writeBytes(blockHeader, sizeof(blockHeader));
+        writeBytes(payload, compressedSize);
+        blockFill = 0;
+    }
+
+    void LogCompressor::writeBytes(const void *data, std::size_t size)
+    {
+        output.write(static_cast<const char *>(data), size);
+        outputBytes += size;
+    }
+
+    std::size_t LogCompressor::compressBlock(const std::uint8_t *src,
+                                             std::size_t srcSize,
+                                             std::uint8_t *dst,
+                                             std::uint16_t *hashTable)
+    {
+        auto op            = dst;
+        std::size_t anchor = 0;
+
+        if (srcSize > matchLimit) {
+            std::fill(hashTable, hashTable + hashSize, 0);
+            const auto matchEnd = srcSize - lastLiterals;
+            std::size_t ip      = 1;
+            hashTable[hash(read32(src))] = 0;
+
+            while (ip + matchLimit <= srcSize) {
+                const auto sequence = read32(src + ip);
+                auto &entry         = hashTable[hash(sequence)];
+                const std::size_t ref = entry;
+                entry                 = static_cast<std::uint16_t>(ip);
+
+                if (ref >= ip || ip - ref > maxOffset || read32(src + ref) != sequence) {
+                    ++ip;
+                    continue;
+                }
+
+                auto matchLength = minMatch;
+                while (ip + matchLength < matchEnd && src[ref + matchLength] == src[ip + matchLength]) {
+                    ++matchLength;
+                }
+
+                auto token = op++;
+                op         = writeLiterals(op, token, src + anchor, ip - anchor);
+
+                const auto offset = ip - ref;
+                *op++             = static_cast<std::uint8_t>(offset);
+                *op++             = static_cast<std::uint8_t>(offset >> 8);
+
+                if (const auto length = matchLength - minMatch; length >= runMask) {
+                    *token |= runMask;
+                    op = writeLength(op, length - runMask);
+                }
+                else {
+                    *token |= static_cast<std::uint8_t>(length);
+                }
+
+                ip += matchLength;
+                anchor = ip;
+            }
+        }
+
+        auto token = op++;
+        op         = writeLiterals(op, token, src + anchor, srcSize - anchor);
+        return static_cast<std::size_t>(op - dst);
+    }
+
+    std::size_t LogCompressor::decompressBlock(const std::uint8_t *src,
+                                               std::size_t srcSize,
+                                               std::uint8_t *dst,
+                                               std::size_t dstCapacity)
+    {
+        std::size_t ip = 0;
+        std::size_t op = 0;
+
+        while (ip < srcSize) {
+            const auto token     = src[ip++];
+            std::size_t literals = token >> 4;
+            if (!readLength(src, srcSize, ip, literals) || literals > srcSize - ip || literals > dstCapacity - op) {
+                return 0;
+            }
+            std::memcpy(dst + op, src + ip, literals);
+            ip += literals;
+            op += literals;
+
+            if (ip == srcSize) {
+                break;
+            }
+            if (srcSize - ip < 2) {
+                return 0;
+            }
+            const std::size_t offset = src[ip] | (src[ip + 1] << 8);
+            ip += 2;
+
+            std::size_t matchLength = token & runMask;
+            if (!readLength(src, srcSize, ip, matchLength)) {
+                return 0;
+            }
+            matchLength += minMatch;
+            if (offset == 0 || offset > op || matchLength > dstCapacity - op) {
+                return 0;
+            }
+            // byte by byte, the match may overlap the bytes it produces
+            for (std::size_t i = 0; i < matchLength; ++i, ++op) {
+                dst[op] = dst[op - offset];
+            }
+        }
+        return op;
+    }
+
+    bool LogCompressor::decompress(std::istream &input, std::ostream &output)
+    {
+        const auto magicSize = std::strlen(magic);
+        char fileHeader[8];
+        if (!input.read(fileHeader, magicSize + sizeof(version)) || std::memcmp(fileHeader, magic, magicSize) != 0 ||
+            static_cast<std::uint8_t>(fileHeader[magicSize]) != version) {
+            return false;
+        }
+
+        auto block           = std::make_unique<std::uint8_t[]>(blockSize);
+        auto compressedBlock = std::make_unique<std::uint8_t[]>(compressBound(blockSize));
+        std::uint8_t blockHeader[8];
+
+        while (input.read(reinterpret_cast<char *>(blockHeader), sizeof(blockHeader))) {
+            const auto rawSize    = readLE32(blockHeader);
+            const auto storedSize = readLE32(blockHeader + 4);
+            const auto size       = storedSize & ~uncompressedBlockFlag;
+            if (rawSize > blockSize || size > compressBound(blockSize) ||
+                !input.read(reinterpret_cast<char *>(compressedBlock.get()), size)) {
+                return false;
+            }
+
+            if (storedSize & uncompressedBlockFlag) {
+                if (size != rawSize) {
+                    return false;
+                }
+                output.write(reinterpret_cast<const char *>(compressedBlock.get()), size);
+            }
+            else {
+                if (decompressBlock(compressedBlock.get(), size, block.get(), blockSize) != rawSize) {
+                    return false;
+                }
+                output.write(reinterpret_cast<const char *>(block.get()), rawSize);
+            }
+        }
+        // a block header cut in the middle means a truncated file
+        return input.gcount() == 0 && output.good();
+    }
+
+    auto LogCompressor::getInputBytes() const noexcept -> std::size_t
+    {
+        return inputBytes;
+    }
+
+    auto LogCompressor::getOutputBytes() const noexcept -> std::size_t
+    {
+        return outputBytes;
+    }
+} // namespace Log
@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string_view>
+
+namespace Log
+{
+    /**
+     * Streaming compressor of the log files.
+     * Logs are gathered in blocks, every block is compressed independently in the LZ4 block format, so the file
+     * stays readable even if the device resets in the middle of a dump. See doc/logging_engine.md for the file
+     * format and tools/decompress_logs.py for the host decompressor. The same format is used for the compressed
+     * files of the backups.
+     */
+    class LogCompressor
+    {
+      public:
+        static constexpr auto magic            = "MLZ4";
+        static constexpr std::uint8_t version  = 1;
+        static constexpr std::size_t blockSize = 16 * 1024;
+        /// Set in the compressed size of the blocks stored without compression
+        static constexpr std::uint32_t uncompressedBlockFlag = 0x80000000U;
+
+        explicit LogCompressor(std::ostream &output);
+
+        void writeFileHeader();
+        void write(std::string_view data);
+        /// Compresses and writes the pending data
+        void flush();
+
+        [[nodiscard]] auto getInputBytes() const noexcept -> std::size_t;
+        [[nodiscard]] auto getOutputBytes() const noexcept -> std::size_t;
+
+        static constexpr std::size_t compressBound(std::size_t size) noexcept
+        {
+            return size + size / 255 + 16;
+        }
+        /// @return size of the LZ4 compressed block written to the dst
+        static std::size_t compressBlock(const std::uint8_t *src,
+                                         std::size_t srcSize,
+                                         std::uint8_t *dst,
+                                         std::uint16_t *hashTable);
+        /// @return size of the block decompressed to the dst or 0 if the block is corrupted
+        static std::size_t decompressBlock(const std::uint8_t *src,
+                                           std::size_t srcSize,
+                                           std::uint8_t *dst,
+                                           std::size_t dstCapacity);
+        /// Decompresses a whole file written by the compressor
+        /// @return false if the input is not a compressed file or it is corrupted
+        static bool decompress(std::istream &input, std::ostream &output);
+
+      private:
+        void writeBlock();
+        void writeBytes(const void *data, std::size_t size);
+
+        std::ostream &output;
+        std::unique_ptr<std::uint8_t[]> block;
+        std::unique_ptr<std::uint8_t[]> compressedBlock;
+        std::unique_ptr<std::uint16_t[]> hashTable;
+        std::size_t blockFill   = 0;
+        std::size_t inputBytes  = 0;
+        std::size_t outputBytes = 0;
+    };
+} // namespace Log
@@ -0,0 +1,28 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "LogWriter.hpp"
+#include <Logger.hpp>
+#include <ticks.hpp>
+
+namespace Log
+{
+    LogWriter::LogWriter(std::filesystem::path logPath, std::chrono::milliseconds flushPeriod)
+        : cpp_freertos::Thread(name, stackDepth, priority), logPath{std::move(logPath)}, flushPeriod{flushPeriod}
+    {}
+
+    void LogWriter::requestFlush()
+    {
+        flushRequest.Give();
+    }
+
+    void LogWriter::Run()
+    {
+        while (true) {
+            flushRequest.Take(cpp_freertos::Ticks::MsToTicks(flushPeriod.count()));
+            if (const auto status = Logger::get().dumpToFile(logPath); status < 0) {
+                LOG_ERROR("Logs flush failed: %d", status);
+            }
+        }
+    }
+} // namespace Log
@@ -0,0 +1,38 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <semaphore.hpp>
+#include <thread.hpp>
+
+#include <chrono>
+#include <filesystem>
+
+namespace Log
+{
+    /// Low priority thread periodically flushing the logs to the file, so the services are not stalled by the flash
+    class LogWriter : public cpp_freertos::Thread
+    {
+      public:
+        static constexpr std::chrono::milliseconds defaultFlushPeriod{1000 * 60 * 5};
+
+        explicit LogWriter(std::filesystem::path logPath,
+                           std::chrono::milliseconds flushPeriod = defaultFlushPeriod);
+
+        /// Wakes the writer up to flush the logs earlier
+        void requestFlush();
+
+      protected:
+        void Run() override;
+
+      private:
+        static constexpr auto name       = "LogWriter";
+        static constexpr auto stackDepth = 2048;
+        static constexpr auto priority   = tskIDLE_PRIORITY + 1;
+
+        const std::filesystem::path logPath;
+        const std::chrono::milliseconds flushPeriod;
+        cpp_freertos::BinarySemaphore flushRequest;
+    };
+} // namespace Log
@@ -2,7 +2,9 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "critical.hpp"
+#include <cinttypes>
 #include <fstream>
+#include <sstream>
 #include "LockGuard.hpp"
 #include <Logger.hpp>
 #include <Utils.hpp>
@@ -35,7 +37,7 @@ namespace Log
         return stream;
     }
 
-    Logger::Logger() : circularBuffer{circularBufferSize}, rotator{".log"}
+    Logger::Logger() : circularBuffer{circularBufferSize}, rotator{".lz4"}
     {}
 
     void Logger::enableColors(bool enable)
@@ -139,54 +141,88 @@ namespace Log
     /// @return:   1 - log flush successflul
     auto Logger::dumpToFile(std::filesystem::path logPath) -> int
     {
-        std::error_code errorCode;
-        auto firstDump = !std::filesystem::exists(logPath, errorCode);
-        if (errorCode) {
-            LOG_ERROR("Failed to check if file %s exists, error: %d", logPath.c_str(), errorCode.value());
-            return -EIO;
-        }
+        int status           = 1;
+        const auto startTime = cpp_freertos::Ticks::GetTicks();
+        FlushStatistics stats;
+        {
+            // the file is checked under the lock too, concurrent flushes mustn't both start a new file
+            LockGuard lock(logFileMutex);
+            std::error_code errorCode;
+            auto firstDump = !std::filesystem::exists(logPath, errorCode);
+            if (errorCode) {
+                LOG_ERROR("Failed to check if file %s exists, error: %d", logPath.c_str(), errorCode.value());
+                return -EIO;
+            }
 
-        if (const bool maxSizeExceeded = !firstDump && std::filesystem::file_size(logPath) > maxFileSize;
-            maxSizeExceeded) {
-            LOG_DEBUG("Max log file size exceeded. Rotating log files...");
-            {
-                LockGuard lock(logFileMutex);
+            if (const bool maxSizeExceeded = !firstDump && std::filesystem::file_size(logPath) > maxFileSize;
+                maxSizeExceeded) {
+                LOG_DEBUG("Max log file size exceeded. Rotating log files...");
                 rotator.rotateFile(logPath);
+                firstDump = true;
             }
-            firstDump = true;
-        }
 
-        int status = 1;
-        {
-            const auto &logs = getLogs();
-
-            LockGuard lock(logFileMutex);
-            std::ofstream logFile(logPath, std::fstream::out | std::fstream::app);
+            std::ofstream logFile(logPath, std::fstream::out | std::fstream::app | std::fstream::binary);
             if (!logFile.good()) {
                 status = -EIO;
             }
 
-            constexpr size_t streamBufferSize = 64 * 1024;
-            auto streamBuffer                 = std::make_unique<char[]>(streamBufferSize);
-            logFile.rdbuf()->pubsetbuf(streamBuffer.get(), streamBufferSize);
-
+            LogCompressor compressor{logFile};
             if (firstDump) {
-                addFileHeader(logFile);
+                compressor.writeFileHeader();
+                addFileHeader(compressor);
             }
-            logFile.write(logs.data(), logs.size());
+            std::string msg;
+            for (auto left = circularBufferSize; left > 0 && popLog(msg); --left) {
+                compressor.write(msg);
+            }
+            compressor.flush();
             if (logFile.bad()) {
                 status = -EIO;
             }
+            stats.logBytes   = compressor.getInputBytes();
+            stats.flashBytes = compressor.getOutputBytes();
+        }
+        stats.durationMs = cpp_freertos::Ticks::TicksToMs(cpp_freertos::Ticks::GetTicks() - startTime);
+
+        {
+            LockGuard lock(mutex);
+            stats.totalLogBytes   = flushStatistics.totalLogBytes + stats.logBytes;
+            stats.totalFlashBytes = flushStatistics.totalFlashBytes + stats.flashBytes;
+            stats.totalDurationMs = flushStatistics.totalDurationMs + stats.durationMs;
+            flushStatistics       = stats;
         }
 
-        LOG_DEBUG("Flush ended with status: %d", status);
+        LOG_DEBUG("Flush ended with status: %d, %zu bytes of logs written as %zu bytes in %" PRIu32 " ms",
+                  status,
+                  stats.logBytes,
+                  stats.flashBytes,
+                  stats.durationMs);
 
         return status;
     }
 
-    void Logger::addFileHeader(std::ofstream &file) const
+    auto Logger::getFlushStatistics() -> FlushStatistics
+    {
+        LockGuard lock(mutex);
+        return flushStatistics;
+    }
+
+    auto Logger::popLog(std::string &msg) -> bool
+    {
+        LockGuard lock(mutex);
+        if (circularBuffer.isEmpty()) {
+            return false;
+        }
+        auto [result, log] = circularBuffer.get();
+        msg                = std::move(log);
+        return result;
+    }
+
+    void Logger::addFileHeader(LogCompressor &compressor) const
     {
-        file << application;
+        std::ostringstream header;
+        header << application;
+        compressor.write(header.str());
     }
 
     const char *getTaskDesc()
@@ -5,6 +5,7 @@
 
 #include <assert.h>
 #include <log/log.hpp>
+#include "LogCompressor.hpp"
 #include "LoggerBuffer.hpp"
 #include "log_colors.hpp"
 #include <rotator/Rotator.hpp>
@@ -30,6 +31,17 @@ namespace Log
     };
     std::ostream &operator<<(std::ostream &stream, const Application &application);
 
+    /// Log flushing metrics, for the last flush and since the boot
+    struct FlushStatistics
+    {
+        std::size_t logBytes          = 0; ///< Log messages drained from the buffer
+        std::size_t flashBytes        = 0; ///< Bytes written to the log files
+        std::uint32_t durationMs      = 0;
+        std::size_t totalLogBytes     = 0;
+        std::size_t totalFlashBytes   = 0;
+        std::uint32_t totalDurationMs = 0;
+    };
+
     class Logger
     {
       public:
@@ -46,6 +58,7 @@ namespace Log
             -> int;
         auto logAssert(const char *fmt, va_list args) -> int;
         auto dumpToFile(std::filesystem::path logPath) -> int;
+        [[nodiscard]] auto getFlushStatistics() -> FlushStatistics;
 
         static constexpr auto CRIT_STR = "CRIT";
         static constexpr auto IRQ_STR  = "IRQ";
@@ -73,7 +86,9 @@ namespace Log
             return sizeLeft;
         }
 
-        void addFileHeader(std::ofstream &file) const;
+        void addFileHeader(LogCompressor &compressor) const;
+        /// Takes a single message from the circular buffer, so the loggers are not blocked for the whole flush
+        [[nodiscard]] auto popLog(std::string &msg) -> bool;
 
         cpp_freertos::MutexStandard mutex;
         cpp_freertos::MutexStandard logFileMutex;
@@ -86,6 +101,7 @@ namespace Log
         Application application;
         LoggerBuffer circularBuffer;
         utils::Rotator<MAX_LOG_FILES_COUNT> rotator;
+        FlushStatistics flushStatistics;
         static constexpr size_t circularBufferSize = 1000;
 
         static const char *levelNames[];
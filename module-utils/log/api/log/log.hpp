@@ -89,7 +89,7 @@ extern "C"
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
 static const size_t LOGGER_BUFFER_SIZE = 8192;
-static const char *LOG_FILE_NAME       = "MuditaOS.log";
+static const char *LOG_FILE_NAME       = "MuditaOS.log.lz4";
 static const int MAX_LOG_FILES_COUNT   = 3;
 static const size_t MAX_LOG_FILE_SIZE  = 1024 * 1024 * 15; // 15 MB
 #pragma GCC diagnostic pop
@@ -12,6 +12,9 @@ extern "C"
     /// @return:   1 - log flush successful
     int dumpLogs();
 
+    /// Starts the low priority thread periodically dumping the logs to the file
+    void startLogsWriter();
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,8 +4,15 @@
 #include <logdump/logdump.h>
 #include <purefs/filesystem_paths.hpp>
 #include <Logger.hpp>
+#include <LogWriter.hpp>
 
 int dumpLogs()
 {
     return Log::Logger::get().dumpToFile(purefs::dir::getLogsPath() / LOG_FILE_NAME);
 }
+
+void startLogsWriter()
+{
+    static Log::LogWriter writer{purefs::dir::getLogsPath() / LOG_FILE_NAME};
+    writer.Start();
+}
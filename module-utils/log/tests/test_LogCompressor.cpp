@@ -0,0 +1,200 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include "RandomStringGenerator.hpp"
+#include "LogCompressor.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using Log::LogCompressor;
+
+namespace
+{
+    std::uint32_t readLE32(const std::string &data, std::size_t pos)
+    {
+        std::uint32_t value = 0;
+        for (auto i = 0; i < 4; ++i) {
+            value |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[pos + i])) << (8 * i);
+        }
+        return value;
+    }
+
+    std::size_t readLength(const std::string &data, std::size_t &pos, std::size_t length)
+    {
+        if (length != 15) {
+            return length;
+        }
+        std::uint8_t byte;
+        do {
+            byte = static_cast<std::uint8_t>(data[pos++]);
+            length += byte;
+        } while (byte == 255);
+        return length;
+    }
+
+    /// Reference LZ4 block decoder, the same as in tools/decompress_logs.py
+    std::string decompressBlock(const std::string &data)
+    {
+        std::string out;
+        std::size_t pos = 0;
+        while (pos < data.size()) {
+            const auto token = static_cast<std::uint8_t>(data[pos++]);
+            const auto literals = readLength(data, pos, token >> 4);
+            out += data.substr(pos, literals);
+            pos += literals;
+            if (pos >= data.size()) {
+                break;
+            }
+            const std::size_t offset = static_cast<std::uint8_t>(data[pos]) |
+                                       (static_cast<std::uint8_t>(data[pos + 1]) << 8);
+            pos += 2;
+            const auto match = readLength(data, pos, token & 15) + 4;
+            REQUIRE(offset > 0);
+            REQUIRE(offset <= out.size());
+            const auto start = out.size() - offset;
+            for (std::size_t i = 0; i < match; ++i) {
+                out += out[start + i];
+            }
+        }
+        return out;
+    }
+
+    std::string decompress(const std::string &file)
+    {
+        REQUIRE(file.compare(0, 4, LogCompressor::magic) == 0);
+        REQUIRE(static_cast<std::uint8_t>(file[4]) == LogCompressor::version);
+
+        std::string out;
+        std::size_t pos = 5;
+        while (pos < file.size()) {
+            const auto rawSize    = readLE32(file, pos);
+            const auto storedSize = readLE32(file, pos + 4);
+            const auto size       = storedSize & ~LogCompressor::uncompressedBlockFlag;
+            pos += 8;
+            const auto payload = file.substr(pos, size);
+            pos += size;
+            const auto block = (storedSize & LogCompressor::uncompressedBlockFlag) ? payload : decompressBlock(payload);
+            REQUIRE(block.size() == rawSize);
+            out += block;
+        }
+        return out;
+    }
+
+    std::string compress(const std::string &logs, std::size_t chunkSize)
+    {
+        std::ostringstream stream;
+        LogCompressor compressor{stream};
+        compressor.writeFileHeader();
+        for (std::size_t pos = 0; pos < logs.size(); pos += chunkSize) {
+            compressor.write(std::string_view(logs).substr(pos, chunkSize));
+        }
+        compressor.flush();
+        REQUIRE(compressor.getInputBytes() == logs.size());
+        REQUIRE(compressor.getOutputBytes() == stream.str().size());
+        return stream.str();
+    }
+
+    std::string createLogs(std::size_t lines)
+    {
+        RandomStringGenerator generator;
+        std::string logs;
+        for (std::size_t i = 0; i < lines; ++i) {
+            logs += std::to_string(i * 17) + " ms INFO  [ServiceCellular] ServiceCellular.cpp:handle:" +
+                    std::to_string(i % 300) + ": " + generator.getRandomString() + "\n";
+        }
+        return logs;
+    }
+} // namespace
+
+TEST_CASE("Log compressor - round trip")
+{
+    SECTION("Empty")
+    {
+        const auto file = compress("", 1);
+        REQUIRE(file.size() == 5);
+        REQUIRE(decompress(file).empty());
+    }
+
+    SECTION("Shorter than the minimal match")
+    {
+        const std::string logs = "0 ms INFO";
+        REQUIRE(decompress(compress(logs, 3)) == logs);
+    }
+
+    SECTION("Long runs")
+    {
+        const auto logs = std::string(5000, 'a') + std::string(300, 'b') + "end";
+        REQUIRE(decompress(compress(logs, 1000)) == logs);
+    }
+
+    SECTION("Random data is stored uncompressed")
+    {
+        RandomStringGenerator generator{1000, 1000};
+        const auto logs = generator.getRandomString();
+        const auto file = compress(logs, logs.size());
+        REQUIRE(file.size() == logs.size() + 5 + 8);
+        REQUIRE(decompress(file) == logs);
+    }
+
+    SECTION("Many blocks")
+    {
+        const auto logs = createLogs(3000);
+        REQUIRE(logs.size() > 4 * LogCompressor::blockSize);
+        const auto file = compress(logs, 100);
+        REQUIRE(decompress(file) == logs);
+        REQUIRE(file.size() * 2 < logs.size());
+    }
+}
+
+TEST_CASE("Log compressor - decompression")
+{
+    const auto logs = createLogs(1000);
+    const auto file = compress(logs, 100);
+
+    SECTION("Round trip")
+    {
+        std::istringstream input{file};
+        std::ostringstream output;
+        REQUIRE(LogCompressor::decompress(input, output));
+        REQUIRE(output.str() == logs);
+    }
+
+    SECTION("Not a compressed file")
+    {
+        std::istringstream input{logs};
+        std::ostringstream output;
+        REQUIRE_FALSE(LogCompressor::decompress(input, output));
+    }
+
+    SECTION("Truncated file")
+    {
+        for (const auto size : {file.size() - 1, file.size() - 100, std::size_t{9}}) {
+            std::istringstream input{file.substr(0, size)};
+            std::ostringstream output;
+            REQUIRE_FALSE(LogCompressor::decompress(input, output));
+        }
+    }
+
+    SECTION("Corrupted block")
+    {
+        std::string block(LogCompressor::compressBound(LogCompressor::blockSize), '\0');
+        auto hashTable         = std::make_unique<std::uint16_t[]>(1U << 12);
+        const auto *src        = reinterpret_cast<const std::uint8_t *>(logs.data());
+        auto *dst              = reinterpret_cast<std::uint8_t *>(block.data());
+        const auto blockLength = LogCompressor::compressBlock(src, LogCompressor::blockSize, dst, hashTable.get());
+
+        std::string decompressed(LogCompressor::blockSize, '\0');
+        auto *out = reinterpret_cast<std::uint8_t *>(decompressed.data());
+        REQUIRE(LogCompressor::decompressBlock(dst, blockLength, out, decompressed.size()) == LogCompressor::blockSize);
+        REQUIRE(decompressed == logs.substr(0, LogCompressor::blockSize));
+
+        REQUIRE(LogCompressor::decompressBlock(dst, blockLength, out, decompressed.size() - 1) == 0);
+        REQUIRE(LogCompressor::decompressBlock(dst, blockLength - 1, out, decompressed.size()) !=
+                LogCompressor::blockSize);
+    }
+}
@@ -4,9 +4,12 @@
 #define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
 #include <catch2/catch.hpp>
 
+#include <cstring>
+#include <fstream>
 #include <string>
 
 #include <log/Logger.hpp>
+#include <LogCompressor.hpp>
 
 namespace
 {
@@ -24,7 +27,7 @@ namespace
         for (int i = 0; i < expectedFilesCount; ++i) {
             auto filePath = path;
             if (i > 0) {
-                filePath.replace_extension(".log." + std::to_string(i));
+                filePath.replace_extension(".lz4." + std::to_string(i));
             }
             if (!std::filesystem::exists(filePath)) {
                 return false;
@@ -32,6 +35,14 @@ namespace
         }
         return true;
     }
+
+    bool isCompressedLogFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::string magic(std::strlen(Log::LogCompressor::magic), '\0');
+        file.read(magic.data(), magic.size());
+        return file.good() && magic == Log::LogCompressor::magic;
+    }
 } // namespace
 
 TEST_CASE("Test if logs are dumped to a file without rotation")
@@ -40,7 +51,7 @@ TEST_CASE("Test if logs are dumped to a file without rotation")
     constexpr auto MaxFileSize          = 1024 * 1024; // 1 MB
     constexpr auto TestLog              = "12345678";
     const std::filesystem::path logsDir = "./ut_logs";
-    const auto testLogFile              = logsDir / "TestApp.log";
+    const auto testLogFile              = logsDir / "TestApp.log.lz4";
 
     // Prepare the environment.
     if (std::filesystem::exists(logsDir)) {
@@ -57,12 +68,18 @@ TEST_CASE("Test if logs are dumped to a file without rotation")
     Log::Logger::get().dumpToFile(testLogFile);
     REQUIRE(countFiles(logsDir) == 1);
     REQUIRE(checkIfLogFilesExist(testLogFile, 1));
+    REQUIRE(isCompressedLogFile(testLogFile));
 
     LOG_ERROR(TestLog);
     Log::Logger::get().dumpToFile(testLogFile);
     REQUIRE(countFiles(logsDir) == 1);
     REQUIRE(checkIfLogFilesExist(testLogFile, 1));
 
+    const auto stats = Log::Logger::get().getFlushStatistics();
+    REQUIRE(stats.logBytes > 0);
+    REQUIRE(stats.flashBytes > 0);
+    REQUIRE(stats.totalLogBytes > stats.logBytes);
+
     // Clean-up the environment
     std::filesystem::remove_all(logsDir);
 }
@@ -73,7 +90,7 @@ TEST_CASE("Test if log files rotate")
     constexpr auto MaxFileSize          = 10; // 10 bytes
     constexpr auto TestLog              = "12345678";
     const std::filesystem::path logsDir = "./ut_logs";
-    const auto testLogFile              = logsDir / "TestApp.log";
+    const auto testLogFile              = logsDir / "TestApp.log.lz4";
 
     // Prepare the environment.
     if (std::filesystem::exists(logsDir)) {
@@ -1,6 +1,7 @@
 ﻿// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
+#include <array>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -691,6 +692,62 @@ TEST_CASE("Duration - display")
         REQUIRE(duration.str(Duration::DisplayedFormat::FixedH0M0S) == "48:03:04");
     }
 }
+TEST_CASE("Timestamp - print to buffer")
+{
+    utils::setDisplayLanguage("English");
+    setenv("TZ", "GMT0", 1);
+    Timestamp timestamp(1623714101);
+
+    SECTION("fits")
+    {
+        std::array<char, 32> buffer;
+        const auto written = timestamp.print(buffer.data(), buffer.size(), "%a %d %B %H:%M");
+        REQUIRE(std::string(buffer.data()) == "Mon 14 June 23:41");
+        REQUIRE(written == std::string("Mon 14 June 23:41").size());
+    }
+
+    SECTION("too small")
+    {
+        std::array<char, 8> buffer;
+        REQUIRE(timestamp.print(buffer.data(), buffer.size(), "%A %d %B") == 0);
+    }
+
+    SECTION("literal percent sign")
+    {
+        REQUIRE(timestamp.str("%%a %a %%") == "%a Mon %");
+    }
+
+    SECTION("same format used many times")
+    {
+        for (auto i = 0; i < 100; i++) {
+            REQUIRE(timestamp.str("%A %b") == "Monday Jun");
+        }
+    }
+
+    SECTION("localized names follow display language")
+    {
+        REQUIRE(timestamp.str("%A %B") == "Monday June");
+        utils::setDisplayLanguage("Polski");
+        REQUIRE(timestamp.str("%A %B") != "Monday June");
+        REQUIRE(timestamp.str("%A") == utils::translate("common_monday"));
+        utils::setDisplayLanguage("English");
+        REQUIRE(timestamp.str("%A %B") == "Monday June");
+    }
+}
+
+TEST_CASE("Duration - print to buffer")
+{
+    utils::setDisplayLanguage("English");
+    Duration duration(27 * 60 * 60 + 23 * 60 + 4);
+
+    std::array<char, 16> buffer;
+    REQUIRE(duration.print(buffer.data(), buffer.size(), Duration::DisplayedFormat::Fixed0M0S) == 7);
+    REQUIRE(std::string(buffer.data()) == "1643:04");
+
+    std::array<char, 4> small;
+    REQUIRE(duration.print(small.data(), small.size(), Duration::DisplayedFormat::Fixed0M0S) == 0);
+}
+
 TEST_CASE("Timestamp factory")
 {
     SECTION("No setting provided")
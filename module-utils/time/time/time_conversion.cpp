@@ -18,8 +18,12 @@
 
 #include "time_locale.hpp"
 #include <Utils.hpp>
+#include <mutex.hpp>
 #include <time/time_constants.hpp>
 
+#include <cstdio>
+#include <cstring>
+
 namespace utils::time
 {
     namespace
@@ -29,12 +33,12 @@ namespace utils::time
         constexpr auto abbrev_len = 3U;
 
         /// order matters, it's used in replace_locale with enum Replacements
-        const std::vector<std::string> specifiers_replacement = {"%a",  // day abbrew
-                                                                 "%A",  // day long
-                                                                 "%b",  // month abbrew
-                                                                 "%B"}; // month long
-        constexpr auto hoursMinFormat12H                      = "%I:%M";
-        constexpr auto hoursMinFormat24H                      = "%H:%M";
+        constexpr std::array<char, 4> specifiers_replacement = {'a',  // day abbrew
+                                                                'A',  // day long
+                                                                'b',  // month abbrew
+                                                                'B'}; // month long
+        constexpr auto hoursMinFormat12H                     = "%I:%M";
+        constexpr auto hoursMinFormat24H                     = "%H:%M";
 
         struct Format
         {
@@ -52,28 +56,313 @@ namespace utils::time
             {Duration::DisplayedFormat::FixedH0M0S, {durationFormatH0M0S, durationFormatH0M0S}},
             {Duration::DisplayedFormat::AutoM, {durationFormatM0S, durationFormatH0M0S}},
             {Duration::DisplayedFormat::Auto0M, {durationFormat0M0S, durationFormatH0M0S}}};
+
+        /// duration fields in order of Duration format specifiers: %H, %M, %N, %S
+        const std::string durationSpecifiers = "HMNS";
+
+        /// strftime conversions never produce more than this, so empty result with more space left isn't an overflow
+        constexpr auto maxConversionLength = 64U;
+        /// number of compiled time formats kept, there are only a few of them in use at the same time
+        constexpr auto maxCachedFormats = 16U;
+
+        /// part of the format string, parsed once and reused on every call
+        struct Token
+        {
+            enum class Type
+            {
+                Text,       /// copied to output as is
+                Conversion, /// single strftime conversion specification
+                Name,       /// localized day or month name, value is Localer::Replacements
+                Field,      /// duration field, value is index in durationSpecifiers
+                FieldZero   /// duration field with leading zeros
+            };
+            Type type;
+            std::string text;
+            unsigned value = 0;
+        };
+        using CompiledFormat = std::vector<Token>;
+
+        void appendText(CompiledFormat &tokens, const char *text, std::size_t length)
+        {
+            if (!tokens.empty() && tokens.back().type == Token::Type::Text) {
+                tokens.back().text.append(text, length);
+                return;
+            }
+            tokens.push_back({Token::Type::Text, std::string(text, length)});
+        }
+
+        CompiledFormat compileTimeFormat(const std::string &format)
+        {
+            constexpr std::string_view flags = "_-0^#+";
+            CompiledFormat tokens;
+            std::size_t pos = 0;
+            while (pos < format.size()) {
+                const auto next = format.find('%', pos);
+                if (next == std::string::npos) {
+                    appendText(tokens, format.c_str() + pos, format.size() - pos);
+                    break;
+                }
+                appendText(tokens, format.c_str() + pos, next - pos);
+
+                auto end = next + 1;
+                while (end < format.size() && flags.find(format[end]) != std::string_view::npos) {
+                    ++end;
+                }
+                while (end < format.size() && std::isdigit(static_cast<unsigned char>(format[end]))) {
+                    ++end;
+                }
+                if (end < format.size() && (format[end] == 'E' || format[end] == 'O')) {
+                    ++end;
+                }
+                if (end >= format.size()) {
+                    // incomplete specification is passed to strftime as it was before
+                    tokens.push_back({Token::Type::Conversion, format.substr(next)});
+                    break;
+                }
+
+                const auto conversion = format[end];
+                const auto name =
+                    std::find(specifiers_replacement.begin(), specifiers_replacement.end(), conversion);
+                if (conversion == '%' && end == next + 1) {
+                    appendText(tokens, "%", 1);
+                }
+                else if (name != specifiers_replacement.end() && end == next + 1) {
+                    tokens.push_back({Token::Type::Name,
+                                      {},
+                                      static_cast<unsigned>(std::distance(specifiers_replacement.begin(), name))});
+                }
+                else {
+                    tokens.push_back({Token::Type::Conversion, format.substr(next, end - next + 1)});
+                }
+                pos = end + 1;
+            }
+            return tokens;
+        }
+
+        CompiledFormat compileDurationFormat(const std::string &format)
+        {
+            CompiledFormat tokens;
+            std::size_t pos = 0;
+            while (pos < format.size()) {
+                const auto next = format.find('%', pos);
+                if (next == std::string::npos) {
+                    appendText(tokens, format.c_str() + pos, format.size() - pos);
+                    break;
+                }
+                appendText(tokens, format.c_str() + pos, next - pos);
+
+                const bool leadingZero = next + 1 < format.size() && format[next + 1] == '0';
+                const auto fieldPos    = next + (leadingZero ? 2 : 1);
+                const auto field       = fieldPos < format.size() ? durationSpecifiers.find(format[fieldPos])
+                                                                  : std::string::npos;
+                if (field == std::string::npos) {
+                    // not a duration specifier, keep it in output
+                    appendText(tokens, "%", 1);
+                    pos = next + 1;
+                    continue;
+                }
+                tokens.push_back(
+                    {leadingZero ? Token::Type::FieldZero : Token::Type::Field, {}, static_cast<unsigned>(field)});
+                pos = fieldPos + 1;
+            }
+            return tokens;
+        }
+
+        /// appends data to caller provided buffer, keeps it null terminated
+        class BufferWriter
+        {
+          public:
+            BufferWriter(char *buffer, std::size_t size) : buffer{buffer}, size{size}
+            {
+                if (size > 0) {
+                    buffer[0] = 0;
+                }
+            }
+
+            bool append(const char *text, std::size_t length)
+            {
+                if (failed || length >= size - used) {
+                    failed = true;
+                    return false;
+                }
+                memcpy(buffer + used, text, length);
+                used += length;
+                buffer[used] = 0;
+                return true;
+            }
+
+            bool appendConversion(const std::string &conversion, const struct tm &timeinfo)
+            {
+                if (failed) {
+                    return false;
+                }
+                const auto space   = size - used;
+                const auto written = std::strftime(buffer + used, space, conversion.c_str(), &timeinfo);
+                if (written == 0 && space <= maxConversionLength) {
+                    failed = true;
+                    return false;
+                }
+                used += written;
+                buffer[used] = 0;
+                return true;
+            }
+
+            bool appendNumber(unsigned long value, bool leadingZero)
+            {
+                std::array<char, 24> number;
+                const auto length = std::snprintf(number.data(), number.size(), leadingZero ? "%02lu" : "%lu", value);
+                return append(number.data(), length);
+            }
+
+            std::size_t result() const
+            {
+                return failed ? 0 : used;
+            }
+
+          private:
+            char *buffer;
+            std::size_t size;
+            std::size_t used = 0;
+            bool failed      = size == 0;
+        };
+
+        /// Compiled formats and localized names shared by all Timestamp and Duration objects. Names are taken from
+        /// translations once per display language instead of on every call.
+        class FormatCache
+        {
+          public:
+            std::size_t formatTime(char *buffer, std::size_t size, const std::string &format, const struct tm &timeinfo)
+            {
+                cpp_freertos::LockGuard lock(mutex);
+                refresh();
+                BufferWriter writer(buffer, size);
+                for (const auto &token : compiled(timeFormats, format, compileTimeFormat)) {
+                    switch (token.type) {
+                    case Token::Type::Text:
+                        writer.append(token.text.c_str(), token.text.size());
+                        break;
+                    case Token::Type::Conversion:
+                        writer.appendConversion(token.text, timeinfo);
+                        break;
+                    case Token::Type::Name: {
+                        const auto &text = name(Localer::Replacements(token.value), timeinfo);
+                        writer.append(text.c_str(), text.size());
+                    } break;
+                    default:
+                        break;
+                    }
+                }
+                return writer.result();
+            }
+
+            std::size_t formatDuration(char *buffer,
+                                       std::size_t size,
+                                       const std::string &formatName,
+                                       const std::array<unsigned long, 4> &fields)
+            {
+                cpp_freertos::LockGuard lock(mutex);
+                refresh();
+                auto it = durationFormats.find(formatName);
+                if (it == durationFormats.end()) {
+                    it = durationFormats.emplace(formatName, compileDurationFormat(utils::translate(formatName))).first;
+                }
+                BufferWriter writer(buffer, size);
+                for (const auto &token : it->second) {
+                    switch (token.type) {
+                    case Token::Type::Text:
+                        writer.append(token.text.c_str(), token.text.size());
+                        break;
+                    case Token::Type::Field:
+                    case Token::Type::FieldZero:
+                        writer.appendNumber(fields[token.value], token.type == Token::Type::FieldZero);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                return writer.result();
+            }
+
+            UTF8 replacement(Localer::Replacements val, const struct tm &timeinfo)
+            {
+                cpp_freertos::LockGuard lock(mutex);
+                refresh();
+                return UTF8(name(val, timeinfo));
+            }
+
+          private:
+            /// reloads localized names if display language has changed
+            void refresh()
+            {
+                const auto version = utils::getDisplayLanguageVersion();
+                if (loaded && version == languageVersion) {
+                    return;
+                }
+                for (std::uint32_t day = 0; day < Locale::num_days; ++day) {
+                    const auto dayName             = Locale::get_day(day);
+                    names[Localer::DayLong][day]   = dayName.c_str();
+                    names[Localer::DayAbbrev][day] = dayName.substr(0, abbrev_len).c_str();
+                }
+                for (std::uint32_t month = 0; month < Locale::num_months; ++month) {
+                    const auto monthName               = Locale::get_month(Locale::Month(month));
+                    names[Localer::MonthLong][month]   = monthName.c_str();
+                    names[Localer::MonthAbbrev][month] = monthName.substr(0, abbrev_len).c_str();
+                }
+                durationFormats.clear();
+                languageVersion = version;
+                loaded          = true;
+            }
+
+            const std::string &name(Localer::Replacements val, const struct tm &timeinfo) const
+            {
+                static const std::string empty;
+                const auto index = (val == Localer::DayLong || val == Localer::DayAbbrev) ? timeinfo.tm_wday
+                                                                                          : timeinfo.tm_mon;
+                const auto &values = names[val];
+                if (index < 0 || static_cast<unsigned>(index) >= values.size() || values[index].empty()) {
+                    return empty;
+                }
+                return values[index];
+            }
+
+            template <typename Compile>
+            const CompiledFormat &compiled(std::map<std::string, CompiledFormat> &cache,
+                                           const std::string &format,
+                                           Compile compile)
+            {
+                if (auto it = cache.find(format); it != cache.end()) {
+                    return it->second;
+                }
+                if (cache.size() >= maxCachedFormats) {
+                    cache.clear();
+                }
+                return cache.emplace(format, compile(format)).first->second;
+            }
+
+            cpp_freertos::MutexStandard mutex;
+            bool loaded                   = false;
+            std::uint32_t languageVersion = 0;
+            std::array<std::vector<std::string>, specifiers_replacement.size()> names{
+                std::vector<std::string>(Locale::num_days),
+                std::vector<std::string>(Locale::num_days),
+                std::vector<std::string>(Locale::num_months),
+                std::vector<std::string>(Locale::num_months)};
+            std::map<std::string, CompiledFormat> timeFormats;
+            std::map<std::string, CompiledFormat> durationFormats;
+        };
+
+        FormatCache &formatCache()
+        {
+            static FormatCache cache;
+            return cache;
+        }
     } // namespace
 
     Locale tlocale;
 
     UTF8 Localer::get_replacement(Replacements val, const struct tm &timeinfo) const
     {
-        UTF8 retval = "";
-        switch (val) {
-        case DayLong:
-            retval = Locale::get_day(Locale::Day(timeinfo.tm_wday));
-            break;
-        case DayAbbrev:
-            retval = Locale::get_day(Locale::Day(timeinfo.tm_wday)).substr(0, abbrev_len);
-            break;
-        case MonthLong:
-            retval = Locale::get_month(Locale::Month(timeinfo.tm_mon));
-            break;
-        case MonthAbbrev:
-            retval = Locale::get_month(Locale::Month(timeinfo.tm_mon)).substr(0, abbrev_len);
-            break;
-        }
-        return retval;
+        return formatCache().replacement(val, timeinfo);
     }
 
     Timestamp::Timestamp(time_t newtime) : time(newtime)
@@ -86,18 +375,17 @@ namespace utils::time
     constexpr uint32_t datasize = 128;
     UTF8 Timestamp::str(std::string fmt) const
     {
-        if (fmt.compare("") == 0) {
-            fmt = format; // take default
+        std::array<char, datasize> data;
+        if (print(data.data(), data.size(), fmt) != 0) {
+            return UTF8(data.data());
         }
-        UTF8 datetimestr = "";
-        auto timeInfo    = std::localtime(&time);
-        auto replaceFunc = [&](int idx) { return get_replacement(Replacements(idx), *timeInfo); };
-        utils::findAndReplaceAll(fmt, specifiers_replacement, replaceFunc);
-        auto data = std::unique_ptr<char[]>(new char[datasize]);
-        if (std::strftime(data.get(), datasize, fmt.c_str(), timeInfo) != 0) {
-            datetimestr = UTF8(data.get());
-        }
-        return datetimestr;
+        return UTF8("");
+    }
+
+    std::size_t Timestamp::print(char *buffer, std::size_t size, const std::string &fmt) const
+    {
+        auto timeInfo = std::localtime(&time);
+        return formatCache().formatTime(buffer, size, fmt.empty() ? format : fmt, *timeInfo);
     }
 
     UTF8 Timestamp::day(bool abbrev) const
@@ -241,22 +529,6 @@ namespace utils::time
     Duration::Duration(const Timestamp &stop, const Timestamp &start) : Duration(stop.getTime(), start.getTime())
     {}
 
-    void Duration::fillStr(std::string &format) const
-    {
-        constexpr auto numberOfLeadingDigits = 2;
-        utils::findAndReplaceAll(format, "%H", utils::to_string(hours));
-        utils::findAndReplaceAll(format, "%M", utils::to_string(minutes));
-        utils::findAndReplaceAll(format, "%N", utils::to_string(hmminutes));
-        utils::findAndReplaceAll(format, "%S", utils::to_string(seconds));
-        utils::findAndReplaceAll(format, "%0H", utils::addLeadingZeros(utils::to_string(hours), numberOfLeadingDigits));
-        utils::findAndReplaceAll(
-            format, "%0M", utils::addLeadingZeros(utils::to_string(minutes), numberOfLeadingDigits));
-        utils::findAndReplaceAll(
-            format, "%0N", utils::addLeadingZeros(utils::to_string(hmminutes), numberOfLeadingDigits));
-        utils::findAndReplaceAll(
-            format, "%0S", utils::addLeadingZeros(utils::to_string(seconds), numberOfLeadingDigits));
-    }
-
     void Duration::calculate()
     {
         hours     = this->duration / secondsInHour;
@@ -271,12 +543,17 @@ namespace utils::time
 
     UTF8 Duration::str(DisplayedFormat displayedFormat) const
     {
-        // switch between format low and hig
-        std::string data = utils::translate(hours != 0 ? formatMap.at(displayedFormat).highFormat
-                                                       : formatMap.at(displayedFormat).lowFormat);
-        fillStr(data);
+        std::array<char, datasize> data;
+        print(data.data(), data.size(), displayedFormat);
+        return UTF8(data.data());
+    }
 
-        return data;
+    std::size_t Duration::print(char *buffer, std::size_t size, DisplayedFormat displayedFormat) const
+    {
+        // switch between format low and hig
+        const auto &formatName =
+            hours != 0 ? formatMap.at(displayedFormat).highFormat : formatMap.at(displayedFormat).lowFormat;
+        return formatCache().formatDuration(buffer, size, formatName, {hours, minutes, hmminutes, seconds});
     }
 
     Timestamp getCurrentTimestamp()
@@ -109,6 +109,10 @@ namespace utils
             /// get Time in any format possible via strftime
             virtual UTF8 str(std::string format = "") const;
 
+            /// writes Time formatted like str() into provided buffer, format is parsed once and cached
+            /// @return number of bytes written without null terminator, 0 if result doesn't fit into the buffer
+            std::size_t print(char *buffer, std::size_t size, const std::string &format = "") const;
+
             /// get day UTF8 value
             UTF8 day(bool abbrev = false) const;
 
@@ -229,6 +233,12 @@ namespace utils
 
             UTF8 str(DisplayedFormat displayedFormat = DisplayedFormat::Auto0M) const;
 
+            /// writes duration formatted like str() into provided buffer
+            /// @return number of bytes written without null terminator, 0 if result doesn't fit into the buffer
+            std::size_t print(char *buffer,
+                              std::size_t size,
+                              DisplayedFormat displayedFormat = DisplayedFormat::Auto0M) const;
+
             // uses default format
             friend inline std::ostream &operator<<(std::ostream &os, Duration t)
             {
@@ -274,7 +284,6 @@ namespace utils
             }
 
           private:
-            void fillStr(std::string &formatlong) const;
             void calculate();
             time_t duration         = 0;
             unsigned long hours     = 0;
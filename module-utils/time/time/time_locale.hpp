@@ -20,10 +20,10 @@ namespace utils
         class Locale
         {
           public:
-            static constexpr int num_days = 7;
+            static constexpr int num_days   = 7;
+            static constexpr int num_months = 12;
 
           private:
-            static const int num_monts      = 12;
             static const int num_formatters = 9;
             // imo it would be nicer to have datetime locales in different json with thiny bit nicer and more effective
             // getters
@@ -38,7 +38,7 @@ namespace utils
                                                             "common_friday",
                                                             "common_saturday"};
 
-            const std::array<std::string, num_monts> months = {"common_january",
+            const std::array<std::string, num_months> months = {"common_january",
                                                                "common_february",
                                                                "common_march",
                                                                "common_april",
@@ -180,7 +180,7 @@ namespace utils
 
             static const UTF8 get_month(enum Month mon)
             {
-                if (mon >= num_monts) {
+                if (mon >= num_months) {
                     LOG_ERROR("Bad value %d", mon);
                     return "";
                 }
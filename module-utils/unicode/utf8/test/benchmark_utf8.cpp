@@ -0,0 +1,99 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include "utf8/UTF8.hpp"
+
+#include <string>
+
+// Benchmarks are hidden from default run, use: catch2-utf8 "[benchmark]"
+namespace
+{
+    const std::string shortText = "Zażółć";
+    std::string longText()
+    {
+        std::string text;
+        for (int i = 0; i < 32; ++i) {
+            text += "Zadzwonię później, walczę z ostrym cieniem mgły ;) ";
+        }
+        return text;
+    }
+} // namespace
+
+TEST_CASE("UTF8: construction benchmark", "[.][benchmark]")
+{
+    const auto text = longText();
+
+    BENCHMARK("short UTF8")
+    {
+        return UTF8(shortText);
+    };
+    BENCHMARK("short std::string reference")
+    {
+        return std::string(shortText);
+    };
+    BENCHMARK("long UTF8")
+    {
+        return UTF8(text);
+    };
+    BENCHMARK("long std::string reference")
+    {
+        return std::string(text);
+    };
+}
+
+TEST_CASE("UTF8: character access benchmark", "[.][benchmark]")
+{
+    const UTF8 text = longText();
+
+    BENCHMARK("operator[] sequential")
+    {
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < text.length(); ++i) {
+            sum += text[i];
+        }
+        return sum;
+    };
+    BENCHMARK("operator[] reverse")
+    {
+        uint32_t sum = 0;
+        for (uint32_t i = text.length(); i > 0; --i) {
+            sum += text[i - 1];
+        }
+        return sum;
+    };
+    BENCHMARK("const_iterator")
+    {
+        uint32_t sum = 0;
+        for (const auto code : text) {
+            sum += code;
+        }
+        return sum;
+    };
+    BENCHMARK("substr")
+    {
+        return text.substr(text.length() / 2, 16);
+    };
+}
+
+TEST_CASE("UTF8: append benchmark", "[.][benchmark]")
+{
+    BENCHMARK("insertCode at the end")
+    {
+        UTF8 text;
+        for (uint32_t i = 0; i < 256; ++i) {
+            text.insertCode(0x105);
+        }
+        return text;
+    };
+    BENCHMARK("operator+=")
+    {
+        UTF8 text;
+        const UTF8 part = shortText;
+        for (uint32_t i = 0; i < 64; ++i) {
+            text += part;
+        }
+        return text;
+    };
+}
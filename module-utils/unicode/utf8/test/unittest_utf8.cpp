@@ -377,3 +377,124 @@ TEST_CASE("UTF8: Not ASCII combination")
         REQUIRE_FALSE(combination.toASCII().has_value());
     }
 }
+
+TEST_CASE("UTF8: short strings are stored inline")
+{
+    UTF8 ustr = "Rąbać";
+    REQUIRE(ustr.allocated() == 16);
+    REQUIRE(ustr.length() == 5);
+
+    ustr += UTF8("1234567890");
+    REQUIRE(ustr.allocated() > 16);
+    REQUIRE(ustr == UTF8("Rąbać1234567890"));
+
+    ustr.clear();
+    REQUIRE(ustr.allocated() == 16);
+    REQUIRE(ustr.empty());
+}
+
+TEST_CASE("UTF8: move leaves empty string")
+{
+    SECTION("Short string")
+    {
+        UTF8 source = "ą";
+        UTF8 target = std::move(source);
+        REQUIRE(target == UTF8("ą"));
+        REQUIRE(source.empty());
+        REQUIRE(std::string(source.c_str()).empty());
+    }
+
+    SECTION("Long string")
+    {
+        UTF8 source = "Zadzwonię później, walczę z ostrym cieniem mgły ;)";
+        UTF8 target;
+        target = std::move(source);
+        REQUIRE(target == UTF8("Zadzwonię później, walczę z ostrym cieniem mgły ;)"));
+        REQUIRE(source.empty());
+        REQUIRE(std::string(source.c_str()).empty());
+    }
+}
+
+TEST_CASE("UTF8: random access in long string")
+{
+    std::string raw;
+    std::u32string codes;
+    for (uint32_t i = 0; i < 300; ++i) {
+        if (i % 3 == 0) {
+            raw += "ż";
+            codes += U'ż';
+        }
+        else {
+            raw += static_cast<char>('a' + i % 26);
+            codes += static_cast<char32_t>('a' + i % 26);
+        }
+    }
+    const UTF8 ustr = raw;
+    REQUIRE(ustr.length() == codes.size());
+
+    SECTION("Forward")
+    {
+        for (uint32_t i = 0; i < codes.size(); ++i) {
+            REQUIRE(ustr[i] == codes[i]);
+        }
+    }
+
+    SECTION("Backward")
+    {
+        for (uint32_t i = codes.size(); i > 0; --i) {
+            REQUIRE(ustr[i - 1] == codes[i - 1]);
+        }
+    }
+
+    SECTION("Jumps")
+    {
+        for (uint32_t i = 0; i < codes.size(); ++i) {
+            const auto idx = (i * 97) % codes.size();
+            REQUIRE(ustr[idx] == codes[idx]);
+        }
+    }
+
+    SECTION("Substring and modifications")
+    {
+        UTF8 copy = ustr;
+        REQUIRE(copy.substr(150, 3) == UTF8("żvw"));
+        REQUIRE(copy.removeChar(0, 150));
+        REQUIRE(copy[0] == codes[150]);
+        REQUIRE(copy.insertCode(U'ą', 1));
+        REQUIRE(copy[1] == U'ą');
+        REQUIRE(copy[2] == codes[151]);
+    }
+}
+
+TEST_CASE("UTF8: const_iterator")
+{
+    const UTF8 ustr = "Rąbać";
+    std::u32string codes;
+    for (auto code : ustr) {
+        codes += static_cast<char32_t>(code);
+    }
+    REQUIRE(codes == U"Rąbać");
+
+    const UTF8 empty;
+    REQUIRE(empty.begin() == empty.end());
+}
+
+TEST_CASE("UTF8: insertString")
+{
+    UTF8 ustr = "Rąć";
+    REQUIRE(ustr.insertString("ba", 2));
+    REQUIRE(ustr == UTF8("Rąbać"));
+    REQUIRE(ustr.length() == 5);
+
+    REQUIRE(ustr.insertString(ustr));
+    REQUIRE(ustr == UTF8("RąbaćRąbać"));
+}
+
+TEST_CASE("UTF8: split")
+{
+    UTF8 ustr = "Zadzwonię później";
+    auto tail = ustr.split(10);
+    REQUIRE(ustr == UTF8("Zadzwonię "));
+    REQUIRE(tail == UTF8("później"));
+    REQUIRE(tail.length() == 7);
+}
@@ -1,6 +1,7 @@
 // Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cstdint>
@@ -113,99 +114,147 @@ void U8char::set(char *val, unsigned int size)
 }
 
 UTF8::UTF8()
-    : data{std::make_unique<char[]>(stringExpansion)},
-      sizeAllocated{stringExpansion}, sizeUsed{1}, strLength{0}, lastIndex{0}, lastIndexData{data.get()}
+    : inlineData{}, sizeAllocated{inlineCapacity}, sizeUsed{1}, strLength{0}, lastIndex{0}, lastIndexOffset{0}
 {}
 
-UTF8::UTF8(const char *str)
+UTF8::UTF8(const char *str) : UTF8()
 {
+    uint32_t size  = 0;
+    uint32_t count = 0;
+    if (!getStreamLength(str, size, count)) {
+        size = strlen(str);
+    }
     // bufferSize increased by 1 to ensure ending 0 in new string
-    sizeUsed      = strlen(str) + 1;
-    sizeAllocated = getDataBufferSize(sizeUsed);
-    data          = std::make_unique<char[]>(sizeAllocated);
-    if (data != nullptr) {
-        memcpy(data.get(), str, sizeUsed);
-        lastIndexData = data.get();
+    if (reserve(size + 1)) {
+        memcpy(buffer(), str, size + 1);
+        sizeUsed  = size + 1;
+        strLength = count;
     }
-    strLength = getCharactersCount(data.get());
-    lastIndex = 0;
 }
 
-UTF8::UTF8(const std::string &str)
+UTF8::UTF8(const std::string &str) : UTF8()
 {
     // bufferSize increased by 1 to ensure ending 0 in new string
-    sizeUsed      = str.length() + 1;
-    sizeAllocated = getDataBufferSize(sizeUsed);
-    data          = std::make_unique<char[]>(sizeAllocated);
-    if (data != nullptr) {
-        memcpy(data.get(), str.c_str(), sizeUsed);
-        lastIndexData = data.get();
+    if (reserve(str.length() + 1)) {
+        memcpy(buffer(), str.c_str(), str.length() + 1);
+        sizeUsed  = str.length() + 1;
+        strLength = getCharactersCount(buffer());
     }
-    strLength = getCharactersCount(data.get());
-    lastIndex = 0;
 }
 
-UTF8::UTF8(const UTF8 &utf)
+UTF8::UTF8(const UTF8 &utf) : UTF8()
 {
-    strLength     = utf.strLength;
-    sizeAllocated = utf.sizeAllocated;
-    sizeUsed      = utf.sizeUsed;
-
     // if there is any data used in the string allocate memory and copy usedSize bytes
-    if (strLength != 0) {
-        data = std::make_unique<char[]>(sizeAllocated);
-        if (data == nullptr) {
-            sizeAllocated = 0;
-            sizeUsed      = 0;
-            return;
-        }
-        memcpy(data.get(), utf.data.get(), sizeAllocated);
+    if (utf.strLength != 0 && reserve(utf.sizeUsed)) {
+        memcpy(buffer(), utf.buffer(), utf.sizeUsed);
+        sizeUsed  = utf.sizeUsed;
+        strLength = utf.strLength;
     }
-    else {
-        sizeAllocated = stringExpansion;
-        data          = std::make_unique<char[]>(sizeAllocated);
-        sizeUsed      = 1;
-    }
-    lastIndex     = 0;
-    lastIndexData = data.get();
 }
 
-UTF8::UTF8(UTF8 &&utf)
-    : data{std::move(utf.data)}, sizeAllocated{utf.sizeAllocated}, sizeUsed{utf.sizeUsed}, strLength{utf.strLength},
-      lastIndex{0}, lastIndexData{data.get()}
-{}
+UTF8::UTF8(UTF8 &&utf) : UTF8()
+{
+    *this = std::move(utf);
+}
 
-UTF8::UTF8(const char *data, const uint32_t allocated, const uint32_t used, const uint32_t len)
-    : sizeAllocated{allocated}, sizeUsed{used}, strLength{len}, lastIndex{0}
+UTF8::UTF8(const char *str, const uint32_t bytes, const uint32_t len) : UTF8()
 {
-    this->data = std::make_unique<char[]>(allocated);
-    if (this->data == nullptr) {
-        sizeAllocated = 0;
-        sizeUsed      = 0;
-        strLength     = 0;
-        return;
+    if (reserve(bytes + 1)) {
+        memcpy(buffer(), str, bytes);
+        buffer()[bytes] = 0;
+        sizeUsed        = bytes + 1;
+        strLength       = len;
+    }
+}
+
+bool UTF8::reserve(uint32_t size)
+{
+    if (size <= sizeAllocated) {
+        return true;
+    }
+    // grow geometrically so that appending character by character doesn't copy the whole buffer every time
+    uint32_t newSizeAllocated = getDataBufferSize(std::max(size, sizeAllocated + sizeAllocated / 2));
+    auto newData              = std::make_unique<char[]>(newSizeAllocated);
+    if (newData == nullptr) {
+        return false;
     }
-    memcpy(this->data.get(), data, allocated);
-    lastIndexData = this->data.get();
+    memcpy(newData.get(), buffer(), sizeUsed);
+    heapData      = std::move(newData);
+    sizeAllocated = newSizeAllocated;
+    return true;
 }
 
 bool UTF8::expand(uint32_t size)
 {
+    return reserve(sizeAllocated + size);
+}
 
-    uint32_t newSizeAllocated = getDataBufferSize(sizeAllocated + size);
-    auto newData              = std::make_unique<char[]>(newSizeAllocated);
+void UTF8::invalidateIndex() const noexcept
+{
+    lastIndex       = 0;
+    lastIndexOffset = 0;
+    offsetIndex.reset();
+}
 
-    if (newData != nullptr) {
+void UTF8::buildIndex() const
+{
+    offsetIndex     = std::make_unique<uint32_t[]>(strLength / indexStride + 1);
+    const char *ptr = buffer();
+    for (uint32_t i = 0; i < strLength; ++i) {
+        if (i % indexStride == 0) {
+            offsetIndex[i / indexStride] = ptr - buffer();
+        }
+        ptr += charLength(ptr);
+    }
+    if (strLength % indexStride == 0) {
+        offsetIndex[strLength / indexStride] = ptr - buffer();
+    }
+}
+
+const char *UTF8::locate(const uint32_t idx) const
+{
+    if (idx > strLength) {
+        return nullptr;
+    }
+    const char *base = buffer();
+    // for ASCII strings character index equals byte offset
+    if (isAscii()) {
+        return base + idx;
+    }
 
-        memcpy(newData.get(), data.get(), sizeUsed);
+    // start from closest known position: beginning of the string, index entry or last used index
+    uint32_t charCnt = 0;
+    uint32_t offset  = 0;
+    if (strLength >= indexThreshold) {
+        if (offsetIndex == nullptr) {
+            buildIndex();
+        }
+        charCnt = idx - idx % indexStride;
+        offset  = offsetIndex[idx / indexStride];
+    }
+    if (lastIndex <= idx && lastIndex > charCnt) {
+        charCnt = lastIndex;
+        offset  = lastIndexOffset;
+    }
+    else if (lastIndex > idx && lastIndex - idx < idx - charCnt) {
+        charCnt = lastIndex;
+        offset  = lastIndexOffset;
+        while (charCnt != idx) {
+            do {
+                --offset;
+            } while (UTF8_CHAR_IS_INNER(base[offset]));
+            --charCnt;
+        }
+    }
 
-        data          = std::move(newData);
-        sizeAllocated = newSizeAllocated;
-        lastIndex     = 0;
-        lastIndexData = data.get();
-        return true;
+    while (charCnt != idx) {
+        offset += charLength(base + offset);
+        ++charCnt;
     }
-    return false;
+
+    lastIndex       = charCnt;
+    lastIndexOffset = offset;
+    return base + offset;
 }
 
 uint32_t UTF8::getDataBufferSize(uint32_t dataBytes)
@@ -243,15 +292,17 @@ UTF8 &UTF8::operator=(const UTF8 &utf)
         return *this;
     }
 
-    sizeAllocated = utf.sizeAllocated;
-    sizeUsed      = utf.sizeUsed;
-    strLength     = utf.strLength;
-
-    data = std::make_unique<char[]>(sizeAllocated);
-    memcpy(data.get(), utf.data.get(), sizeAllocated);
-
-    lastIndex     = 0;
-    lastIndexData = data.get();
+    invalidateIndex();
+    sizeUsed  = 1;
+    strLength = 0;
+    if (reserve(utf.sizeUsed)) {
+        memcpy(buffer(), utf.buffer(), utf.sizeUsed);
+        sizeUsed  = utf.sizeUsed;
+        strLength = utf.strLength;
+    }
+    else {
+        buffer()[0] = 0;
+    }
 
     return *this;
 }
@@ -259,59 +310,73 @@ UTF8 &UTF8::operator=(const UTF8 &utf)
 UTF8 &UTF8::operator=(UTF8 &&utf) noexcept
 {
     // prevent moving if object is moved to itself
-    if (this != &utf) {
-        data          = std::move(utf.data);
+    if (this == &utf) {
+        return *this;
+    }
+
+    if (utf.heapData != nullptr) {
+        heapData      = std::move(utf.heapData);
         sizeAllocated = utf.sizeAllocated;
-        sizeUsed      = utf.sizeUsed;
-        strLength     = utf.strLength;
     }
+    else {
+        heapData.reset();
+        memcpy(inlineData, utf.inlineData, utf.sizeUsed);
+        sizeAllocated = inlineCapacity;
+    }
+    sizeUsed        = utf.sizeUsed;
+    strLength       = utf.strLength;
+    lastIndex       = utf.lastIndex;
+    lastIndexOffset = utf.lastIndexOffset;
+    offsetIndex     = std::move(utf.offsetIndex);
+
+    // leave moved-from string empty but valid
+    utf.inlineData[0] = 0;
+    utf.sizeAllocated = inlineCapacity;
+    utf.sizeUsed      = 1;
+    utf.strLength     = 0;
+    utf.invalidateIndex();
     return *this;
 }
 
 uint32_t UTF8::operator[](const uint32_t &idx) const
 {
-
     if (idx >= strLength) {
         return 0;
     }
 
-    char *dataPtr    = nullptr;
-    uint32_t charCnt = 0;
-
-    if (lastIndex < idx) {
-        dataPtr = lastIndexData;
-        charCnt = lastIndex;
-    }
-    else {
-        dataPtr = data.get();
-        charCnt = 0;
-    }
+    const char *dataPtr = locate(idx);
     assert(dataPtr);
-    while (charCnt != idx) {
-        dataPtr += charLength(dataPtr);
-        charCnt++;
-    }
-
-    lastIndex     = charCnt;
-    lastIndexData = dataPtr;
 
     uint32_t length;
     return decode(dataPtr, length);
 }
 
-U8char UTF8::getChar(unsigned int pos)
+U8char UTF8::getChar(unsigned int pos) const
 {
-    auto ptr    = data.get();
-    long int to = pos;
-
-    U8char u;
-    while (to >= 0) {
-        u = U8char(ptr);
-        ptr += u.size;
-        --to;
+    if (pos >= strLength) {
+        return U8char();
     }
+    return U8char(const_cast<char *>(locate(pos)));
+}
+
+UTF8::const_iterator::value_type UTF8::const_iterator::operator*() const
+{
+    uint32_t length;
+    return decode(position, length);
+}
+
+UTF8::const_iterator &UTF8::const_iterator::operator++()
+{
+    // skip invalid bytes one by one so that iteration always reaches end of the string
+    position += std::max(charLength(position), 1U);
+    return *this;
+}
 
-    return u;
+UTF8::const_iterator UTF8::const_iterator::operator++(int)
+{
+    auto previous = *this;
+    ++(*this);
+    return previous;
 }
 
 UTF8 UTF8::operator+(const UTF8 &utf) const
@@ -326,20 +391,17 @@ UTF8 &UTF8::operator+=(const UTF8 &utf)
         return *this;
     }
 
-    uint32_t newSizeAllocated = getDataBufferSize(sizeUsed + utf.sizeUsed);
-    auto newData              = std::make_unique<char[]>(newSizeAllocated);
-    if (newData != nullptr) {
-
-        memcpy(newData.get(), data.get(), sizeUsed);
-        //-1 comes from the fact that null terminator is counted as a used byte in string's buffer.
-        memcpy(newData.get() + sizeUsed - 1, utf.data.get(), utf.sizeUsed);
-        data          = std::move(newData);
-        sizeAllocated = newSizeAllocated;
-        strLength += utf.strLength;
+    // sizes are stored before reserve, as utf may be the same object as this
+    const auto appendedBytes  = utf.sizeUsed;
+    const auto appendedLength = utf.strLength;
+    //-1 comes from the fact that null terminator is counted as a used byte in string's buffer.
+    if (reserve(sizeUsed + appendedBytes - 1)) {
+        memcpy(buffer() + sizeUsed - 1, utf.buffer(), appendedBytes - 1);
         //-1 is to ignore double null terminator as it is counted in sizeUsed
-        sizeUsed += utf.sizeUsed - 1;
-        lastIndex     = 0;
-        lastIndexData = data.get();
+        sizeUsed += appendedBytes - 1;
+        buffer()[sizeUsed - 1] = 0;
+        strLength += appendedLength;
+        offsetIndex.reset();
     }
     return *this;
 }
@@ -349,24 +411,24 @@ bool UTF8::operator==(const UTF8 &utf) const
     uint32_t len  = strLength - utf.strLength;
     uint32_t used = sizeUsed - utf.sizeUsed;
     if ((len | used) == 0) {
-        return memcmp(data.get(), utf.data.get(), sizeUsed) == 0;
+        return memcmp(buffer(), utf.buffer(), sizeUsed) == 0;
     }
     return false;
 }
 
 const char *UTF8::c_str() const
 {
-    return data.get();
+    return buffer();
 }
 
 void UTF8::clear()
 {
-    data          = std::make_unique<char[]>(stringExpansion);
-    sizeAllocated = stringExpansion;
+    heapData.reset();
+    inlineData[0] = 0;
+    sizeAllocated = inlineCapacity;
     sizeUsed      = 1;
     strLength     = 0;
-    lastIndex     = 0;
-    lastIndexData = data.get();
+    invalidateIndex();
 }
 
 UTF8 UTF8::substr(const uint32_t begin, const uint32_t length) const
@@ -376,32 +438,10 @@ UTF8 UTF8::substr(const uint32_t begin, const uint32_t length) const
         return UTF8();
     }
 
-    char *beginPtr = this->data.get();
-    char *endPtr   = nullptr;
-
-    uint32_t bufferSize = 0;
-    uint32_t strCounter = 0;
-    // find pointer to begin char
-    while (strCounter != begin) {
-        beginPtr += charLength(beginPtr);
-        strCounter++;
-    }
-    // find pinter to end char
-    endPtr = beginPtr;
-    for (strCounter = 0; strCounter < length; strCounter++) {
-        uint32_t charSize = 0;
-        charSize          = charLength(endPtr);
-        endPtr += charSize;
-        bufferSize += charSize;
-    }
-    // copy data to buffer
-    // bufferSize increased by 1 to ensure ending 0 in new string
-    auto buffer = std::make_unique<char[]>(bufferSize + 1);
-    memcpy(buffer.get(), beginPtr, bufferSize);
-
-    UTF8 retString = UTF8(buffer.get());
+    const char *beginPtr = locate(begin);
+    const char *endPtr   = locate(begin + length);
 
-    return retString;
+    return UTF8(beginPtr, endPtr - beginPtr, length);
 }
 
 uint32_t UTF8::find(const char *s, uint32_t pos) const
@@ -420,14 +460,9 @@ uint32_t UTF8::find(const char *s, uint32_t pos) const
         return npos;
     }
 
-    uint32_t position = 0;
-    auto *dataPtr     = this->data.get();
-
-    for (position = 0; position < pos; position++) {
-        dataPtr += charLength(dataPtr);
-    }
+    const char *dataPtr = locate(pos);
 
-    for (position = pos; position < this->length(); position++) {
+    for (uint32_t position = pos; position < this->length(); position++) {
 
         if (memcmp(dataPtr, s, stringSize) == 0) {
             return position;
@@ -458,7 +493,7 @@ uint32_t UTF8::findLast(const char *s, uint32_t pos) const
     }
 
     uint32_t position          = 0;
-    auto *dataPtr              = this->data.get();
+    const char *dataPtr        = buffer();
     uint32_t lastFoundPosition = npos;
 
     // calculate position of last string to compare
@@ -480,41 +515,26 @@ UTF8 UTF8::split(const uint32_t &idx)
         return UTF8();
     }
 
-    auto *dataPtr = this->data.get();
+    const char *dataPtr = locate(idx);
+    const auto offset   = static_cast<uint32_t>(dataPtr - buffer());
 
-    // move data pointer to split index
-    for (uint32_t i = 0; i < idx; i++) {
-        dataPtr += charLength(dataPtr);
-    }
     // create new string
-    UTF8 retString(dataPtr);
-
-    // re-create source string
-    // create temp copy of string
-    uint32_t tempStringSize       = dataPtr - this->data.get();
-    uint32_t tempStringBufferSize = getDataBufferSize(tempStringSize);
-    auto tempString               = std::make_unique<char[]>(tempStringBufferSize);
-
-    memcpy(tempString.get(), this->data.get(), tempStringSize);
+    UTF8 retString(dataPtr, sizeUsed - 1 - offset, strLength - idx);
 
-    // add 1 to ensure string terminating zero
-    this->sizeUsed      = tempStringSize + 1;
-    this->sizeAllocated = tempStringBufferSize;
-    this->strLength     = idx;
-
-    // clear used memory
-    this->data = std::move(tempString);
-
-    this->lastIndex     = 0;
-    this->lastIndexData = this->data.get();
+    // truncate source string in place, add 1 to ensure string terminating zero
+    buffer()[offset] = 0;
+    sizeUsed         = offset + 1;
+    strLength        = idx;
+    invalidateIndex();
 
     return retString;
 }
 
 UTF8 UTF8::getLine()
 {
-    for (uint32_t i = 0; i < this->length(); i++) {
-        uint32_t character = this->operator[](i);
+    uint32_t i = 0;
+    for (auto it = begin(); it != end(); ++it, ++i) {
+        const auto character = *it;
         if ((character == '\r') || (character == '\n')) {
             return this->substr(0, i);
         }
@@ -533,38 +553,18 @@ bool UTF8::removeChar(const uint32_t &pos, const uint32_t &count)
         return false;
     }
 
-    // get pointer to begin of string to remove
-    auto *beginPtr = this->data.get();
-    for (uint32_t i = 0; i < pos; i++) {
-        beginPtr += charLength(beginPtr);
-    }
-
-    // get pointer to end of string to remove
-    auto *endPtr = beginPtr;
-    for (uint32_t i = 0; i < count; i++) {
-        endPtr += charLength(endPtr);
-    }
+    // get offsets of the begin and end of string to remove
+    const auto beginOffset = static_cast<uint32_t>(locate(pos) - buffer());
+    const auto endOffset   = static_cast<uint32_t>(locate(pos + count) - buffer());
 
-    uint32_t bytesToRemove = endPtr - beginPtr;
-    uint32_t newStringSize = this->sizeUsed - bytesToRemove;
+    uint32_t bytesToRemove = endOffset - beginOffset;
 
-    uint32_t tempStringBufferSize = getDataBufferSize(newStringSize);
-    auto tempString               = std::make_unique<char[]>(tempStringBufferSize);
-    if (tempString == nullptr) {
-        return false;
-    }
+    // move remaining data together with the null terminator
+    memmove(buffer() + beginOffset, buffer() + endOffset, sizeUsed - endOffset);
 
-    // create new data buffer
-    uint32_t copyOffset = beginPtr - this->data.get();
-    memcpy(tempString.get(), this->data.get(), beginPtr - this->data.get());
-    memcpy(tempString.get() + copyOffset, endPtr, this->sizeUsed - bytesToRemove - copyOffset);
-
-    this->sizeAllocated = tempStringBufferSize;
     this->strLength -= count;
     this->sizeUsed -= bytesToRemove;
-
-    // assign new data buffer
-    this->data = std::move(tempString);
+    invalidateIndex();
 
     return true;
 }
@@ -643,31 +643,22 @@ bool UTF8::insert(const char *ch, const uint32_t &index)
         return false;
     }
 
-    // if there is not enough space in string buffer try to expand it by default expansion size.
-    if (ch_len + sizeUsed >= sizeAllocated) {
-        if (expand() == false) {
-            LOG_FATAL("expand");
-            return false;
-        }
-    }
-
-    // find pointer where new character should be copied
-    auto *pos = data.get();
-    for (unsigned int i = 0; i < insertIndex; i++) {
-        pos += charLength(pos);
-    }
+    // find offset where new character should be copied
+    const auto offset = static_cast<uint32_t>(locate(insertIndex) - buffer());
 
-    if ((pos - data.get()) >= static_cast<int64_t>(sizeUsed)) {
-        debug_utf("decode/encode error %d - ( %d ) < 0 && allocated: %d\n", sizeUsed, pos - data, sizeAllocated);
+    // if there is not enough space in string buffer try to expand it.
+    if (!reserve(sizeUsed + ch_len)) {
+        LOG_FATAL("expand");
         return false;
     }
-    if (insertIndex != length()) {
-        memmove(pos + ch_len, pos, sizeUsed - (pos - data.get())); // move data when insert is in text, not at the end
-    }
-    memcpy(pos, ch, ch_len); // copy UTF8 char value
+
+    auto *pos = buffer() + offset;
+    memmove(pos + ch_len, pos, sizeUsed - offset); // move data together with the null terminator
+    memcpy(pos, ch, ch_len);                       // copy UTF8 char value
 
     sizeUsed += ch_len;
     ++strLength;
+    invalidateIndex();
 
     return true;
 }
@@ -697,19 +688,27 @@ bool UTF8::insertString(const UTF8 &str, const uint32_t &index)
         insertIndex = strLength;
     }
 
-    uint32_t totalSize = sizeUsed + str.sizeUsed - 1; //-1 because there are 2 end terminators
-    expand(getDataBufferSize(totalSize));
+    if (&str == this) {
+        return insertString(UTF8(str), insertIndex);
+    }
+
+    const auto offset = static_cast<uint32_t>(locate(insertIndex) - buffer());
 
-    auto *beginPtr = this->data.get();
-    for (uint32_t i = 0; i < insertIndex; i++) {
-        beginPtr += charLength(beginPtr);
+    uint32_t totalSize = sizeUsed + str.sizeUsed - 1; //-1 because there are 2 end terminators
+    if (!reserve(totalSize)) {
+        return false;
     }
 
+    auto *beginPtr = buffer() + offset;
     //-1 to ignore end terminator from str
-    memmove(beginPtr + str.sizeUsed - 1, beginPtr, sizeUsed - (beginPtr - data.get()));
-    memcpy(beginPtr, str.data.get(), str.sizeUsed - 1);
+    memmove(beginPtr + str.sizeUsed - 1, beginPtr, sizeUsed - offset);
+    memcpy(beginPtr, str.buffer(), str.sizeUsed - 1);
 
-    return false;
+    sizeUsed = totalSize;
+    strLength += str.strLength;
+    invalidateIndex();
+
+    return true;
 }
 
 uint32_t UTF8::getCharactersCount(const char *stream)
@@ -791,7 +790,8 @@ std::ostream &operator<<(std::ostream &os, const UTF8 &el)
 
 bool UTF8::isASCIICombination() const noexcept
 {
-    const auto len                          = strlen(data.get());
+    const auto *data                        = buffer();
+    const auto len                          = strlen(data);
     std::size_t i                           = 0;
     constexpr char asciiZero                = '0';
     constexpr uint8_t firstCharacterFactor  = 100;
@@ -817,7 +817,8 @@ bool UTF8::isASCIICombination() const noexcept
 std::optional<std::string> UTF8::toASCII() const noexcept
 {
     std::string ret{};
-    const auto len                          = strlen(data.get());
+    const auto *data                        = buffer();
+    const auto len                          = strlen(data);
     constexpr char asciiZero                = '0';
     constexpr uint8_t firstCharacterFactor  = 100;
     constexpr uint8_t secondCharacterFactor = 10;
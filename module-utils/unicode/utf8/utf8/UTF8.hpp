@@ -4,8 +4,10 @@
 #pragma once
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd> // for forward declaration for ostream
+#include <iterator>
 #include <memory>
 #include <optional>
 
@@ -36,10 +38,19 @@ struct U8char
 class UTF8
 {
   protected:
-    UTF8(const char *data, const uint32_t allocated, const uint32_t used, const uint32_t len);
+    UTF8(const char *str, const uint32_t bytes, const uint32_t len);
 
-    /// pointer to buffer
-    std::unique_ptr<char[]> data;
+    /// number of bytes stored inside of the object, short strings don't allocate heap memory
+    static constexpr uint32_t inlineCapacity = 16;
+    /// number of characters between two consecutive entries of the offset index
+    static constexpr uint32_t indexStride = 32;
+    /// minimal number of characters in the string for which offset index is built
+    static constexpr uint32_t indexThreshold = 64;
+
+    /// buffer used for short strings
+    char inlineData[inlineCapacity];
+    /// buffer used when string doesn't fit in inlineData
+    std::unique_ptr<char[]> heapData;
     /// total size of buffer in bytes
     uint32_t sizeAllocated;
     /// number of bytes used in buffer
@@ -48,8 +59,10 @@ class UTF8
     uint32_t strLength;
     /// last used index
     mutable uint32_t lastIndex;
-    /// pointer to last indexed character
-    mutable char *lastIndexData;
+    /// byte offset of last indexed character
+    mutable uint32_t lastIndexOffset;
+    /// sparse index - byte offsets of every indexStride-th character, built on first random access
+    mutable std::unique_ptr<uint32_t[]> offsetIndex;
 
     /// variable used when c_str() is called for a string that has no data yet
     static const char *emptyString;
@@ -63,6 +76,30 @@ class UTF8
      */
     uint32_t getDataBufferSize(uint32_t dataBytes);
     bool expand(uint32_t size = stringExpansion);
+    /**
+     * @brief Ensures that buffer can hold provided number of bytes, current content is preserved.
+     * @param size required size of the buffer in bytes.
+     * @return true if buffer is big enough, false otherwise.
+     */
+    bool reserve(uint32_t size);
+    /// drops cached character positions, has to be called after every modification of the buffer
+    void invalidateIndex() const noexcept;
+    void buildIndex() const;
+    /**
+     * @brief Finds position of the character in the buffer using cached positions.
+     * @param idx index of the character, index equal to length() returns position of the null terminator.
+     * @return pointer to the first byte of the character or nullptr in case of invalid index.
+     */
+    const char *locate(const uint32_t idx) const;
+
+    char *buffer() noexcept
+    {
+        return heapData ? heapData.get() : inlineData;
+    }
+    const char *buffer() const noexcept
+    {
+        return heapData ? heapData.get() : inlineData;
+    }
 
   public:
     UTF8();
@@ -74,6 +111,50 @@ class UTF8
 
     virtual ~UTF8() = default;
 
+    /// forward iterator over the characters of the string, dereferencing returns UTF16 value of character
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = uint32_t;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const uint32_t *;
+        using reference         = uint32_t;
+
+        const_iterator() = default;
+        explicit const_iterator(const char *position) : position{position}
+        {}
+
+        uint32_t operator*() const;
+        const_iterator &operator++();
+        const_iterator operator++(int);
+        bool operator==(const const_iterator &other) const noexcept
+        {
+            return position == other.position;
+        }
+        bool operator!=(const const_iterator &other) const noexcept
+        {
+            return position != other.position;
+        }
+        /// returns pointer to the first byte of the current character
+        const char *raw() const noexcept
+        {
+            return position;
+        }
+
+      private:
+        const char *position = nullptr;
+    };
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator{buffer()};
+    }
+    const_iterator end() const noexcept
+    {
+        return const_iterator{buffer() + sizeUsed - 1};
+    }
+
     /**
      * OPERATORS
      */
@@ -125,7 +206,7 @@ class UTF8
     const char *c_str() const;
 
     /// returns utf8 value on position, to get utf16 use operator[]
-    U8char getChar(unsigned int pos);
+    U8char getChar(unsigned int pos) const;
 
     /**
      * @brief Removes all content from the string and reduce assigned memory to default value.
@@ -509,7 +509,17 @@ namespace purefs::fs::drivers
             LOG_ERROR("Non ext4 filesystem file pointer");
             return -EBADF;
         }
-        return invoke_efs(vfile->mntpoint(), ::ext4_cache_flush, vfile->mntpoint()->mount_path().c_str());
+        const auto err =
+            invoke_efs(vfile->mntpoint(), ::ext4_cache_flush, vfile->mntpoint()->mount_path().c_str());
+        if (err) {
+            return err;
+        }
+        // lwext4 has no sync callback so write the disk manager cache here
+        auto diskmm = disk_mngr();
+        if (!diskmm) {
+            return -EIO;
+        }
+        return diskmm->sync(vfile->mntpoint()->disk());
     }
 
 } // namespace purefs::fs::drivers
@@ -0,0 +1,97 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <purefs/blkdev/defs.hpp>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_freertos
+{
+    class MutexStandard;
+}
+
+namespace purefs::blkdev
+{
+    class disk;
+}
+
+namespace purefs::blkdev::internal
+{
+    /** LRU sector cache for the single hardware partition of the disk.
+     * Sector numbers are absolute ones so all user partitions share the cache
+     * of the hardware partition they belong to.
+     */
+    class disk_cache
+    {
+      public:
+        disk_cache(hwpart_t hwpart, std::size_t sector_size, std::size_t capacity, cache_mode mode);
+        disk_cache(const disk_cache &) = delete;
+        auto operator=(const disk_cache &) -> disk_cache & = delete;
+        ~disk_cache();
+
+        /** Read sectors through the cache
+         * @param[in] dev Underlying block device
+         * @param[out] buf Data buffer for read
+         * @param[in] lba First sector
+         * @param[in] count Sectors count
+         * @return zero on success otherwise error
+         */
+        auto read(disk &dev, void *buf, sector_t lba, std::size_t count) -> int;
+        /** Write sectors through the cache
+         * @param[in] dev Underlying block device
+         * @param[in] buf Data buffer to write
+         * @param[in] lba First sector
+         * @param[in] count Sectors count
+         * @return zero on success otherwise error
+         */
+        auto write(disk &dev, const void *buf, sector_t lba, std::size_t count) -> int;
+        /** Drop the cached sectors and erase them on the device
+         * @param[in] dev Underlying block device
+         * @param[in] lba First sector to erase
+         * @param[in] count Sectors count for erase
+         * @return zero on success otherwise error
+         */
+        auto erase(disk &dev, sector_t lba, std::size_t count) -> int;
+        /** Write all dirty sectors onto the device
+         * @param[in] dev Underlying block device
+         * @return zero on success otherwise error
+         */
+        auto flush(disk &dev) -> int;
+        [[nodiscard]] auto stats() const -> cache_stats;
+
+      private:
+        struct entry
+        {
+            sector_t lba;
+            std::size_t slot;
+            bool dirty;
+        };
+        using lru_list = std::list<entry>;
+
+        auto sector_data(std::size_t slot) noexcept -> std::uint8_t *
+        {
+            return &m_data[slot * m_sector_size];
+        }
+        auto touch(lru_list::iterator it) -> void;
+        auto insert(disk &dev, sector_t lba, const std::uint8_t *data, bool dirty) -> int;
+        auto remove(lru_list::iterator it) -> void;
+        auto bypass(std::size_t count) const noexcept -> bool;
+
+      private:
+        const hwpart_t m_hwpart;
+        const std::size_t m_sector_size;
+        const std::size_t m_capacity;
+        const cache_mode m_mode;
+        std::unique_ptr<std::uint8_t[]> m_data;
+        lru_list m_lru; //! Most recently used sector first
+        std::unordered_map<sector_t, lru_list::iterator> m_index;
+        std::vector<std::size_t> m_free_slots;
+        std::vector<std::uint8_t> m_flush_buffer;
+        cache_stats m_stats{};
+        std::unique_ptr<cpp_freertos::MutexStandard> m_lock;
+    };
+} // namespace purefs::blkdev::internal
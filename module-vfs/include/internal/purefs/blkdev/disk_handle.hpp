@@ -66,7 +66,7 @@ namespace purefs::blkdev::internal
             return (m_partition >= hw_partition_first) ? (m_partition - hw_partition_first + 1) : (0);
         }
         auto sectors() const noexcept -> sector_t;
-        auto name() const noexcept
+        auto name() const noexcept -> const std::string &
         {
             return m_name;
         }
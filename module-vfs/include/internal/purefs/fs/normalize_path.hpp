@@ -0,0 +1,18 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+#include <string_view>
+#include <sys/types.h>
+
+namespace purefs::fs::internal
+{
+    /** Normalize the path into the caller buffer without any allocation
+     * @param[in] cwd Absolute directory used as the base for the relative path
+     * @param[in] path Absolute or relative path to normalize
+     * @param[out] buf Output buffer, cwd.size() + path.size() + 2 bytes are always enough
+     * @param[in] size Output buffer size
+     * @return Normalized path length (not null terminated) or -ENAMETOOLONG
+     */
+    auto normalize_path(std::string_view cwd, std::string_view path, char *buf, std::size_t size) noexcept -> ssize_t;
+} // namespace purefs::fs::internal
@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <purefs/io_stats.hpp>
+#include <functional>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace cpp_freertos
+{
+    class MutexStandard;
+}
+
+namespace purefs::internal
+{
+    /** Collects the I/O statistics per source and the calling task
+     * Latency is measured with the run time statistics timer so the
+     * tracing costs only a timer read and a map lookup per operation
+     */
+    class io_stats_collector
+    {
+      public:
+        using timestamp_t = std::uint32_t;
+
+        io_stats_collector();
+        io_stats_collector(const io_stats_collector &) = delete;
+        auto operator=(const io_stats_collector &) -> io_stats_collector & = delete;
+        ~io_stats_collector();
+
+        /** Start of the traced operation
+         * @return Timestamp for the record call
+         */
+        [[nodiscard]] static auto timestamp() noexcept -> timestamp_t;
+        /** Record the operation finished by the current task
+         * A new source or task is skipped when there is no memory for its entry
+         * @param[in] op Operation type
+         * @param[in] source Mount point or block device name
+         * @param[in] driver Filesystem type or the whole disk name
+         * @param[in] result Result of the operation, negative on error
+         * @param[in] nbytes Bytes transferred
+         * @param[in] start Timestamp taken before the operation
+         */
+        auto record(io_op op,
+                    std::string_view source,
+                    std::string_view driver,
+                    std::int64_t result,
+                    std::size_t nbytes,
+                    timestamp_t start) noexcept -> void;
+        /** Copy of the statistics collected so far
+         * @return Statistics sorted by the source and the task name
+         */
+        [[nodiscard]] auto snapshot() const -> std::vector<io_stats_entry>;
+        /** Remove all the collected statistics
+         */
+        auto reset() noexcept -> void;
+
+      private:
+        [[nodiscard]] static auto current_task() noexcept -> std::string_view;
+
+        using key_type = std::tuple<std::string, std::string>;
+        std::map<key_type, io_stats_entry, std::less<>> m_entries;
+        std::unique_ptr<cpp_freertos::MutexStandard> m_lock;
+    };
+} // namespace purefs::internal
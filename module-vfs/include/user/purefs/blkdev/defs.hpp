@@ -50,6 +50,26 @@ namespace purefs::blkdev
         power_off      //! Device is in poweroff state
     };
 
+    //! Sector cache policy
+    enum class cache_mode
+    {
+        disabled,      //! No sector cache
+        write_through, //! Writes go straight to the device, cached copies are updated
+        write_back     //! Writes are kept in the cache until flush, sync or eviction
+    };
+
+    //! Sector cache statistics
+    struct cache_stats
+    {
+        std::size_t capacity;   //! Cache size in sectors
+        std::size_t cached;     //! Sectors currently in the cache
+        std::size_t dirty;      //! Sectors not yet written to the device
+        std::size_t hits;       //! Sectors read from the cache
+        std::size_t misses;     //! Sectors read from the device
+        std::size_t evictions;  //! Sectors dropped to make room for the new ones
+        std::size_t writebacks; //! Dirty sectors written to the device
+    };
+
     //! Disk manager flags
     struct flags
     {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -11,15 +12,25 @@
 #include <optional>
 #include "defs.hpp"
 #include "partition.hpp"
+#include <purefs/io_stats.hpp>
 
 namespace cpp_freertos
 {
     class MutexRecursive;
 }
 
+namespace purefs::internal
+{
+    class io_stats_collector;
+}
+
 namespace purefs::blkdev
 {
     class disk;
+    namespace internal
+    {
+        class disk_cache;
+    }
 
     /** Disk manager is a class for allows to control block devices media
      */
@@ -72,9 +83,32 @@ namespace purefs::blkdev
         /** Flush buffers and write all data into the physical device
          * param[in] dfd Disc manager fd
          * @return zero or success otherwise error
+         * @note Dirty sectors from all caches of the device are written first
          */
         auto sync(disk_fd dfd) -> int;
         auto sync(std::string_view device_name) -> int;
+        /** Write dirty cached sectors onto the block device without syncing it
+         * @param[in] dfd Disk manager fd
+         * @return zero or success otherwise error
+         */
+        auto flush(disk_fd dfd) -> int;
+        auto flush(std::string_view device_name) -> int;
+        /** Configure the sector cache
+         * @param[in] dfd Disk manager fd
+         * @param[in] mode Cache policy, disabled mode flushes and removes the cache
+         * @param[in] sectors Cache size in sectors
+         * @return zero or success otherwise error
+         * @note The cache is kept per hardware partition, user partitions share the cache of the whole device.
+         * Configure it before mounting the filesystems.
+         */
+        auto configure_cache(disk_fd dfd, cache_mode mode, std::size_t sectors) -> int;
+        auto configure_cache(std::string_view device_name, cache_mode mode, std::size_t sectors) -> int;
+        /** Get the sector cache statistics
+         * @param[in] dfd Disk manager fd
+         * @return Statistics or nothing if the cache is disabled
+         */
+        [[nodiscard]] auto cache_info(disk_fd dfd) const -> std::optional<cache_stats>;
+        [[nodiscard]] auto cache_info(std::string_view device_name) const -> std::optional<cache_stats>;
         /** Set block device power state
          * @param[in] device_name Device or partition name
          * @param[in] target_state Set the target power state
@@ -144,12 +178,32 @@ namespace purefs::blkdev
          */
         static auto disk_handle_from_partition_handle(disk_fd disk) -> disk_fd;
 
+        /** Get the statistics of the read, write, erase and sync calls
+         * @return Statistics per device or partition and calling task
+         */
+        [[nodiscard]] auto io_statistics() const -> std::vector<io_stats_entry>;
+        /** Remove all the collected I/O statistics
+         */
+        auto reset_io_statistics() -> void;
+
       private:
         static auto parse_device_name(std::string_view device) -> std::tuple<std::string_view, part_t>;
         static auto part_lba_to_disk_lba(disk_fd disk, sector_t part_lba, size_t count) -> scount_t;
+        auto find_cache(const disk &disk, hwpart_t hwpart) const -> std::shared_ptr<internal::disk_cache>;
+        auto flush_caches(disk &disk) -> int;
+        auto remove_caches(const disk &disk) -> void;
+        auto trace_io(io_op op,
+                      const internal::disk_handle &dfd,
+                      const disk &disk,
+                      int result,
+                      std::size_t count,
+                      uint32_t start) -> void;
 
       private:
+        using cache_key = std::pair<const disk *, hwpart_t>;
         std::unordered_map<std::string, std::shared_ptr<disk>> m_dev_map;
+        std::map<cache_key, std::shared_ptr<internal::disk_cache>> m_caches;
         std::unique_ptr<cpp_freertos::MutexRecursive> m_lock;
+        std::unique_ptr<purefs::internal::io_stats_collector> m_io_stats;
     };
 } // namespace purefs::blkdev
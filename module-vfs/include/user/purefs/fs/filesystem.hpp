@@ -10,12 +10,15 @@
 #include <functional>
 #include <ctime>
 #include <unordered_set>
+#include <vector>
+#include <optional>
 #include <purefs/fs/handle_mapper.hpp>
 #include <purefs/fs/file_handle.hpp>
 #include <purefs/fs/directory_handle.hpp>
 #include <purefs/fs/mount_point.hpp>
 #include <purefs/fs/mount_flags.hpp>
 #include <purefs/fs/fsnotify.hpp>
+#include <purefs/io_stats.hpp>
 #include <type_traits>
 
 struct statvfs;
@@ -26,6 +29,11 @@ namespace purefs::blkdev
     class disk_manager;
 }
 
+namespace purefs::internal
+{
+    class io_stats_collector;
+}
+
 namespace cpp_freertos
 {
     class MutexRecursive;
@@ -153,6 +161,15 @@ namespace purefs::fs
         /** Inotify API */
         [[nodiscard]] auto inotify_create(std::shared_ptr<sys::Service> svc) -> std::shared_ptr<inotify>;
 
+        /** I/O statistics API */
+        /** Get the statistics of the open, read, write, fsync, stat and readdir calls
+         * @return Statistics per mount point and calling task
+         */
+        [[nodiscard]] auto io_statistics() const -> std::vector<io_stats_entry>;
+        /** Remove all the collected I/O statistics
+         */
+        auto reset_io_statistics() -> void;
+
       private:
         /** Unregister filesystem driver
          * @param[in] fsname Unique filesystem name for example fat
@@ -164,6 +181,9 @@ namespace purefs::fs
          */
         auto find_mount_point(std::string_view path) const noexcept
             -> std::tuple<std::shared_ptr<internal::mount_point>, size_t>;
+        /** Rebuild the mount point lookup index after the mount table change
+         */
+        auto rebuild_mount_index() -> void;
         /** Return absolute path from the relative path
          * @param[in] path Unormalized path
          * @return Full Normalized path
@@ -180,6 +200,19 @@ namespace purefs::fs
         auto remove_filehandle(int fds) noexcept -> fsfile;
         auto find_filehandle(int fds) const noexcept -> fsfile;
         auto autodetect_filesystem_type(std::string_view dev_or_part) const noexcept -> std::string;
+        /** Record the traced operation in the I/O statistics
+         * @param[in] op Operation type
+         * @param[in] mp Mount point the operation was made on
+         * @param[in] fsops Filesystem driver of the mount point
+         * @param[in] result Operation result, for read and write the number of bytes
+         * @param[in] start Timestamp taken before the operation
+         */
+        auto trace_io(io_op op,
+                      const internal::mount_point &mp,
+                      const filesystem_operations &fsops,
+                      std::int64_t result,
+                      std::uint32_t start) const noexcept -> void;
+        static auto io_timestamp() noexcept -> std::uint32_t;
 
         enum class iaccess : bool
         {
@@ -189,6 +222,13 @@ namespace purefs::fs
         template <class Base, class T, typename... Args>
         inline auto invoke_fops(T Base::*method, int fds, Args &&... args)
             -> decltype((static_cast<Base *>(nullptr)->*method)(0, std::forward<Args>(args)...))
+        {
+            return invoke_fops(std::optional<io_op>{}, method, fds, std::forward<Args>(args)...);
+        }
+
+        template <class Base, class T, typename... Args>
+        inline auto invoke_fops(std::optional<io_op> op, T Base::*method, int fds, Args &&... args)
+            -> decltype((static_cast<Base *>(nullptr)->*method)(0, std::forward<Args>(args)...))
         {
             auto fil = find_filehandle(fds);
             if (!fil) {
@@ -203,15 +243,29 @@ namespace purefs::fs
                 if (!fsops) {
                     return -EIO;
                 }
-                else {
+                else if (!op) {
                     return (fsops.get()->*method)(fil, std::forward<Args>(args)...);
                 }
+                else {
+                    const auto start = io_timestamp();
+                    const auto ret   = (fsops.get()->*method)(fil, std::forward<Args>(args)...);
+                    trace_io(*op, *mp, *fsops, ret, start);
+                    return ret;
+                }
             }
         }
 
         template <class Base, class T, typename... Args>
         inline auto invoke_fops(iaccess acc, T Base::*method, std::string_view path, Args &&... args) const
             -> decltype((static_cast<Base *>(nullptr)->*method)(nullptr, {}, std::forward<Args>(args)...))
+        {
+            return invoke_fops(std::optional<io_op>{}, acc, method, path, std::forward<Args>(args)...);
+        }
+
+        template <class Base, class T, typename... Args>
+        inline auto invoke_fops(
+            std::optional<io_op> op, iaccess acc, T Base::*method, std::string_view path, Args &&... args) const
+            -> decltype((static_cast<Base *>(nullptr)->*method)(nullptr, {}, std::forward<Args>(args)...))
         {
             if (path.empty()) {
                 return -ENOENT;
@@ -225,10 +279,18 @@ namespace purefs::fs
                 return -EACCES;
             }
             auto fsops = mountp->fs_ops();
-            if (fsops)
-                return (fsops.get()->*method)(mountp, abspath, std::forward<Args>(args)...);
-            else
+            if (!fsops) {
                 return -EIO;
+            }
+            else if (!op) {
+                return (fsops.get()->*method)(mountp, abspath, std::forward<Args>(args)...);
+            }
+            else {
+                const auto start = io_timestamp();
+                const auto ret   = (fsops.get()->*method)(mountp, abspath, std::forward<Args>(args)...);
+                trace_io(*op, *mountp, *fsops, ret, start);
+                return ret;
+            }
         }
 
         template <class Base, class T, typename... Args>
@@ -250,7 +312,7 @@ namespace purefs::fs
             if (mountp->is_ro()) {
                 return -EACCES;
             }
-            if (path.compare(0, pathpos, path2, 0, pathpos) != 0) {
+            if (abspath.compare(0, pathpos, abspath2, 0, pathpos) != 0) {
                 // Mount points are not the same
                 return -EXDEV;
             }
@@ -263,6 +325,13 @@ namespace purefs::fs
         template <class Base, class T, typename... Args>
         inline auto invoke_fops(T Base::*method, fsdir dirp, Args &&... args)
             -> decltype((static_cast<Base *>(nullptr)->*method)(nullptr, std::forward<Args>(args)...))
+        {
+            return invoke_fops(std::optional<io_op>{}, method, std::move(dirp), std::forward<Args>(args)...);
+        }
+
+        template <class Base, class T, typename... Args>
+        inline auto invoke_fops(std::optional<io_op> op, T Base::*method, fsdir dirp, Args &&... args)
+            -> decltype((static_cast<Base *>(nullptr)->*method)(nullptr, std::forward<Args>(args)...))
         {
             const auto err = dirp->error();
             if (err) {
@@ -277,9 +346,15 @@ namespace purefs::fs
                 if (!fsops) {
                     return -EIO;
                 }
-                else {
+                else if (!op) {
                     return (fsops.get()->*method)(dirp, std::forward<Args>(args)...);
                 }
+                else {
+                    const auto start = io_timestamp();
+                    const auto ret   = (fsops.get()->*method)(dirp, std::forward<Args>(args)...);
+                    trace_io(*op, *mp, *fsops, ret, start);
+                    return ret;
+                }
             }
         }
         auto cleanup_opened_files(std::string_view mount_point) -> void;
@@ -288,9 +363,12 @@ namespace purefs::fs
         std::weak_ptr<blkdev::disk_manager> m_diskmm;
         std::unordered_map<std::string, std::shared_ptr<filesystem_operations>> m_fstypes;
         std::map<std::string, std::shared_ptr<internal::mount_point>> m_mounts;
+        //! Mount points sorted by the descending path length, keys refer to m_mounts
+        std::vector<std::pair<std::string_view, std::shared_ptr<internal::mount_point>>> m_mount_index;
         std::unordered_set<std::string> m_partitions;
         internal::handle_mapper<fsfile> m_fds;
         std::unique_ptr<cpp_freertos::MutexRecursive> m_lock;
         std::shared_ptr<internal::notifier> m_notifier;
+        std::unique_ptr<purefs::internal::io_stats_collector> m_io_stats;
     };
 } // namespace purefs::fs
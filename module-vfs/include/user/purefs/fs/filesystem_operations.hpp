@@ -86,11 +86,17 @@ namespace purefs::fs
         {
             return m_mount_count;
         }
-        auto finalize_registration(std::weak_ptr<blkdev::disk_manager> diskmgr)
+        auto finalize_registration(std::string_view fsname, std::weak_ptr<blkdev::disk_manager> diskmgr)
         {
+            m_fsname = fsname;
             m_diskmm = diskmgr;
             return filesystem_register_completed();
         }
+        //! Name the filesystem was registered with
+        auto fs_name() const noexcept -> std::string_view
+        {
+            return m_fsname;
+        }
 
       protected:
         auto disk_mngr() const noexcept
@@ -105,5 +111,6 @@ namespace purefs::fs
       private:
         std::size_t m_mount_count{};
         std::weak_ptr<blkdev::disk_manager> m_diskmm;
+        std::string m_fsname;
     };
 } // namespace purefs::fs
@@ -36,7 +36,7 @@ namespace purefs::fs::internal
         {
             return m_diskh.lock();
         }
-        auto mount_path() const noexcept
+        auto mount_path() const noexcept -> const std::string &
         {
             return m_path;
         }
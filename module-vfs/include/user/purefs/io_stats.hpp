@@ -0,0 +1,74 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace purefs
+{
+    //! Operation types traced by the VFS and the disk manager
+    enum class io_op : std::uint8_t
+    {
+        open,    //! File or directory open
+        read,    //! File or sectors read
+        write,   //! File or sectors write
+        fsync,   //! File or device sync
+        stat,    //! File status
+        readdir, //! Directory entry read
+        erase,   //! Sectors erase
+    };
+    //! Number of the traced operation types
+    constexpr std::size_t io_op_count = static_cast<std::size_t>(io_op::erase) + 1;
+
+    /** Operation type name
+     * @param[in] op Operation type
+     * @return Operation name for example read
+     */
+    auto io_op_name(io_op op) noexcept -> std::string_view;
+
+    //! Statistics of the single operation type
+    struct io_op_stats
+    {
+        //! Latency resolution, the same as the resolution of the run time statistics timer
+        static constexpr std::uint32_t latency_resolution_us = 100;
+        //! Bucket n counts the operations shorter than 2^n * resolution, the last one counts all the longer ones
+        static constexpr std::size_t histogram_buckets = 16;
+
+        std::uint32_t calls{};    //! Number of calls
+        std::uint32_t errors{};   //! Number of calls which returned an error
+        std::uint64_t bytes{};    //! Bytes transferred
+        std::uint64_t total_us{}; //! Total time spent in the calls
+        std::uint32_t max_us{};   //! Longest call
+        std::array<std::uint32_t, histogram_buckets> histogram{};
+
+        /** Record the single operation
+         * @param[in] result Result of the operation, negative on error
+         * @param[in] nbytes Bytes transferred
+         * @param[in] latency_us Time spent in the operation
+         */
+        auto record(std::int64_t result, std::size_t nbytes, std::uint32_t latency_us) noexcept -> void;
+        /** Upper bound of the latency percentile
+         * @param[in] percent Percentile from 1 to 100
+         * @return Latency upper bound or zero if there were no calls
+         */
+        [[nodiscard]] auto percentile_us(unsigned percent) const noexcept -> std::uint32_t;
+    };
+
+    //! Statistics of the single source used by the single task
+    struct io_stats_entry
+    {
+        std::string source; //! Mount point or block device name
+        std::string driver; //! Filesystem type or the whole disk name
+        std::string task;   //! Name of the calling task
+        std::array<io_op_stats, io_op_count> ops;
+
+        [[nodiscard]] auto op(io_op type) const noexcept -> const io_op_stats &
+        {
+            return ops[static_cast<std::size_t>(type)];
+        }
+    };
+} // namespace purefs
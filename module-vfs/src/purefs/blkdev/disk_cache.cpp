@@ -0,0 +1,233 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <purefs/blkdev/disk_cache.hpp>
+#include <purefs/blkdev/disk.hpp>
+#include <mutex.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace purefs::blkdev::internal
+{
+    namespace
+    {
+        //! Maximum number of adjacent dirty sectors written in a single request
+        constexpr std::size_t max_flush_sectors = 32;
+    } // namespace
+
+    disk_cache::disk_cache(hwpart_t hwpart, std::size_t sector_size, std::size_t capacity, cache_mode mode)
+        : m_hwpart(hwpart), m_sector_size(sector_size), m_capacity(capacity), m_mode(mode),
+          m_data(std::make_unique<std::uint8_t[]>(capacity * sector_size)),
+          m_lock(std::make_unique<cpp_freertos::MutexStandard>())
+    {
+        m_index.reserve(capacity);
+        m_free_slots.reserve(capacity);
+        for (std::size_t slot = capacity; slot > 0; --slot) {
+            m_free_slots.push_back(slot - 1);
+        }
+        m_stats.capacity = capacity;
+    }
+
+    disk_cache::~disk_cache()
+    {}
+
+    auto disk_cache::read(disk &dev, void *buf, sector_t lba, std::size_t count) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        auto out = static_cast<std::uint8_t *>(buf);
+        for (std::size_t i = 0; i < count;) {
+            if (const auto it = m_index.find(lba + i); it != std::end(m_index)) {
+                std::memcpy(&out[i * m_sector_size], sector_data(it->second->slot), m_sector_size);
+                touch(it->second);
+                ++m_stats.hits;
+                ++i;
+                continue;
+            }
+            // Read the whole run of missing sectors at once
+            std::size_t run = 1;
+            while (i + run < count && m_index.find(lba + i + run) == std::end(m_index)) {
+                ++run;
+            }
+            m_stats.misses += run;
+            auto err = dev.read(&out[i * m_sector_size], lba + i, run, m_hwpart);
+            if (err) {
+                return err;
+            }
+            if (!bypass(run)) {
+                for (std::size_t j = i; j < i + run; ++j) {
+                    err = insert(dev, lba + j, &out[j * m_sector_size], false);
+                    if (err) {
+                        return err;
+                    }
+                }
+            }
+            i += run;
+        }
+        return 0;
+    }
+
+    auto disk_cache::write(disk &dev, const void *buf, sector_t lba, std::size_t count) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        auto in = static_cast<const std::uint8_t *>(buf);
+        if (m_mode == cache_mode::write_through || bypass(count)) {
+            const auto err = dev.write(buf, lba, count, m_hwpart);
+            if (err) {
+                return err;
+            }
+            // Keep already cached copies up to date, they are clean now
+            for (std::size_t i = 0; i < count; ++i) {
+                if (const auto it = m_index.find(lba + i); it != std::end(m_index)) {
+                    std::memcpy(sector_data(it->second->slot), &in[i * m_sector_size], m_sector_size);
+                    if (it->second->dirty) {
+                        it->second->dirty = false;
+                        --m_stats.dirty;
+                    }
+                }
+            }
+            return 0;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            if (const auto it = m_index.find(lba + i); it != std::end(m_index)) {
+                std::memcpy(sector_data(it->second->slot), &in[i * m_sector_size], m_sector_size);
+                if (!it->second->dirty) {
+                    it->second->dirty = true;
+                    ++m_stats.dirty;
+                }
+                touch(it->second);
+            }
+            else {
+                const auto err = insert(dev, lba + i, &in[i * m_sector_size], true);
+                if (err) {
+                    return err;
+                }
+            }
+        }
+        return 0;
+    }
+
+    auto disk_cache::erase(disk &dev, sector_t lba, std::size_t count) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        const auto err = dev.erase(lba, count, m_hwpart);
+        if (err) {
+            return err;
+        }
+        if (count < m_index.size()) {
+            for (auto sector = lba; sector < lba + count; ++sector) {
+                if (const auto it = m_index.find(sector); it != std::end(m_index)) {
+                    remove(it->second);
+                }
+            }
+        }
+        else {
+            for (auto it = std::begin(m_lru); it != std::end(m_lru);) {
+                const auto current = it++;
+                if (current->lba >= lba && current->lba < lba + count) {
+                    remove(current);
+                }
+            }
+        }
+        return 0;
+    }
+
+    auto disk_cache::flush(disk &dev) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        if (m_stats.dirty == 0) {
+            return 0;
+        }
+        std::vector<entry *> dirty;
+        dirty.reserve(m_stats.dirty);
+        for (auto &ent : m_lru) {
+            if (ent.dirty) {
+                dirty.push_back(&ent);
+            }
+        }
+        std::sort(std::begin(dirty), std::end(dirty), [](auto a, auto b) { return a->lba < b->lba; });
+
+        // Merge adjacent sectors into the single device request
+        m_flush_buffer.resize(max_flush_sectors * m_sector_size);
+        for (std::size_t i = 0; i < dirty.size();) {
+            std::size_t run = 1;
+            while (i + run < dirty.size() && run < max_flush_sectors &&
+                   dirty[i + run]->lba == dirty[i]->lba + run) {
+                ++run;
+            }
+            for (std::size_t j = 0; j < run; ++j) {
+                std::memcpy(&m_flush_buffer[j * m_sector_size], sector_data(dirty[i + j]->slot), m_sector_size);
+            }
+            const auto err = dev.write(m_flush_buffer.data(), dirty[i]->lba, run, m_hwpart);
+            if (err) {
+                return err;
+            }
+            for (std::size_t j = 0; j < run; ++j) {
+                dirty[i + j]->dirty = false;
+            }
+            m_stats.dirty -= run;
+            m_stats.writebacks += run;
+            i += run;
+        }
+        return 0;
+    }
+
+    auto disk_cache::stats() const -> cache_stats
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        auto ret   = m_stats;
+        ret.cached = m_index.size();
+        return ret;
+    }
+
+    auto disk_cache::touch(lru_list::iterator it) -> void
+    {
+        m_lru.splice(std::begin(m_lru), m_lru, it);
+    }
+
+    auto disk_cache::insert(disk &dev, sector_t lba, const std::uint8_t *data, bool dirty) -> int
+    {
+        if (!m_free_slots.empty()) {
+            m_lru.push_front({lba, m_free_slots.back(), dirty});
+            m_free_slots.pop_back();
+        }
+        else {
+            // Reuse the least recently used entry
+            const auto victim = std::prev(std::end(m_lru));
+            if (victim->dirty) {
+                const auto err = dev.write(sector_data(victim->slot), victim->lba, 1, m_hwpart);
+                if (err) {
+                    return err;
+                }
+                --m_stats.dirty;
+                ++m_stats.writebacks;
+            }
+            ++m_stats.evictions;
+            m_index.erase(victim->lba);
+            victim->lba   = lba;
+            victim->dirty = dirty;
+            touch(victim);
+        }
+        std::memcpy(sector_data(m_lru.front().slot), data, m_sector_size);
+        m_index.emplace(lba, std::begin(m_lru));
+        if (dirty) {
+            ++m_stats.dirty;
+        }
+        return 0;
+    }
+
+    auto disk_cache::remove(lru_list::iterator it) -> void
+    {
+        if (it->dirty) {
+            --m_stats.dirty;
+        }
+        m_free_slots.push_back(it->slot);
+        m_index.erase(it->lba);
+        m_lru.erase(it);
+    }
+
+    auto disk_cache::bypass(std::size_t count) const noexcept -> bool
+    {
+        // Large sequential transfers would only flush out the frequently used metadata
+        return count > m_capacity / 2;
+    }
+} // namespace purefs::blkdev::internal
@@ -9,10 +9,10 @@
 #include <charconv>
 #include <tuple>
 #include <purefs/blkdev/disk_handle.hpp>
+#include <purefs/blkdev/disk_cache.hpp>
 #include <purefs/blkdev/partition_parser.hpp>
+#include <purefs/io_stats_collector.hpp>
 
-/** NOTE: Device manager implementation without sector cache
- */
 namespace purefs::blkdev
 {
     namespace
@@ -22,11 +22,17 @@ namespace purefs::blkdev
         static constexpr auto syspart_suffix = "sys"sv;
     } // namespace
 
-    disk_manager::disk_manager() : m_lock(std::make_unique<cpp_freertos::MutexRecursive>())
+    disk_manager::disk_manager()
+        : m_lock(std::make_unique<cpp_freertos::MutexRecursive>()),
+          m_io_stats(std::make_unique<purefs::internal::io_stats_collector>())
     {}
 
     disk_manager::~disk_manager()
-    {}
+    {
+        for (const auto &dev : m_dev_map) {
+            flush_caches(*dev.second);
+        }
+    }
 
     auto disk_manager::register_device(std::shared_ptr<disk> disk, std::string_view device_name, unsigned flags) -> int
     {
@@ -65,6 +71,10 @@ namespace purefs::blkdev
             LOG_ERROR("Disc with given name doesn't exists in manager");
             return -ENOENT;
         }
+        if (const auto err = flush_caches(*it->second); err) {
+            LOG_ERROR("Unable to flush disk cache errno %i", err);
+        }
+        remove_caches(*it->second);
         auto ret = it->second->cleanup();
         m_dev_map.erase(it);
         if (ret < 0) {
@@ -170,9 +180,12 @@ namespace purefs::blkdev
         if (calc_lba < 0) {
             return calc_lba;
         }
-        else {
-            return disk->write(buf, calc_lba, count, dfd->system_partition());
-        }
+        const auto start = purefs::internal::io_stats_collector::timestamp();
+        const auto cache = find_cache(*disk, dfd->system_partition());
+        const auto err   = cache ? (cache->write(*disk, buf, calc_lba, count))
+                                 : (disk->write(buf, calc_lba, count, dfd->system_partition()));
+        trace_io(io_op::write, *dfd, *disk, err, count, start);
+        return err;
     }
     auto disk_manager::read(disk_fd dfd, void *buf, sector_t lba, std::size_t count) -> int
     {
@@ -189,9 +202,12 @@ namespace purefs::blkdev
         if (calc_lba < 0) {
             return calc_lba;
         }
-        else {
-            return disk->read(buf, calc_lba, count, dfd->system_partition());
-        }
+        const auto start = purefs::internal::io_stats_collector::timestamp();
+        const auto cache = find_cache(*disk, dfd->system_partition());
+        const auto err   = cache ? (cache->read(*disk, buf, calc_lba, count))
+                                 : (disk->read(buf, calc_lba, count, dfd->system_partition()));
+        trace_io(io_op::read, *dfd, *disk, err, count, start);
+        return err;
     }
     auto disk_manager::erase(disk_fd dfd, sector_t lba, std::size_t count) -> int
     {
@@ -208,9 +224,12 @@ namespace purefs::blkdev
         if (calc_lba < 0) {
             return calc_lba;
         }
-        else {
-            return disk->erase(calc_lba, count, dfd->system_partition());
-        }
+        const auto start = purefs::internal::io_stats_collector::timestamp();
+        const auto cache = find_cache(*disk, dfd->system_partition());
+        const auto err   = cache ? (cache->erase(*disk, calc_lba, count))
+                                 : (disk->erase(calc_lba, count, dfd->system_partition()));
+        trace_io(io_op::erase, *dfd, *disk, err, count, start);
+        return err;
     }
     auto disk_manager::sync(disk_fd dfd) -> int
     {
@@ -223,7 +242,77 @@ namespace purefs::blkdev
             LOG_ERROR("Disk doesn't exists");
             return -ENOENT;
         }
-        return disk->sync();
+        const auto start = purefs::internal::io_stats_collector::timestamp();
+        auto err         = flush_caches(*disk);
+        if (!err) {
+            err = disk->sync();
+        }
+        trace_io(io_op::fsync, *dfd, *disk, err, 0, start);
+        return err;
+    }
+    auto disk_manager::flush(disk_fd dfd) -> int
+    {
+        if (!dfd) {
+            LOG_ERROR("Disk handle doesn't exists");
+            return -EINVAL;
+        }
+        auto disk = dfd->disk();
+        if (!disk) {
+            LOG_ERROR("Disk doesn't exists");
+            return -ENOENT;
+        }
+        const auto cache = find_cache(*disk, dfd->system_partition());
+        return cache ? cache->flush(*disk) : 0;
+    }
+    auto disk_manager::configure_cache(disk_fd dfd, cache_mode mode, std::size_t sectors) -> int
+    {
+        if (!dfd) {
+            LOG_ERROR("Disk handle doesn't exists");
+            return -EINVAL;
+        }
+        auto disk = dfd->disk();
+        if (!disk) {
+            LOG_ERROR("Disk doesn't exists");
+            return -ENOENT;
+        }
+        const hwpart_t hwpart = dfd->system_partition();
+        const auto sect_size  = disk->get_info(info_type::sector_size, hwpart);
+        if (sect_size <= 0) {
+            LOG_ERROR("Unable to get sector size %li", long(sect_size));
+            return (sect_size < 0) ? (sect_size) : (-EIO);
+        }
+        cpp_freertos::LockGuard _lck(*m_lock);
+        const auto it = m_caches.find({disk.get(), hwpart});
+        if (it != std::end(m_caches)) {
+            const auto err = it->second->flush(*disk);
+            if (err) {
+                LOG_ERROR("Unable to flush disk cache errno %i", err);
+                return err;
+            }
+            m_caches.erase(it);
+        }
+        if (mode != cache_mode::disabled && sectors > 0) {
+            m_caches.emplace(cache_key{disk.get(), hwpart},
+                             std::make_shared<internal::disk_cache>(hwpart, sect_size, sectors, mode));
+        }
+        return 0;
+    }
+    auto disk_manager::cache_info(disk_fd dfd) const -> std::optional<cache_stats>
+    {
+        if (!dfd) {
+            LOG_ERROR("Disk handle doesn't exists");
+            return std::nullopt;
+        }
+        auto disk = dfd->disk();
+        if (!disk) {
+            LOG_ERROR("Disk doesn't exists");
+            return std::nullopt;
+        }
+        const auto cache = find_cache(*disk, dfd->system_partition());
+        if (!cache) {
+            return std::nullopt;
+        }
+        return cache->stats();
     }
     auto disk_manager::pm_control(disk_fd dfd, pm_state target_state) -> int
     {
@@ -236,6 +325,12 @@ namespace purefs::blkdev
             LOG_ERROR("Disk doesn't exists");
             return -ENOENT;
         }
+        if (target_state != pm_state::active) {
+            const auto err = flush_caches(*disk);
+            if (err) {
+                return err;
+            }
+        }
         return disk->pm_control(target_state);
     }
     auto disk_manager::pm_control(pm_state target_state) -> int
@@ -243,7 +338,10 @@ namespace purefs::blkdev
         cpp_freertos::LockGuard _lck(*m_lock);
         int last_err{};
         for (const auto &disk : m_dev_map) {
-            auto err = disk.second->pm_control(target_state);
+            auto err = (target_state != pm_state::active) ? flush_caches(*disk.second) : 0;
+            if (!err) {
+                err = disk.second->pm_control(target_state);
+            }
             if (err) {
                 LOG_ERROR("Unable to change PM state for specified device. Errno: %i", err);
                 last_err = err;
@@ -357,6 +455,10 @@ namespace purefs::blkdev
             LOG_ERROR("Disk doesn't exists");
             return {};
         }
+        // Partition parser reads the device directly
+        if (const auto err = flush_caches(*disk); err) {
+            return err;
+        }
         disk->clear_partitions();
         internal::partition_parser pparser(disk, disk->partitions());
         auto ret = pparser.partition_search();
@@ -404,6 +506,30 @@ namespace purefs::blkdev
         else
             return -ENOENT;
     }
+    auto disk_manager::flush(std::string_view device_name) -> int
+    {
+        auto dfd = device_handle(device_name);
+        if (dfd)
+            return flush(dfd);
+        else
+            return -ENOENT;
+    }
+    auto disk_manager::configure_cache(std::string_view device_name, cache_mode mode, std::size_t sectors) -> int
+    {
+        auto dfd = device_handle(device_name);
+        if (dfd)
+            return configure_cache(dfd, mode, sectors);
+        else
+            return -ENOENT;
+    }
+    auto disk_manager::cache_info(std::string_view device_name) const -> std::optional<cache_stats>
+    {
+        auto dfd = device_handle(device_name);
+        if (dfd)
+            return cache_info(dfd);
+        else
+            return std::nullopt;
+    }
     auto disk_manager::pm_control(std::string_view device_name, pm_state target_state) -> int
     {
         auto dfd = device_handle(device_name);
@@ -465,5 +591,52 @@ namespace purefs::blkdev
         const auto new_name = std::get<0>(parse_device_name(disk->name()));
         return std::make_shared<internal::disk_handle>(disk->disk(), new_name);
     }
+    auto disk_manager::io_statistics() const -> std::vector<io_stats_entry>
+    {
+        return m_io_stats->snapshot();
+    }
+    auto disk_manager::reset_io_statistics() -> void
+    {
+        m_io_stats->reset();
+    }
+    auto disk_manager::trace_io(
+        io_op op, const internal::disk_handle &dfd, const disk &disk, int result, std::size_t count, uint32_t start)
+        -> void
+    {
+        std::size_t nbytes = 0;
+        if (result >= 0 && count > 0) {
+            const auto sect_size = disk.get_info(info_type::sector_size, dfd.system_partition());
+            nbytes               = (sect_size > 0) ? (count * sect_size) : (0);
+        }
+        const auto &name       = dfd.name();
+        const auto device_name = std::get<0>(parse_device_name(name));
+        m_io_stats->record(op, name, device_name, result, nbytes, start);
+    }
+    auto disk_manager::find_cache(const disk &disk, hwpart_t hwpart) const -> std::shared_ptr<internal::disk_cache>
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        const auto it = m_caches.find({&disk, hwpart});
+        return (it != std::end(m_caches)) ? (it->second) : (nullptr);
+    }
+    auto disk_manager::flush_caches(disk &disk) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        int last_err{};
+        for (auto it = m_caches.lower_bound({&disk, 0}); it != std::end(m_caches) && it->first.first == &disk; ++it) {
+            const auto err = it->second->flush(disk);
+            if (err) {
+                LOG_ERROR("Unable to flush cache of hw partition %u errno %i", unsigned(it->first.second), err);
+                last_err = err;
+            }
+        }
+        return last_err;
+    }
+    auto disk_manager::remove_caches(const disk &disk) -> void
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        for (auto it = m_caches.lower_bound({&disk, 0}); it != std::end(m_caches) && it->first.first == &disk;) {
+            it = m_caches.erase(it);
+        }
+    }
 
 } // namespace purefs::blkdev
@@ -8,10 +8,12 @@
 #include <purefs/blkdev/disk_handle.hpp>
 #include <purefs/fs/notifier.hpp>
 #include <purefs/fs/fsnotify.hpp>
+#include <purefs/fs/normalize_path.hpp>
+#include <purefs/io_stats_collector.hpp>
 #include <log/log.hpp>
-#include <split_sv.hpp>
 #include <errno.h>
 #include <mutex.hpp>
+#include <algorithm>
 
 namespace purefs::fs
 {
@@ -35,7 +37,8 @@ namespace purefs::fs
     }
     filesystem::filesystem(std::shared_ptr<blkdev::disk_manager> diskmm)
         : m_diskmm(diskmm), m_lock(std::make_unique<cpp_freertos::MutexRecursive>()),
-          m_notifier(std::make_unique<internal::notifier>())
+          m_notifier(std::make_unique<internal::notifier>()),
+          m_io_stats(std::make_unique<purefs::internal::io_stats_collector>())
     {}
 
     filesystem::~filesystem()
@@ -54,7 +57,7 @@ namespace purefs::fs
             return -EEXIST;
         }
         else {
-            const auto ret = fops->finalize_registration(m_diskmm);
+            const auto ret = fops->finalize_registration(fsname, m_diskmm);
             if (ret) {
                 LOG_ERROR("Disc: Unable to register filesystem finalize error %i", ret);
                 return ret;
@@ -147,6 +150,7 @@ namespace purefs::fs
                 if (!ret_mnt) {
                     m_mounts.emplace(std::make_pair(target, mnt_point));
                     m_partitions.emplace(dev_or_part);
+                    rebuild_mount_index();
                 }
                 else {
                     return ret_mnt;
@@ -181,9 +185,17 @@ namespace purefs::fs
             return umnt_ret;
         }
         if (diskh) {
+            // Write the cached sectors left behind by the filesystem
+            if (auto diskmm = m_diskmm.lock(); diskmm) {
+                const auto err = diskmm->sync(diskh);
+                if (err) {
+                    LOG_ERROR("Unable to sync disk after umount errno %i", err);
+                }
+            }
             m_partitions.erase(std::string(diskh->name()));
         }
         m_mounts.erase(mnti);
+        rebuild_mount_index();
         return {};
     }
 
@@ -199,68 +211,51 @@ namespace purefs::fs
     auto filesystem::find_mount_point(std::string_view path) const noexcept
         -> std::tuple<std::shared_ptr<internal::mount_point>, size_t>
     {
-        size_t longest_match{};
-        std::shared_ptr<internal::mount_point> mount_pnt;
         cpp_freertos::LockGuard _lck(*m_lock);
-        for (const auto &mntp : m_mounts) {
-            const auto slen = mntp.first.size();
-            if ((slen < longest_match) || (slen > path.size())) {
+        // Index is sorted by the path length so the first match is the longest one
+        for (const auto &[mnt_path, mnt_point] : m_mount_index) {
+            const auto slen = mnt_path.size();
+            if (slen > path.size()) {
                 continue;
             }
-            if ((slen > 1) && (path[slen] != '/') && (path[slen] != '\0')) {
+            if ((slen > 1) && (slen < path.size()) && (path[slen] != path_separator)) {
                 continue;
             }
-            if (path.compare(0, slen, mntp.first) == 0) {
-                mount_pnt     = mntp.second;
-                longest_match = slen;
+            if (path.compare(0, slen, mnt_path) == 0) {
+                return std::make_tuple(mnt_point, slen);
             }
         }
-        return std::make_tuple(mount_pnt, longest_match);
+        return std::make_tuple(nullptr, 0);
     }
 
-    auto filesystem::absolute_path(std::string_view path) noexcept -> std::string
+    auto filesystem::rebuild_mount_index() -> void
     {
-        std::string ret{};
-        if (!path.empty() && path[0] == path_separator) {
-            ret.append(path);
-        }
-        else {
-            ret.append(internal::get_thread_local_cwd_path()).append("/").append(path);
+        m_mount_index.clear();
+        m_mount_index.reserve(m_mounts.size());
+        for (const auto &mntp : m_mounts) {
+            m_mount_index.emplace_back(mntp.first, mntp.second);
         }
-        return normalize_path(ret);
+        std::stable_sort(std::begin(m_mount_index), std::end(m_mount_index), [](const auto &a, const auto &b) {
+            return a.first.size() > b.first.size();
+        });
+    }
+
+    auto filesystem::absolute_path(std::string_view path) noexcept -> std::string
+    {
+        const auto cwd = (!path.empty() && path[0] == path_separator) ? std::string_view{}
+                                                                       : internal::get_thread_local_cwd_path();
+        // Normalized path is never longer than its input
+        std::string ret(cwd.size() + path.size() + 2, '\0');
+        const auto len = internal::normalize_path(cwd, path, ret.data(), ret.size());
+        ret.resize((len > 0) ? (len) : (0));
+        return ret;
     }
 
     auto filesystem::normalize_path(std::string_view path) noexcept -> std::string
     {
-        std::string ret;
-        auto paths = utils::split<std::list, std::string_view>(path, "/");
-        for (auto it = std::begin(paths); it != std::end(paths);) {
-            if (!it->compare(".")) {
-                it = paths.erase(it);
-            }
-            else if (!it->compare("..")) {
-                auto pit = it;
-                --pit;
-                if (pit != std::end(paths)) {
-                    it = paths.erase(pit);
-                    if (it != std::end(paths))
-                        it = paths.erase(it);
-                }
-                else {
-                    it = paths.erase(it);
-                }
-            }
-            else {
-                ++it;
-            }
-        }
-        for (auto ep : paths) {
-            if (!ep.empty()) {
-                ret.append("/").append(ep);
-            }
-        }
-        if (ret.empty())
-            ret.append("/");
+        std::string ret(path.size() + 2, '\0');
+        const auto len = internal::normalize_path({}, path, ret.data(), ret.size());
+        ret.resize((len > 0) ? (len) : (0));
         return ret;
     }
 
@@ -331,6 +326,31 @@ namespace purefs::fs
         return std::make_shared<inotify>(svc, m_notifier);
     }
 
+    auto filesystem::io_statistics() const -> std::vector<io_stats_entry>
+    {
+        return m_io_stats->snapshot();
+    }
+
+    auto filesystem::reset_io_statistics() -> void
+    {
+        m_io_stats->reset();
+    }
+
+    auto filesystem::io_timestamp() noexcept -> std::uint32_t
+    {
+        return purefs::internal::io_stats_collector::timestamp();
+    }
+
+    auto filesystem::trace_io(io_op op,
+                              const internal::mount_point &mp,
+                              const filesystem_operations &fsops,
+                              std::int64_t result,
+                              std::uint32_t start) const noexcept -> void
+    {
+        const auto transfer = (op == io_op::read || op == io_op::write) && result > 0;
+        m_io_stats->record(op, mp.mount_path(), fsops.fs_name(), result, transfer ? result : 0, start);
+    }
+
     auto filesystem::cleanup_opened_files(std::string_view mount_point) -> void
     {
         LOG_INFO("Closing opened files on mntpoint: %s before umount.", std::string(mount_point).c_str());
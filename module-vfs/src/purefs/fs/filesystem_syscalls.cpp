@@ -19,7 +19,7 @@ namespace purefs::fs
 
     auto filesystem::stat(std::string_view file, struct stat &st) noexcept -> int
     {
-        return invoke_fops(iaccess::ro, &filesystem_operations::stat, file, st);
+        return invoke_fops(io_op::stat, iaccess::ro, &filesystem_operations::stat, file, st);
     }
 
     auto filesystem::unlink(std::string_view name) noexcept -> int
@@ -84,12 +84,12 @@ namespace purefs::fs
 
     auto filesystem::write(int fd, const char *ptr, size_t len) noexcept -> ssize_t
     {
-        return invoke_fops(&filesystem_operations::write, fd, ptr, len);
+        return invoke_fops(io_op::write, &filesystem_operations::write, fd, ptr, len);
     }
 
     auto filesystem::read(int fd, char *ptr, size_t len) noexcept -> ssize_t
     {
-        return invoke_fops(&filesystem_operations::read, fd, ptr, len);
+        return invoke_fops(io_op::read, &filesystem_operations::read, fd, ptr, len);
     }
 
     auto filesystem::seek(int fd, off_t pos, int dir) noexcept -> off_t
@@ -99,7 +99,7 @@ namespace purefs::fs
 
     auto filesystem::fstat(int fd, struct stat &st) noexcept -> int
     {
-        return invoke_fops(&filesystem_operations::fstat, fd, st);
+        return invoke_fops(io_op::stat, &filesystem_operations::fstat, fd, st);
     }
 
     auto filesystem::ftruncate(int fd, off_t len) noexcept -> int
@@ -109,7 +109,7 @@ namespace purefs::fs
 
     auto filesystem::fsync(int fd) noexcept -> int
     {
-        return invoke_fops(&filesystem_operations::fsync, fd);
+        return invoke_fops(io_op::fsync, &filesystem_operations::fsync, fd);
     }
 
     auto filesystem::fchmod(int fd, mode_t mode) noexcept -> int
@@ -163,12 +163,15 @@ namespace purefs::fs
                 LOG_ERROR("Trying to open file with WR... flag on RO filesystem");
                 return -EACCES;
             }
-            auto fh = fsops->open(mountp, abspath, flags, mode);
+            const auto start = io_timestamp();
+            auto fh          = fsops->open(mountp, abspath, flags, mode);
             if (!fh) {
                 LOG_ERROR("VFS: Unable to get fops");
+                trace_io(io_op::open, *mountp, *fsops, -EBADF, start);
                 return -EBADF;
             }
             const auto err = fh->error();
+            trace_io(io_op::open, *mountp, *fsops, err, start);
             if (err) {
                 return err;
             }
@@ -202,11 +205,14 @@ namespace purefs::fs
         }
         auto fsops = mountp->fs_ops();
         if (fsops) {
-            auto dh = fsops->diropen(mountp, abspath);
+            const auto start = io_timestamp();
+            auto dh          = fsops->diropen(mountp, abspath);
             if (!dh) {
                 LOG_ERROR("VFS: Unable to get diropen");
+                trace_io(io_op::open, *mountp, *fsops, -ENXIO, start);
                 return std::make_shared<internal::directory_handle>(nullptr, -ENXIO);
             }
+            trace_io(io_op::open, *mountp, *fsops, dh->error(), start);
             return dh;
         }
         else {
@@ -226,7 +232,7 @@ namespace purefs::fs
             LOG_ERROR("No directory handle");
             return -ENXIO;
         }
-        return invoke_fops(&filesystem_operations::dirnext, dirstate, filename, filestat);
+        return invoke_fops(io_op::readdir, &filesystem_operations::dirnext, dirstate, filename, filestat);
     }
 
     auto filesystem::dirclose(fsdir dirstate) noexcept -> int
@@ -0,0 +1,62 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <purefs/fs/normalize_path.hpp>
+#include <cstring>
+#include <errno.h>
+
+namespace purefs::fs::internal
+{
+    namespace
+    {
+        constexpr auto path_separator = '/';
+
+        //! Append path components to the normalized part of the buffer
+        auto append_components(std::string_view path, char *buf, std::size_t size, std::size_t &len) noexcept -> bool
+        {
+            std::size_t pos = 0;
+            while (pos < path.size()) {
+                auto end = path.find(path_separator, pos);
+                if (end == std::string_view::npos) {
+                    end = path.size();
+                }
+                const auto component = path.substr(pos, end - pos);
+                pos                  = end + 1;
+                if (component.empty() || component == ".") {
+                    continue;
+                }
+                if (component == "..") {
+                    while (len > 0 && buf[--len] != path_separator) {}
+                    continue;
+                }
+                if (len + 1 + component.size() > size) {
+                    return false;
+                }
+                buf[len++] = path_separator;
+                std::memcpy(&buf[len], component.data(), component.size());
+                len += component.size();
+            }
+            return true;
+        }
+    } // namespace
+
+    auto normalize_path(std::string_view cwd, std::string_view path, char *buf, std::size_t size) noexcept -> ssize_t
+    {
+        std::size_t len = 0;
+        if (path.empty() || path[0] != path_separator) {
+            if (!append_components(cwd, buf, size, len)) {
+                return -ENAMETOOLONG;
+            }
+        }
+        if (!append_components(path, buf, size, len)) {
+            return -ENAMETOOLONG;
+        }
+        if (len == 0) {
+            if (size == 0) {
+                return -ENAMETOOLONG;
+            }
+            buf[len++] = path_separator;
+        }
+        return len;
+    }
+} // namespace purefs::fs::internal
@@ -0,0 +1,136 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <purefs/io_stats.hpp>
+#include <purefs/io_stats_collector.hpp>
+#include <mutex.hpp>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <algorithm>
+#include <new>
+
+namespace purefs
+{
+    namespace
+    {
+        constexpr std::string_view io_op_names[io_op_count] = {
+            "open", "read", "write", "fsync", "stat", "readdir", "erase"};
+
+        auto histogram_bucket(std::uint32_t latency_us) noexcept -> std::size_t
+        {
+            auto ticks         = latency_us / io_op_stats::latency_resolution_us;
+            std::size_t bucket = 0;
+            while (ticks > 0 && bucket < io_op_stats::histogram_buckets - 1) {
+                ticks >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+    } // namespace
+
+    auto io_op_name(io_op op) noexcept -> std::string_view
+    {
+        const auto index = static_cast<std::size_t>(op);
+        return (index < io_op_count) ? io_op_names[index] : std::string_view{};
+    }
+
+    auto io_op_stats::record(std::int64_t result, std::size_t nbytes, std::uint32_t latency_us) noexcept -> void
+    {
+        ++calls;
+        if (result < 0) {
+            ++errors;
+        }
+        bytes += nbytes;
+        total_us += latency_us;
+        max_us = std::max(max_us, latency_us);
+        ++histogram[histogram_bucket(latency_us)];
+    }
+
+    auto io_op_stats::percentile_us(unsigned percent) const noexcept -> std::uint32_t
+    {
+        if (calls == 0) {
+            return 0;
+        }
+        const auto threshold = (std::uint64_t(calls) * std::min(percent, 100U) + 99) / 100;
+        std::uint64_t count  = 0;
+        for (std::size_t bucket = 0; bucket < histogram_buckets - 1; ++bucket) {
+            count += histogram[bucket];
+            if (count >= threshold) {
+                return std::min(latency_resolution_us << bucket, max_us);
+            }
+        }
+        return max_us;
+    }
+} // namespace purefs
+
+namespace purefs::internal
+{
+    namespace
+    {
+        //! Frequency of the run time statistics timer
+        constexpr std::uint32_t timestamp_ticks_per_second = 10000;
+        static_assert(io_op_stats::latency_resolution_us * timestamp_ticks_per_second == 1000000);
+        //! Name of the calls made before the scheduler is started, for example in the unit tests
+        constexpr std::string_view no_task_name = "main";
+    } // namespace
+
+    io_stats_collector::io_stats_collector() : m_lock(std::make_unique<cpp_freertos::MutexStandard>())
+    {}
+
+    io_stats_collector::~io_stats_collector()
+    {}
+
+    auto io_stats_collector::timestamp() noexcept -> timestamp_t
+    {
+        return ulHighFrequencyTimerTicks();
+    }
+
+    auto io_stats_collector::current_task() noexcept -> std::string_view
+    {
+        if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+            return no_task_name;
+        }
+        return pcTaskGetName(nullptr);
+    }
+
+    auto io_stats_collector::record(io_op op,
+                                    std::string_view source,
+                                    std::string_view driver,
+                                    std::int64_t result,
+                                    std::size_t nbytes,
+                                    timestamp_t start) noexcept -> void
+    {
+        const auto latency_us = (timestamp() - start) * io_op_stats::latency_resolution_us;
+        const auto task       = current_task();
+        cpp_freertos::LockGuard _lck(*m_lock);
+        auto it = m_entries.find(std::make_tuple(source, task));
+        if (it == std::end(m_entries)) {
+            // called from the noexcept I/O path, no memory only costs the statistics of the new source
+            try {
+                io_stats_entry entry{std::string(source), std::string(driver), std::string(task), {}};
+                it = m_entries.emplace(key_type{source, task}, std::move(entry)).first;
+            }
+            catch (const std::bad_alloc &) {
+                return;
+            }
+        }
+        it->second.ops[static_cast<std::size_t>(op)].record(result, nbytes, latency_us);
+    }
+
+    auto io_stats_collector::snapshot() const -> std::vector<io_stats_entry>
+    {
+        std::vector<io_stats_entry> entries;
+        cpp_freertos::LockGuard _lck(*m_lock);
+        entries.reserve(m_entries.size());
+        for (const auto &entry : m_entries) {
+            entries.push_back(entry.second);
+        }
+        return entries;
+    }
+
+    auto io_stats_collector::reset() noexcept -> void
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        m_entries.clear();
+    }
+} // namespace purefs::internal
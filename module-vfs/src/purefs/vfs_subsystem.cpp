@@ -31,6 +31,7 @@ namespace purefs::subsystem
         constexpr auto block_size_max_shift     = 21;
         constexpr auto block_size_min_shift     = 8;
         constexpr uint32_t nvrom_lfs_block_size = 128U;
+        constexpr auto blkdev_cache_sectors     = 256U;
         namespace json
         {
             constexpr auto os_type = "ostype";
@@ -129,6 +130,11 @@ namespace purefs::subsystem
             LOG_FATAL("Unable to register block device with error %i", err);
             return {};
         }
+        // Metadata blocks of all the partitions are reread constantly
+        err = disk_mgr->configure_cache(default_blkdev_name, blkdev::cache_mode::write_through, blkdev_cache_sectors);
+        if (err) {
+            LOG_WARN("Unable to enable block device cache with error %i", err);
+        }
         const std::shared_ptr<blkdev::disk> nvrom_bdev = deviceFactory->makeDefaultNvmDevice();
         if (nvrom_bdev) {
             err = disk_mgr->register_device(nvrom_bdev, default_nvrom_name, blkdev::flags::no_parts_scan);
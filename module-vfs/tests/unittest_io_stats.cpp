@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include <purefs/io_stats.hpp>
+#include <purefs/io_stats_collector.hpp>
+
+#include <errno.h>
+
+TEST_CASE("I/O statistics of the single operation")
+{
+    using namespace purefs;
+    io_op_stats stats;
+    constexpr auto resolution = io_op_stats::latency_resolution_us;
+    REQUIRE(stats.percentile_us(50) == 0);
+
+    SECTION("Counters")
+    {
+        stats.record(512, 512, 0);
+        stats.record(-EIO, 0, 3 * resolution);
+        stats.record(1024, 1024, resolution);
+        REQUIRE(stats.calls == 3);
+        REQUIRE(stats.errors == 1);
+        REQUIRE(stats.bytes == 1536);
+        REQUIRE(stats.total_us == 4 * resolution);
+        REQUIRE(stats.max_us == 3 * resolution);
+    }
+
+    SECTION("Histogram buckets")
+    {
+        stats.record(0, 0, 0);
+        stats.record(0, 0, resolution - 1);
+        stats.record(0, 0, resolution);
+        stats.record(0, 0, 2 * resolution);
+        stats.record(0, 0, 3 * resolution);
+        stats.record(0, 0, 4 * resolution);
+        stats.record(0, 0, 1000000000);
+        REQUIRE(stats.histogram[0] == 2);
+        REQUIRE(stats.histogram[1] == 1);
+        REQUIRE(stats.histogram[2] == 2);
+        REQUIRE(stats.histogram[3] == 1);
+        REQUIRE(stats.histogram[io_op_stats::histogram_buckets - 1] == 1);
+    }
+
+    SECTION("Percentiles")
+    {
+        for (auto i = 0; i < 90; ++i) {
+            stats.record(0, 0, resolution / 2);
+        }
+        for (auto i = 0; i < 9; ++i) {
+            stats.record(0, 0, 5 * resolution);
+        }
+        stats.record(0, 0, 50 * resolution);
+        REQUIRE(stats.percentile_us(50) == resolution);
+        REQUIRE(stats.percentile_us(90) == resolution);
+        REQUIRE(stats.percentile_us(99) == 8 * resolution);
+        REQUIRE(stats.percentile_us(100) == 50 * resolution);
+    }
+}
+
+TEST_CASE("I/O statistics collector")
+{
+    using namespace purefs;
+    internal::io_stats_collector collector;
+    REQUIRE(collector.snapshot().empty());
+
+    const auto start = internal::io_stats_collector::timestamp();
+    collector.record(io_op::read, "/sys", "vfat", 100, 100, start);
+    collector.record(io_op::read, "/sys", "vfat", 50, 50, start);
+    collector.record(io_op::open, "/user", "littlefs", -ENOENT, 0, start);
+    collector.record(io_op::write, "/sys", "vfat", 10, 10, start);
+
+    const auto stats = collector.snapshot();
+    REQUIRE(stats.size() == 2);
+    REQUIRE(stats[0].source == "/sys");
+    REQUIRE(stats[0].driver == "vfat");
+    REQUIRE(stats[0].op(io_op::read).calls == 2);
+    REQUIRE(stats[0].op(io_op::read).bytes == 150);
+    REQUIRE(stats[0].op(io_op::write).calls == 1);
+    REQUIRE(stats[0].op(io_op::open).calls == 0);
+    REQUIRE(stats[1].source == "/user");
+    REQUIRE(stats[1].driver == "littlefs");
+    REQUIRE(stats[1].task == stats[0].task);
+    REQUIRE(stats[1].op(io_op::open).errors == 1);
+
+    collector.reset();
+    REQUIRE(collector.snapshot().empty());
+}
+
+TEST_CASE("I/O operation names")
+{
+    using namespace purefs;
+    REQUIRE(io_op_name(io_op::open) == "open");
+    REQUIRE(io_op_name(io_op::readdir) == "readdir");
+    REQUIRE(io_op_name(io_op::erase) == "erase");
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include <purefs/fs/normalize_path.hpp>
+
+#include <errno.h>
+#include <string>
+
+namespace
+{
+    std::string normalize(std::string_view cwd, std::string_view path)
+    {
+        std::string buf(cwd.size() + path.size() + 2, '\0');
+        const auto len = purefs::fs::internal::normalize_path(cwd, path, buf.data(), buf.size());
+        REQUIRE(len >= 0);
+        buf.resize(len);
+        return buf;
+    }
+} // namespace
+
+TEST_CASE("Normalize path: absolute paths")
+{
+    REQUIRE(normalize("/sys", "/") == "/");
+    REQUIRE(normalize("/sys", "/user/music") == "/user/music");
+    REQUIRE(normalize("/sys", "/user/music/") == "/user/music");
+    REQUIRE(normalize("/sys", "//user///music//file.mp3") == "/user/music/file.mp3");
+}
+
+TEST_CASE("Normalize path: relative paths")
+{
+    REQUIRE(normalize("/sys", "") == "/sys");
+    REQUIRE(normalize("/sys", "file.txt") == "/sys/file.txt");
+    REQUIRE(normalize("/sys/", "dir/file.txt") == "/sys/dir/file.txt");
+    REQUIRE(normalize("/", "file.txt") == "/file.txt");
+    REQUIRE(normalize("", "file.txt") == "/file.txt");
+}
+
+TEST_CASE("Normalize path: dot components")
+{
+    REQUIRE(normalize("/sys", "./file.txt") == "/sys/file.txt");
+    REQUIRE(normalize("/sys", "../user/file.txt") == "/user/file.txt");
+    REQUIRE(normalize("/sys/a/b", "../../c/./d/..") == "/sys/c");
+    REQUIRE(normalize("/sys", "/user/.././sys/./.") == "/sys");
+    REQUIRE(normalize("/sys", "..") == "/");
+    REQUIRE(normalize("/sys", "../../../..") == "/");
+    REQUIRE(normalize("/", "/../user") == "/user");
+    REQUIRE(normalize("/sys", "...") == "/sys/...");
+    REQUIRE(normalize("/sys", ".hidden") == "/sys/.hidden");
+}
+
+TEST_CASE("Normalize path: too small buffer")
+{
+    char buf[8];
+    REQUIRE(purefs::fs::internal::normalize_path("/sys", "file.txt", buf, sizeof buf) == -ENAMETOOLONG);
+    REQUIRE(purefs::fs::internal::normalize_path("/sys", "/abc", buf, sizeof buf) == 4);
+    REQUIRE(std::string_view(buf, 4) == "/abc");
+    REQUIRE(purefs::fs::internal::normalize_path("/sys", "/", buf, 0) == -ENAMETOOLONG);
+}
@@ -29,7 +29,5 @@ class SoundsRepository : public AbstractSoundsRepository
     std::vector<UTF8> getSongTitles() override;
 
   private:
-    void processEntry(const std::filesystem::recursive_directory_iterator::value_type &entry);
-
     std::vector<tags::fetcher::Tags> samples;
 };
@@ -3,21 +3,13 @@
 
 #include "SoundsRepository.hpp"
 
-#include <algorithm>
-
-namespace fs = std::filesystem;
+#include <tags_fetcher/SoundsCatalog.hpp>
 
-namespace
-{
-    constexpr auto allowedExtensions = {".wav", ".mp3", ".flac"};
-} // namespace
+#include <algorithm>
 
 SoundsRepository::SoundsRepository(std::filesystem::path dirToScan)
-{
-    for (auto const &entry : std::filesystem::directory_iterator(dirToScan)) {
-        processEntry(entry);
-    }
-}
+    : samples{tags::SoundsCatalog::getInstance().getSounds(dirToScan)}
+{}
 std::optional<std::filesystem::path> SoundsRepository::titleToPath(const UTF8 &title) const
 {
     const auto res =
@@ -43,14 +35,3 @@ std::vector<UTF8> SoundsRepository::getSongTitles()
     std::transform(samples.begin(), samples.end(), std::back_inserter(ret), [](const auto &e) { return e.title; });
     return ret;
 }
-
-void SoundsRepository::processEntry(const std::filesystem::recursive_directory_iterator::value_type &entry)
-{
-    if (fs::is_regular_file(entry)) {
-        for (const auto &ext : allowedExtensions) {
-            if (fs::path(entry).extension() == ext) {
-                samples.emplace_back(tags::fetcher::fetchTags(fs::absolute(entry).string()));
-            }
-        }
-    }
-}
@@ -142,16 +142,17 @@ namespace sdesktop::endpoints
         unsigned long freeMbytes  = (vfstat->f_bfree * vfstat->f_bsize) / 1024LLU / 1024LLU;
         unsigned long freePercent = (freeMbytes * 100) / totalMbytes;
 
+        const auto gsm = Store::GSM::get()->getSnapshot();
+
         context.setResponseBody(json11::Json::object(
             {{json::batteryLevel, std::to_string(Store::Battery::get().level)},
              {json::batteryState, std::to_string(static_cast<int>(Store::Battery::get().state))},
              {json::selectedSim, std::to_string(static_cast<int>(Store::GSM::get()->selected))},
              {json::trayState, std::to_string(static_cast<int>(Store::GSM::get()->tray))},
-             {json::signalStrength, std::to_string(static_cast<int>(Store::GSM::get()->getSignalStrength().rssiBar))},
-             {json::accessTechnology,
-              std::to_string(static_cast<int>(Store::GSM::get()->getNetwork().accessTechnology))},
-             {json::networkStatus, std::to_string(static_cast<int>(Store::GSM::get()->getNetwork().status))},
-             {json::networkOperatorName, Store::GSM::get()->getNetworkOperatorName()},
+             {json::signalStrength, std::to_string(static_cast<int>(gsm.signalStrength.rssiBar))},
+             {json::accessTechnology, std::to_string(static_cast<int>(gsm.network.accessTechnology))},
+             {json::networkStatus, std::to_string(static_cast<int>(gsm.network.status))},
+             {json::networkOperatorName, std::string(gsm.networkOperatorName.data())},
              {json::fsTotal, std::to_string(totalMbytes)},
              {json::fsFree, std::to_string(freeMbytes)},
              {json::fsFreePercent, std::to_string(freePercent)},
@@ -15,7 +15,7 @@ def setPasscode(harness, flag):
 
 
 testFileName = "lorem-ipsum.txt"
-osLogFileName = "MuditaOS.log"
+osLogFileName = "MuditaOS.log.lz4"
 
 sysUserPath = "/sys/user"
 sysUserLogsPath = sysUserPath + "/logs"
@@ -129,6 +129,6 @@ def test_get_invalid_chunks(harness):
 @pytest.mark.rt1051
 def test_get_file(harness):
     """
-    Get file MuditaOS.log file - whole transfer
+    Get file MuditaOS.log.lz4 file - whole transfer
     """
     get_file(harness, osLogFileName, "./", sysUserLogsPath)
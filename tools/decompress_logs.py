@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+Decompress the log files written by the phone (MuditaOS.log.lz4, MuditaOS.log.lz4.1, ...).
+Rotated files are older, so pass them first to get the logs in chronological order.
+
+e.g.: python3 tools/decompress_logs.py MuditaOS.log.lz4.2 MuditaOS.log.lz4.1 MuditaOS.log.lz4 > MuditaOS.log
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"MLZ4"
+VERSION = 1
+UNCOMPRESSED_BLOCK_FLAG = 0x80000000
+
+
+def read_length(data, pos, length):
+    if length != 15:
+        return length, pos
+    while True:
+        byte = data[pos]
+        pos += 1
+        length += byte
+        if byte != 255:
+            return length, pos
+
+
+def decompress_block(data, raw_size):
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+        literals, pos = read_length(data, pos, token >> 4)
+        out += data[pos:pos + literals]
+        pos += literals
+        if pos >= len(data):
+            break
+        offset = data[pos] | (data[pos + 1] << 8)
+        pos += 2
+        match, pos = read_length(data, pos, token & 15)
+        match += 4
+        start = len(out) - offset
+        if offset == 0 or start < 0:
+            raise ValueError("corrupted block")
+        for i in range(match):
+            out.append(out[start + i])
+    if len(out) != raw_size:
+        raise ValueError("block size mismatch: {} != {}".format(len(out), raw_size))
+    return bytes(out)
+
+
+def decompress_file(path, output):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != MAGIC or data[4] != VERSION:
+        raise ValueError("{} is not a compressed log file".format(path))
+    pos = 5
+    while pos + 8 <= len(data):
+        raw_size, stored_size = struct.unpack_from("<II", data, pos)
+        pos += 8
+        size = stored_size & ~UNCOMPRESSED_BLOCK_FLAG
+        payload = data[pos:pos + size]
+        if len(payload) != size:
+            print("{}: truncated block skipped".format(path), file=sys.stderr)
+            break
+        pos += size
+        if stored_size & UNCOMPRESSED_BLOCK_FLAG:
+            output.write(payload)
+        else:
+            output.write(decompress_block(payload, raw_size))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decompress MuditaOS log files")
+    parser.add_argument("files", nargs="+", help="Compressed log files, the oldest first")
+    parser.add_argument("-o", "--output", help="Output file, defaults to stdout")
+    args = parser.parse_args()
+
+    output = open(args.output, "wb") if args.output else sys.stdout.buffer
+    try:
+        for path in args.files:
+            decompress_file(path, output)
+    finally:
+        if args.output:
+            output.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
+For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+Generate the catalog of the system sounds, so the phone doesn't need to parse
+every audio file on flash to display the sound pickers.
+
+e.g.: python3 tools/generate_sounds_catalog.py --root build/sysroot/sys/current --dir assets/audio
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+CATALOG_VERSION = 1
+
+MPEG_BITRATES = {
+    # (version, layer): kbps by index
+    (1, 1): [0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448],
+    (1, 2): [0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384],
+    (1, 3): [0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320],
+    (2, 1): [0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256],
+    (2, 2): [0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160],
+    (2, 3): [0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160],
+}
+MPEG_SAMPLE_RATES = {1: [44100, 48000, 32000], 2: [22050, 24000, 16000], 2.5: [11025, 12000, 8000]}
+
+
+def decode_text(data):
+    """Decode ID3v2 text frame payload"""
+    if not data:
+        return ""
+    encoding, payload = data[0], data[1:]
+    codec = {0: "latin-1", 1: "utf-16", 2: "utf-16-be", 3: "utf-8"}.get(encoding, "latin-1")
+    return payload.decode(codec, errors="replace").split("\x00")[0].strip()
+
+
+def read_id3(data):
+    """Return (tags, audio offset) of the ID3v2 tagged file"""
+    tags = {}
+    if len(data) < 10 or data[0:3] != b"ID3":
+        return tags, 0
+    major, flags = data[3], data[5]
+    size = (data[6] << 21) | (data[7] << 14) | (data[8] << 7) | data[9]
+    end = 10 + size + (10 if flags & 0x10 else 0)
+    pos = 10
+    frame_ids = {b"TIT2": "title", b"TPE1": "artist", b"TALB": "album"}
+    while pos + 10 <= 10 + size:
+        frame_id = data[pos:pos + 4]
+        if frame_id == b"\x00\x00\x00\x00":
+            break
+        if major == 4:
+            frame_size = (data[pos + 4] << 21) | (data[pos + 5] << 14) | (data[pos + 6] << 7) | data[pos + 7]
+        else:
+            frame_size = struct.unpack(">I", data[pos + 4:pos + 8])[0]
+        if frame_id in frame_ids:
+            tags[frame_ids[frame_id]] = decode_text(data[pos + 10:pos + 10 + frame_size])
+        pos += 10 + frame_size
+    return tags, end
+
+
+def read_mp3(data):
+    tags, pos = read_id3(data)
+    while pos + 4 <= len(data) and not (data[pos] == 0xFF and (data[pos + 1] & 0xE0) == 0xE0):
+        pos += 1
+    if pos + 4 > len(data):
+        return tags
+    header = struct.unpack(">I", data[pos:pos + 4])[0]
+    version = {3: 1, 2: 2, 0: 2.5}.get((header >> 19) & 3)
+    layer = {3: 1, 2: 2, 1: 3}.get((header >> 17) & 3)
+    if version is None or layer is None:
+        return tags
+    bitrate = MPEG_BITRATES[(1 if version == 1 else 2, layer)][(header >> 12) & 0xF]
+    sample_rate = MPEG_SAMPLE_RATES[version][(header >> 10) & 3]
+    channels = 1 if ((header >> 6) & 3) == 3 else 2
+    samples_per_frame = 384 if layer == 1 else (1152 if layer == 2 or version == 1 else 576)
+
+    # VBR files carry the frame count in the Xing/Info header of the first frame
+    duration = 0
+    for marker in (b"Xing", b"Info"):
+        xing = data.find(marker, pos, pos + 64)
+        if xing >= 0 and struct.unpack(">I", data[xing + 4:xing + 8])[0] & 1:
+            frames = struct.unpack(">I", data[xing + 8:xing + 12])[0]
+            duration = frames * samples_per_frame // sample_rate
+            break
+    if not duration and bitrate:
+        duration = (len(data) - pos) * 8 // (bitrate * 1000)
+
+    tags.update({"duration": duration, "sample_rate": sample_rate, "channels": channels, "bitrate": bitrate})
+    return tags
+
+
+def read_wav(data):
+    tags = {}
+    if data[0:4] != b"RIFF" or data[8:12] != b"WAVE":
+        return tags
+    pos, byte_rate = 12, 0
+    while pos + 8 <= len(data):
+        chunk_id, chunk_size = data[pos:pos + 4], struct.unpack("<I", data[pos + 4:pos + 8])[0]
+        if chunk_id == b"fmt ":
+            channels, sample_rate, byte_rate = struct.unpack("<HII", data[pos + 10:pos + 20])
+            tags.update({"sample_rate": sample_rate, "channels": channels, "bitrate": byte_rate * 8 // 1000})
+        elif chunk_id == b"data" and byte_rate:
+            tags["duration"] = chunk_size // byte_rate
+        pos += 8 + chunk_size + (chunk_size & 1)
+    return tags
+
+
+def read_flac(data):
+    tags = {}
+    if data[0:4] != b"fLaC":
+        return tags
+    pos, last = 4, False
+    while not last and pos + 4 <= len(data):
+        last = bool(data[pos] & 0x80)
+        block_type, block_size = data[pos] & 0x7F, struct.unpack(">I", b"\x00" + data[pos + 1:pos + 4])[0]
+        block = data[pos + 4:pos + 4 + block_size]
+        if block_type == 0:
+            info = struct.unpack(">Q", block[10:18])[0]
+            sample_rate, channels, samples = info >> 44, ((info >> 41) & 7) + 1, info & 0xFFFFFFFFF
+            duration = samples // sample_rate if sample_rate else 0
+            tags.update({"duration": duration, "sample_rate": sample_rate, "channels": channels,
+                         "bitrate": len(data) * 8 // duration // 1000 if duration else 0})
+        elif block_type == 4:
+            vendor = struct.unpack("<I", block[0:4])[0]
+            count = struct.unpack("<I", block[4 + vendor:8 + vendor])[0]
+            cpos = 8 + vendor
+            for _ in range(count):
+                length = struct.unpack("<I", block[cpos:cpos + 4])[0]
+                key, _, value = block[cpos + 4:cpos + 4 + length].decode("utf-8", errors="replace").partition("=")
+                if key.lower() in ("title", "artist", "album"):
+                    tags[key.lower()] = value
+                cpos += 4 + length
+        pos += 4 + block_size
+    return tags
+
+
+READERS = {".mp3": read_mp3, ".wav": read_wav, ".flac": read_flac}
+
+
+def catalog_entry(root, path):
+    with open(os.path.join(root, path), "rb") as f:
+        tags = READERS[os.path.splitext(path)[1].lower()](f.read())
+    return {
+        "path": path,
+        # Same fallback as the on device tags fetcher
+        "title": tags.get("title") or os.path.basename(path),
+        "artist": tags.get("artist", ""),
+        "album": tags.get("album", ""),
+        "duration": tags.get("duration", 0),
+        "sample_rate": tags.get("sample_rate", 0),
+        "channels": tags.get("channels", 0),
+        "bitrate": tags.get("bitrate", 0),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the system sounds catalog")
+    parser.add_argument("--root", required=True, help="OS root directory, catalog paths are relative to it")
+    parser.add_argument("--dir", default="assets/audio", help="Sounds directory relative to the root")
+    parser.add_argument("--output", help="Output file, defaults to <root>/<dir>/catalog.json")
+    args = parser.parse_args()
+
+    sounds_dir = os.path.join(args.root, args.dir)
+    if not os.path.isdir(sounds_dir):
+        print("Sounds catalog: no sounds directory {}, skipping".format(sounds_dir))
+        return 0
+
+    sounds = []
+    for dirpath, dirnames, filenames in os.walk(sounds_dir):
+        dirnames.sort()
+        for filename in sorted(filenames):
+            if os.path.splitext(filename)[1].lower() in READERS:
+                path = os.path.relpath(os.path.join(dirpath, filename), args.root)
+                sounds.append(catalog_entry(args.root, path))
+
+    output = args.output or os.path.join(args.root, args.dir, "catalog.json")
+    with open(output, "w") as f:
+        json.dump({"version": CATALOG_VERSION, "sounds": sounds}, f, indent=1, ensure_ascii=False)
+    print("Sounds catalog: {} entries written to {}".format(len(sounds), output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())